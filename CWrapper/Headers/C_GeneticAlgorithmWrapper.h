@@ -0,0 +1,74 @@
+/**
+*  @file    C_GeneticAlgorithmWrapper.h
+*  @author  Jordan Nesley
+*
+*  A plain C interface to the genetic algorithm so it can be driven through any language's FFI.
+*  All objects are opaque handles and no C++ exceptions cross the interface (functions return GA_SUCCESS or an error code).
+**/
+
+#ifndef C_GENETICALGORITHMWRAPPER_H
+#define C_GENETICALGORITHMWRAPPER_H
+
+#include <stdint.h> /* uint64_t */
+
+#ifdef _WIN32
+#define GA_API __declspec(dllexport)
+#else
+#define GA_API __attribute__((visibility("default")))
+#endif
+
+/* Incremented whenever the interface changes in a way that is not backwards compatible */
+#define GA_ABI_VERSION 1
+
+#define GA_SUCCESS 0
+#define GA_ERROR_INVALID_ARGUMENT 1
+#define GA_ERROR_FAILED 2
+
+/* Must match NichingType and CrossoverType in GeneticAlgorithmParameters.h */
+#define GA_NICHING_NONE 0
+#define GA_NICHING_FITNESS_SHARING 1
+#define GA_NICHING_CLEARING 2
+
+#define GA_CROSSOVER_PROPERTY 0
+#define GA_CROSSOVER_ARITHMETIC 1
+#define GA_CROSSOVER_BLX 2
+#define GA_CROSSOVER_SBX 3
+#define GA_CROSSOVER_UNIFORM 4
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+typedef struct GA_Parameters GA_Parameters;
+typedef struct GA_GeneticAlgorithm GA_GeneticAlgorithm;
+
+/** Calculates the fitness of a whole generation in one call (lower fitness is better).
+* @param aValues The property values of all the parents stored one after another (parent i starts at aValues[i*aNumberOfProperties]).
+* @param aNumberOfParents The number of parents.
+* @param aNumberOfProperties The number of properties of each parent.
+* @param aFitness The fitness of each parent must be written here (aNumberOfParents values).
+* @param aUserData The pointer given to GA_Create.
+*/
+typedef void (*GA_BatchFitnessFunction)(const double* aValues, unsigned aNumberOfParents, unsigned aNumberOfProperties, double* aFitness, void* aUserData);
+
+GA_API int GA_GetABIVersion(void);
+
+GA_API GA_Parameters* GA_CreateParameters(unsigned aNumberOfGenerations, unsigned aNumberOfParents, double aRandomParentRatio);
+GA_API void GA_DestroyParameters(GA_Parameters* aParameters);
+GA_API int GA_AddDoubleProperty(GA_Parameters* aParameters, double aMaxValue, double aMinValue);
+GA_API int GA_SetNiching(GA_Parameters* aParameters, int aNichingType, double aNicheRadius, unsigned aNicheCapacity);
+GA_API int GA_SetCrossover(GA_Parameters* aParameters, int aCrossoverType, double aCrossoverParameter);
+GA_API int GA_SetNoisyFitness(GA_Parameters* aParameters, unsigned aInitialSamples, unsigned aMaxSamples, double aConfidenceBound, double aRacingRatio);
+
+GA_API GA_GeneticAlgorithm* GA_Create(unsigned aSeed, const GA_Parameters* aParameters, GA_BatchFitnessFunction aFitnessFunction, void* aUserData);
+GA_API void GA_Destroy(GA_GeneticAlgorithm* aGeneticAlgorithm);
+GA_API int GA_Start(GA_GeneticAlgorithm* aGeneticAlgorithm);
+GA_API double GA_GetBestFitness(const GA_GeneticAlgorithm* aGeneticAlgorithm);
+GA_API unsigned GA_GetBestValues(const GA_GeneticAlgorithm* aGeneticAlgorithm, double* aValues, unsigned aNumberOfValues);
+GA_API uint64_t GA_GetNumberOfEvaluations(const GA_GeneticAlgorithm* aGeneticAlgorithm);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
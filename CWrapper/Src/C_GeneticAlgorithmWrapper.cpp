@@ -0,0 +1,258 @@
+/**
+*  @file    C_GeneticAlgorithmWrapper.cpp
+*  @author  Jordan Nesley
+**/
+
+#include "C_GeneticAlgorithmWrapper.h"
+#include "GeneticAlgorithm.h"
+#include "ParentPropertyDouble.h"
+#include "FitnessEvaluatorBase.h"
+#include <float.h> // DBL_MAX
+
+#pragma unmanaged
+
+/** Evaluates the fitness of a generation by handing the whole block of property values to a C callback.
+*/
+class CallbackEvaluator : public FitnessEvaluatorBase
+{
+	private:
+		GA_BatchFitnessFunction m_Function;
+		void* m_UserData;
+
+	public:
+		CallbackEvaluator(GA_BatchFitnessFunction aFunction, void* aUserData)
+		{
+			this->m_Function = aFunction;
+			this->m_UserData = aUserData;
+		}
+
+		void Evaluate(const std::vector<double>& aValues, const unsigned aNumberOfProperties, std::vector<double>& aFitness) override
+		{
+			unsigned lNumberOfParents = (aNumberOfProperties == 0) ? 0 : aValues.size() / aNumberOfProperties;
+			aFitness.assign(lNumberOfParents, DBL_MAX);
+			if (lNumberOfParents > 0) this->m_Function(aValues.data(), lNumberOfParents, aNumberOfProperties, aFitness.data(), this->m_UserData);
+		}
+};
+
+struct GA_Parameters
+{
+	unsigned NumberOfGenerations;
+	unsigned NumberOfParents;
+	double RandomParentRatio;
+	std::vector<std::shared_ptr<ParentPropertyBase>> ParentTemplate;
+
+	// holds the optional settings (niching, crossover, noisy fitness)
+	GeneticAlgorithmParameters Settings;
+};
+
+struct GA_GeneticAlgorithm
+{
+	std::unique_ptr<GeneticAlgorithm> Algorithm;
+};
+
+/** Returns the version of the C interface.
+*/
+int GA_GetABIVersion(void)
+{
+	return GA_ABI_VERSION;
+}
+
+/** Creates a set of genetic algorithm parameters. Must be destroyed with GA_DestroyParameters.
+* @param aNumberOfGenerations The number of generations.
+* @param aNumberOfParents The number of parents for each generation.
+* @param aRandomParentRatio The percentage of random parents each generation.
+* @return The parameters (null on failure).
+*/
+GA_Parameters* GA_CreateParameters(unsigned aNumberOfGenerations, unsigned aNumberOfParents, double aRandomParentRatio)
+{
+	if (aNumberOfParents < 2) return nullptr;
+
+	try
+	{
+		GA_Parameters* lResult = new GA_Parameters();
+		lResult->NumberOfGenerations = aNumberOfGenerations;
+		lResult->NumberOfParents = aNumberOfParents;
+		lResult->RandomParentRatio = aRandomParentRatio;
+		return lResult;
+	}
+	catch (...)
+	{
+		return nullptr;
+	}
+}
+
+/** Destroys a set of genetic algorithm parameters.
+* @param aParameters The parameters.
+*/
+void GA_DestroyParameters(GA_Parameters* aParameters)
+{
+	delete aParameters;
+}
+
+/** Adds a double property to the parent template.
+* @param aParameters The parameters.
+* @param aMaxValue The maximum value that the property can have.
+* @param aMinValue The minimum value that the property can have.
+*/
+int GA_AddDoubleProperty(GA_Parameters* aParameters, double aMaxValue, double aMinValue)
+{
+	if (aParameters == nullptr || aMaxValue < aMinValue) return GA_ERROR_INVALID_ARGUMENT;
+
+	try
+	{
+		aParameters->ParentTemplate.push_back(std::make_shared<ParentPropertyDouble>(aMaxValue, aMinValue));
+		return GA_SUCCESS;
+	}
+	catch (...)
+	{
+		return GA_ERROR_FAILED;
+	}
+}
+
+/** Sets the niching method (see GeneticAlgorithmParameters::setNiching).
+*/
+int GA_SetNiching(GA_Parameters* aParameters, int aNichingType, double aNicheRadius, unsigned aNicheCapacity)
+{
+	if (aParameters == nullptr || aNichingType < GA_NICHING_NONE || aNichingType > GA_NICHING_CLEARING) return GA_ERROR_INVALID_ARGUMENT;
+
+	aParameters->Settings.setNiching(static_cast<NichingType>(aNichingType), aNicheRadius, aNicheCapacity);
+	return GA_SUCCESS;
+}
+
+/** Sets the crossover method (see GeneticAlgorithmParameters::setCrossover).
+*/
+int GA_SetCrossover(GA_Parameters* aParameters, int aCrossoverType, double aCrossoverParameter)
+{
+	if (aParameters == nullptr || aCrossoverType < GA_CROSSOVER_PROPERTY || aCrossoverType > GA_CROSSOVER_UNIFORM) return GA_ERROR_INVALID_ARGUMENT;
+	if (aCrossoverType == GA_CROSSOVER_SBX && !(aCrossoverParameter >= 0.0)) return GA_ERROR_INVALID_ARGUMENT;
+
+	aParameters->Settings.setCrossover(static_cast<CrossoverType>(aCrossoverType), aCrossoverParameter);
+	return GA_SUCCESS;
+}
+
+/** Sets up racing for a noisy fitness function (see GeneticAlgorithmParameters::setNoisyFitness).
+*/
+int GA_SetNoisyFitness(GA_Parameters* aParameters, unsigned aInitialSamples, unsigned aMaxSamples, double aConfidenceBound, double aRacingRatio)
+{
+	if (aParameters == nullptr) return GA_ERROR_INVALID_ARGUMENT;
+
+	aParameters->Settings.setNoisyFitness(aInitialSamples, aMaxSamples, aConfidenceBound, aRacingRatio);
+	return GA_SUCCESS;
+}
+
+/** Creates a genetic algorithm. Must be destroyed with GA_Destroy.
+* @param aSeed The seed number to use for randomization.
+* @param aParameters The parameters (can be destroyed once the genetic algorithm is created).
+* @param aFitnessFunction The function that calculates the fitness of a whole generation.
+* @param aUserData A pointer passed back to aFitnessFunction.
+* @return The genetic algorithm (null on failure).
+*/
+GA_GeneticAlgorithm* GA_Create(unsigned aSeed, const GA_Parameters* aParameters, GA_BatchFitnessFunction aFitnessFunction, void* aUserData)
+{
+	if (aParameters == nullptr || aFitnessFunction == nullptr || aParameters->ParentTemplate.empty()) return nullptr;
+
+	try
+	{
+		const GeneticAlgorithmParameters& lSettings = aParameters->Settings;
+		GeneticAlgorithmParameters lGAParameters(aParameters->NumberOfGenerations, aParameters->NumberOfParents, aParameters->RandomParentRatio, aParameters->ParentTemplate);
+		lGAParameters.setNiching(lSettings.getNichingType(), lSettings.getNicheRadius(), lSettings.getNicheCapacity());
+		lGAParameters.setCrossover(lSettings.getCrossoverType(), lSettings.getCrossoverParameter());
+		if (lSettings.isNoisyFitness())
+		{
+			lGAParameters.setNoisyFitness(lSettings.getInitialSamples(), lSettings.getMaxSamples(), lSettings.getConfidenceBound(), lSettings.getRacingRatio());
+		}
+
+		GA_GeneticAlgorithm* lResult = new GA_GeneticAlgorithm();
+		lResult->Algorithm.reset(new GeneticAlgorithm(aSeed, lGAParameters, std::make_shared<CallbackEvaluator>(aFitnessFunction, aUserData)));
+		return lResult;
+	}
+	catch (...)
+	{
+		return nullptr;
+	}
+}
+
+/** Destroys a genetic algorithm.
+* @param aGeneticAlgorithm The genetic algorithm.
+*/
+void GA_Destroy(GA_GeneticAlgorithm* aGeneticAlgorithm)
+{
+	delete aGeneticAlgorithm;
+}
+
+/** Runs the genetic algorithm.
+* @param aGeneticAlgorithm The genetic algorithm.
+*/
+int GA_Start(GA_GeneticAlgorithm* aGeneticAlgorithm)
+{
+	if (aGeneticAlgorithm == nullptr) return GA_ERROR_INVALID_ARGUMENT;
+
+	try
+	{
+		aGeneticAlgorithm->Algorithm->Start();
+		return GA_SUCCESS;
+	}
+	catch (...)
+	{
+		return GA_ERROR_FAILED;
+	}
+}
+
+/** Returns the fitness of the best parent found (DBL_MAX if the genetic algorithm has not been run).
+* @param aGeneticAlgorithm The genetic algorithm.
+*/
+double GA_GetBestFitness(const GA_GeneticAlgorithm* aGeneticAlgorithm)
+{
+	if (aGeneticAlgorithm == nullptr) return DBL_MAX;
+
+	try
+	{
+		return aGeneticAlgorithm->Algorithm->GetBestParent().getFitness();
+	}
+	catch (...)
+	{
+		return DBL_MAX;
+	}
+}
+
+/** Copies the property values of the best parent found.
+* @param aGeneticAlgorithm The genetic algorithm.
+* @param aValues The array to copy the values into.
+* @param aNumberOfValues The length of aValues.
+* @return The number of properties of the best parent (may be more than aNumberOfValues).
+*/
+unsigned GA_GetBestValues(const GA_GeneticAlgorithm* aGeneticAlgorithm, double* aValues, unsigned aNumberOfValues)
+{
+	if (aGeneticAlgorithm == nullptr) return 0;
+
+	try
+	{
+		std::vector<double> lValues = aGeneticAlgorithm->Algorithm->GetBestParent().getValues();
+		for (unsigned lCount = 0; lCount < lValues.size() && lCount < aNumberOfValues && aValues != nullptr; lCount++)
+		{
+			aValues[lCount] = lValues[lCount];
+		}
+		return lValues.size();
+	}
+	catch (...)
+	{
+		return 0;
+	}
+}
+
+/** Returns the total number of fitness evaluations made (64 bits on every platform, unlike unsigned long).
+* @param aGeneticAlgorithm The genetic algorithm.
+*/
+uint64_t GA_GetNumberOfEvaluations(const GA_GeneticAlgorithm* aGeneticAlgorithm)
+{
+	if (aGeneticAlgorithm == nullptr) return 0;
+
+	try
+	{
+		return static_cast<uint64_t>(aGeneticAlgorithm->Algorithm->GetNumberOfEvaluations());
+	}
+	catch (...)
+	{
+		return 0;
+	}
+}
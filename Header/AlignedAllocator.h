@@ -0,0 +1,69 @@
+/**
+*  @file    AlignedAllocator.h
+*  @author  Jordan Nesley
+**/
+
+#ifndef ALIGNEDALLOCATOR_H
+#define ALIGNEDALLOCATOR_H
+
+#include <cstddef> // std::size_t
+#include <new> // std::bad_alloc
+#ifdef _WIN32
+#include <malloc.h> // _aligned_malloc
+#else
+#include <stdlib.h> // posix_memalign
+#endif
+
+#pragma unmanaged
+
+/** A std::allocator replacement that aligns every allocation to Alignment bytes (a cache line by default) so SIMD
+*   loads of the first element never split a cache line.
+*/
+template<typename T, std::size_t Alignment = 64>
+class AlignedAllocator
+{
+public:
+	typedef T value_type;
+
+	template<typename U>
+	struct rebind { typedef AlignedAllocator<U, Alignment> other; };
+
+	AlignedAllocator() {}
+	template<typename U>
+	AlignedAllocator(const AlignedAllocator<U, Alignment>&) {}
+
+	/** Allocates aligned memory for aNumberOfElements elements
+	*/
+	T* allocate(const std::size_t aNumberOfElements)
+	{
+		if (aNumberOfElements == 0) return nullptr;
+		if (aNumberOfElements > static_cast<std::size_t>(-1) / sizeof(T)) throw std::bad_alloc();
+
+		void* lResult = nullptr;
+#ifdef _WIN32
+		lResult = _aligned_malloc(aNumberOfElements * sizeof(T), Alignment);
+#else
+		if (posix_memalign(&lResult, Alignment, aNumberOfElements * sizeof(T)) != 0) lResult = nullptr;
+#endif
+		if (lResult == nullptr) throw std::bad_alloc();
+		return static_cast<T*>(lResult);
+	}
+
+	/** Frees memory returned by allocate
+	*/
+	void deallocate(T* const aPointer, const std::size_t)
+	{
+#ifdef _WIN32
+		_aligned_free(aPointer);
+#else
+		free(aPointer);
+#endif
+	}
+
+	template<typename U>
+	bool operator==(const AlignedAllocator<U, Alignment>&) const { return true; }
+	template<typename U>
+	bool operator!=(const AlignedAllocator<U, Alignment>&) const { return false; }
+};
+
+#endif
@@ -0,0 +1,338 @@
+/**
+*  @file    ArrayExpression.h
+*  @author  Jordan Nesley
+**/
+
+#ifndef ARRAYEXPRESSION_H
+#define ARRAYEXPRESSION_H
+
+#include "ArrayView.h"
+#include "ArrayStorage.h"
+#include <cstddef> // std::size_t
+#include <math.h>
+
+#pragma unmanaged
+
+template<typename T, std::size_t Rank, typename Storage>
+class FixedRankArray;
+
+/** The base of every lazy element-wise array expression. Adding, multiplying, etc. arrays (MultidimensionalArray and
+*   FixedRankArray both derive from this class) builds a small tree of expression objects instead of new arrays. No
+*   elements are calculated until the expression is assigned to an array, and then every element is calculated in a
+*   single loop with no temporary arrays.
+*
+*   Every expression E provides:
+*   value_type, evaluate(aPosition) (the element at a position in memory), getTotalNumberOfElements(),
+*   getNumberOfDimensions() and getNumberOfElementsOfDimension(aDimension).
+*
+*   Expressions hold references to the arrays they use, so an expression must be assigned before those arrays are
+*   destroyed (i.e. don't keep an expression of a temporary array in an auto variable).
+*/
+template<typename E>
+class ArrayExpression
+{
+public:
+	const E& derived() const { return static_cast<const E&>(*this); }
+};
+
+/** How an expression stores its operands: arrays by reference, expression nodes (which are small) by value.
+*/
+template<typename E>
+struct ExpressionReference { typedef const E type; };
+
+template<typename T, typename Storage>
+struct ExpressionReference<MultidimensionalArray<T, Storage>> { typedef const MultidimensionalArray<T, Storage>& type; };
+
+template<typename T, std::size_t Rank, typename Storage>
+struct ExpressionReference<FixedRankArray<T, Rank, Storage>> { typedef const FixedRankArray<T, Rank, Storage>& type; };
+
+enum ArrayExpressionException
+{
+	EXPRESSION_DIMENSIONS_DONT_MATCH,
+};
+
+/** Returns true if two expressions have the same dimensions
+*/
+template<typename L, typename R>
+bool expressionShapesMatch(const L& aLeft, const R& aRight)
+{
+	if (aLeft.getNumberOfDimensions() != aRight.getNumberOfDimensions()) return false;
+	for (std::size_t lCount = 0; lCount < aLeft.getNumberOfDimensions(); lCount++)
+	{
+		if (aLeft.getNumberOfElementsOfDimension(lCount) != aRight.getNumberOfElementsOfDimension(lCount)) return false;
+	}
+	return true;
+}
+
+struct ExpressionAssign { template<typename T> static T apply(const T&, const T& aRight) { return aRight; } };
+struct ExpressionAdd { template<typename T> static T apply(const T& aLeft, const T& aRight) { return aLeft + aRight; } };
+struct ExpressionSubtract { template<typename T> static T apply(const T& aLeft, const T& aRight) { return aLeft - aRight; } };
+struct ExpressionMultiply { template<typename T> static T apply(const T& aLeft, const T& aRight) { return aLeft * aRight; } };
+struct ExpressionDivide { template<typename T> static T apply(const T& aLeft, const T& aRight) { return aLeft / aRight; } };
+struct ExpressionReverseSubtract { template<typename T> static T apply(const T& aLeft, const T& aRight) { return aRight - aLeft; } };
+struct ExpressionReverseDivide { template<typename T> static T apply(const T& aLeft, const T& aRight) { return aRight / aLeft; } };
+
+struct ExpressionNegate { template<typename T> static T apply(const T& aValue) { return -aValue; } };
+struct ExpressionExp { template<typename T> static T apply(const T& aValue) { return ::exp(aValue); } };
+struct ExpressionLog { template<typename T> static T apply(const T& aValue) { return ::log(aValue); } };
+
+/** An element-wise operation on two expressions with the same dimensions
+*/
+template<typename L, typename R, typename Op>
+class ArrayBinaryExpression : public ArrayExpression<ArrayBinaryExpression<L, R, Op>>
+{
+private:
+	typename ExpressionReference<L>::type m_Left;
+	typename ExpressionReference<R>::type m_Right;
+
+public:
+	typedef typename L::value_type value_type;
+
+	ArrayBinaryExpression(const L& aLeft, const R& aRight) : m_Left(aLeft), m_Right(aRight)
+	{
+		if (!expressionShapesMatch(aLeft, aRight)) throw EXPRESSION_DIMENSIONS_DONT_MATCH;
+	}
+
+	value_type evaluate(const std::size_t aPosition) const { return Op::apply(this->m_Left.evaluate(aPosition), this->m_Right.evaluate(aPosition)); }
+	std::size_t getTotalNumberOfElements() const { return this->m_Left.getTotalNumberOfElements(); }
+	std::size_t getNumberOfDimensions() const { return this->m_Left.getNumberOfDimensions(); }
+	std::size_t getNumberOfElementsOfDimension(const std::size_t aDimension) const { return this->m_Left.getNumberOfElementsOfDimension(aDimension); }
+};
+
+/** An element-wise operation on an expression and a scalar (the expression is always the left operand of Op)
+*/
+template<typename E, typename Op>
+class ArrayScalarExpression : public ArrayExpression<ArrayScalarExpression<E, Op>>
+{
+public:
+	typedef typename E::value_type value_type;
+
+private:
+	typename ExpressionReference<E>::type m_Expression;
+	value_type m_Scalar;
+
+public:
+	ArrayScalarExpression(const E& aExpression, const value_type aScalar) : m_Expression(aExpression), m_Scalar(aScalar) {}
+
+	value_type evaluate(const std::size_t aPosition) const { return Op::apply(this->m_Expression.evaluate(aPosition), this->m_Scalar); }
+	std::size_t getTotalNumberOfElements() const { return this->m_Expression.getTotalNumberOfElements(); }
+	std::size_t getNumberOfDimensions() const { return this->m_Expression.getNumberOfDimensions(); }
+	std::size_t getNumberOfElementsOfDimension(const std::size_t aDimension) const { return this->m_Expression.getNumberOfElementsOfDimension(aDimension); }
+};
+
+/** An element-wise function of an expression
+*/
+template<typename E, typename Op>
+class ArrayUnaryExpression : public ArrayExpression<ArrayUnaryExpression<E, Op>>
+{
+private:
+	typename ExpressionReference<E>::type m_Expression;
+
+public:
+	typedef typename E::value_type value_type;
+
+	ArrayUnaryExpression(const E& aExpression) : m_Expression(aExpression) {}
+
+	value_type evaluate(const std::size_t aPosition) const { return Op::apply(this->m_Expression.evaluate(aPosition)); }
+	std::size_t getTotalNumberOfElements() const { return this->m_Expression.getTotalNumberOfElements(); }
+	std::size_t getNumberOfDimensions() const { return this->m_Expression.getNumberOfDimensions(); }
+	std::size_t getNumberOfElementsOfDimension(const std::size_t aDimension) const { return this->m_Expression.getNumberOfElementsOfDimension(aDimension); }
+};
+
+/** Repeats a vector along the leading dimensions so it has the same dimensions as another expression.
+*   A row broadcast uses aValues[last coordinate] for every element (aValues has the length of the last dimension).
+*   A column broadcast uses aValues[row] for every element of a row (aValues has one value per row, i.e. the total
+*   number of elements divided by the length of the last dimension).
+*/
+template<typename T, typename S, bool IsRow>
+class ArrayBroadcastExpression : public ArrayExpression<ArrayBroadcastExpression<T, S, IsRow>>
+{
+private:
+	ArrayView<const T> m_Values;
+	typename ExpressionReference<S>::type m_Shape;
+	std::size_t m_LastDimensionLength;
+
+public:
+	typedef T value_type;
+
+	ArrayBroadcastExpression(const ArrayView<const T>& aValues, const S& aShape) : m_Values(aValues), m_Shape(aShape)
+	{
+		this->m_LastDimensionLength = aShape.getNumberOfElementsOfDimension(aShape.getNumberOfDimensions() - 1);
+		std::size_t lExpectedLength = IsRow ? this->m_LastDimensionLength : ((this->m_LastDimensionLength == 0) ? 0 : aShape.getTotalNumberOfElements() / this->m_LastDimensionLength);
+		if (aValues.size() != lExpectedLength) throw EXPRESSION_DIMENSIONS_DONT_MATCH;
+	}
+
+	value_type evaluate(const std::size_t aPosition) const
+	{
+		return IsRow ? this->m_Values[aPosition % this->m_LastDimensionLength] : this->m_Values[aPosition / this->m_LastDimensionLength];
+	}
+	std::size_t getTotalNumberOfElements() const { return this->m_Shape.getTotalNumberOfElements(); }
+	std::size_t getNumberOfDimensions() const { return this->m_Shape.getNumberOfDimensions(); }
+	std::size_t getNumberOfElementsOfDimension(const std::size_t aDimension) const { return this->m_Shape.getNumberOfElementsOfDimension(aDimension); }
+};
+
+/** Calculates the elements of an expression from aBegin to aEnd and combines them with the elements of an array
+* (the parallel assignments give each thread a range)
+* @param aData The elements of the array (stored in the same order as the expression)
+* @param aExpression The expression
+* @param aBegin The position of the first element
+* @param aEnd One past the position of the last element
+*/
+template<typename Op, typename T, typename E>
+void evaluateExpression(T* const aData, const ArrayExpression<E>& aExpression, const std::size_t aBegin, const std::size_t aEnd)
+{
+	const E& lExpression = aExpression.derived();
+	for (std::size_t lCount = aBegin; lCount < aEnd; lCount++)
+	{
+		aData[lCount] = Op::apply(aData[lCount], static_cast<T>(lExpression.evaluate(lCount)));
+	}
+}
+
+/** Calculates every element of an expression and combines it with the element of an array (used by the assignment operators of the arrays)
+* @param aData The elements of the array (stored in the same order as the expression)
+* @param aExpression The expression
+*/
+template<typename Op, typename T, typename E>
+void evaluateExpression(T* const aData, const ArrayExpression<E>& aExpression)
+{
+	evaluateExpression<Op>(aData, aExpression, 0, aExpression.derived().getTotalNumberOfElements());
+}
+
+/** Combines every element of an array with a scalar (used by the assignment operators of the arrays)
+*/
+template<typename Op, typename T>
+void evaluateScalar(T* const aData, const std::size_t aNumberOfElements, const T& aScalar)
+{
+	for (std::size_t lCount = 0; lCount < aNumberOfElements; lCount++)
+	{
+		aData[lCount] = Op::apply(aData[lCount], aScalar);
+	}
+}
+
+template<typename L, typename R>
+ArrayBinaryExpression<L, R, ExpressionAdd> operator+(const ArrayExpression<L>& aLeft, const ArrayExpression<R>& aRight)
+{
+	return ArrayBinaryExpression<L, R, ExpressionAdd>(aLeft.derived(), aRight.derived());
+}
+
+template<typename L, typename R>
+ArrayBinaryExpression<L, R, ExpressionSubtract> operator-(const ArrayExpression<L>& aLeft, const ArrayExpression<R>& aRight)
+{
+	return ArrayBinaryExpression<L, R, ExpressionSubtract>(aLeft.derived(), aRight.derived());
+}
+
+template<typename L, typename R>
+ArrayBinaryExpression<L, R, ExpressionMultiply> operator*(const ArrayExpression<L>& aLeft, const ArrayExpression<R>& aRight)
+{
+	return ArrayBinaryExpression<L, R, ExpressionMultiply>(aLeft.derived(), aRight.derived());
+}
+
+template<typename L, typename R>
+ArrayBinaryExpression<L, R, ExpressionDivide> operator/(const ArrayExpression<L>& aLeft, const ArrayExpression<R>& aRight)
+{
+	return ArrayBinaryExpression<L, R, ExpressionDivide>(aLeft.derived(), aRight.derived());
+}
+
+template<typename E>
+ArrayScalarExpression<E, ExpressionAdd> operator+(const ArrayExpression<E>& aLeft, const typename E::value_type aRight)
+{
+	return ArrayScalarExpression<E, ExpressionAdd>(aLeft.derived(), aRight);
+}
+
+template<typename E>
+ArrayScalarExpression<E, ExpressionAdd> operator+(const typename E::value_type aLeft, const ArrayExpression<E>& aRight)
+{
+	return ArrayScalarExpression<E, ExpressionAdd>(aRight.derived(), aLeft);
+}
+
+template<typename E>
+ArrayScalarExpression<E, ExpressionSubtract> operator-(const ArrayExpression<E>& aLeft, const typename E::value_type aRight)
+{
+	return ArrayScalarExpression<E, ExpressionSubtract>(aLeft.derived(), aRight);
+}
+
+template<typename E>
+ArrayScalarExpression<E, ExpressionReverseSubtract> operator-(const typename E::value_type aLeft, const ArrayExpression<E>& aRight)
+{
+	return ArrayScalarExpression<E, ExpressionReverseSubtract>(aRight.derived(), aLeft);
+}
+
+template<typename E>
+ArrayScalarExpression<E, ExpressionMultiply> operator*(const ArrayExpression<E>& aLeft, const typename E::value_type aRight)
+{
+	return ArrayScalarExpression<E, ExpressionMultiply>(aLeft.derived(), aRight);
+}
+
+template<typename E>
+ArrayScalarExpression<E, ExpressionMultiply> operator*(const typename E::value_type aLeft, const ArrayExpression<E>& aRight)
+{
+	return ArrayScalarExpression<E, ExpressionMultiply>(aRight.derived(), aLeft);
+}
+
+template<typename E>
+ArrayScalarExpression<E, ExpressionDivide> operator/(const ArrayExpression<E>& aLeft, const typename E::value_type aRight)
+{
+	return ArrayScalarExpression<E, ExpressionDivide>(aLeft.derived(), aRight);
+}
+
+template<typename E>
+ArrayScalarExpression<E, ExpressionReverseDivide> operator/(const typename E::value_type aLeft, const ArrayExpression<E>& aRight)
+{
+	return ArrayScalarExpression<E, ExpressionReverseDivide>(aRight.derived(), aLeft);
+}
+
+template<typename E>
+ArrayUnaryExpression<E, ExpressionNegate> operator-(const ArrayExpression<E>& aExpression)
+{
+	return ArrayUnaryExpression<E, ExpressionNegate>(aExpression.derived());
+}
+
+/** Element-wise e^x of an expression
+*/
+template<typename E>
+ArrayUnaryExpression<E, ExpressionExp> exp(const ArrayExpression<E>& aExpression)
+{
+	return ArrayUnaryExpression<E, ExpressionExp>(aExpression.derived());
+}
+
+/** Element-wise natural log of an expression
+*/
+template<typename E>
+ArrayUnaryExpression<E, ExpressionLog> log(const ArrayExpression<E>& aExpression)
+{
+	return ArrayUnaryExpression<E, ExpressionLog>(aExpression.derived());
+}
+
+/** Repeats a row so it has the same dimensions as aShape
+* @param aRow The row (same length as the last dimension of aShape)
+* @param aShape The array (or expression) to take the dimensions from
+*/
+template<typename T, typename S>
+ArrayBroadcastExpression<T, S, true> rowBroadcast(const std::vector<T>& aRow, const ArrayExpression<S>& aShape)
+{
+	return ArrayBroadcastExpression<T, S, true>(ArrayView<const T>(aRow), aShape.derived());
+}
+
+template<typename T, typename S>
+ArrayBroadcastExpression<typename std::remove_const<T>::type, S, true> rowBroadcast(const ArrayView<T>& aRow, const ArrayExpression<S>& aShape)
+{
+	return ArrayBroadcastExpression<typename std::remove_const<T>::type, S, true>(aRow, aShape.derived());
+}
+
+/** Repeats a column so it has the same dimensions as aShape
+* @param aColumn The column (one value for each row of aShape)
+* @param aShape The array (or expression) to take the dimensions from
+*/
+template<typename T, typename S>
+ArrayBroadcastExpression<T, S, false> columnBroadcast(const std::vector<T>& aColumn, const ArrayExpression<S>& aShape)
+{
+	return ArrayBroadcastExpression<T, S, false>(ArrayView<const T>(aColumn), aShape.derived());
+}
+
+template<typename T, typename S>
+ArrayBroadcastExpression<typename std::remove_const<T>::type, S, false> columnBroadcast(const ArrayView<T>& aColumn, const ArrayExpression<S>& aShape)
+{
+	return ArrayBroadcastExpression<typename std::remove_const<T>::type, S, false>(aColumn, aShape.derived());
+}
+
+#endif
@@ -0,0 +1,312 @@
+/**
+*  @file    ArrayStorage.h
+*  @author  Jordan Nesley
+**/
+
+#ifndef ARRAYSTORAGE_H
+#define ARRAYSTORAGE_H
+
+#include "AlignedAllocator.h"
+#include <vector>
+#include <cstddef> // std::size_t
+#include <algorithm> // std::copy, std::fill, std::swap_ranges
+#include <iterator> // std::distance
+#include <type_traits> // std::is_trivially_copyable
+#include <utility> // std::move, std::swap
+#include <memory> // std::shared_ptr
+#include <atomic> // std::atomic_thread_fence
+
+#pragma unmanaged
+
+/** The storage policies of MultidimensionalArray. A storage owns one contiguous block of elements and provides the part
+*   of the std::vector interface the array uses: data(), size(), empty(), operator[], clear(), assign(aCount, aValue) and
+*   assign(aFirst, aLast).
+*
+*   VectorStorage keeps the elements in 64 byte aligned memory and is the default.
+*   InlineStorage keeps up to Capacity elements inside the object itself (e.g. on the stack).
+*   SharedStorage shares the elements between copies until one of them is changed (copy on write).
+*   MappedStorage (MappedStorage.h) keeps the elements in a memory mapped file.
+*/
+template<typename T>
+using VectorStorage = std::vector<T, AlignedAllocator<T>>;
+
+/** A storage with room for Capacity elements inside the object, so small arrays and vectors never allocate. Anything
+*   bigger than Capacity goes to a VectorStorage on the heap.
+*/
+template<typename T, std::size_t Capacity>
+class InlineStorage
+{
+	static_assert(std::is_trivially_copyable<T>::value, "InlineStorage can only hold trivially copyable elements");
+
+private:
+	T m_Inline[Capacity];
+	VectorStorage<T> m_Heap;
+	std::size_t m_Size;
+
+public:
+	typedef T value_type;
+
+	InlineStorage();
+	explicit InlineStorage(const std::size_t aCount, const T& aValue = T());
+	InlineStorage(const InlineStorage& aCopy);
+	InlineStorage(InlineStorage&& aMove);
+	~InlineStorage() = default;
+
+	InlineStorage& operator=(const InlineStorage& aRight);
+	InlineStorage& operator=(InlineStorage&& aRight);
+
+	T* data() { return this->isInline() ? this->m_Inline : this->m_Heap.data(); }
+	const T* data() const { return this->isInline() ? this->m_Inline : this->m_Heap.data(); }
+	std::size_t size() const { return this->m_Size; }
+	bool empty() const { return this->m_Size == 0; }
+	bool isInline() const { return this->m_Size <= Capacity; }
+	T& operator[](const std::size_t aPosition) { return this->data()[aPosition]; }
+	const T& operator[](const std::size_t aPosition) const { return this->data()[aPosition]; }
+	T* begin() { return this->data(); }
+	T* end() { return this->data() + this->m_Size; }
+	const T* begin() const { return this->data(); }
+	const T* end() const { return this->data() + this->m_Size; }
+
+	void clear();
+	void assign(const std::size_t aCount, const T& aValue);
+	template<typename Iterator>
+	void assign(Iterator aFirst, Iterator aLast);
+	void swap(InlineStorage& aOther);
+};
+
+/** Default constructor for InlineStorage (no elements)
+*/
+template<typename T, std::size_t Capacity>
+InlineStorage<T, Capacity>::InlineStorage()
+{
+	this->m_Size = 0;
+}
+
+/** Constructor for InlineStorage
+* @param aCount The number of elements
+* @param aValue The value of every element
+*/
+template<typename T, std::size_t Capacity>
+InlineStorage<T, Capacity>::InlineStorage(const std::size_t aCount, const T& aValue)
+{
+	this->m_Size = 0;
+	this->assign(aCount, aValue);
+}
+
+/** Copy Constructor for InlineStorage
+* @param aCopy The object to copy
+*/
+template<typename T, std::size_t Capacity>
+InlineStorage<T, Capacity>::InlineStorage(const InlineStorage& aCopy)
+{
+	this->m_Size = 0;
+	this->assign(aCopy.begin(), aCopy.end());
+}
+
+/** Move Constructor for InlineStorage. Only heap elements are moved, inline elements are copied.
+* @param aMove The object to move
+*/
+template<typename T, std::size_t Capacity>
+InlineStorage<T, Capacity>::InlineStorage(InlineStorage&& aMove)
+{
+	this->m_Size = 0;
+	*this = std::move(aMove);
+}
+
+/** Assingment operator
+* @param aRight The right side of the = operator
+*/
+template<typename T, std::size_t Capacity>
+InlineStorage<T, Capacity>& InlineStorage<T, Capacity>::operator=(const InlineStorage& aRight)
+{
+	if (this != &aRight) this->assign(aRight.begin(), aRight.end());
+	return *this;
+}
+
+/** Move assignment operator
+* @param aRight The right side of the = operator
+*/
+template<typename T, std::size_t Capacity>
+InlineStorage<T, Capacity>& InlineStorage<T, Capacity>::operator=(InlineStorage&& aRight)
+{
+	if (this == &aRight) return *this;
+
+	if (aRight.isInline())
+	{
+		this->assign(aRight.begin(), aRight.end());
+	}
+	else
+	{
+		this->m_Heap = std::move(aRight.m_Heap);
+		this->m_Size = aRight.m_Size;
+	}
+	aRight.clear();
+	return *this;
+}
+
+/** Removes every element (and frees any heap memory)
+*/
+template<typename T, std::size_t Capacity>
+void InlineStorage<T, Capacity>::clear()
+{
+	this->m_Heap = VectorStorage<T>();
+	this->m_Size = 0;
+}
+
+/** Replaces the elements
+* @param aCount The number of elements
+* @param aValue The value of every element
+*/
+template<typename T, std::size_t Capacity>
+void InlineStorage<T, Capacity>::assign(const std::size_t aCount, const T& aValue)
+{
+	if (aCount <= Capacity)
+	{
+		std::fill(this->m_Inline, this->m_Inline + aCount, aValue); // before freeing the heap, aValue may be in it
+		this->m_Heap = VectorStorage<T>();
+	}
+	else
+	{
+		this->m_Heap.assign(aCount, aValue);
+	}
+	this->m_Size = aCount;
+}
+
+/** Replaces the elements with copies of a range
+* @param aFirst The first element to copy
+* @param aLast One past the last element to copy
+*/
+template<typename T, std::size_t Capacity>
+template<typename Iterator>
+void InlineStorage<T, Capacity>::assign(Iterator aFirst, Iterator aLast)
+{
+	const std::size_t lCount = static_cast<std::size_t>(std::distance(aFirst, aLast));
+	if (lCount <= Capacity)
+	{
+		std::copy(aFirst, aLast, this->m_Inline); // before freeing the heap, the range may be in it
+		this->m_Heap = VectorStorage<T>();
+	}
+	else
+	{
+		this->m_Heap.assign(aFirst, aLast);
+	}
+	this->m_Size = lCount;
+}
+
+/** Exchanges the elements with another storage (only the elements in use are copied when both are inline)
+* @param aOther The other storage
+*/
+template<typename T, std::size_t Capacity>
+void InlineStorage<T, Capacity>::swap(InlineStorage& aOther)
+{
+	const std::size_t lInlineCount = std::max(this->isInline() ? this->m_Size : 0, aOther.isInline() ? aOther.m_Size : 0);
+	std::swap_ranges(this->m_Inline, this->m_Inline + lInlineCount, aOther.m_Inline);
+	this->m_Heap.swap(aOther.m_Heap);
+	std::swap(this->m_Size, aOther.m_Size);
+}
+
+/** A storage whose copies share one reference counted VectorStorage, so copying an array is O(1). The elements are
+*   copied the first time a storage that shares them is written to: the non-const data() and operator[] give the storage
+*   its own elements first, the const versions never copy.
+*
+*   A pointer from the non-const data() writes to this storage only until the storage is copied again, so get a new
+*   pointer after copying. Like the other storages, one storage must not be written to on one thread while it is copied
+*   on another; different copies can be used on different threads.
+*
+*   Opt in per array with MultidimensionalArray<T, SharedStorage<T>>.
+*/
+template<typename T>
+class SharedStorage
+{
+private:
+	std::shared_ptr<VectorStorage<T>> m_Elements;
+
+	void detach();
+
+public:
+	typedef T value_type;
+
+	SharedStorage() = default;
+	SharedStorage(const SharedStorage& aCopy) = default;
+	SharedStorage(SharedStorage&& aMove) = default;
+	~SharedStorage() = default;
+
+	SharedStorage& operator=(const SharedStorage& aRight) = default;
+	SharedStorage& operator=(SharedStorage&& aRight) = default;
+
+	T* data() { this->detach(); return this->m_Elements ? this->m_Elements->data() : nullptr; }
+	const T* data() const { return this->m_Elements ? this->m_Elements->data() : nullptr; }
+	std::size_t size() const { return this->m_Elements ? this->m_Elements->size() : 0; }
+	bool empty() const { return this->size() == 0; }
+	bool isShared() const;
+	T& operator[](const std::size_t aPosition) { return this->data()[aPosition]; }
+	const T& operator[](const std::size_t aPosition) const { return this->data()[aPosition]; }
+
+	void clear();
+	void assign(const std::size_t aCount, const T& aValue);
+	template<typename Iterator>
+	void assign(Iterator aFirst, Iterator aLast);
+};
+
+/** Returns whether another storage shares the elements
+*/
+template<typename T>
+bool SharedStorage<T>::isShared() const
+{
+	if (!this->m_Elements) return false;
+	if (this->m_Elements.use_count() > 1) return true;
+
+	// use_count is a relaxed load, so without the fence the elements could be written in place before a copy that was
+	// just released on another thread has finished reading them
+	std::atomic_thread_fence(std::memory_order_acquire);
+	return false;
+}
+
+/** Gives the storage its own copy of the elements if they are shared with another storage
+*/
+template<typename T>
+void SharedStorage<T>::detach()
+{
+	if (this->isShared()) this->m_Elements = std::make_shared<VectorStorage<T>>(*this->m_Elements);
+}
+
+/** Removes every element (the elements are freed when no other storage shares them)
+*/
+template<typename T>
+void SharedStorage<T>::clear()
+{
+	this->m_Elements.reset();
+}
+
+/** Replaces the elements. Elements shared with another storage are left unchanged for it.
+* @param aCount The number of elements
+* @param aValue The value of every element
+*/
+template<typename T>
+void SharedStorage<T>::assign(const std::size_t aCount, const T& aValue)
+{
+	if (this->m_Elements && !this->isShared()) this->m_Elements->assign(aCount, aValue);
+	else this->m_Elements = std::make_shared<VectorStorage<T>>(aCount, aValue);
+}
+
+/** Replaces the elements with copies of a range. Elements shared with another storage are left unchanged for it.
+* @param aFirst The first element to copy
+* @param aLast One past the last element to copy
+*/
+template<typename T>
+template<typename Iterator>
+void SharedStorage<T>::assign(Iterator aFirst, Iterator aLast)
+{
+	if (this->m_Elements && !this->isShared()) this->m_Elements->assign(aFirst, aLast);
+	else this->m_Elements = std::make_shared<VectorStorage<T>>(aFirst, aLast);
+}
+
+template<typename T, typename Storage = VectorStorage<T>>
+class MultidimensionalArray;
+
+/** A MultidimensionalArray that keeps up to Capacity elements inside the object (see InlineStorage)
+*/
+template<typename T, std::size_t Capacity = 64>
+using SmallMultidimensionalArray = MultidimensionalArray<T, InlineStorage<T, Capacity>>;
+
+#endif
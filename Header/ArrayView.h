@@ -0,0 +1,403 @@
+/**
+*  @file    ArrayView.h
+*  @author  Jordan Nesley
+**/
+
+#ifndef ARRAYVIEW_H
+#define ARRAYVIEW_H
+
+#include <vector>
+#include <cstddef> // std::size_t, std::ptrdiff_t
+#include <iterator> // std::forward_iterator_tag
+#include <type_traits> // std::remove_const
+
+#pragma unmanaged
+
+/** A non-owning view of elements that are evenly spaced in memory (a row, a column or a strided slice of an array).
+*   Reading or writing through the view reads or writes the storage of the array it was taken from, so the view must
+*   not outlive that array or be used after the array is resized.
+*/
+template<typename T>
+class ArrayView
+{
+public:
+	typedef typename std::remove_const<T>::type value_type;
+
+	class Iterator
+	{
+	private:
+		T* m_Position;
+		std::ptrdiff_t m_Stride;
+
+	public:
+		typedef std::forward_iterator_tag iterator_category;
+		typedef typename std::remove_const<T>::type value_type;
+		typedef std::ptrdiff_t difference_type;
+		typedef T* pointer;
+		typedef T& reference;
+
+		Iterator(T* aPosition, const std::ptrdiff_t aStride) : m_Position(aPosition), m_Stride(aStride) {}
+		T& operator*() const { return *this->m_Position; }
+		Iterator& operator++() { this->m_Position += this->m_Stride; return *this; }
+		Iterator operator++(int) { Iterator lResult(*this); this->m_Position += this->m_Stride; return lResult; }
+		bool operator==(const Iterator& aRight) const { return this->m_Position == aRight.m_Position; }
+		bool operator!=(const Iterator& aRight) const { return this->m_Position != aRight.m_Position; }
+	};
+
+private:
+	T* m_Data;
+	std::size_t m_Length;
+	std::ptrdiff_t m_Stride;
+
+public:
+	ArrayView();
+	ArrayView(T* aData, const std::size_t aLength, const std::ptrdiff_t aStride = 1);
+	ArrayView(std::vector<value_type>& aVector);
+	ArrayView(const std::vector<value_type>& aVector);
+	template<typename U>
+	ArrayView(const ArrayView<U>& aView);
+
+	T& operator[](const std::size_t aIndex) const;
+	T& at(const std::size_t aIndex) const;
+
+	std::size_t size() const;
+	std::ptrdiff_t getStride() const;
+	T* data() const;
+	bool isContiguous() const;
+
+	Iterator begin() const;
+	Iterator end() const;
+
+	ArrayView<T> slice(const std::size_t aStart, const std::size_t aLength, const std::size_t aStep = 1) const;
+
+	template<typename Range>
+	void assign(const Range& aValues) const;
+	void fill(const value_type& aValue) const;
+	value_type dot(const ArrayView<const value_type>& aRight) const;
+
+	std::vector<value_type> toVector() const;
+	operator std::vector<value_type>() const;
+
+	enum Exeception
+	{
+		OUT_OF_RANGE,
+		DIMENSIONS_DONT_MATCH,
+	};
+};
+
+/** A non-owning two dimensional view of a block of an array (a sub-matrix). Like ArrayView it reads and writes the
+*   storage of the array it was taken from.
+*/
+template<typename T>
+class ArrayBlockView
+{
+private:
+	T* m_Data;
+	std::size_t m_NumberOfRows;
+	std::size_t m_NumberOfColumns;
+	std::ptrdiff_t m_RowStride;
+	std::ptrdiff_t m_ColumnStride;
+
+public:
+	ArrayBlockView();
+	ArrayBlockView(T* aData, const std::size_t aNumberOfRows, const std::size_t aNumberOfColumns, const std::ptrdiff_t aRowStride, const std::ptrdiff_t aColumnStride = 1);
+
+	T& operator()(const std::size_t aRow, const std::size_t aColumn) const;
+
+	std::size_t getNumberOfRows() const;
+	std::size_t getNumberOfColumns() const;
+
+	ArrayView<T> row(const std::size_t aRow) const;
+	ArrayView<T> column(const std::size_t aColumn) const;
+
+	void fill(const typename std::remove_const<T>::type& aValue) const;
+};
+
+/** Default constructor for ArrayView (an empty view)
+*/
+template<typename T>
+ArrayView<T>::ArrayView()
+{
+	this->m_Data = nullptr;
+	this->m_Length = 0;
+	this->m_Stride = 1;
+}
+
+/** Constructor for ArrayView
+* @param aData A pointer to the first element
+* @param aLength The number of elements in the view
+* @param aStride The distance between two elements that are next to each other in the view
+*/
+template<typename T>
+ArrayView<T>::ArrayView(T* aData, const std::size_t aLength, const std::ptrdiff_t aStride)
+{
+	this->m_Data = aData;
+	this->m_Length = aLength;
+	this->m_Stride = aStride;
+}
+
+/** Constructor for ArrayView that views all the elements of a vector
+* @param aVector The vector
+*/
+template<typename T>
+ArrayView<T>::ArrayView(std::vector<value_type>& aVector)
+{
+	this->m_Data = aVector.data();
+	this->m_Length = aVector.size();
+	this->m_Stride = 1;
+}
+
+/** Constructor for a read only ArrayView that views all the elements of a vector (only usable when T is const)
+* @param aVector The vector
+*/
+template<typename T>
+ArrayView<T>::ArrayView(const std::vector<value_type>& aVector)
+{
+	this->m_Data = aVector.data();
+	this->m_Length = aVector.size();
+	this->m_Stride = 1;
+}
+
+/** Converts a view of T to a view of const T
+* @param aView The view to convert
+*/
+template<typename T>
+template<typename U>
+ArrayView<T>::ArrayView(const ArrayView<U>& aView)
+{
+	this->m_Data = aView.data();
+	this->m_Length = aView.size();
+	this->m_Stride = aView.getStride();
+}
+
+/** Returns a reference to an element (no bounds checking)
+* @param aIndex The index of the element in the view
+*/
+template<typename T>
+T& ArrayView<T>::operator[](const std::size_t aIndex) const
+{
+	return this->m_Data[static_cast<std::ptrdiff_t>(aIndex) * this->m_Stride];
+}
+
+/** Returns a reference to an element
+* @param aIndex The index of the element in the view
+*/
+template<typename T>
+T& ArrayView<T>::at(const std::size_t aIndex) const
+{
+	if (aIndex >= this->m_Length) throw ArrayView::OUT_OF_RANGE;
+
+	return (*this)[aIndex];
+}
+
+/** Returns the number of elements in the view
+*/
+template<typename T>
+std::size_t ArrayView<T>::size() const
+{
+	return this->m_Length;
+}
+
+/** Returns the distance between two elements that are next to each other in the view
+*/
+template<typename T>
+std::ptrdiff_t ArrayView<T>::getStride() const
+{
+	return this->m_Stride;
+}
+
+/** Returns a pointer to the first element of the view
+*/
+template<typename T>
+T* ArrayView<T>::data() const
+{
+	return this->m_Data;
+}
+
+/** Returns true if the elements of the view are next to each other in memory
+*/
+template<typename T>
+bool ArrayView<T>::isContiguous() const
+{
+	return this->m_Stride == 1;
+}
+
+/** Returns an iterator to the first element of the view
+*/
+template<typename T>
+typename ArrayView<T>::Iterator ArrayView<T>::begin() const
+{
+	return Iterator(this->m_Data, this->m_Stride);
+}
+
+/** Returns an iterator to one past the last element of the view
+*/
+template<typename T>
+typename ArrayView<T>::Iterator ArrayView<T>::end() const
+{
+	return Iterator(this->m_Data + static_cast<std::ptrdiff_t>(this->m_Length) * this->m_Stride, this->m_Stride);
+}
+
+/** Returns a view of part of this view
+* @param aStart The index of the first element
+* @param aLength The number of elements
+* @param aStep Take every aStep element
+*/
+template<typename T>
+ArrayView<T> ArrayView<T>::slice(const std::size_t aStart, const std::size_t aLength, const std::size_t aStep) const
+{
+	if (aStep == 0) throw ArrayView::OUT_OF_RANGE;
+	if (aLength > 0 && aStart + (aLength - 1) * aStep >= this->m_Length) throw ArrayView::OUT_OF_RANGE;
+
+	return ArrayView<T>(this->m_Data + static_cast<std::ptrdiff_t>(aStart) * this->m_Stride, aLength, this->m_Stride * static_cast<std::ptrdiff_t>(aStep));
+}
+
+/** Copies values into the viewed elements
+* @param aValues Any container with size() and operator[] (a std::vector or another ArrayView) with the same length as the view
+*/
+template<typename T>
+template<typename Range>
+void ArrayView<T>::assign(const Range& aValues) const
+{
+	if (aValues.size() != this->m_Length) throw ArrayView::DIMENSIONS_DONT_MATCH;
+
+	for (std::size_t lCount = 0; lCount < this->m_Length; lCount++)
+	{
+		(*this)[lCount] = aValues[lCount];
+	}
+}
+
+/** Sets every viewed element to a value
+* @param aValue The value
+*/
+template<typename T>
+void ArrayView<T>::fill(const value_type& aValue) const
+{
+	for (std::size_t lCount = 0; lCount < this->m_Length; lCount++)
+	{
+		(*this)[lCount] = aValue;
+	}
+}
+
+/** Returns the sum of the products of the elements of two views with the same length
+* @param aRight The other view
+*/
+template<typename T>
+typename ArrayView<T>::value_type ArrayView<T>::dot(const ArrayView<const value_type>& aRight) const
+{
+	if (aRight.size() != this->m_Length) throw ArrayView::DIMENSIONS_DONT_MATCH;
+
+	value_type lResult = value_type();
+	for (std::size_t lCount = 0; lCount < this->m_Length; lCount++)
+	{
+		lResult += (*this)[lCount] * aRight[lCount];
+	}
+	return lResult;
+}
+
+/** Copies the viewed elements into a vector
+*/
+template<typename T>
+std::vector<typename ArrayView<T>::value_type> ArrayView<T>::toVector() const
+{
+	return std::vector<value_type>(this->begin(), this->end());
+}
+
+/** Copies the viewed elements into a vector so a view can be passed where a std::vector is expected
+*/
+template<typename T>
+ArrayView<T>::operator std::vector<typename ArrayView<T>::value_type>() const
+{
+	return this->toVector();
+}
+
+/** Default constructor for ArrayBlockView (an empty view)
+*/
+template<typename T>
+ArrayBlockView<T>::ArrayBlockView()
+{
+	this->m_Data = nullptr;
+	this->m_NumberOfRows = 0;
+	this->m_NumberOfColumns = 0;
+	this->m_RowStride = 0;
+	this->m_ColumnStride = 1;
+}
+
+/** Constructor for ArrayBlockView
+* @param aData A pointer to the top left element of the block
+* @param aNumberOfRows The number of rows in the block
+* @param aNumberOfColumns The number of columns in the block
+* @param aRowStride The distance between two elements that are in the same column and next to each other
+* @param aColumnStride The distance between two elements that are in the same row and next to each other
+*/
+template<typename T>
+ArrayBlockView<T>::ArrayBlockView(T* aData, const std::size_t aNumberOfRows, const std::size_t aNumberOfColumns, const std::ptrdiff_t aRowStride, const std::ptrdiff_t aColumnStride)
+{
+	this->m_Data = aData;
+	this->m_NumberOfRows = aNumberOfRows;
+	this->m_NumberOfColumns = aNumberOfColumns;
+	this->m_RowStride = aRowStride;
+	this->m_ColumnStride = aColumnStride;
+}
+
+/** Returns a reference to an element of the block (no bounds checking)
+* @param aRow The row of the element in the block
+* @param aColumn The column of the element in the block
+*/
+template<typename T>
+T& ArrayBlockView<T>::operator()(const std::size_t aRow, const std::size_t aColumn) const
+{
+	return this->m_Data[static_cast<std::ptrdiff_t>(aRow) * this->m_RowStride + static_cast<std::ptrdiff_t>(aColumn) * this->m_ColumnStride];
+}
+
+/** Returns the number of rows in the block
+*/
+template<typename T>
+std::size_t ArrayBlockView<T>::getNumberOfRows() const
+{
+	return this->m_NumberOfRows;
+}
+
+/** Returns the number of columns in the block
+*/
+template<typename T>
+std::size_t ArrayBlockView<T>::getNumberOfColumns() const
+{
+	return this->m_NumberOfColumns;
+}
+
+/** Returns a view of a row of the block
+* @param aRow The row
+*/
+template<typename T>
+ArrayView<T> ArrayBlockView<T>::row(const std::size_t aRow) const
+{
+	if (aRow >= this->m_NumberOfRows) throw ArrayView<T>::OUT_OF_RANGE;
+
+	return ArrayView<T>(this->m_Data + static_cast<std::ptrdiff_t>(aRow) * this->m_RowStride, this->m_NumberOfColumns, this->m_ColumnStride);
+}
+
+/** Returns a view of a column of the block
+* @param aColumn The column
+*/
+template<typename T>
+ArrayView<T> ArrayBlockView<T>::column(const std::size_t aColumn) const
+{
+	if (aColumn >= this->m_NumberOfColumns) throw ArrayView<T>::OUT_OF_RANGE;
+
+	return ArrayView<T>(this->m_Data + static_cast<std::ptrdiff_t>(aColumn) * this->m_ColumnStride, this->m_NumberOfRows, this->m_RowStride);
+}
+
+/** Sets every element of the block to a value
+* @param aValue The value
+*/
+template<typename T>
+void ArrayBlockView<T>::fill(const typename std::remove_const<T>::type& aValue) const
+{
+	for (std::size_t lCount = 0; lCount < this->m_NumberOfRows; lCount++)
+	{
+		this->row(lCount).fill(aValue);
+	}
+}
+
+#endif
@@ -0,0 +1,65 @@
+/**
+*  @file    BFloat16.h
+*  @author  Jordan Nesley
+**/
+
+#ifndef BFLOAT16_H
+#define BFLOAT16_H
+
+#include <cstdint> // std::uint16_t
+#include <cstring> // std::memcpy
+
+#pragma unmanaged
+
+/** A 16 bit floating point number: the top half of a float (the same 8 bit exponent, so the same range, with an 8 bit
+*   significand, about 3 significant digits). Arithmetic converts to float, so arrays of BFloat16 can be used anywhere
+*   a float array can at half the memory and bandwidth.
+*/
+class BFloat16
+{
+private:
+	std::uint16_t m_Bits;
+
+public:
+	BFloat16() : m_Bits(0) {}
+	BFloat16(const float aValue);
+
+	operator float() const;
+	std::uint16_t getBits() const { return this->m_Bits; }
+
+	BFloat16& operator+=(const float aRight) { return *this = BFloat16(static_cast<float>(*this) + aRight); }
+	BFloat16& operator-=(const float aRight) { return *this = BFloat16(static_cast<float>(*this) - aRight); }
+	BFloat16& operator*=(const float aRight) { return *this = BFloat16(static_cast<float>(*this) * aRight); }
+	BFloat16& operator/=(const float aRight) { return *this = BFloat16(static_cast<float>(*this) / aRight); }
+};
+
+/** Constructor for BFloat16 that rounds a float to the nearest BFloat16 (ties to even)
+* @param aValue The value
+*/
+inline BFloat16::BFloat16(const float aValue)
+{
+	std::uint32_t lBits;
+	std::memcpy(&lBits, &aValue, sizeof(lBits));
+
+	if ((lBits & 0x7fffffff) > 0x7f800000)
+	{
+		// NaN: keep it a NaN after the low bits are dropped
+		this->m_Bits = static_cast<std::uint16_t>((lBits >> 16) | 0x0040);
+		return;
+	}
+
+	lBits += 0x7fff + ((lBits >> 16) & 1);
+	this->m_Bits = static_cast<std::uint16_t>(lBits >> 16);
+}
+
+/** Returns the value as a float (exact)
+*/
+inline BFloat16::operator float() const
+{
+	const std::uint32_t lBits = static_cast<std::uint32_t>(this->m_Bits) << 16;
+	float lResult;
+	std::memcpy(&lResult, &lBits, sizeof(lResult));
+	return lResult;
+}
+
+#endif
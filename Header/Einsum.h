@@ -0,0 +1,289 @@
+/**
+*  @file    Einsum.h
+*  @author  Jordan Nesley
+**/
+
+#ifndef EINSUM_H
+#define EINSUM_H
+
+#include "MultidimensionalArray.h"
+#include "ExecutionPolicy.h"
+#include <vector>
+#include <string>
+#include <tuple>
+#include <cstddef> // std::size_t, std::ptrdiff_t
+
+#pragma unmanaged
+
+/** A tensor contraction written in Einstein summation notation, e.g. "ij,jk->ik" for a matrix product, "ti->i" for the
+*   sum over the rows of a matrix or "ti,ij,tj,t->ij" for the expected transitions of the Baum Welch algorithm.
+*
+*   Every operand is named by one letter per dimension. Letters shared by operands are multiplied element-wise, letters
+*   missing from the result (after "->") are summed over. Without "->" the result has every letter used once, in
+*   alphabetical order. A letter repeated in one operand takes its diagonal.
+*
+*   The plan is made once from the shapes of the operands: the loops are ordered so the largest strides are outermost and
+*   the innermost loop walks memory contiguously, and the outermost loop is split into blocks for the ThreadPool. When the
+*   outermost loop is summed over (e.g. time in "ti->i") every block sums into its own copy of the result and the copies
+*   are added in block order, so the result does not depend on the number of threads. The products are calculated in the
+*   type of the result, so operands of different types (e.g. float and double) can be mixed.
+*/
+class EinsumPlan
+{
+private:
+	std::size_t m_NumberOfOperands;
+	std::string m_LoopIndices; // the letter of every loop, outermost first
+	std::vector<std::size_t> m_LoopLengths;
+	std::vector<std::ptrdiff_t> m_Strides; // [loop * (m_NumberOfOperands + 1) + operand], the result is the last operand
+	std::vector<std::size_t> m_ResultDimLengths;
+	std::size_t m_ResultSize;
+	std::size_t m_TotalNumberOfProducts;
+	bool m_IsOuterLoopSummed;
+
+	template<typename R, typename Tuple>
+	void accumulateRange(const Tuple& aOperands, R* const aResult, const std::size_t aBegin, const std::size_t aEnd) const;
+
+public:
+	// at most this many copies of the result are made when the outermost loop is summed over
+	static const std::size_t MAXIMUM_NUMBER_OF_PARTIAL_RESULTS = 64;
+
+	EinsumPlan(const std::string& aSpecification, const std::vector<std::vector<std::size_t>>& aOperandDimLengths);
+
+	std::size_t getNumberOfOperands() const;
+	const std::vector<std::size_t>& getResultDimLengths() const;
+	std::size_t getResultSize() const;
+	const std::string& getLoopOrder() const;
+
+	template<typename R, typename... Ts>
+	void accumulate(R* const aResult, const ExecutionPolicy& aPolicy, const Ts* const... aOperands) const;
+
+	enum Exeception
+	{
+		SPECIFICATION_EXCEPTION,
+		DIMENSIONS_DONT_MATCH,
+		NUMBER_OF_OPERANDS_EXCEPTION,
+	};
+};
+
+/** Multiplies the elements at aPosition along a loop of every operand
+*/
+template<std::size_t Index, std::size_t Count>
+struct EinsumProduct
+{
+	template<typename R, typename Tuple>
+	static R calculate(const Tuple& aOperands, const std::ptrdiff_t* const aStrides, const std::ptrdiff_t aPosition)
+	{
+		return static_cast<R>(std::get<Index>(aOperands)[aPosition * aStrides[Index]]) * EinsumProduct<Index + 1, Count>::template calculate<R>(aOperands, aStrides, aPosition);
+	}
+
+	template<typename Tuple>
+	static void advance(Tuple& aOperands, const std::ptrdiff_t* const aStrides, const std::ptrdiff_t aPosition)
+	{
+		std::get<Index>(aOperands) += aPosition * aStrides[Index];
+		EinsumProduct<Index + 1, Count>::advance(aOperands, aStrides, aPosition);
+	}
+};
+
+template<std::size_t Count>
+struct EinsumProduct<Count, Count>
+{
+	template<typename R, typename Tuple>
+	static R calculate(const Tuple&, const std::ptrdiff_t* const, const std::ptrdiff_t)
+	{
+		return static_cast<R>(1);
+	}
+
+	template<typename Tuple>
+	static void advance(Tuple&, const std::ptrdiff_t* const, const std::ptrdiff_t)
+	{
+	}
+};
+
+/** Adds the contraction of the operands to aResult (which must hold getResultSize() elements in the order of the result
+*   letters, last letter changing fastest). The operands are pointers to their first element, in the order of the
+*   specification, with the last dimension changing fastest.
+* @param aResult The result to add to
+* @param aPolicy The execution policy
+* @param aOperands The operands
+*/
+template<typename R, typename... Ts>
+void EinsumPlan::accumulate(R* const aResult, const ExecutionPolicy& aPolicy, const Ts* const... aOperands) const
+{
+	if (sizeof...(Ts) != this->m_NumberOfOperands) throw EinsumPlan::NUMBER_OF_OPERANDS_EXCEPTION;
+	if (this->m_TotalNumberOfProducts == 0) return;
+
+	const std::tuple<const Ts*...> lOperands(aOperands...);
+	if (this->m_LoopLengths.empty())
+	{
+		this->accumulateRange(lOperands, aResult, 0, 1);
+		return;
+	}
+
+	const std::size_t lOuterLength = this->m_LoopLengths[0];
+	const std::size_t lProductsPerOuterIndex = this->m_TotalNumberOfProducts / lOuterLength;
+	if (!this->m_IsOuterLoopSummed)
+	{
+		// every block writes its own part of the result
+		aPolicy.forItemsOfLength(lProductsPerOuterIndex).forEachBlock(lOuterLength, [this, &lOperands, aResult](const std::size_t, const std::size_t aBegin, const std::size_t aEnd)
+		{
+			this->accumulateRange(lOperands, aResult, aBegin, aEnd);
+		});
+		return;
+	}
+
+	const std::size_t lMinimumGrainSize = (lOuterLength + EinsumPlan::MAXIMUM_NUMBER_OF_PARTIAL_RESULTS - 1) / EinsumPlan::MAXIMUM_NUMBER_OF_PARTIAL_RESULTS;
+	const ExecutionPolicy lPolicy = aPolicy.forItemsOfLength(lProductsPerOuterIndex, lMinimumGrainSize);
+	const std::size_t lNumberOfBlocks = lPolicy.calculateNumberOfBlocks(lOuterLength);
+	if (lNumberOfBlocks <= 1)
+	{
+		this->accumulateRange(lOperands, aResult, 0, lOuterLength);
+		return;
+	}
+
+	const std::size_t lResultSize = this->m_ResultSize;
+	std::vector<R> lPartialResults(lNumberOfBlocks * lResultSize, static_cast<R>(0));
+	lPolicy.forEachBlock(lOuterLength, [this, &lOperands, &lPartialResults, lResultSize](const std::size_t aBlock, const std::size_t aBegin, const std::size_t aEnd)
+	{
+		this->accumulateRange(lOperands, lPartialResults.data() + aBlock * lResultSize, aBegin, aEnd);
+	});
+
+	for (std::size_t lBlock = 0; lBlock < lNumberOfBlocks; lBlock++)
+	{
+		const R* const lPartialResult = lPartialResults.data() + lBlock * lResultSize;
+		for (std::size_t lCount = 0; lCount < lResultSize; lCount++)
+		{
+			aResult[lCount] += lPartialResult[lCount];
+		}
+	}
+}
+
+/** Adds the products of the outermost loop indices aBegin to aEnd to aResult
+* @param aOperands The pointers to the operands
+* @param aResult The result to add to
+* @param aBegin The first index of the outermost loop
+* @param aEnd One past the last index of the outermost loop
+*/
+template<typename R, typename Tuple>
+void EinsumPlan::accumulateRange(const Tuple& aOperands, R* const aResult, const std::size_t aBegin, const std::size_t aEnd) const
+{
+	const std::size_t lNumberOfOperands = this->m_NumberOfOperands;
+	const std::size_t lNumberOfArrays = lNumberOfOperands + 1;
+	const std::size_t lNumberOfLoops = this->m_LoopLengths.size();
+	typedef EinsumProduct<0, std::tuple_size<Tuple>::value> Product;
+
+	if (lNumberOfLoops == 0)
+	{
+		const InlineStorage<std::ptrdiff_t, 16> lNoStrides(lNumberOfArrays, 0);
+		aResult[0] += Product::template calculate<R>(aOperands, lNoStrides.data(), 0);
+		return;
+	}
+
+	// the outermost loop only runs from aBegin to aEnd
+	InlineStorage<std::size_t, 16> lLengthStorage(lNumberOfLoops);
+	std::size_t* const lLengths = lLengthStorage.data();
+	for (std::size_t lLoop = 0; lLoop < lNumberOfLoops; lLoop++)
+	{
+		lLengths[lLoop] = this->m_LoopLengths[lLoop];
+	}
+	lLengths[0] = aEnd - aBegin;
+
+	Tuple lOperands = aOperands;
+	Product::advance(lOperands, this->m_Strides.data(), aBegin);
+	R* lResult = aResult + static_cast<std::ptrdiff_t>(aBegin) * this->m_Strides[lNumberOfOperands];
+
+	// the two innermost loops run without the odometer (a single loop is the innermost loop inside a loop of length 1)
+	const bool lIsSingleLoop = (lNumberOfLoops == 1);
+	const std::size_t lInnerLoop = lNumberOfLoops - 1;
+	const std::size_t lMiddleLoop = lIsSingleLoop ? 0 : lNumberOfLoops - 2;
+	const std::ptrdiff_t* const lInnerStrides = this->m_Strides.data() + lInnerLoop * lNumberOfArrays;
+	const std::ptrdiff_t* const lMiddleStrides = this->m_Strides.data() + lMiddleLoop * lNumberOfArrays;
+	const std::ptrdiff_t lInnerLength = static_cast<std::ptrdiff_t>(lLengths[lInnerLoop]);
+	const std::ptrdiff_t lMiddleLength = lIsSingleLoop ? 1 : static_cast<std::ptrdiff_t>(lLengths[lMiddleLoop]);
+	const std::ptrdiff_t lResultInnerStride = lInnerStrides[lNumberOfOperands];
+	const std::ptrdiff_t lResultMiddleStride = lMiddleStrides[lNumberOfOperands];
+	const std::size_t lNumberOfOuterLoops = lIsSingleLoop ? 0 : lNumberOfLoops - 2;
+
+	InlineStorage<std::size_t, 16> lCounterStorage(lNumberOfLoops, 0);
+	std::size_t* const lCounters = lCounterStorage.data();
+	while (true)
+	{
+		for (std::ptrdiff_t lMiddle = 0; lMiddle < lMiddleLength; lMiddle++)
+		{
+			Tuple lRow = lOperands;
+			Product::advance(lRow, lMiddleStrides, lMiddle);
+			R* const lResultRow = lResult + lMiddle * lResultMiddleStride;
+			if (lResultInnerStride == 0)
+			{
+				R lSum = static_cast<R>(0);
+				for (std::ptrdiff_t lPosition = 0; lPosition < lInnerLength; lPosition++)
+				{
+					lSum += Product::template calculate<R>(lRow, lInnerStrides, lPosition);
+				}
+				lResultRow[0] += lSum;
+			}
+			else
+			{
+				for (std::ptrdiff_t lPosition = 0; lPosition < lInnerLength; lPosition++)
+				{
+					lResultRow[lPosition * lResultInnerStride] += Product::template calculate<R>(lRow, lInnerStrides, lPosition);
+				}
+			}
+		}
+
+		// advance the outer loops like an odometer
+		std::size_t lLoop = lNumberOfOuterLoops;
+		while (true)
+		{
+			if (lLoop == 0) return;
+			lLoop--;
+
+			const std::ptrdiff_t* const lStrides = this->m_Strides.data() + lLoop * lNumberOfArrays;
+			lCounters[lLoop]++;
+			if (lCounters[lLoop] < lLengths[lLoop])
+			{
+				Product::advance(lOperands, lStrides, 1);
+				lResult += lStrides[lNumberOfOperands];
+				break;
+			}
+
+			const std::ptrdiff_t lRewind = -static_cast<std::ptrdiff_t>(lLengths[lLoop] - 1);
+			Product::advance(lOperands, lStrides, lRewind);
+			lResult += lRewind * lStrides[lNumberOfOperands];
+			lCounters[lLoop] = 0;
+		}
+	}
+}
+
+/** Returns the contraction of MultidimensionalArrays written in Einstein summation notation (see EinsumPlan),
+*   e.g. Einsum("ij,jk->ik", lLeft, lRight)
+* @param aPolicy The execution policy
+* @param aSpecification The letters of every dimension of the operands and of the result
+* @param aFirst The first operand (the result has the same element type)
+* @param aRest The other operands
+*/
+template<typename T, typename S, typename... Arrays>
+MultidimensionalArray<T> Einsum(const ExecutionPolicy& aPolicy, const std::string& aSpecification, const MultidimensionalArray<T, S>& aFirst, const Arrays&... aRest)
+{
+	const EinsumPlan lPlan(aSpecification, { aFirst.getNumberOfElementsOfAllDimensions(), aRest.getNumberOfElementsOfAllDimensions()... });
+
+	// a contraction to a single number is returned as an array with one element
+	std::vector<std::size_t> lResultDimLengths = lPlan.getResultDimLengths();
+	if (lResultDimLengths.empty()) lResultDimLengths.push_back(1);
+
+	MultidimensionalArray<T> lResult(static_cast<std::size_t>(lResultDimLengths.size()), lResultDimLengths);
+	lPlan.accumulate(lResult.data(), aPolicy, aFirst.data(), aRest.data()...);
+	return lResult;
+}
+
+/** Returns the contraction of MultidimensionalArrays written in Einstein summation notation (see EinsumPlan)
+* @param aSpecification The letters of every dimension of the operands and of the result
+* @param aFirst The first operand (the result has the same element type)
+* @param aRest The other operands
+*/
+template<typename T, typename S, typename... Arrays>
+MultidimensionalArray<T> Einsum(const std::string& aSpecification, const MultidimensionalArray<T, S>& aFirst, const Arrays&... aRest)
+{
+	return Einsum(ExecutionPolicy(), aSpecification, aFirst, aRest...);
+}
+
+#endif
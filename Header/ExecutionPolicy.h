@@ -0,0 +1,129 @@
+/**
+*  @file    ExecutionPolicy.h
+*  @author  Jordan Nesley
+**/
+
+#ifndef EXECUTIONPOLICY_H
+#define EXECUTIONPOLICY_H
+
+#include "ThreadPool.h"
+#include <cstddef> // std::size_t
+#include <functional> // std::function
+
+#pragma unmanaged
+
+/** How a bulk operation on an array runs (the optional last parameter of fill, transform, reduce, the reductions, etc.).
+*
+*   SEQUENTIAL runs on the calling thread. PARALLEL splits the elements into blocks of getGrainSize() elements that run
+*   on the ThreadPool; the elements of a block are processed in order by one thread. PARALLEL_UNSEQUENCED additionally
+*   allows the elements of a block to be processed out of order or interleaved (vectorized), so the function passed
+*   to transform or reduce must not lock or depend on the order of the elements. The pool runs both the same way today.
+*
+*   The blocks only depend on the number of elements and the grain size, so a parallel reduction gives the same result
+*   however many threads the machine has. Arrays smaller than the grain size always run on the calling thread.
+*/
+class ExecutionPolicy
+{
+public:
+	enum Mode
+	{
+		SEQUENTIAL,
+		PARALLEL,
+		PARALLEL_UNSEQUENCED,
+	};
+
+	// large enough that the cost of handing a block to a thread is small compared to the work (512KB of doubles)
+	static const std::size_t DEFAULT_GRAIN_SIZE = 65536;
+
+	ExecutionPolicy(const Mode aMode = SEQUENTIAL, const std::size_t aGrainSize = DEFAULT_GRAIN_SIZE);
+
+	Mode getMode() const;
+	std::size_t getGrainSize() const;
+	bool isParallel() const;
+	std::size_t calculateNumberOfBlocks(const std::size_t aLength) const;
+	ExecutionPolicy forItemsOfLength(const std::size_t aItemLength, const std::size_t aMinimumGrainSize = 1) const;
+
+	template<typename Function>
+	void forEachBlock(const std::size_t aLength, Function aFunction) const;
+
+private:
+	Mode m_Mode;
+	std::size_t m_GrainSize;
+};
+
+/** Constructor for ExecutionPolicy
+* @param aMode SEQUENTIAL, PARALLEL or PARALLEL_UNSEQUENCED
+* @param aGrainSize The smallest number of elements given to a thread at a time (at least 1)
+*/
+inline ExecutionPolicy::ExecutionPolicy(const Mode aMode, const std::size_t aGrainSize)
+{
+	this->m_Mode = aMode;
+	this->m_GrainSize = (aGrainSize == 0) ? 1 : aGrainSize;
+}
+
+/** Returns the mode
+*/
+inline ExecutionPolicy::Mode ExecutionPolicy::getMode() const
+{
+	return this->m_Mode;
+}
+
+/** Returns the smallest number of elements given to a thread at a time
+*/
+inline std::size_t ExecutionPolicy::getGrainSize() const
+{
+	return this->m_GrainSize;
+}
+
+/** Returns true if the mode is PARALLEL or PARALLEL_UNSEQUENCED
+*/
+inline bool ExecutionPolicy::isParallel() const
+{
+	return this->m_Mode != ExecutionPolicy::SEQUENTIAL;
+}
+
+/** Returns the number of blocks forEachBlock splits aLength elements into
+* @param aLength The number of elements
+*/
+inline std::size_t ExecutionPolicy::calculateNumberOfBlocks(const std::size_t aLength) const
+{
+	if (!this->isParallel() || aLength <= this->m_GrainSize) return (aLength == 0) ? 0 : 1;
+
+	return (aLength + this->m_GrainSize - 1) / this->m_GrainSize;
+}
+
+/** Returns the policy for processing items of aItemLength elements each (e.g. the rows of a matrix), so a block still
+*   holds about getGrainSize() elements
+* @param aItemLength The number of elements of an item
+* @param aMinimumGrainSize The smallest number of items in a block
+*/
+inline ExecutionPolicy ExecutionPolicy::forItemsOfLength(const std::size_t aItemLength, const std::size_t aMinimumGrainSize) const
+{
+	const std::size_t lGrainSize = (aItemLength == 0) ? this->m_GrainSize : this->m_GrainSize / aItemLength;
+	return ExecutionPolicy(this->m_Mode, (lGrainSize < aMinimumGrainSize) ? aMinimumGrainSize : lGrainSize);
+}
+
+/** Calls aFunction(aBlock, aBegin, aEnd) for blocks of elements that together cover 0 to aLength, on the ThreadPool if
+*   the policy is parallel. Returns when every block has finished.
+* @param aLength The number of elements
+* @param aFunction The function to call for each block
+*/
+template<typename Function>
+void ExecutionPolicy::forEachBlock(const std::size_t aLength, Function aFunction) const
+{
+	const std::size_t lNumberOfBlocks = this->calculateNumberOfBlocks(aLength);
+	if (lNumberOfBlocks <= 1)
+	{
+		if (lNumberOfBlocks == 1) aFunction(0, 0, aLength);
+		return;
+	}
+
+	const std::size_t lGrainSize = this->m_GrainSize;
+	ThreadPool::getInstance().parallelFor(lNumberOfBlocks, [&aFunction, lGrainSize, aLength](const std::size_t aBlock)
+	{
+		const std::size_t lBegin = aBlock * lGrainSize;
+		aFunction(aBlock, lBegin, (lBegin + lGrainSize < aLength) ? lBegin + lGrainSize : aLength);
+	});
+}
+
+#endif
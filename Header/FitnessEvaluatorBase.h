@@ -0,0 +1,29 @@
+/**
+*  @file    FitnessEvaluatorBase.h
+*  @author  Jordan Nesley
+**/
+
+#ifndef FITNESSEVALUATORBASE_H
+#define FITNESSEVALUATORBASE_H
+
+#include <vector>
+
+#pragma unmanaged
+
+/** Base class for evaluating the fitness of a whole generation of parents at once.
+*/
+class FitnessEvaluatorBase
+{
+	public:
+		FitnessEvaluatorBase() {}
+		virtual ~FitnessEvaluatorBase() {}
+
+		/** Evaluates the fitness of every parent.
+		* @param aValues The property values of all the parents stored one after another (parent i starts at aValues[i*aNumberOfProperties]).
+		* @param aNumberOfProperties The number of properties of each parent.
+		* @param aFitness Will be returned with the fitness of each parent (resized to the number of parents).
+		*/
+		virtual void Evaluate(const std::vector<double>& aValues, const unsigned aNumberOfProperties, std::vector<double>& aFitness) = 0;
+};
+
+#endif
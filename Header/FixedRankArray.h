@@ -0,0 +1,482 @@
+/**
+*  @file    FixedRankArray.h
+*  @author  Jordan Nesley
+**/
+
+#ifndef FIXEDRANKARRAY_H
+#define FIXEDRANKARRAY_H
+
+#include "MultidimensionalArray.h"
+#include "ArrayExpression.h"
+#include "ArrayStorage.h"
+#include <array>
+#include <algorithm> // std::fill
+#include <cstddef> // std::size_t
+#include <utility> //std::move
+
+#pragma unmanaged
+
+/** A multidimensional array where the number of dimensions is known at compile time.
+*   The strides are calculated once at construction so accessing an element with operator()(i, j, k)
+*   is a multiply-add per dimension with no allocations (unlike MultidimensionalArray::getElement).
+*   Element-wise arithmetic is lazy like MultidimensionalArray (see ArrayExpression.h) and the two can be mixed in one expression.
+*   The elements are kept in a Storage like MultidimensionalArray (see ArrayStorage.h and ChunkedStorage.h).
+*/
+template<typename T, std::size_t Rank, typename Storage = VectorStorage<T>>
+class FixedRankArray : public ArrayExpression<FixedRankArray<T, Rank, Storage>>
+{
+	static_assert(Rank > 0, "FixedRankArray must have at least one dimension");
+
+private:
+	Storage m_Elements;
+	std::array<std::size_t, Rank> m_DimLengths;
+	std::array<std::size_t, Rank> m_Strides;
+	std::size_t m_TotalNumberOfElements;
+
+	void calculateStrides();
+
+	template<typename... I>
+	std::size_t calculateElementPosition(const I... aIndices) const;
+
+public:
+	typedef T value_type;
+
+	FixedRankArray();
+	FixedRankArray(const std::array<std::size_t, Rank>& aNumberOfElementsOfAllDimensions);
+	FixedRankArray(const std::array<std::size_t, Rank>& aNumberOfElementsOfAllDimensions, const T& aValue);
+	explicit FixedRankArray(const MultidimensionalArray<T>& aArray);
+	template<typename E>
+	FixedRankArray(const ArrayExpression<E>& aExpression);
+
+	FixedRankArray(const FixedRankArray<T, Rank, Storage>& aCopy) = default;
+	FixedRankArray(FixedRankArray<T, Rank, Storage>&& aMove);
+	~FixedRankArray() = default;
+
+	template<typename... I>
+	T& operator()(const I... aIndices);
+	template<typename... I>
+	const T& operator()(const I... aIndices) const;
+
+	template<typename... I>
+	T& at(const I... aIndices);
+	template<typename... I>
+	const T& at(const I... aIndices) const;
+
+	template<typename... I>
+	ArrayView<T> rowView(const I... aIndices);
+	template<typename... I>
+	ArrayView<const T> rowView(const I... aIndices) const;
+
+	static constexpr std::size_t getNumberOfDimensions() { return Rank; }
+	std::size_t getTotalNumberOfElements() const;
+	std::size_t getNumberOfElementsOfDimension(const std::size_t aDimension) const;
+	std::size_t getStride(const std::size_t aDimension) const;
+
+	T* data();
+	const T* data() const;
+	T evaluate(const std::size_t aPosition) const;
+
+	void fill(const T& aValue);
+	MultidimensionalArray<T> toMultidimensionalArray() const;
+
+	FixedRankArray<T, Rank, Storage>& operator=(const FixedRankArray<T, Rank, Storage>& aRight) = default;
+	FixedRankArray<T, Rank, Storage>& operator=(FixedRankArray<T, Rank, Storage>&& aRight);
+	template<typename E>
+	FixedRankArray<T, Rank, Storage>& operator=(const ArrayExpression<E>& aRight);
+	template<typename E>
+	FixedRankArray<T, Rank, Storage>& operator+=(const ArrayExpression<E>& aRight);
+	template<typename E>
+	FixedRankArray<T, Rank, Storage>& operator-=(const ArrayExpression<E>& aRight);
+	template<typename E>
+	FixedRankArray<T, Rank, Storage>& operator*=(const ArrayExpression<E>& aRight);
+	template<typename E>
+	FixedRankArray<T, Rank, Storage>& operator/=(const ArrayExpression<E>& aRight);
+	FixedRankArray<T, Rank, Storage>& operator*=(const T aRight);
+	FixedRankArray<T, Rank, Storage>& operator/=(const T aRight);
+
+	enum Exeception
+	{
+		CONSTRUCTOR_EXCEPTION,
+		DIMENSIONS_DONT_MATCH,
+	};
+};
+
+/** Default constructor for FixedRankArray
+*/
+template<typename T, std::size_t Rank, typename Storage>
+FixedRankArray<T, Rank, Storage>::FixedRankArray()
+{
+	this->m_Elements.clear();
+	this->m_DimLengths.fill(0);
+	this->m_Strides.fill(0);
+	this->m_TotalNumberOfElements = 0;
+}
+
+/** Constructor for FixedRankArray
+* @param aNumberOfElementsOfAllDimensions The lengths of each dimension
+*/
+template<typename T, std::size_t Rank, typename Storage>
+FixedRankArray<T, Rank, Storage>::FixedRankArray(const std::array<std::size_t, Rank>& aNumberOfElementsOfAllDimensions)
+{
+	this->m_DimLengths = aNumberOfElementsOfAllDimensions;
+	this->calculateStrides();
+	this->m_Elements.assign(this->m_TotalNumberOfElements, T());
+}
+
+/** Constructor for FixedRankArray
+* @param aNumberOfElementsOfAllDimensions The lengths of each dimension
+* @param aValue The value of every element
+*/
+template<typename T, std::size_t Rank, typename Storage>
+FixedRankArray<T, Rank, Storage>::FixedRankArray(const std::array<std::size_t, Rank>& aNumberOfElementsOfAllDimensions, const T& aValue)
+{
+	this->m_DimLengths = aNumberOfElementsOfAllDimensions;
+	this->calculateStrides();
+	this->m_Elements.assign(this->m_TotalNumberOfElements, aValue);
+}
+
+/** Constructor for FixedRankArray that copies a MultidimensionalArray with the same number of dimensions
+* @param aArray The array to copy
+*/
+template<typename T, std::size_t Rank, typename Storage>
+FixedRankArray<T, Rank, Storage>::FixedRankArray(const MultidimensionalArray<T>& aArray)
+{
+	if (aArray.getNumberOfElementsOfAllDimensions().size() != Rank) throw FixedRankArray::CONSTRUCTOR_EXCEPTION;
+
+	for (std::size_t lCount = 0; lCount < Rank; lCount++)
+	{
+		this->m_DimLengths[lCount] = aArray.getNumberOfElementsOfDimension(lCount);
+	}
+	this->calculateStrides();
+	this->m_Elements.assign(aArray.data(), aArray.data() + this->m_TotalNumberOfElements);
+}
+
+/** Constructor for FixedRankArray that calculates every element of an expression
+* @param aExpression The expression (must have Rank dimensions)
+*/
+template<typename T, std::size_t Rank, typename Storage>
+template<typename E>
+FixedRankArray<T, Rank, Storage>::FixedRankArray(const ArrayExpression<E>& aExpression)
+{
+	const E& lExpression = aExpression.derived();
+	if (lExpression.getNumberOfDimensions() != Rank) throw FixedRankArray::CONSTRUCTOR_EXCEPTION;
+
+	for (std::size_t lCount = 0; lCount < Rank; lCount++)
+	{
+		this->m_DimLengths[lCount] = lExpression.getNumberOfElementsOfDimension(lCount);
+	}
+	this->calculateStrides();
+	this->m_Elements.assign(this->m_TotalNumberOfElements, T());
+	evaluateExpression<ExpressionAssign>(this->m_Elements.data(), lExpression);
+}
+
+/** Move Constructor for FixedRankArray
+* @param aMove The object to move
+*/
+template<typename T, std::size_t Rank, typename Storage>
+FixedRankArray<T, Rank, Storage>::FixedRankArray(FixedRankArray<T, Rank, Storage>&& aMove)
+{
+	this->m_Elements = std::move(aMove.m_Elements);
+	this->m_DimLengths = aMove.m_DimLengths;
+	this->m_Strides = aMove.m_Strides;
+	this->m_TotalNumberOfElements = aMove.m_TotalNumberOfElements;
+
+	aMove.m_Elements.clear();
+	aMove.m_DimLengths.fill(0);
+	aMove.m_Strides.fill(0);
+	aMove.m_TotalNumberOfElements = 0;
+}
+
+/** Returns a reference to the element at the indices (no bounds checking)
+* @param aIndices One index for each dimension
+* @return The element
+*/
+template<typename T, std::size_t Rank, typename Storage>
+template<typename... I>
+T& FixedRankArray<T, Rank, Storage>::operator()(const I... aIndices)
+{
+	return this->m_Elements[this->calculateElementPosition(aIndices...)];
+}
+
+/** Returns a reference to the element at the indices (no bounds checking)
+* @param aIndices One index for each dimension
+* @return The element
+*/
+template<typename T, std::size_t Rank, typename Storage>
+template<typename... I>
+const T& FixedRankArray<T, Rank, Storage>::operator()(const I... aIndices) const
+{
+	return this->m_Elements[this->calculateElementPosition(aIndices...)];
+}
+
+/** Returns a reference to the element at the indices
+* @param aIndices One index for each dimension
+* @return The element
+*/
+template<typename T, std::size_t Rank, typename Storage>
+template<typename... I>
+T& FixedRankArray<T, Rank, Storage>::at(const I... aIndices)
+{
+	const std::size_t lIndices[] = { static_cast<std::size_t>(aIndices)... };
+	for (std::size_t lCount = 0; lCount < Rank; lCount++)
+	{
+		if (lIndices[lCount] >= this->m_DimLengths[lCount]) throw FixedRankArray::DIMENSIONS_DONT_MATCH;
+	}
+	return (*this)(aIndices...);
+}
+
+/** Returns a reference to the element at the indices
+* @param aIndices One index for each dimension
+* @return The element
+*/
+template<typename T, std::size_t Rank, typename Storage>
+template<typename... I>
+const T& FixedRankArray<T, Rank, Storage>::at(const I... aIndices) const
+{
+	const std::size_t lIndices[] = { static_cast<std::size_t>(aIndices)... };
+	for (std::size_t lCount = 0; lCount < Rank; lCount++)
+	{
+		if (lIndices[lCount] >= this->m_DimLengths[lCount]) throw FixedRankArray::DIMENSIONS_DONT_MATCH;
+	}
+	return (*this)(aIndices...);
+}
+
+/** Returns a view of a row (the elements along the last dimension), e.g. rowView(t) of a matrix is row t. Like
+*   operator() it does not check the indices or allocate.
+* @param aIndices One index for each dimension except the last
+*/
+template<typename T, std::size_t Rank, typename Storage>
+template<typename... I>
+ArrayView<T> FixedRankArray<T, Rank, Storage>::rowView(const I... aIndices)
+{
+	static_assert(sizeof...(I) + 1 == Rank, "The number of indices must be one less than the number of dimensions");
+	return ArrayView<T>(this->data() + this->calculateElementPosition(aIndices..., std::size_t(0)), this->m_DimLengths[Rank - 1]);
+}
+
+/** Returns a read only view of a row (the elements along the last dimension). Like operator() it does not check the
+*   indices or allocate.
+* @param aIndices One index for each dimension except the last
+*/
+template<typename T, std::size_t Rank, typename Storage>
+template<typename... I>
+ArrayView<const T> FixedRankArray<T, Rank, Storage>::rowView(const I... aIndices) const
+{
+	static_assert(sizeof...(I) + 1 == Rank, "The number of indices must be one less than the number of dimensions");
+	return ArrayView<const T>(this->data() + this->calculateElementPosition(aIndices..., std::size_t(0)), this->m_DimLengths[Rank - 1]);
+}
+
+/** Returns the total number of elements of the array
+* @return The total number of elements
+*/
+template<typename T, std::size_t Rank, typename Storage>
+std::size_t FixedRankArray<T, Rank, Storage>::getTotalNumberOfElements() const
+{
+	return this->m_TotalNumberOfElements;
+}
+
+/** Returns the length of a dimension
+* @param aDimension The dimension
+* @return The number of elements in the dimension
+*/
+template<typename T, std::size_t Rank, typename Storage>
+std::size_t FixedRankArray<T, Rank, Storage>::getNumberOfElementsOfDimension(const std::size_t aDimension) const
+{
+	if (aDimension >= Rank) throw FixedRankArray::DIMENSIONS_DONT_MATCH;
+
+	return this->m_DimLengths[aDimension];
+}
+
+/** Returns the distance between two elements that are next to each other in a dimension
+* @param aDimension The dimension
+* @return The stride of the dimension
+*/
+template<typename T, std::size_t Rank, typename Storage>
+std::size_t FixedRankArray<T, Rank, Storage>::getStride(const std::size_t aDimension) const
+{
+	if (aDimension >= Rank) throw FixedRankArray::DIMENSIONS_DONT_MATCH;
+
+	return this->m_Strides[aDimension];
+}
+
+/** Returns a pointer to the first element (elements are stored with the last dimension changing fastest)
+*/
+template<typename T, std::size_t Rank, typename Storage>
+T* FixedRankArray<T, Rank, Storage>::data()
+{
+	return this->m_Elements.data();
+}
+
+/** Returns a pointer to the first element (elements are stored with the last dimension changing fastest)
+*/
+template<typename T, std::size_t Rank, typename Storage>
+const T* FixedRankArray<T, Rank, Storage>::data() const
+{
+	return this->m_Elements.data();
+}
+
+/** Returns the element at a position in memory (used when the array is part of an expression)
+* @param aPosition The position of the element
+*/
+template<typename T, std::size_t Rank, typename Storage>
+T FixedRankArray<T, Rank, Storage>::evaluate(const std::size_t aPosition) const
+{
+	return this->m_Elements[aPosition];
+}
+
+/** Sets every element to a value
+* @param aValue The value
+*/
+template<typename T, std::size_t Rank, typename Storage>
+void FixedRankArray<T, Rank, Storage>::fill(const T& aValue)
+{
+	std::fill(this->m_Elements.data(), this->m_Elements.data() + this->m_Elements.size(), aValue);
+}
+
+/** Copies the array into a MultidimensionalArray
+* @return The MultidimensionalArray
+*/
+template<typename T, std::size_t Rank, typename Storage>
+MultidimensionalArray<T> FixedRankArray<T, Rank, Storage>::toMultidimensionalArray() const
+{
+	std::vector<std::size_t> lDimLengths(this->m_DimLengths.begin(), this->m_DimLengths.end());
+	MultidimensionalArray<T> lResult(Rank, lDimLengths);
+	std::copy(this->m_Elements.data(), this->m_Elements.data() + this->m_Elements.size(), lResult.data());
+	return lResult;
+}
+
+/** Move assignment operator
+* @param aRight The right side of the = operator
+*/
+template<typename T, std::size_t Rank, typename Storage>
+FixedRankArray<T, Rank, Storage>& FixedRankArray<T, Rank, Storage>::operator=(FixedRankArray<T, Rank, Storage>&& aRight)
+{
+	this->m_Elements = std::move(aRight.m_Elements);
+	this->m_DimLengths = aRight.m_DimLengths;
+	this->m_Strides = aRight.m_Strides;
+	this->m_TotalNumberOfElements = aRight.m_TotalNumberOfElements;
+
+	aRight.m_Elements.clear();
+	aRight.m_DimLengths.fill(0);
+	aRight.m_Strides.fill(0);
+	aRight.m_TotalNumberOfElements = 0;
+	return *this;
+}
+
+/** Assignment operator that calculates every element of an expression in a single loop
+* @param aRight The right side of the = operator (must have the same dimensions as the array)
+*/
+template<typename T, std::size_t Rank, typename Storage>
+template<typename E>
+FixedRankArray<T, Rank, Storage>& FixedRankArray<T, Rank, Storage>::operator=(const ArrayExpression<E>& aRight)
+{
+	if (!expressionShapesMatch(*this, aRight.derived())) throw FixedRankArray::DIMENSIONS_DONT_MATCH;
+
+	evaluateExpression<ExpressionAssign>(this->m_Elements.data(), aRight);
+	return *this;
+}
+
+/** Adds an expression to the array element-wise
+* @param aRight The right side of the += operator
+*/
+template<typename T, std::size_t Rank, typename Storage>
+template<typename E>
+FixedRankArray<T, Rank, Storage>& FixedRankArray<T, Rank, Storage>::operator+=(const ArrayExpression<E>& aRight)
+{
+	if (!expressionShapesMatch(*this, aRight.derived())) throw FixedRankArray::DIMENSIONS_DONT_MATCH;
+
+	evaluateExpression<ExpressionAdd>(this->m_Elements.data(), aRight);
+	return *this;
+}
+
+/** Subtracts an expression from the array element-wise
+* @param aRight The right side of the -= operator
+*/
+template<typename T, std::size_t Rank, typename Storage>
+template<typename E>
+FixedRankArray<T, Rank, Storage>& FixedRankArray<T, Rank, Storage>::operator-=(const ArrayExpression<E>& aRight)
+{
+	if (!expressionShapesMatch(*this, aRight.derived())) throw FixedRankArray::DIMENSIONS_DONT_MATCH;
+
+	evaluateExpression<ExpressionSubtract>(this->m_Elements.data(), aRight);
+	return *this;
+}
+
+/** Multiplies the array by an expression element-wise
+* @param aRight The right side of the *= operator
+*/
+template<typename T, std::size_t Rank, typename Storage>
+template<typename E>
+FixedRankArray<T, Rank, Storage>& FixedRankArray<T, Rank, Storage>::operator*=(const ArrayExpression<E>& aRight)
+{
+	if (!expressionShapesMatch(*this, aRight.derived())) throw FixedRankArray::DIMENSIONS_DONT_MATCH;
+
+	evaluateExpression<ExpressionMultiply>(this->m_Elements.data(), aRight);
+	return *this;
+}
+
+/** Divides the array by an expression element-wise
+* @param aRight The right side of the /= operator
+*/
+template<typename T, std::size_t Rank, typename Storage>
+template<typename E>
+FixedRankArray<T, Rank, Storage>& FixedRankArray<T, Rank, Storage>::operator/=(const ArrayExpression<E>& aRight)
+{
+	if (!expressionShapesMatch(*this, aRight.derived())) throw FixedRankArray::DIMENSIONS_DONT_MATCH;
+
+	evaluateExpression<ExpressionDivide>(this->m_Elements.data(), aRight);
+	return *this;
+}
+
+/** Multiplies every element by a scalar
+* @param aRight The right side of the *= operator
+*/
+template<typename T, std::size_t Rank, typename Storage>
+FixedRankArray<T, Rank, Storage>& FixedRankArray<T, Rank, Storage>::operator*=(const T aRight)
+{
+	evaluateScalar<ExpressionMultiply>(this->m_Elements.data(), this->m_Elements.size(), aRight);
+	return *this;
+}
+
+/** Divides every element by a scalar
+* @param aRight The right side of the /= operator
+*/
+template<typename T, std::size_t Rank, typename Storage>
+FixedRankArray<T, Rank, Storage>& FixedRankArray<T, Rank, Storage>::operator/=(const T aRight)
+{
+	evaluateScalar<ExpressionDivide>(this->m_Elements.data(), this->m_Elements.size(), aRight);
+	return *this;
+}
+
+/** Calculates the strides of each dimension and the total number of elements from the dimension lengths
+*/
+template<typename T, std::size_t Rank, typename Storage>
+void FixedRankArray<T, Rank, Storage>::calculateStrides()
+{
+	std::size_t lSkip = 1;
+	for (std::size_t lCount = Rank; lCount > 0; lCount--)
+	{
+		this->m_Strides[lCount - 1] = lSkip;
+		lSkip = lSkip * this->m_DimLengths[lCount - 1];
+	}
+	this->m_TotalNumberOfElements = lSkip;
+}
+
+/** Calculates the position in m_Elements of the element at the indices
+* @param aIndices One index for each dimension
+*/
+template<typename T, std::size_t Rank, typename Storage>
+template<typename... I>
+std::size_t FixedRankArray<T, Rank, Storage>::calculateElementPosition(const I... aIndices) const
+{
+	static_assert(sizeof...(I) == Rank, "The number of indices must equal the number of dimensions");
+
+	const std::size_t lIndices[] = { static_cast<std::size_t>(aIndices)... };
+	std::size_t lElementPosition = 0;
+	for (std::size_t lCount = 0; lCount < Rank; lCount++)
+	{
+		lElementPosition += lIndices[lCount] * this->m_Strides[lCount];
+	}
+	return lElementPosition;
+}
+
+#endif
@@ -9,14 +9,22 @@
 #include "ParentPropertyBase.h"
 #include "GeneticAlgorithmParameters.h"
 #include "Parent.h"
+#include "FitnessEvaluatorBase.h"
 #include "Utilities.h"
+#include "KDTree.h"
+#include "RealCrossover.h"
 #include <vector>
 #include <tuple>
+#include <algorithm> // std::sort, std::stable_sort
 #include <math.h>
 #include <cfloat>
 
 #pragma unmanaged
 
+#ifndef _WIN32
+#define __stdcall
+#endif
+
 typedef double(__stdcall *UNMANAGED_FITNESS_FUNCTION)(std::vector<std::unique_ptr<ParentPropertyBase>>&& aParentProperties);
 
 class GeneticAlgorithm
@@ -30,15 +38,27 @@ private:
 	//The function to test
 	UNMANAGED_FITNESS_FUNCTION m_Function;
 
+	//The evaluator for the whole generation (used instead of m_Function when set)
+	std::shared_ptr<FitnessEvaluatorBase> m_Evaluator;
+
+	//The total number of fitness evaluations
+	unsigned long m_NumberOfEvaluations;
+
+	void evaluateParents();
+	void sampleFitness(const std::vector<unsigned>& aParentIndices, std::vector<double>& aFitness);
+
 	void static rankParents(std::vector<Parent>& aParentArray);
-	std::vector<Parent> static breed(const std::vector<Parent>& aParentArray, unsigned aSeed);
+	void static applyNiching(std::vector<Parent>& aParentArray, const GeneticAlgorithmParameters& aGAParameters);
+	std::vector<Parent> static breed(const std::vector<Parent>& aParentArray, const GeneticAlgorithmParameters& aGAParameters, unsigned aSeed);
 
 	public:
 		GeneticAlgorithm(const unsigned int aSeed, const GeneticAlgorithmParameters aGAParameters, UNMANAGED_FITNESS_FUNCTION aFitnessFunction);
+		GeneticAlgorithm(const unsigned int aSeed, const GeneticAlgorithmParameters aGAParameters, std::shared_ptr<FitnessEvaluatorBase> aEvaluator);
 
 		void Start();
 
 		Parent GetBestParent();
+		unsigned long GetNumberOfEvaluations() const;
 };
 
 #endif
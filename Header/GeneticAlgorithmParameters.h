@@ -9,6 +9,15 @@
 #include "ParentPropertyBase.h"
 #pragma unmanaged
 
+/** The methods available for preserving diversity (niching) in the population.
+*/
+enum NichingType { NoNiching, FitnessSharing, Clearing };
+
+/** The methods available for crossing over parents. PropertyCrossover lets each property cross itself over,
+*   the others are real coded operators that cross over the whole generation at once.
+*/
+enum CrossoverType { PropertyCrossover, ArithmeticCrossover, BLXCrossover, SBXCrossover, UniformCrossover };
+
 class GeneticAlgorithmParameters
 {
 	private:
@@ -16,6 +25,15 @@ class GeneticAlgorithmParameters
 		unsigned int m_NumberOfParents;
 		double m_RandomParentRatio;
 		std::vector<std::shared_ptr<ParentPropertyBase>> m_ParentTemplate;
+		NichingType m_NichingType;
+		double m_NicheRadius;
+		unsigned int m_NicheCapacity;
+		unsigned int m_InitialSamples;
+		unsigned int m_MaxSamples;
+		double m_ConfidenceBound;
+		double m_RacingRatio;
+		CrossoverType m_CrossoverType;
+		double m_CrossoverParameter;
 
 	public:
 		GeneticAlgorithmParameters();
@@ -29,6 +47,20 @@ class GeneticAlgorithmParameters
 		unsigned int getNumberOfParents() const;
 		double getRandomParentRatio() const;
 		std::vector<std::shared_ptr<ParentPropertyBase>> getParentTemplate();
+		NichingType getNichingType() const;
+		double getNicheRadius() const;
+		unsigned int getNicheCapacity() const;
+		unsigned int getInitialSamples() const;
+		unsigned int getMaxSamples() const;
+		double getConfidenceBound() const;
+		double getRacingRatio() const;
+		bool isNoisyFitness() const;
+		CrossoverType getCrossoverType() const;
+		double getCrossoverParameter() const;
+
+		void setNiching(const NichingType aNichingType, const double aNicheRadius, const unsigned int aNicheCapacity = 1);
+		void setCrossover(const CrossoverType aCrossoverType, const double aCrossoverParameter);
+		void setNoisyFitness(const unsigned int aInitialSamples, const unsigned int aMaxSamples, const double aConfidenceBound = 1.96, const double aRacingRatio = 0.25);
 
 		GeneticAlgorithmParameters& operator=(const GeneticAlgorithmParameters& aRight);
 
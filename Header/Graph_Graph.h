@@ -9,6 +9,7 @@
 #include "Graph_GraphNode.h"
 #include "Graph_AdjacentNode.h"
 #include "MyList.h"
+#include "UnrolledList.h"
 #include <vector>
 
 #pragma unmanaged
@@ -27,7 +28,13 @@
 	{
 	private:
 		std::vector<GraphNode<T1>> m_NodeList;
-		std::vector<MyList<AdjacentNode<T2>>> m_AdjacentNodeList;
+		// the edges of a node (a Voronoi node has 3), so a node of the list fills one cache line
+		typedef UnrolledList<AdjacentNode<T2>, 4> AdjacentNodeList;
+
+		std::vector<AdjacentNodeList> m_AdjacentNodeList;
+		NodePoolAllocator<UnrolledListNode<AdjacentNode<T2>, 4>> m_AdjacentNodeAllocator; // one pool for the edges of every node
+
+		void copyEdges(const Graph<T1, T2>& aOther);
 
 	public:
 		Graph();
@@ -53,7 +60,7 @@ Graph<T1,T2>::Graph()
 {
 	// initialize the nodes list and edges
 	this->m_NodeList = std::vector<GraphNode<T1>>();
-	this->m_AdjacentNodeList = std::vector<MyList<AdjacentNode<T2>>>();
+	this->m_AdjacentNodeList = std::vector<AdjacentNodeList>();
 }
 
 /** Constructor for Graph
@@ -68,18 +75,39 @@ Graph<T1,T2>::Graph(const std::vector<GraphNode<T1>> aNodes)
 		this->m_NodeList[lCount] = GraphNode<T1>(lCount, aNodes[lCount].getData());
 	}
 
-	// initialize the edges
-	this->m_AdjacentNodeList = std::vector<MyList<AdjacentNode<T2>>>(aNodes.size());
+	// initialize the edges (one list at a time: copies of a list would get pools of their own)
+	this->m_AdjacentNodeList.reserve(aNodes.size());
+	for (unsigned lCount = 0; lCount < aNodes.size(); lCount++)
+	{
+		this->m_AdjacentNodeList.push_back(AdjacentNodeList(this->m_AdjacentNodeAllocator));
+	}
 }
 
-/** Copy constructor for Graph
+/** Copy constructor for Graph (the copy has a pool of its own for its edges)
 * @param aCopy The object to copy
 */
 template<typename T1, typename T2>
 Graph<T1, T2>::Graph(const Graph<T1, T2>& aCopy)
 {
 	this->m_NodeList = aCopy.m_NodeList;
-	this->m_AdjacentNodeList = aCopy.m_AdjacentNodeList;
+	this->copyEdges(aCopy);
+}
+
+/** Replaces the edges with copies of the edges of another graph, in lists built with the allocator of this graph
+* @param aOther The graph to copy the edges of
+*/
+template<typename T1, typename T2>
+void Graph<T1, T2>::copyEdges(const Graph<T1, T2>& aOther)
+{
+	std::vector<AdjacentNodeList> lAdjacentNodeList;
+	lAdjacentNodeList.reserve(aOther.m_AdjacentNodeList.size());
+	for (std::size_t lCount = 0; lCount < aOther.m_AdjacentNodeList.size(); lCount++)
+	{
+		lAdjacentNodeList.push_back(AdjacentNodeList(this->m_AdjacentNodeAllocator));
+		lAdjacentNodeList.back() = aOther.m_AdjacentNodeList[lCount];
+	}
+
+	this->m_AdjacentNodeList.swap(lAdjacentNodeList);
 }
 
 /** Returns the node of the specified index
@@ -113,7 +141,7 @@ EdgeData<T2> Graph<T1, T2>::getEdgeData(const unsigned aStartNode, const unsigne
 	if (aStartNode >= this->m_NodeList.size()) throw 1;
 	if (aEndNode >= this->m_NodeList.size()) throw 1;
 
-	MyListIterator<AdjacentNode<T2>> lCurrent = this->m_AdjacentNodeList[aStartNode].begin();
+	typename AdjacentNodeList::Iterator lCurrent = this->m_AdjacentNodeList[aStartNode].begin();
 	EdgeData<T2> lResult = EdgeData<T2>();
 	while (lCurrent != this->m_AdjacentNodeList[aStartNode].end())
 	{
@@ -137,8 +165,9 @@ EdgeData<T2> Graph<T1, T2>::getEdgeData(const unsigned aStartNode, const unsigne
 template<typename T1, typename T2>
 MyList<EdgeData<T2>> Graph<T1,T2>::getAllEdges(const unsigned aNodeIndex) const
 {
-	MyListIterator<AdjacentNode<T2>> lCurrent = this->m_AdjacentNodeList[aNodeIndex].begin();
+	typename AdjacentNodeList::Iterator lCurrent = this->m_AdjacentNodeList[aNodeIndex].begin();
 	MyList<EdgeData<T2>> lResult;
+	lResult.reserve(this->m_AdjacentNodeList[aNodeIndex].size());
 
 	while (lCurrent != this->m_AdjacentNodeList[aNodeIndex].end())
 	{
@@ -166,7 +195,7 @@ unsigned Graph<T1,T2>::addNode(const GraphNode<T1> aNode)
 	lTemp.setIndex(this->m_NodeList.size());
 	this->m_NodeList.push_back(lTemp);
 
-	this->m_AdjacentNodeList.push_back(MyList<AdjacentNode<T2>>());
+	this->m_AdjacentNodeList.push_back(AdjacentNodeList(this->m_AdjacentNodeAllocator));
 
 	return this->m_NodeList[this->m_NodeList.size() - 1].getIndex();
 }
@@ -200,7 +229,7 @@ bool Graph<T1,T2>::isConnected(const unsigned aStartNode, const unsigned aEndNod
 	if (aStartNode >= this->m_NodeList.size()) throw 1;
 	if (aEndNode >= this->m_NodeList.size()) throw 1;
 
-	MyListIterator<AdjacentNode<T2>> lCurrent = this->m_AdjacentNodeList[aStartNode].begin();
+	typename AdjacentNodeList::Iterator lCurrent = this->m_AdjacentNodeList[aStartNode].begin();
 	while (lCurrent != this->m_AdjacentNodeList[aStartNode].end())
 	{
 		if ((*lCurrent).getEndingNodeIndex() == aEndNode) return true;
@@ -216,8 +245,10 @@ bool Graph<T1,T2>::isConnected(const unsigned aStartNode, const unsigned aEndNod
 template<typename T1, typename T2>
 Graph<T1, T2>& Graph<T1, T2>::operator=(const Graph<T1, T2>& aRight)
 {
+	if (this == &aRight) return *(this);
+
 	this->m_NodeList = aRight.m_NodeList;
-	this->m_AdjacentNodeList = aRight.m_AdjacentNodeList;
+	this->copyEdges(aRight);
 	return *(this);
 }
 
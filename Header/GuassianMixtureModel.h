@@ -7,6 +7,7 @@
 #define GUASSIANMIXTUREMODEL_H
 
 #include "MultidimensionalArray.h"
+#include "SparseMatrix.h"
 #include <vector>
 #include "DebugLogger.h"
 #include <algorithm>    // std::copy
@@ -16,7 +17,7 @@
 #pragma unmanaged
 
 /** A class that will take a continuous set of data and will turn it into a set of discrete states.
-*   The class uses hard clustering.
+*   The class uses hard clustering, so every row of the states has a single 1.0 and they are stored as a SparseMatrix.
 */
 class GuassianMixtureModel
 {
@@ -32,22 +33,23 @@ private:
 	std::vector<double> m_InputData;
 	std::vector<double> m_ScaledData;
 
-	MultidimensionalArray<double> m_States;
+	SparseMatrix<double> m_States;
 
 	const static double ZERO;
 
-	static std::vector<double> scaleData(const std::vector<double> aData, double* aMax, double* aMin);
-	static void calculateMaxAndMin(const std::vector<double> aData, double* aMax, double* aMin);
+	static std::vector<double> scaleData(const std::vector<double>& aData, double* aMax, double* aMin);
+	static void calculateMaxAndMin(const std::vector<double>& aData, double* aMax, double* aMin);
 	static double calculateIncrement(const double& aMax, const double& aMin, const int& aGMMStates);
 	static double calculateTau(const double& aIncrement);
-	static MultidimensionalArray<double> calculateDiscreteStates(const std::vector<double> aData, const double& aMin, const unsigned& aGMMStates, const double& aIncrement, const double& aTau);
-	static std::vector<double> inverseGuassianMixtureModel(const MultidimensionalArray<double>& aDiscreteStates, const double& aMax, const double& aMin, const unsigned& aGMMStates);
+	static SparseMatrix<double> calculateDiscreteStates(const std::vector<double>& aData, const double& aMin, const unsigned& aGMMStates, const double& aIncrement, const double& aTau);
+	static std::vector<double> inverseGuassianMixtureModel(const SparseMatrix<double>& aDiscreteStates, const double& aMax, const double& aMin, const unsigned& aGMMStates);
 
 public:
 	GuassianMixtureModel();
-	GuassianMixtureModel(const unsigned& aGMMStates, const std::vector<double> aData);
+	GuassianMixtureModel(const unsigned& aGMMStates, const std::vector<double>& aData);
 	std::vector<double> inverseGuassianMixtureModel() const;
 	MultidimensionalArray<double> getStates() const;
+	const SparseMatrix<double>& getSparseStates() const;
 };
 
 #endif
\ No newline at end of file
@@ -8,6 +8,7 @@
 #include "MultidimensionalArray.h"
 #include "DebugLogger.h"
 #include <vector>
+#include <utility> //std::move
 
 #pragma unmanaged
 
@@ -20,19 +21,31 @@ private:
 	MultidimensionalArray<double>  m_EmissionMatrix;
 	std::vector<double> m_InitialDistribution;
 
+	static void validateDimensions(const std::vector<double>& aInitialDistribution, const MultidimensionalArray<double>& aTransitionMatrix, const MultidimensionalArray<double>& aEmissionMatrix);
+
 public:
 	HMMModelParameters();
 	HMMModelParameters(const std::vector<double>& aInitialDistribution, const MultidimensionalArray<double>& aTransitionMatrix, const MultidimensionalArray<double>& aEmissionMatrix);
+	HMMModelParameters(std::vector<double>&& aInitialDistribution, MultidimensionalArray<double>&& aTransitionMatrix, MultidimensionalArray<double>&& aEmissionMatrix);
+	HMMModelParameters(const HMMModelParameters& aCopy) = default;
+	HMMModelParameters(HMMModelParameters&& aMove) = default;
+	~HMMModelParameters() = default;
+
+	HMMModelParameters& operator=(const HMMModelParameters& aRight) = default;
+	HMMModelParameters& operator=(HMMModelParameters&& aRight) = default;
 
 	unsigned getNumberOfHiddenStates() const;
 	unsigned getNumberOfEmissionStates() const;
-	MultidimensionalArray<double>  getTransitionMatrix() const;
-	MultidimensionalArray<double>  getEmissionMatrix() const;
-	std::vector<double> getInitialDistribution() const;
+	const MultidimensionalArray<double>& getTransitionMatrix() const;
+	const MultidimensionalArray<double>& getEmissionMatrix() const;
+	const std::vector<double>& getInitialDistribution() const;
 
 	void setTransitionMatrix(const MultidimensionalArray<double>& aTransitionMatrix);
+	void setTransitionMatrix(MultidimensionalArray<double>&& aTransitionMatrix);
 	void setEmissionMatrix(const MultidimensionalArray<double>& aEmissionMatrix);
+	void setEmissionMatrix(MultidimensionalArray<double>&& aEmissionMatrix);
 	void setInitialDistributionMatrix(const std::vector<double>& aInitialDistribution);
+	void setInitialDistributionMatrix(std::vector<double>&& aInitialDistribution);
 
 	bool checkParameters() const;
 	bool checkInitialDistribution() const;
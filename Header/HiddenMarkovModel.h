@@ -11,6 +11,9 @@
 #include "Utilities.h"
 #include <vector>
 #include "MultidimensionalArray.h"
+#include "FixedRankArray.h"
+#include "SparseMatrix.h"
+#include "LinearAlgebra.h"
 #include "DebugLogger.h"
 #include <float.h> // DBL_MAX;
 
@@ -18,21 +21,46 @@
 
 class HiddenMarkovModel
 {
+public:
+	/** The element type Baum Welch uses for its per time iteration arrays (the model parameters are always double) */
+	enum Precision
+	{
+		DOUBLE_PRECISION,
+		SINGLE_PRECISION, // float: half the memory traffic, about 7 significant digits
+		BFLOAT16_PRECISION, // BFloat16: a quarter of the memory traffic, about 3 significant digits
+	};
+
 private:
 	HMMModelParameters m_ModelParameters;
 	GuassianMixtureModel m_GMM;
+	Precision m_Precision;
+	ExecutionPolicy m_ExecutionPolicy; // how Baum Welch runs its sums over time (sequential by default)
+
+	// transition matrices with at most this fraction of non-zero elements use the sparse products
+	const static double SPARSE_TRANSITION_DENSITY;
+
+	// a probability for each hidden state, kept on the stack for models with up to 16 hidden states
+	typedef InlineStorage<double, 16> StateVector;
 
-	static HMMModelParameters BaumWelchAlorithm(const MultidimensionalArray<double> aObservations, const HMMModelParameters aModelParameters);
-	static std::vector<double> ForwardAlgorithm(const MultidimensionalArray<double> aObservations, const HMMModelParameters aModelParameters, const unsigned aTimerIterations);
-	static std::vector<double> BackwardAlgorithm(const MultidimensionalArray<double> aObservations, const HMMModelParameters aModelParameters, const unsigned aTimerIterations);
-	static double HiddenStateEmission(const unsigned aCountN, const unsigned aCountT, const MultidimensionalArray<double> aObservations, const MultidimensionalArray<double> aEmissionMatrix);
-	static std::vector<double> CalculateObservations(const std::vector<double> aHiddenState, const MultidimensionalArray<double> aEmissionMAtrix);
+	template<typename Real = double>
+	static HMMModelParameters BaumWelchAlorithm(const SparseMatrix<double>& aObservations, const HMMModelParameters& aModelParameters, const ExecutionPolicy& aPolicy = ExecutionPolicy());
+	static HMMModelParameters BaumWelchAlorithm(const SparseMatrix<double>& aObservations, const HMMModelParameters& aModelParameters, const Precision aPrecision, const ExecutionPolicy& aPolicy = ExecutionPolicy());
+	static std::vector<double> ForwardAlgorithm(const SparseMatrix<double>& aObservations, const HMMModelParameters& aModelParameters, const SparseMatrix<double>& aSparseTransitionMatrix, const std::size_t aTimerIterations);
+	static std::vector<double> BackwardAlgorithm(const SparseMatrix<double>& aObservations, const HMMModelParameters& aModelParameters, const SparseMatrix<double>& aSparseTransitionMatrix, const std::size_t aTimerIterations);
+	static double HiddenStateEmission(const std::size_t aCountN, const std::size_t aCountT, const SparseMatrix<double>& aObservations, const MultidimensionalArray<double>& aEmissionMatrix);
+	static void CalculateObservations(ArrayView<const double> aHiddenState, const MultidimensionalArray<double>& aEmissionMatrix, ArrayView<double> aObservation);
 
 public:
-	HiddenMarkovModel(const HMMModelParameters& aModelParameters, const std::vector<double> aData);
-	HiddenMarkovModel(const std::vector<double>& aInitialDistribution, const MultidimensionalArray<double>& aTransitionMatrix, const MultidimensionalArray<double>& aEmissionMatrix, const std::vector<double> aData);
+	HiddenMarkovModel(const HMMModelParameters& aModelParameters, const std::vector<double>& aData);
+	HiddenMarkovModel(const std::vector<double>& aInitialDistribution, const MultidimensionalArray<double>& aTransitionMatrix, const MultidimensionalArray<double>& aEmissionMatrix, const std::vector<double>& aData);
 	void startTraining(const unsigned& aBaumWelchIterations, const bool aConvergenceCheck, const double aConvergenceValue = 1.0);
-	static MultidimensionalArray<double> OutputObservations(const HMMModelParameters aModelParameters, const unsigned aTimeIterations);
+	void setPrecision(const Precision aPrecision);
+	Precision getPrecision() const;
+	void setExecutionPolicy(const ExecutionPolicy& aPolicy);
+	const ExecutionPolicy& getExecutionPolicy() const;
+	const HMMModelParameters& getModelParameters() const;
+	double calculatePrecisionDelta() const;
+	static MultidimensionalArray<double> OutputObservations(const HMMModelParameters& aModelParameters, const std::size_t aTimeIterations);
 };
 
 #endif 
\ No newline at end of file
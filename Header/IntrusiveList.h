@@ -0,0 +1,495 @@
+/**
+*  @file    IntrusiveList.h
+*  @author  Jordan Nesley
+**/
+
+#ifndef INTRUSIVELIST_H
+#define INTRUSIVELIST_H
+
+#include <utility> // std::move
+
+#pragma unmanaged
+
+template<typename T, typename Tag> class IntrusiveList;
+template<typename T, typename Tag> class IntrusiveListIterator;
+
+/** The links an object needs to be in an IntrusiveList: a class derives from IntrusiveListHook<Tag> once for every
+*   list it can be in at the same time (with a different Tag for each).
+*
+*   An object takes itself out of its list with unlink (or by being destroyed) without knowing the list. A copy of an
+*   object is not in a list, and assigning an object does not change the list it is in.
+*/
+template<typename Tag = void>
+class IntrusiveListHook
+{
+	template<typename, typename> friend class IntrusiveList;
+	template<typename, typename> friend class IntrusiveListIterator;
+
+private:
+	IntrusiveListHook* m_Next;
+	IntrusiveListHook* m_Previous;
+
+public:
+	IntrusiveListHook() : m_Next(nullptr), m_Previous(nullptr) {}
+	IntrusiveListHook(const IntrusiveListHook&) : m_Next(nullptr), m_Previous(nullptr) {}
+	~IntrusiveListHook() { this->unlink(); }
+
+	IntrusiveListHook& operator=(const IntrusiveListHook&) { return *this; }
+
+	/** Returns whether the object is in a list
+	*/
+	bool isLinked() const { return this->m_Next != nullptr; }
+
+	/** Takes the object out of its list (if it is in one)
+	*/
+	void unlink()
+	{
+		if (this->m_Next == nullptr) return;
+		this->m_Previous->m_Next = this->m_Next;
+		this->m_Next->m_Previous = this->m_Previous;
+		this->m_Next = nullptr;
+		this->m_Previous = nullptr;
+	}
+};
+
+////////////////////////////////////////////////////////////////////////////////
+
+////////////////////////////////////////////////////////////////////////////////
+
+/** A doubly linked list of objects that carry their own links (see IntrusiveListHook), so linking an object needs no
+*   node allocation and an iterator to an object can be made from the object itself. The list does not own its objects:
+*   erasing or clearing only unlinks them (the Dispose versions also hand every object to a disposer, e.g. to destroy
+*   it), and an object unlinks itself when it is destroyed.
+*
+*   The list is circular around an end() link of its own, so linking and unlinking never need the list. size() walks
+*   the list for the same reason.
+*/
+template<typename T, typename Tag = void>
+class IntrusiveList
+{
+private:
+	typedef IntrusiveListHook<Tag> Hook;
+
+	Hook m_End;
+
+	static Hook* hook(T& aObject) { return &static_cast<Hook&>(aObject); }
+	void initialize();
+	void link(Hook* aLoc, Hook* aHook);
+	void takeObjects(IntrusiveList& aOther);
+
+public:
+	typedef IntrusiveListIterator<T, Tag> Iterator;
+
+	IntrusiveList();
+	IntrusiveList(const IntrusiveList&) = delete;
+	IntrusiveList(IntrusiveList&& aMove);
+	~IntrusiveList();
+
+	void pushBack(T& aObject);
+	void pushFront(T& aObject);
+	Iterator insert(const Iterator& aLoc, T& aObject);
+	void popFront();
+	void popBack();
+	Iterator erase(const Iterator& aLoc);
+	template<typename Disposer>
+	Iterator eraseAndDispose(const Iterator& aLoc, Disposer aDisposer);
+	void clear();
+	template<typename Disposer>
+	void clearAndDispose(Disposer aDisposer);
+
+	void splice(const Iterator& aLoc, IntrusiveList& aOther);
+	void splice(const Iterator& aLoc, T& aObject);
+	void swap(IntrusiveList& aOther);
+
+	int size() const;
+	bool empty() const;
+	static Iterator iteratorTo(T& aObject);
+
+	Iterator begin() const;
+	Iterator end() const;
+
+	IntrusiveList& operator=(const IntrusiveList&) = delete;
+	IntrusiveList& operator=(IntrusiveList&& aRight);
+};
+
+////////////////////////////////////////////////////////////////////////////////
+
+template<typename T, typename Tag = void>
+class IntrusiveListIterator
+{
+	template<typename, typename> friend class IntrusiveList;
+
+private:
+	IntrusiveListHook<Tag>* m_Ptr;
+	IntrusiveListIterator(IntrusiveListHook<Tag>* aHook);
+public:
+	IntrusiveListIterator();
+	IntrusiveListIterator(const IntrusiveListIterator<T, Tag>& aCopy);
+
+	IntrusiveListIterator<T, Tag> next() const;
+	IntrusiveListIterator<T, Tag> prev() const;
+
+	T& operator*();
+	const T& operator*() const;
+	bool operator==(const IntrusiveListIterator<T, Tag>& aRight) const;
+	bool operator!=(const IntrusiveListIterator<T, Tag>& aRight) const;
+	IntrusiveListIterator<T, Tag>& operator++();
+	IntrusiveListIterator<T, Tag> operator++(int);
+	IntrusiveListIterator<T, Tag>& operator--();
+	IntrusiveListIterator<T, Tag> operator--(int);
+	IntrusiveListIterator<T, Tag>& operator=(const IntrusiveListIterator<T, Tag>& aRight);
+};
+
+////////////////////////////////////////////////////////////////////////////////
+
+////////////////////////////////////////////////////////////////////////////////
+
+/** Default constructor for IntrusiveList
+*/
+template<typename T, typename Tag>
+IntrusiveList<T, Tag>::IntrusiveList()
+{
+	this->initialize();
+}
+
+/** Move constructor for IntrusiveList (aMove is left empty)
+* @param aMove The list to move
+*/
+template<typename T, typename Tag>
+IntrusiveList<T, Tag>::IntrusiveList(IntrusiveList&& aMove)
+{
+	this->initialize();
+	this->takeObjects(aMove);
+}
+
+/** Destructor for IntrusiveList: unlinks every object (the objects are not destroyed)
+*/
+template<typename T, typename Tag>
+IntrusiveList<T, Tag>::~IntrusiveList()
+{
+	this->clear();
+	this->m_End.m_Next = nullptr;
+	this->m_End.m_Previous = nullptr;
+}
+
+/** Makes the list empty (end() linked to itself)
+*/
+template<typename T, typename Tag>
+void IntrusiveList<T, Tag>::initialize()
+{
+	this->m_End.m_Next = &this->m_End;
+	this->m_End.m_Previous = &this->m_End;
+}
+
+/** Links a hook in front of another
+* @param aLoc The hook to link in front of
+* @param aHook The hook to link (it must not be in a list)
+*/
+template<typename T, typename Tag>
+void IntrusiveList<T, Tag>::link(Hook* aLoc, Hook* aHook)
+{
+	aHook->m_Next = aLoc;
+	aHook->m_Previous = aLoc->m_Previous;
+	aLoc->m_Previous->m_Next = aHook;
+	aLoc->m_Previous = aHook;
+}
+
+/** Moves the objects of an empty list from another list (aOther is left empty)
+* @param aOther The list to take the objects of
+*/
+template<typename T, typename Tag>
+void IntrusiveList<T, Tag>::takeObjects(IntrusiveList& aOther)
+{
+	if (aOther.empty()) return;
+
+	this->m_End.m_Next = aOther.m_End.m_Next;
+	this->m_End.m_Previous = aOther.m_End.m_Previous;
+	this->m_End.m_Next->m_Previous = &this->m_End;
+	this->m_End.m_Previous->m_Next = &this->m_End;
+	aOther.initialize();
+}
+
+/** Links an object at the back of the list
+* @param aObject The object (it is first unlinked from the list it is in)
+*/
+template<typename T, typename Tag>
+void IntrusiveList<T, Tag>::pushBack(T& aObject)
+{
+	this->insert(this->end(), aObject);
+}
+
+/** Links an object at the front of the list
+* @param aObject The object (it is first unlinked from the list it is in)
+*/
+template<typename T, typename Tag>
+void IntrusiveList<T, Tag>::pushFront(T& aObject)
+{
+	this->insert(this->begin(), aObject);
+}
+
+/** Links an object in front of a location
+* @param aLoc The location to link the object in front of
+* @param aObject The object (it is first unlinked from the list it is in)
+* @return The location of the object
+*/
+template<typename T, typename Tag>
+IntrusiveListIterator<T, Tag> IntrusiveList<T, Tag>::insert(const Iterator& aLoc, T& aObject)
+{
+	Hook* const lHook = IntrusiveList<T, Tag>::hook(aObject);
+	lHook->unlink();
+	this->link(aLoc.m_Ptr, lHook);
+	return Iterator(lHook);
+}
+
+/** Unlinks the first object
+*/
+template<typename T, typename Tag>
+void IntrusiveList<T, Tag>::popFront()
+{
+	if (!this->empty()) this->m_End.m_Next->unlink();
+}
+
+/** Unlinks the last object
+*/
+template<typename T, typename Tag>
+void IntrusiveList<T, Tag>::popBack()
+{
+	if (!this->empty()) this->m_End.m_Previous->unlink();
+}
+
+/** Unlinks the object at a location
+* @param aLoc The location of the object
+* @return The location of the object after it
+*/
+template<typename T, typename Tag>
+IntrusiveListIterator<T, Tag> IntrusiveList<T, Tag>::erase(const Iterator& aLoc)
+{
+	Hook* const lNext = aLoc.m_Ptr->m_Next;
+	aLoc.m_Ptr->unlink();
+	return Iterator(lNext);
+}
+
+/** Unlinks the object at a location and hands it to a disposer
+* @param aLoc The location of the object
+* @param aDisposer Called with a pointer to the object once it is unlinked (e.g. to destroy it)
+* @return The location of the object after it
+*/
+template<typename T, typename Tag>
+template<typename Disposer>
+IntrusiveListIterator<T, Tag> IntrusiveList<T, Tag>::eraseAndDispose(const Iterator& aLoc, Disposer aDisposer)
+{
+	T* const lObject = &static_cast<T&>(*aLoc.m_Ptr);
+	const Iterator lNext = this->erase(aLoc);
+	aDisposer(lObject);
+	return lNext;
+}
+
+/** Unlinks every object
+*/
+template<typename T, typename Tag>
+void IntrusiveList<T, Tag>::clear()
+{
+	while (!this->empty()) this->m_End.m_Next->unlink();
+}
+
+/** Unlinks every object and hands it to a disposer
+* @param aDisposer Called with a pointer to every object once it is unlinked (e.g. to destroy it)
+*/
+template<typename T, typename Tag>
+template<typename Disposer>
+void IntrusiveList<T, Tag>::clearAndDispose(Disposer aDisposer)
+{
+	while (!this->empty()) this->eraseAndDispose(this->begin(), aDisposer);
+}
+
+/** Moves every object of another list in front of a location
+* @param aLoc The location to move the objects in front of
+* @param aOther The list to move the objects from (left empty)
+*/
+template<typename T, typename Tag>
+void IntrusiveList<T, Tag>::splice(const Iterator& aLoc, IntrusiveList& aOther)
+{
+	if (&aOther == this || aOther.empty()) return;
+
+	Hook* const lFirst = aOther.m_End.m_Next;
+	Hook* const lLast = aOther.m_End.m_Previous;
+	aOther.initialize();
+
+	lFirst->m_Previous = aLoc.m_Ptr->m_Previous;
+	lLast->m_Next = aLoc.m_Ptr;
+	aLoc.m_Ptr->m_Previous->m_Next = lFirst;
+	aLoc.m_Ptr->m_Previous = lLast;
+}
+
+/** Moves an object (of this or any other list) in front of a location
+* @param aLoc The location to move the object in front of
+* @param aObject The object
+*/
+template<typename T, typename Tag>
+void IntrusiveList<T, Tag>::splice(const Iterator& aLoc, T& aObject)
+{
+	if (aLoc.m_Ptr == IntrusiveList<T, Tag>::hook(aObject)) return;
+	this->insert(aLoc, aObject);
+}
+
+/** Swaps the objects of two lists
+* @param aOther The other list
+*/
+template<typename T, typename Tag>
+void IntrusiveList<T, Tag>::swap(IntrusiveList& aOther)
+{
+	if (&aOther == this) return;
+
+	IntrusiveList<T, Tag> lTemp(std::move(aOther));
+	aOther.takeObjects(*this);
+	this->takeObjects(lTemp);
+}
+
+/** Returns the number of objects (by walking the list)
+*/
+template<typename T, typename Tag>
+int IntrusiveList<T, Tag>::size() const
+{
+	int Result = 0;
+	for (const Hook* lCurrent = this->m_End.m_Next; lCurrent != &this->m_End; lCurrent = lCurrent->m_Next) Result++;
+	return Result;
+}
+
+/** Returns whether the list is empty
+*/
+template<typename T, typename Tag>
+bool IntrusiveList<T, Tag>::empty() const
+{
+	return this->m_End.m_Next == &this->m_End;
+}
+
+/** Returns the location of an object in the list it is in
+* @param aObject The object (it must be in a list)
+*/
+template<typename T, typename Tag>
+IntrusiveListIterator<T, Tag> IntrusiveList<T, Tag>::iteratorTo(T& aObject)
+{
+	return Iterator(IntrusiveList<T, Tag>::hook(aObject));
+}
+
+template<typename T, typename Tag>
+IntrusiveListIterator<T, Tag> IntrusiveList<T, Tag>::begin() const
+{
+	return Iterator(this->m_End.m_Next);
+}
+
+template<typename T, typename Tag>
+IntrusiveListIterator<T, Tag> IntrusiveList<T, Tag>::end() const
+{
+	return Iterator(const_cast<Hook*>(&this->m_End));
+}
+
+/** Move assignment operator (the objects of the list are unlinked first)
+* @param aRight The right side of the = operator
+*/
+template<typename T, typename Tag>
+IntrusiveList<T, Tag>& IntrusiveList<T, Tag>::operator=(IntrusiveList&& aRight)
+{
+	if (&aRight == this) return *this;
+
+	this->clear();
+	this->takeObjects(aRight);
+	return *this;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+////////////////////////////////////////////////////////////////////////////////
+
+template<typename T, typename Tag>
+IntrusiveListIterator<T, Tag>::IntrusiveListIterator()
+{
+	this->m_Ptr = nullptr;
+}
+
+template<typename T, typename Tag>
+IntrusiveListIterator<T, Tag>::IntrusiveListIterator(const IntrusiveListIterator<T, Tag>& aCopy)
+{
+	this->m_Ptr = aCopy.m_Ptr;
+}
+
+template<typename T, typename Tag>
+IntrusiveListIterator<T, Tag>::IntrusiveListIterator(IntrusiveListHook<Tag>* aHook)
+{
+	this->m_Ptr = aHook;
+}
+
+template<typename T, typename Tag>
+IntrusiveListIterator<T, Tag> IntrusiveListIterator<T, Tag>::next() const
+{
+	return IntrusiveListIterator<T, Tag>(this->m_Ptr->m_Next);
+}
+
+template<typename T, typename Tag>
+IntrusiveListIterator<T, Tag> IntrusiveListIterator<T, Tag>::prev() const
+{
+	return IntrusiveListIterator<T, Tag>(this->m_Ptr->m_Previous);
+}
+
+template<typename T, typename Tag>
+T& IntrusiveListIterator<T, Tag>::operator*()
+{
+	return static_cast<T&>(*this->m_Ptr);
+}
+
+template<typename T, typename Tag>
+const T& IntrusiveListIterator<T, Tag>::operator*() const
+{
+	return static_cast<const T&>(*this->m_Ptr);
+}
+
+template<typename T, typename Tag>
+bool IntrusiveListIterator<T, Tag>::operator==(const IntrusiveListIterator<T, Tag>& aRight) const
+{
+	return (this->m_Ptr == aRight.m_Ptr);
+}
+
+template<typename T, typename Tag>
+bool IntrusiveListIterator<T, Tag>::operator!=(const IntrusiveListIterator<T, Tag>& aRight) const
+{
+	return !(*this == aRight);
+}
+
+template<typename T, typename Tag>
+IntrusiveListIterator<T, Tag>& IntrusiveListIterator<T, Tag>::operator++()
+{
+	this->m_Ptr = this->m_Ptr->m_Next;
+	return *this;
+}
+
+template<typename T, typename Tag>
+IntrusiveListIterator<T, Tag> IntrusiveListIterator<T, Tag>::operator++(int)
+{
+	IntrusiveListIterator<T, Tag> Result(*this);
+	++(*this);
+	return Result;
+}
+
+template<typename T, typename Tag>
+IntrusiveListIterator<T, Tag>& IntrusiveListIterator<T, Tag>::operator--()
+{
+	this->m_Ptr = this->m_Ptr->m_Previous;
+	return *this;
+}
+
+template<typename T, typename Tag>
+IntrusiveListIterator<T, Tag> IntrusiveListIterator<T, Tag>::operator--(int)
+{
+	IntrusiveListIterator<T, Tag> Result(*this);
+	--(*this);
+	return Result;
+}
+
+template<typename T, typename Tag>
+IntrusiveListIterator<T, Tag>& IntrusiveListIterator<T, Tag>::operator=(const IntrusiveListIterator<T, Tag>& aRight)
+{
+	this->m_Ptr = aRight.m_Ptr;
+	return *(this);
+}
+
+#endif
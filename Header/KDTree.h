@@ -0,0 +1,56 @@
+/**
+*  @file    KDTree.h
+*  @author  Jordan Nesley
+**/
+
+#ifndef KDTREE_H
+#define KDTREE_H
+
+#include <vector>
+#include <algorithm> // std::nth_element
+#include <math.h>
+
+#pragma unmanaged
+
+/** A k-d tree over a fixed set of points. Used for radius (neighbor) queries so that
+*   searches that would otherwise compare every point with every other point run in O(N log N).
+*/
+class KDTree
+{
+private:
+	struct KDNode
+	{
+		unsigned Point;
+		unsigned Axis;
+		int Left;
+		int Right;
+	};
+
+	unsigned m_NumberOfDimensions;
+	unsigned m_NumberOfPoints;
+	std::vector<double> m_Points;
+	std::vector<KDNode> m_Nodes;
+	int m_Root;
+
+	int build(std::vector<unsigned>& aIndices, const unsigned aStart, const unsigned aEnd, const unsigned aDepth);
+	void radiusSearch(const int aNode, const double* const aPoint, const double aRadiusSquared, std::vector<unsigned>& aResult) const;
+	double distanceSquared(const unsigned aPointIndex, const double* const aPoint) const;
+
+public:
+	KDTree();
+	KDTree(const std::vector<double>& aPoints, const unsigned aNumberOfDimensions);
+
+	unsigned getNumberOfPoints() const;
+	unsigned getNumberOfDimensions() const;
+	double distance(const unsigned aPointIndex1, const unsigned aPointIndex2) const;
+
+	std::vector<unsigned> radiusSearch(const unsigned aPointIndex, const double aRadius) const;
+	std::vector<unsigned> radiusSearch(const std::vector<double>& aPoint, const double aRadius) const;
+
+	enum Exeception
+	{
+		DIMENSIONS_DONT_MATCH,
+	};
+};
+
+#endif
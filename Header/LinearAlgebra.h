@@ -0,0 +1,303 @@
+/**
+*  @file    LinearAlgebra.h
+*  @author  Jordan Nesley
+**/
+
+#ifndef LINEARALGEBRA_H
+#define LINEARALGEBRA_H
+
+#include "ArrayStorage.h"
+#include "BFloat16.h"
+#include <vector>
+#include <cstddef> // std::size_t
+
+#pragma unmanaged
+
+/** Matrix-vector and matrix-matrix kernels for row major double matrices (the storage order of MultidimensionalArray).
+*   The inner loops are vectorized with AVX-512 or AVX2 when the compiler targets them (e.g. /arch:AVX2 or -mavx2 -mfma)
+*   and fall back to scalar code otherwise. The loops only ever walk along rows so memory is read in order, and the
+*   larger kernels are blocked so the part of the right hand side being reused stays in cache.
+*
+*   The reductions (Sum, Min, Max, ArgMax, Dot) and element-wise accumulations (AddTo, MinTo, MaxTo, MultiplyAddTo, Scale)
+*   work on contiguous elements of any type and are vectorized for double.
+*
+*   Arrays of float or BFloat16 halve or quarter the memory traffic of double. Their sums are accumulated in double
+*   (see Accumulator) so only the stored values are rounded, not every partial sum; Sum and Dot of float are vectorized.
+*/
+class LinearAlgebra
+{
+private:
+	// the number of doubles of a vector that are kept in cache while a block of rows is processed
+	static const std::size_t COLUMN_BLOCK = 2048;
+	// the number of rows of the matrix kept in cache while BatchedGemv processes every vector
+	static const std::size_t ROW_BLOCK = 64;
+	// the block sizes of Gemm (a DEPTH_BLOCK x GEMM_COLUMN_BLOCK panel of the right matrix is 256KB)
+	static const std::size_t DEPTH_BLOCK = 128;
+	static const std::size_t GEMM_COLUMN_BLOCK = 256;
+
+	static double dot(const double* const aLeft, const double* const aRight, const std::size_t aLength);
+	static void axpy(const double aScale, const double* const aVector, double* const aResult, const std::size_t aLength);
+
+public:
+	/** The type sums of T are accumulated in: double for the reduced precision types */
+	template<typename T>
+	struct Accumulator
+	{
+		typedef T type;
+	};
+
+	static void Gemv(const double* const aMatrix, const std::size_t aNumberOfRows, const std::size_t aNumberOfColumns, const double* const aVector, double* const aResult);
+	static void GemvTransposed(const double* const aMatrix, const std::size_t aNumberOfRows, const std::size_t aNumberOfColumns, const double* const aVector, double* const aResult);
+	static void Gemm(const double* const aLeft, const double* const aRight, double* const aResult, const std::size_t aNumberOfRows, const std::size_t aDepth, const std::size_t aNumberOfColumns);
+	static void BatchedGemv(const double* const aMatrix, const std::size_t aNumberOfRows, const std::size_t aNumberOfColumns, const double* const aVectors, double* const aResults, const std::size_t aNumberOfVectors, const bool aTransposed);
+	static void Multiply(const double* const aLeft, const double* const aRight, double* const aResult, const std::size_t aLength);
+
+	template<typename T>
+	static void Gemv(const T* const aMatrix, const std::size_t aNumberOfRows, const std::size_t aNumberOfColumns, const T* const aVector, T* const aResult);
+	template<typename T>
+	static void GemvTransposed(const T* const aMatrix, const std::size_t aNumberOfRows, const std::size_t aNumberOfColumns, const T* const aVector, T* const aResult);
+	template<typename T>
+	static void Multiply(const T* const aLeft, const T* const aRight, T* const aResult, const std::size_t aLength);
+
+	template<typename T>
+	static T Sum(const T* const aData, const std::size_t aLength);
+	template<typename T>
+	static T Min(const T* const aData, const std::size_t aLength);
+	template<typename T>
+	static T Max(const T* const aData, const std::size_t aLength);
+	template<typename T>
+	static std::size_t ArgMax(const T* const aData, const std::size_t aLength);
+	template<typename T>
+	static T Dot(const T* const aLeft, const T* const aRight, const std::size_t aLength);
+	template<typename T>
+	static void AddTo(const T* const aVector, T* const aResult, const std::size_t aLength);
+	template<typename T>
+	static void MinTo(const T* const aVector, T* const aResult, const std::size_t aLength);
+	template<typename T>
+	static void MaxTo(const T* const aVector, T* const aResult, const std::size_t aLength);
+	template<typename T>
+	static void MultiplyAddTo(const T* const aLeft, const T* const aRight, T* const aResult, const std::size_t aLength);
+	template<typename T>
+	static void Scale(const T aScale, T* const aData, const std::size_t aLength);
+
+	static std::vector<double> Gemv(const MultidimensionalArray<double>& aMatrix, const std::vector<double>& aVector);
+	static std::vector<double> GemvTransposed(const MultidimensionalArray<double>& aMatrix, const std::vector<double>& aVector);
+	static MultidimensionalArray<double> Gemm(const MultidimensionalArray<double>& aLeft, const MultidimensionalArray<double>& aRight);
+	static MultidimensionalArray<double> BatchedGemv(const MultidimensionalArray<double>& aMatrix, const MultidimensionalArray<double>& aVectors, const bool aTransposed);
+
+	enum Exeception
+	{
+		DIMENSIONS_DONT_MATCH,
+	};
+};
+
+template<> struct LinearAlgebra::Accumulator<float> { typedef double type; };
+template<> struct LinearAlgebra::Accumulator<BFloat16> { typedef double type; };
+
+/** Multiplies a matrix by a vector (aResult = aMatrix * aVector) for any element type, accumulating in Accumulator<T>
+* @param aMatrix The matrix (row major)
+* @param aNumberOfRows The number of rows of the matrix and the length of aResult
+* @param aNumberOfColumns The number of columns of the matrix and the length of aVector
+*/
+template<typename T>
+void LinearAlgebra::Gemv(const T* const aMatrix, const std::size_t aNumberOfRows, const std::size_t aNumberOfColumns, const T* const aVector, T* const aResult)
+{
+	for (std::size_t lCountRow = 0; lCountRow < aNumberOfRows; lCountRow++)
+	{
+		aResult[lCountRow] = LinearAlgebra::Dot(aMatrix + lCountRow * aNumberOfColumns, aVector, aNumberOfColumns);
+	}
+}
+
+/** Multiplies the transpose of a matrix by a vector (aResult = aMatrix^T * aVector) for any element type, accumulating
+*   in Accumulator<T>. The matrix is still read a row at a time.
+* @param aMatrix The matrix (row major)
+* @param aNumberOfRows The number of rows of the matrix and the length of aVector
+* @param aNumberOfColumns The number of columns of the matrix and the length of aResult
+*/
+template<typename T>
+void LinearAlgebra::GemvTransposed(const T* const aMatrix, const std::size_t aNumberOfRows, const std::size_t aNumberOfColumns, const T* const aVector, T* const aResult)
+{
+	typedef typename LinearAlgebra::Accumulator<T>::type SumType;
+
+	InlineStorage<SumType, 64> lResult(aNumberOfColumns, SumType());
+	for (std::size_t lCountRow = 0; lCountRow < aNumberOfRows; lCountRow++)
+	{
+		const SumType lScale = aVector[lCountRow];
+		const T* const lRow = aMatrix + lCountRow * aNumberOfColumns;
+		for (std::size_t lCountColumn = 0; lCountColumn < aNumberOfColumns; lCountColumn++)
+		{
+			lResult[lCountColumn] += lScale * static_cast<SumType>(lRow[lCountColumn]);
+		}
+	}
+
+	for (std::size_t lCountColumn = 0; lCountColumn < aNumberOfColumns; lCountColumn++)
+	{
+		aResult[lCountColumn] = static_cast<T>(lResult[lCountColumn]);
+	}
+}
+
+/** Multiplies two vectors element-wise (aResult = aLeft * aRight) for any element type
+* @param aLength The length of the vectors
+*/
+template<typename T>
+void LinearAlgebra::Multiply(const T* const aLeft, const T* const aRight, T* const aResult, const std::size_t aLength)
+{
+	for (std::size_t lCount = 0; lCount < aLength; lCount++)
+	{
+		aResult[lCount] = aLeft[lCount] * aRight[lCount];
+	}
+}
+
+/** Returns the sum of the elements
+* @param aData The elements
+* @param aLength The number of elements
+*/
+template<typename T>
+T LinearAlgebra::Sum(const T* const aData, const std::size_t aLength)
+{
+	typename LinearAlgebra::Accumulator<T>::type lResult = typename LinearAlgebra::Accumulator<T>::type();
+	for (std::size_t lCount = 0; lCount < aLength; lCount++)
+	{
+		lResult += aData[lCount];
+	}
+	return static_cast<T>(lResult);
+}
+
+/** Returns the smallest element (aLength must be greater than 0)
+* @param aData The elements
+* @param aLength The number of elements
+*/
+template<typename T>
+T LinearAlgebra::Min(const T* const aData, const std::size_t aLength)
+{
+	T lResult = aData[0];
+	for (std::size_t lCount = 1; lCount < aLength; lCount++)
+	{
+		if (aData[lCount] < lResult) lResult = aData[lCount];
+	}
+	return lResult;
+}
+
+/** Returns the largest element (aLength must be greater than 0)
+* @param aData The elements
+* @param aLength The number of elements
+*/
+template<typename T>
+T LinearAlgebra::Max(const T* const aData, const std::size_t aLength)
+{
+	T lResult = aData[0];
+	for (std::size_t lCount = 1; lCount < aLength; lCount++)
+	{
+		if (aData[lCount] > lResult) lResult = aData[lCount];
+	}
+	return lResult;
+}
+
+/** Returns the index of the first largest element (aLength must be greater than 0)
+* @param aData The elements
+* @param aLength The number of elements
+*/
+template<typename T>
+std::size_t LinearAlgebra::ArgMax(const T* const aData, const std::size_t aLength)
+{
+	std::size_t lResult = 0;
+	for (std::size_t lCount = 1; lCount < aLength; lCount++)
+	{
+		if (aData[lCount] > aData[lResult]) lResult = lCount;
+	}
+	return lResult;
+}
+
+/** Returns the sum of the products of the elements of two vectors
+* @param aLength The length of the vectors
+*/
+template<typename T>
+T LinearAlgebra::Dot(const T* const aLeft, const T* const aRight, const std::size_t aLength)
+{
+	typedef typename LinearAlgebra::Accumulator<T>::type SumType;
+
+	SumType lResult = SumType();
+	for (std::size_t lCount = 0; lCount < aLength; lCount++)
+	{
+		lResult += static_cast<SumType>(aLeft[lCount]) * static_cast<SumType>(aRight[lCount]);
+	}
+	return static_cast<T>(lResult);
+}
+
+/** Adds a vector to another vector element-wise (aResult = aResult + aVector)
+* @param aLength The length of the vectors
+*/
+template<typename T>
+void LinearAlgebra::AddTo(const T* const aVector, T* const aResult, const std::size_t aLength)
+{
+	for (std::size_t lCount = 0; lCount < aLength; lCount++)
+	{
+		aResult[lCount] += aVector[lCount];
+	}
+}
+
+/** Keeps the smaller of two elements element-wise (aResult = min(aResult, aVector))
+* @param aLength The length of the vectors
+*/
+template<typename T>
+void LinearAlgebra::MinTo(const T* const aVector, T* const aResult, const std::size_t aLength)
+{
+	for (std::size_t lCount = 0; lCount < aLength; lCount++)
+	{
+		if (aVector[lCount] < aResult[lCount]) aResult[lCount] = aVector[lCount];
+	}
+}
+
+/** Keeps the larger of two elements element-wise (aResult = max(aResult, aVector))
+* @param aLength The length of the vectors
+*/
+template<typename T>
+void LinearAlgebra::MaxTo(const T* const aVector, T* const aResult, const std::size_t aLength)
+{
+	for (std::size_t lCount = 0; lCount < aLength; lCount++)
+	{
+		if (aVector[lCount] > aResult[lCount]) aResult[lCount] = aVector[lCount];
+	}
+}
+
+/** Adds the element-wise product of two vectors to another vector (aResult = aResult + aLeft * aRight)
+* @param aLength The length of the vectors
+*/
+template<typename T>
+void LinearAlgebra::MultiplyAddTo(const T* const aLeft, const T* const aRight, T* const aResult, const std::size_t aLength)
+{
+	for (std::size_t lCount = 0; lCount < aLength; lCount++)
+	{
+		aResult[lCount] += aLeft[lCount] * aRight[lCount];
+	}
+}
+
+/** Multiplies every element by a scalar
+* @param aLength The number of elements
+*/
+template<typename T>
+void LinearAlgebra::Scale(const T aScale, T* const aData, const std::size_t aLength)
+{
+	for (std::size_t lCount = 0; lCount < aLength; lCount++)
+	{
+		aData[lCount] *= aScale;
+	}
+}
+
+// vectorized versions for double (LinearAlgebra.cpp)
+template<> double LinearAlgebra::Sum<double>(const double* const aData, const std::size_t aLength);
+template<> double LinearAlgebra::Min<double>(const double* const aData, const std::size_t aLength);
+template<> double LinearAlgebra::Max<double>(const double* const aData, const std::size_t aLength);
+template<> std::size_t LinearAlgebra::ArgMax<double>(const double* const aData, const std::size_t aLength);
+template<> double LinearAlgebra::Dot<double>(const double* const aLeft, const double* const aRight, const std::size_t aLength);
+template<> void LinearAlgebra::AddTo<double>(const double* const aVector, double* const aResult, const std::size_t aLength);
+template<> void LinearAlgebra::MinTo<double>(const double* const aVector, double* const aResult, const std::size_t aLength);
+template<> void LinearAlgebra::MaxTo<double>(const double* const aVector, double* const aResult, const std::size_t aLength);
+template<> void LinearAlgebra::MultiplyAddTo<double>(const double* const aLeft, const double* const aRight, double* const aResult, const std::size_t aLength);
+template<> void LinearAlgebra::Scale<double>(const double aScale, double* const aData, const std::size_t aLength);
+
+// vectorized versions for float that accumulate in double (LinearAlgebra.cpp)
+template<> float LinearAlgebra::Sum<float>(const float* const aData, const std::size_t aLength);
+template<> float LinearAlgebra::Dot<float>(const float* const aLeft, const float* const aRight, const std::size_t aLength);
+
+#endif
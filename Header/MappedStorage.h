@@ -0,0 +1,365 @@
+/**
+*  @file    MappedStorage.h
+*  @author  Jordan Nesley
+**/
+
+#ifndef MAPPEDSTORAGE_H
+#define MAPPEDSTORAGE_H
+
+#include "MultidimensionalArray.h"
+#include <vector>
+#include <string>
+#include <cstddef> // std::size_t
+#include <cstdint> // std::uint32_t
+#include <type_traits> // std::is_floating_point
+#include <algorithm> // std::fill
+#include <iterator> // std::distance
+#include <utility> // std::move
+
+#pragma unmanaged
+
+/** A file mapped into memory. Mapping a file is O(1): nothing is read until a page is touched, and then the operating
+*   system reads just that page.
+*/
+class MappedFile
+{
+public:
+	enum Mode
+	{
+		READ_ONLY, // writing to the memory is an access violation
+		READ_WRITE, // writes go to the file
+		COPY_ON_WRITE, // writes go to private copies of the pages and the file is never changed
+	};
+
+	MappedFile();
+	MappedFile(MappedFile&& aMove);
+	MappedFile(const MappedFile&) = delete;
+	~MappedFile();
+
+	MappedFile& operator=(MappedFile&& aRight);
+	MappedFile& operator=(const MappedFile&) = delete;
+
+	void create(const std::string& aPath, const std::size_t aSize);
+	void open(const std::string& aPath, const Mode aMode);
+	void close();
+	void flush();
+
+	unsigned char* data();
+	const unsigned char* data() const;
+	std::size_t size() const;
+	Mode getMode() const;
+	bool isOpen() const;
+
+	enum Exeception
+	{
+		OPEN_EXCEPTION,
+		MAP_EXCEPTION,
+	};
+
+private:
+	unsigned char* m_Data;
+	std::size_t m_Size;
+	Mode m_Mode;
+#ifdef _WIN32
+	void* m_File;
+	void* m_Mapping;
+#else
+	int m_File;
+#endif
+};
+
+/** The on-disk format of a memory mapped MultidimensionalArray (all values in the byte order of the machine):
+*
+*   magic "MYLIBMDA" (8 bytes), version, element type, element size, number of dimensions (4 bytes each),
+*   offset of the elements from the start of the file (8 bytes), the length of every dimension (8 bytes each),
+*   padding up to the offset (a multiple of 64 so the elements are aligned like VectorStorage), the elements.
+*/
+class MappedArrayFormat
+{
+public:
+	static const std::uint32_t VERSION = 1;
+	static const std::size_t ALIGNMENT = 64;
+
+	enum ElementType
+	{
+		FLOATING_POINT = 1,
+		SIGNED_INTEGER = 2,
+		UNSIGNED_INTEGER = 3,
+	};
+
+	template<typename T>
+	static std::uint32_t getElementType();
+
+	static std::size_t calculateDataOffset(const std::size_t aNumberOfDimensions);
+	static void writeHeader(MappedFile& aFile, const std::uint32_t aElementType, const std::uint32_t aElementSize, const std::vector<std::size_t>& aDimLengths);
+	static std::size_t readHeader(const MappedFile& aFile, const std::uint32_t aElementType, const std::uint32_t aElementSize, std::vector<std::size_t>& aDimLengths);
+
+	enum Exeception
+	{
+		FORMAT_EXCEPTION,
+		VERSION_EXCEPTION,
+		ELEMENT_TYPE_EXCEPTION,
+	};
+};
+
+/** Returns the code stored in the header for an element type
+*/
+template<typename T>
+std::uint32_t MappedArrayFormat::getElementType()
+{
+	static_assert(std::is_arithmetic<T>::value, "MappedStorage can only hold numbers");
+
+	if (std::is_floating_point<T>::value) return MappedArrayFormat::FLOATING_POINT;
+	if (std::is_signed<T>::value) return MappedArrayFormat::SIGNED_INTEGER;
+	return MappedArrayFormat::UNSIGNED_INTEGER;
+}
+
+/** A MultidimensionalArray storage policy that keeps the elements in a memory mapped file (see MappedArrayFormat),
+*   so arrays bigger than memory can be used and opening one is O(1) whatever its size.
+*
+*   The number of elements is fixed when the file is created: the array can be written to but not resized.
+*   Results of reductions and expressions assigned to a new array are ordinary in-memory arrays.
+*/
+template<typename T>
+class MappedStorage
+{
+private:
+	MappedFile m_File;
+	T* m_Elements;
+	std::size_t m_Size;
+
+public:
+	typedef T value_type;
+	typedef MultidimensionalArray<T, MappedStorage<T>> Array;
+
+	MappedStorage();
+	MappedStorage(MappedStorage&& aMove);
+	MappedStorage(const MappedStorage&) = delete;
+	~MappedStorage() = default;
+
+	MappedStorage& operator=(MappedStorage&& aRight);
+	MappedStorage& operator=(const MappedStorage&) = delete;
+
+	static Array createArray(const std::string& aPath, const std::size_t aNumberOfDimensions, const std::vector<std::size_t>& aNumberOfElementsOfAllDimensions);
+	static Array openArray(const std::string& aPath, const MappedFile::Mode aMode);
+	template<typename S>
+	static void saveArray(const std::string& aPath, const MultidimensionalArray<T, S>& aArray);
+
+	T* data();
+	const T* data() const;
+	std::size_t size() const;
+	bool empty() const;
+	T& operator[](const std::size_t aPosition);
+	const T& operator[](const std::size_t aPosition) const;
+
+	void clear();
+	void assign(const std::size_t aCount, const T& aValue);
+	template<typename Iterator>
+	void assign(Iterator aFirst, Iterator aLast);
+	void flush();
+
+	enum Exeception
+	{
+		RESIZE_EXCEPTION,
+	};
+};
+
+/** Default constructor for MappedStorage (no file)
+*/
+template<typename T>
+MappedStorage<T>::MappedStorage()
+{
+	this->m_Elements = nullptr;
+	this->m_Size = 0;
+}
+
+/** Move Constructor for MappedStorage
+* @param aMove The object to move
+*/
+template<typename T>
+MappedStorage<T>::MappedStorage(MappedStorage&& aMove)
+	: m_File(std::move(aMove.m_File))
+{
+	this->m_Elements = aMove.m_Elements;
+	this->m_Size = aMove.m_Size;
+
+	aMove.m_Elements = nullptr;
+	aMove.m_Size = 0;
+}
+
+/** Move assignment operator
+* @param aRight The right side of the = operator
+*/
+template<typename T>
+MappedStorage<T>& MappedStorage<T>::operator=(MappedStorage&& aRight)
+{
+	if (this == &aRight) return *this;
+
+	this->m_File = std::move(aRight.m_File);
+	this->m_Elements = aRight.m_Elements;
+	this->m_Size = aRight.m_Size;
+
+	aRight.m_Elements = nullptr;
+	aRight.m_Size = 0;
+	return *this;
+}
+
+/** Creates a new file (replacing any existing file) holding an array with every element 0
+* @param aPath The path of the file
+* @param aNumberOfDimensions The number of dimensions
+* @param aNumberOfElementsOfAllDimensions An array of the lengths for each dimension
+* @return The array, mapped READ_WRITE
+*/
+template<typename T>
+typename MappedStorage<T>::Array MappedStorage<T>::createArray(const std::string& aPath, const std::size_t aNumberOfDimensions, const std::vector<std::size_t>& aNumberOfElementsOfAllDimensions)
+{
+	if (aNumberOfElementsOfAllDimensions.size() != aNumberOfDimensions) throw Array::CONSTRUCTOR_EXCEPTION;
+
+	std::size_t lTotalNumberOfElements = 1;
+	for (std::size_t lCountDim = 0; lCountDim < aNumberOfDimensions; lCountDim++)
+	{
+		lTotalNumberOfElements = lTotalNumberOfElements * aNumberOfElementsOfAllDimensions[lCountDim];
+	}
+
+	const std::size_t lDataOffset = MappedArrayFormat::calculateDataOffset(aNumberOfDimensions);
+	MappedStorage<T> lStorage;
+	lStorage.m_File.create(aPath, lDataOffset + lTotalNumberOfElements * sizeof(T));
+	MappedArrayFormat::writeHeader(lStorage.m_File, MappedArrayFormat::getElementType<T>(), sizeof(T), aNumberOfElementsOfAllDimensions);
+
+	// a new file reads as zeros so the elements are already initialized
+	lStorage.m_Elements = reinterpret_cast<T*>(lStorage.m_File.data() + lDataOffset);
+	lStorage.m_Size = lTotalNumberOfElements;
+
+	return Array(std::move(lStorage), aNumberOfDimensions, aNumberOfElementsOfAllDimensions);
+}
+
+/** Maps an array file created by createArray or saveArray. Only the header is read.
+* @param aPath The path of the file
+* @param aMode READ_ONLY, READ_WRITE or COPY_ON_WRITE (an array opened READ_ONLY should only be used through a const reference)
+* @return The array
+*/
+template<typename T>
+typename MappedStorage<T>::Array MappedStorage<T>::openArray(const std::string& aPath, const MappedFile::Mode aMode)
+{
+	MappedStorage<T> lStorage;
+	lStorage.m_File.open(aPath, aMode);
+
+	std::vector<std::size_t> lDimLengths;
+	const std::size_t lDataOffset = MappedArrayFormat::readHeader(lStorage.m_File, MappedArrayFormat::getElementType<T>(), sizeof(T), lDimLengths);
+
+	std::size_t lTotalNumberOfElements = 1;
+	for (std::size_t lCountDim = 0; lCountDim < lDimLengths.size(); lCountDim++)
+	{
+		lTotalNumberOfElements = lTotalNumberOfElements * lDimLengths[lCountDim];
+	}
+
+	lStorage.m_Elements = reinterpret_cast<T*>(lStorage.m_File.data() + lDataOffset);
+	lStorage.m_Size = lTotalNumberOfElements;
+
+	return Array(std::move(lStorage), static_cast<std::size_t>(lDimLengths.size()), lDimLengths);
+}
+
+/** Writes an array to a new file that can be opened with openArray
+* @param aPath The path of the file
+* @param aArray The array to write
+*/
+template<typename T>
+template<typename S>
+void MappedStorage<T>::saveArray(const std::string& aPath, const MultidimensionalArray<T, S>& aArray)
+{
+	Array lArray = MappedStorage<T>::createArray(aPath, aArray.getNumberOfDimensions(), aArray.getNumberOfElementsOfAllDimensions());
+	std::copy(aArray.data(), aArray.data() + aArray.getTotalNumberOfElements(), lArray.data());
+}
+
+/** Returns a pointer to the first element
+*/
+template<typename T>
+T* MappedStorage<T>::data()
+{
+	return this->m_Elements;
+}
+
+/** Returns a pointer to the first element
+*/
+template<typename T>
+const T* MappedStorage<T>::data() const
+{
+	return this->m_Elements;
+}
+
+/** Returns the number of elements
+*/
+template<typename T>
+std::size_t MappedStorage<T>::size() const
+{
+	return this->m_Size;
+}
+
+/** Returns true if there are no elements
+*/
+template<typename T>
+bool MappedStorage<T>::empty() const
+{
+	return this->m_Size == 0;
+}
+
+/** Returns the element at a position
+*/
+template<typename T>
+T& MappedStorage<T>::operator[](const std::size_t aPosition)
+{
+	return this->m_Elements[aPosition];
+}
+
+/** Returns the element at a position
+*/
+template<typename T>
+const T& MappedStorage<T>::operator[](const std::size_t aPosition) const
+{
+	return this->m_Elements[aPosition];
+}
+
+/** Unmaps the file
+*/
+template<typename T>
+void MappedStorage<T>::clear()
+{
+	this->m_File.close();
+	this->m_Elements = nullptr;
+	this->m_Size = 0;
+}
+
+/** Sets every element to a value. The number of elements can not change.
+* @param aCount The number of elements
+* @param aValue The value
+*/
+template<typename T>
+void MappedStorage<T>::assign(const std::size_t aCount, const T& aValue)
+{
+	if (aCount != this->m_Size) throw MappedStorage::RESIZE_EXCEPTION;
+
+	std::fill(this->m_Elements, this->m_Elements + this->m_Size, aValue);
+}
+
+/** Copies elements into the storage. The number of elements can not change.
+* @param aFirst The first element to copy
+* @param aLast One past the last element to copy
+*/
+template<typename T>
+template<typename Iterator>
+void MappedStorage<T>::assign(Iterator aFirst, Iterator aLast)
+{
+	if (static_cast<std::size_t>(std::distance(aFirst, aLast)) != this->m_Size) throw MappedStorage::RESIZE_EXCEPTION;
+
+	std::copy(aFirst, aLast, this->m_Elements);
+}
+
+/** Writes the changed pages to the file now instead of whenever the operating system decides to
+*/
+template<typename T>
+void MappedStorage<T>::flush()
+{
+	this->m_File.flush();
+}
+
+#endif
@@ -7,41 +7,135 @@
 #define MULTIDIMENSIONALARRAY_H
 
 #include "DebugLogger.h"
+#include "ArrayView.h"
+#include "ArrayExpression.h"
+#include "ArrayStorage.h"
+#include "LinearAlgebra.h"
+#include "ExecutionPolicy.h"
 #include <vector>
 #include <utility> //std::move
+#include <algorithm> // std::copy
 
 #pragma unmanaged
 
-template<typename T>
-class MultidimensionalArray
+/** An array with any number of dimensions. The elements are stored with the last dimension changing fastest in a
+*   Storage (see ArrayStorage.h); by default 64 byte aligned memory.
+*   Element-wise arithmetic on arrays (+ - * /, scalars, exp, log, rowBroadcast, columnBroadcast) is lazy, see ArrayExpression.h.
+*   The bulk operations (fill, transform, reduce, assign, the reductions and the copy constructor) take an optional
+*   ExecutionPolicy to run on every core. Contractions over several arrays (Einstein summation) are in Einsum.h.
+*/
+template<typename T, typename Storage>
+class MultidimensionalArray : public ArrayExpression<MultidimensionalArray<T, Storage>>
 {
 private:
-	std::vector<T> m_Elements;
+	Storage m_Elements;
 	unsigned m_NumberOfDimensions;
-	std::vector<unsigned long> m_DimLengths;
-	unsigned m_TotalNumberOfElements;
+	InlineStorage<std::size_t, 4> m_DimLengths; // no allocation for up to 4 dimensions
+	std::size_t m_TotalNumberOfElements;
+
+	std::size_t calculateElementPosition(const std::vector<std::size_t>& aCoordinates) const;
+	std::size_t calculateStride(const std::size_t aDimension) const;
+	std::size_t calculateRowPosition(const std::vector<std::size_t>& aCoordinatesOfRow) const;
+	std::size_t calculateRowPosition(const std::size_t aRow) const;
+	std::size_t calculateMatrixPosition(const std::size_t aRow, const std::size_t aColumn, const std::size_t aDimension) const;
+	void calculateReductionLengths(const std::size_t aDimension, std::size_t& aOuter, std::size_t& aLength, std::size_t& aInner) const;
+
+	template<typename Reduction>
+	MultidimensionalArray<T> reduceDimension(const std::size_t aDimension, const ExecutionPolicy& aPolicy) const;
+	template<typename Reduction>
+	static T reduceElements(const T* const aData, const std::size_t aLength, const ExecutionPolicy& aPolicy);
 
-	unsigned calculateElementPosition(const std::vector<unsigned long> aCoordinates) const;
+	struct SumReduction
+	{
+		static T reduce(const T* const aData, const std::size_t aLength) { return LinearAlgebra::Sum(aData, aLength); }
+		static void accumulate(const T* const aData, T* const aResult, const std::size_t aLength) { LinearAlgebra::AddTo(aData, aResult, aLength); }
+	};
+	struct MinimumReduction
+	{
+		static T reduce(const T* const aData, const std::size_t aLength) { return LinearAlgebra::Min(aData, aLength); }
+		static void accumulate(const T* const aData, T* const aResult, const std::size_t aLength) { LinearAlgebra::MinTo(aData, aResult, aLength); }
+	};
+	struct MaximumReduction
+	{
+		static T reduce(const T* const aData, const std::size_t aLength) { return LinearAlgebra::Max(aData, aLength); }
+		static void accumulate(const T* const aData, T* const aResult, const std::size_t aLength) { LinearAlgebra::MaxTo(aData, aResult, aLength); }
+	};
 
 public:
+	typedef T value_type;
+
 	MultidimensionalArray();
-	MultidimensionalArray(const unsigned long aNumberOfDimensions, std::vector<unsigned long> aNumberOfElementsOfAllDimensions, const std::vector<T> aElements);
-	MultidimensionalArray(const unsigned long aNumberOfDimensions, const std::vector<unsigned long>  aNumberOfElementsOfAllDimensions);
+	MultidimensionalArray(const std::size_t aNumberOfDimensions, const std::vector<std::size_t>& aNumberOfElementsOfAllDimensions, const std::vector<T>& aElements);
+	MultidimensionalArray(const std::size_t aNumberOfDimensions, const std::vector<std::size_t>& aNumberOfElementsOfAllDimensions);
 
-	MultidimensionalArray(const MultidimensionalArray<T>& aCopy);
-	MultidimensionalArray(MultidimensionalArray<T>&& aMove);
+	MultidimensionalArray(Storage&& aStorage, const std::size_t aNumberOfDimensions, const std::vector<std::size_t>& aNumberOfElementsOfAllDimensions);
+
+	MultidimensionalArray(const MultidimensionalArray& aCopy);
+	MultidimensionalArray(const MultidimensionalArray& aCopy, const ExecutionPolicy& aPolicy);
+	MultidimensionalArray(MultidimensionalArray&& aMove);
+	template<typename E>
+	MultidimensionalArray(const ArrayExpression<E>& aExpression);
 	~MultidimensionalArray() = default;
 
-	T getElement(const std::vector<unsigned long> aCoordinates) const;
-	unsigned long getTotalNumberOfElements() const;
-	unsigned long getNumberOfElementsOfDimension(const unsigned long aDimension) const;
-	std::vector<unsigned long> getNumberOfElementsOfAllDimensions() const;
-	std::vector<T> getRow(const std::vector<unsigned long> aCoordinatesOfRow) const;
+	T getElement(const std::vector<std::size_t>& aCoordinates) const;
+	std::size_t getTotalNumberOfElements() const;
+	std::size_t getNumberOfDimensions() const;
+	std::size_t getNumberOfElementsOfDimension(const std::size_t aDimension) const;
+	std::vector<std::size_t> getNumberOfElementsOfAllDimensions() const;
+	std::vector<T> getRow(const std::vector<std::size_t>& aCoordinatesOfRow) const;
+	T* data();
+	const T* data() const;
+	Storage& getStorage();
+	T evaluate(const std::size_t aPosition) const;
+
+	ArrayView<T> rowView(const std::vector<std::size_t>& aCoordinatesOfRow);
+	ArrayView<const T> rowView(const std::vector<std::size_t>& aCoordinatesOfRow) const;
+	ArrayView<T> rowView(const std::size_t aRow);
+	ArrayView<const T> rowView(const std::size_t aRow) const;
+	ArrayView<T> sliceView(const std::vector<std::size_t>& aCoordinates, const std::size_t aDimension);
+	ArrayView<const T> sliceView(const std::vector<std::size_t>& aCoordinates, const std::size_t aDimension) const;
+	ArrayView<T> sliceView(const std::size_t aRow, const std::size_t aColumn, const std::size_t aDimension);
+	ArrayView<const T> sliceView(const std::size_t aRow, const std::size_t aColumn, const std::size_t aDimension) const;
+	ArrayBlockView<T> blockView(const std::vector<std::size_t>& aCoordinates, const std::size_t aNumberOfRows, const std::size_t aNumberOfColumns);
+	ArrayBlockView<const T> blockView(const std::vector<std::size_t>& aCoordinates, const std::size_t aNumberOfRows, const std::size_t aNumberOfColumns) const;
+
+	T sum(const ExecutionPolicy& aPolicy = ExecutionPolicy()) const;
+	T minimum(const ExecutionPolicy& aPolicy = ExecutionPolicy()) const;
+	T maximum(const ExecutionPolicy& aPolicy = ExecutionPolicy()) const;
+	template<typename Function>
+	T reduce(const T aIdentity, Function aCombine, const ExecutionPolicy& aPolicy = ExecutionPolicy()) const;
+	MultidimensionalArray<T> sum(const std::size_t aDimension, const ExecutionPolicy& aPolicy = ExecutionPolicy()) const;
+	MultidimensionalArray<T> minimum(const std::size_t aDimension, const ExecutionPolicy& aPolicy = ExecutionPolicy()) const;
+	MultidimensionalArray<T> maximum(const std::size_t aDimension, const ExecutionPolicy& aPolicy = ExecutionPolicy()) const;
+	MultidimensionalArray<std::size_t> argmax(const std::size_t aDimension) const;
+	template<typename S>
+	MultidimensionalArray<T> dot(const MultidimensionalArray<T, S>& aRight, const std::size_t aDimension) const;
+	void normalize(const std::size_t aDimension, const ExecutionPolicy& aPolicy = ExecutionPolicy());
 
-	void setElement(const std::vector<unsigned long> aCoordinates, const T aValue);
-	void setRow(const std::vector<unsigned long> aCoordinatesOfRow, const std::vector<T> aValues);
+	void setElement(const std::vector<std::size_t>& aCoordinates, const T aValue);
+	void setRow(const std::vector<std::size_t>& aCoordinatesOfRow, const std::vector<T>& aValues);
+	void fill(const T aValue, const ExecutionPolicy& aPolicy = ExecutionPolicy());
+	template<typename Function>
+	void transform(Function aFunction, const ExecutionPolicy& aPolicy = ExecutionPolicy());
+	template<typename E>
+	MultidimensionalArray& assign(const ArrayExpression<E>& aExpression, const ExecutionPolicy& aPolicy);
 
-	MultidimensionalArray<T>& operator=(const MultidimensionalArray<T>& aRight);
+	MultidimensionalArray& operator=(const MultidimensionalArray& aRight);
+	MultidimensionalArray& operator=(MultidimensionalArray&& aRight);
+	template<typename E>
+	MultidimensionalArray& operator=(const ArrayExpression<E>& aRight);
+	template<typename E>
+	MultidimensionalArray& operator+=(const ArrayExpression<E>& aRight);
+	template<typename E>
+	MultidimensionalArray& operator-=(const ArrayExpression<E>& aRight);
+	template<typename E>
+	MultidimensionalArray& operator*=(const ArrayExpression<E>& aRight);
+	template<typename E>
+	MultidimensionalArray& operator/=(const ArrayExpression<E>& aRight);
+	MultidimensionalArray& operator+=(const T aRight);
+	MultidimensionalArray& operator-=(const T aRight);
+	MultidimensionalArray& operator*=(const T aRight);
+	MultidimensionalArray& operator/=(const T aRight);
 
 	enum Exeception
 	{
@@ -52,12 +146,12 @@ public:
 
 /** Default constructor for MultidimensionalArray
 */
-template<typename T>
-MultidimensionalArray<T>::MultidimensionalArray()
+template<typename T, typename Storage>
+MultidimensionalArray<T, Storage>::MultidimensionalArray()
 {
-	this->m_Elements = std::vector<T>();
+	this->m_Elements.clear();
 	this->m_NumberOfDimensions = 0;
-	this->m_DimLengths = std::vector<unsigned long>();
+	this->m_DimLengths.clear();
 	this->m_TotalNumberOfElements = 0;
 }
 
@@ -66,45 +160,66 @@ MultidimensionalArray<T>::MultidimensionalArray()
 * @param aNumberOfElementsForDimensions An array of the lengths for each dimension
 * @param aElements All the elements of the multidimensional array
 */
-template<typename T>
-MultidimensionalArray<T>::MultidimensionalArray(const unsigned long aNumberOfDimensions, std::vector<unsigned long> aNumberOfElementsOfAllDimensions, const std::vector<T> aElements)
+template<typename T, typename Storage>
+MultidimensionalArray<T, Storage>::MultidimensionalArray(const std::size_t aNumberOfDimensions, const std::vector<std::size_t>& aNumberOfElementsOfAllDimensions, const std::vector<T>& aElements)
 {
 	this->m_TotalNumberOfElements = 1;
-	for (unsigned long lCountDim = 0; lCountDim < aNumberOfDimensions; lCountDim++)
+	for (std::size_t lCountDim = 0; lCountDim < aNumberOfDimensions; lCountDim++)
 	{
 		this->m_TotalNumberOfElements = m_TotalNumberOfElements * aNumberOfElementsOfAllDimensions[lCountDim];
 	}
 
 	if (this->m_TotalNumberOfElements != aElements.size()) throw MultidimensionalArray::CONSTRUCTOR_EXCEPTION;
 
-	this->m_Elements = aElements;
+	this->m_Elements.assign(aElements.begin(), aElements.end());
 	this->m_NumberOfDimensions = aNumberOfDimensions;
-	this->m_DimLengths = aNumberOfElementsOfAllDimensions;
+	this->m_DimLengths.assign(aNumberOfElementsOfAllDimensions.begin(), aNumberOfElementsOfAllDimensions.end());
 }
 
 /** Constructor for MultidimensionalArray
 * @param aNumberOfDimensions The number of dimensions
 * @param aNumberOfElementsForDimensions An array of the lengths for each dimension
 */
-template<typename T>
-MultidimensionalArray<T>::MultidimensionalArray(const unsigned long aNumberOfDimensions, std::vector<unsigned long> aNumberOfElementsOfAllDimensions)
+template<typename T, typename Storage>
+MultidimensionalArray<T, Storage>::MultidimensionalArray(const std::size_t aNumberOfDimensions, const std::vector<std::size_t>& aNumberOfElementsOfAllDimensions)
+{
+	this->m_TotalNumberOfElements = 1;
+	for (std::size_t lCountDim = 0; lCountDim < aNumberOfDimensions; lCountDim++)
+	{
+		this->m_TotalNumberOfElements = m_TotalNumberOfElements * aNumberOfElementsOfAllDimensions[lCountDim];
+	}
+
+	this->m_Elements.assign(this->m_TotalNumberOfElements, T());
+	this->m_NumberOfDimensions = aNumberOfDimensions;
+	this->m_DimLengths.assign(aNumberOfElementsOfAllDimensions.begin(), aNumberOfElementsOfAllDimensions.end());
+}
+
+/** Constructor for MultidimensionalArray that takes ownership of storage that already holds the elements (e.g. a MappedStorage)
+* @param aStorage The storage with all the elements of the multidimensional array
+* @param aNumberOfDimensions The number of dimensions
+* @param aNumberOfElementsForDimensions An array of the lengths for each dimension
+*/
+template<typename T, typename Storage>
+MultidimensionalArray<T, Storage>::MultidimensionalArray(Storage&& aStorage, const std::size_t aNumberOfDimensions, const std::vector<std::size_t>& aNumberOfElementsOfAllDimensions)
+	: m_Elements(std::move(aStorage))
 {
 	this->m_TotalNumberOfElements = 1;
-	for (unsigned long lCountDim = 0; lCountDim < aNumberOfDimensions; lCountDim++)
+	for (std::size_t lCountDim = 0; lCountDim < aNumberOfDimensions; lCountDim++)
 	{
 		this->m_TotalNumberOfElements = m_TotalNumberOfElements * aNumberOfElementsOfAllDimensions[lCountDim];
 	}
 
-	this->m_Elements = std::vector<T>(this->m_TotalNumberOfElements);
+	if (this->m_TotalNumberOfElements != this->m_Elements.size()) throw MultidimensionalArray::CONSTRUCTOR_EXCEPTION;
+
 	this->m_NumberOfDimensions = aNumberOfDimensions;
-	this->m_DimLengths = aNumberOfElementsOfAllDimensions;
+	this->m_DimLengths.assign(aNumberOfElementsOfAllDimensions.begin(), aNumberOfElementsOfAllDimensions.end());
 }
 
 /** Copy Constructor for MultidimensionalArray
 * @param aCopy The object to copy
 */
-template<typename T>
-MultidimensionalArray<T>::MultidimensionalArray(const MultidimensionalArray<T>& aCopy)
+template<typename T, typename Storage>
+MultidimensionalArray<T, Storage>::MultidimensionalArray(const MultidimensionalArray& aCopy)
 {
 	this->m_Elements = aCopy.m_Elements;
 	this->m_NumberOfDimensions = aCopy.m_NumberOfDimensions;
@@ -112,11 +227,31 @@ MultidimensionalArray<T>::MultidimensionalArray(const MultidimensionalArray<T>&
 	this->m_TotalNumberOfElements = aCopy.m_TotalNumberOfElements;
 }
 
-/** Move Constructor for MultidimensionalArray
+/** Copy Constructor for MultidimensionalArray that copies the elements with an execution policy
 * @param aCopy The object to copy
+* @param aPolicy The execution policy
 */
-template<typename T>
-MultidimensionalArray<T>::MultidimensionalArray(MultidimensionalArray&& aMove)
+template<typename T, typename Storage>
+MultidimensionalArray<T, Storage>::MultidimensionalArray(const MultidimensionalArray& aCopy, const ExecutionPolicy& aPolicy)
+{
+	this->m_NumberOfDimensions = aCopy.m_NumberOfDimensions;
+	this->m_DimLengths = aCopy.m_DimLengths;
+	this->m_TotalNumberOfElements = aCopy.m_TotalNumberOfElements;
+	this->m_Elements.assign(this->m_TotalNumberOfElements, T());
+
+	const T* const lSource = aCopy.m_Elements.data();
+	T* const lDestination = this->m_Elements.data();
+	aPolicy.forEachBlock(this->m_TotalNumberOfElements, [lSource, lDestination](const std::size_t, const std::size_t aBegin, const std::size_t aEnd)
+	{
+		std::copy(lSource + aBegin, lSource + aEnd, lDestination + aBegin);
+	});
+}
+
+/** Move Constructor for MultidimensionalArray
+* @param aMove The object to move from
+*/
+template<typename T, typename Storage>
+MultidimensionalArray<T, Storage>::MultidimensionalArray(MultidimensionalArray&& aMove)
 {
 	this->m_Elements = std::move(aMove.m_Elements);
 	this->m_NumberOfDimensions = std::move(aMove.m_NumberOfDimensions);
@@ -129,16 +264,35 @@ MultidimensionalArray<T>::MultidimensionalArray(MultidimensionalArray&& aMove)
 	aMove.m_DimLengths.clear();
 }
 
+/** Constructor for MultidimensionalArray that calculates every element of an expression
+* @param aExpression The expression
+*/
+template<typename T, typename Storage>
+template<typename E>
+MultidimensionalArray<T, Storage>::MultidimensionalArray(const ArrayExpression<E>& aExpression)
+{
+	const E& lExpression = aExpression.derived();
+	this->m_NumberOfDimensions = lExpression.getNumberOfDimensions();
+	this->m_DimLengths.assign(this->m_NumberOfDimensions, 0);
+	for (std::size_t lCount = 0; lCount < this->m_NumberOfDimensions; lCount++)
+	{
+		this->m_DimLengths[lCount] = lExpression.getNumberOfElementsOfDimension(lCount);
+	}
+	this->m_TotalNumberOfElements = lExpression.getTotalNumberOfElements();
+	this->m_Elements.assign(this->m_TotalNumberOfElements, T());
+	evaluateExpression<ExpressionAssign>(this->m_Elements.data(), lExpression);
+}
+
 /** Returns the element located at the specified coordinates
 * @param aCoordinates The coordinates for the element
 * @return The element
 */
-template<typename T>
-T MultidimensionalArray<T>::getElement(const std::vector<unsigned long> aCoordinates) const
+template<typename T, typename Storage>
+T MultidimensionalArray<T, Storage>::getElement(const std::vector<std::size_t>& aCoordinates) const
 {
 	if (aCoordinates.size()!= this->m_NumberOfDimensions) throw MultidimensionalArray::DIMENSIONS_DONT_MATCH;
 
-	unsigned long lElementPosition = this->calculateElementPosition(aCoordinates);
+	std::size_t lElementPosition = this->calculateElementPosition(aCoordinates);
 
 	return this->m_Elements[lElementPosition];
 }
@@ -146,17 +300,25 @@ T MultidimensionalArray<T>::getElement(const std::vector<unsigned long> aCoordin
 /** Returns the total number of elements of the array
 * @return The total number of elements
 */
-template<typename T>
-unsigned long MultidimensionalArray<T>::getTotalNumberOfElements() const
+template<typename T, typename Storage>
+std::size_t MultidimensionalArray<T, Storage>::getTotalNumberOfElements() const
 {
 	return this->m_TotalNumberOfElements;
 }
 
+/** Returns the number of dimensions of the array
+*/
+template<typename T, typename Storage>
+std::size_t MultidimensionalArray<T, Storage>::getNumberOfDimensions() const
+{
+	return this->m_NumberOfDimensions;
+}
+
 /** Returns the total number of elements of the array
 * @return The total number of elements
 */
-template<typename T>
-unsigned long MultidimensionalArray<T>::getNumberOfElementsOfDimension(const unsigned long aDimension) const
+template<typename T, typename Storage>
+std::size_t MultidimensionalArray<T, Storage>::getNumberOfElementsOfDimension(const std::size_t aDimension) const
 {
 	if (aDimension > this->m_NumberOfDimensions) throw MultidimensionalArray::DIMENSIONS_DONT_MATCH;
 
@@ -166,49 +328,399 @@ unsigned long MultidimensionalArray<T>::getNumberOfElementsOfDimension(const uns
 /** Returns the lengths of all the dimensions
 * @return All the dimension lengths
 */
-template<typename T>
-std::vector<unsigned long> MultidimensionalArray<T>::getNumberOfElementsOfAllDimensions() const
+template<typename T, typename Storage>
+std::vector<std::size_t> MultidimensionalArray<T, Storage>::getNumberOfElementsOfAllDimensions() const
 {
-	return this->m_DimLengths;
+	return std::vector<std::size_t>(this->m_DimLengths.begin(), this->m_DimLengths.end());
 }
 
 /** Returns the all the values for a given row
 * @return The elements of a given row
 */
-template<typename T>
-std::vector<T> MultidimensionalArray<T>::getRow(const std::vector<unsigned long> aCoordinatesOfRow) const
+template<typename T, typename Storage>
+std::vector<T> MultidimensionalArray<T, Storage>::getRow(const std::vector<std::size_t>& aCoordinatesOfRow) const
 {
-	// The length of aCoordinatesOfRow must equal the total number of dimensions - 1
-	if (aCoordinatesOfRow.size() != this->m_NumberOfDimensions - 1) throw MultidimensionalArray::DIMENSIONS_DONT_MATCH;
+	return this->rowView(aCoordinatesOfRow).toVector();
+}
+
+/** Returns a pointer to the first element (elements are stored with the last dimension changing fastest)
+*/
+template<typename T, typename Storage>
+T* MultidimensionalArray<T, Storage>::data()
+{
+	return this->m_Elements.data();
+}
+
+/** Returns a pointer to the first element (elements are stored with the last dimension changing fastest)
+*/
+template<typename T, typename Storage>
+const T* MultidimensionalArray<T, Storage>::data() const
+{
+	return this->m_Elements.data();
+}
+
+/** Returns the storage of the elements (e.g. to flush a MappedStorage)
+*/
+template<typename T, typename Storage>
+Storage& MultidimensionalArray<T, Storage>::getStorage()
+{
+	return this->m_Elements;
+}
+
+/** Returns the element at a position in memory (used when the array is part of an expression)
+* @param aPosition The position of the element
+*/
+template<typename T, typename Storage>
+T MultidimensionalArray<T, Storage>::evaluate(const std::size_t aPosition) const
+{
+	return this->m_Elements[aPosition];
+}
+
+/** Returns a view of a row (the elements along the last dimension) that reads and writes this array's elements
+* @param aCoordinatesOfRow The coordinates of the row (one for each dimension except the last)
+*/
+template<typename T, typename Storage>
+ArrayView<T> MultidimensionalArray<T, Storage>::rowView(const std::vector<std::size_t>& aCoordinatesOfRow)
+{
+	return ArrayView<T>(this->m_Elements.data() + this->calculateRowPosition(aCoordinatesOfRow), this->m_DimLengths[this->m_NumberOfDimensions - 1]);
+}
+
+/** Returns a read only view of a row (the elements along the last dimension)
+* @param aCoordinatesOfRow The coordinates of the row (one for each dimension except the last)
+*/
+template<typename T, typename Storage>
+ArrayView<const T> MultidimensionalArray<T, Storage>::rowView(const std::vector<std::size_t>& aCoordinatesOfRow) const
+{
+	return ArrayView<const T>(this->m_Elements.data() + this->calculateRowPosition(aCoordinatesOfRow), this->m_DimLengths[this->m_NumberOfDimensions - 1]);
+}
+
+/** Returns a view of a row (the elements along the last dimension) without building a coordinate vector. The rows are
+*   counted in memory order, so for a matrix it is the row with index aRow.
+* @param aRow The index of the row
+*/
+template<typename T, typename Storage>
+ArrayView<T> MultidimensionalArray<T, Storage>::rowView(const std::size_t aRow)
+{
+	const std::size_t lPosition = this->calculateRowPosition(aRow);
+	return ArrayView<T>(this->m_Elements.data() + lPosition, this->m_DimLengths[this->m_NumberOfDimensions - 1]);
+}
+
+/** Returns a read only view of a row (the elements along the last dimension) without building a coordinate vector
+* @param aRow The index of the row (counted in memory order)
+*/
+template<typename T, typename Storage>
+ArrayView<const T> MultidimensionalArray<T, Storage>::rowView(const std::size_t aRow) const
+{
+	const std::size_t lPosition = this->calculateRowPosition(aRow);
+	return ArrayView<const T>(this->m_Elements.data() + lPosition, this->m_DimLengths[this->m_NumberOfDimensions - 1]);
+}
+
+/** Returns a view of the elements along any dimension (e.g. a column of a matrix when aDimension = 0)
+* @param aCoordinates The coordinates of the first element of the view
+* @param aDimension The dimension the view runs along. The view ends at the last element of the dimension.
+*/
+template<typename T, typename Storage>
+ArrayView<T> MultidimensionalArray<T, Storage>::sliceView(const std::vector<std::size_t>& aCoordinates, const std::size_t aDimension)
+{
+	if (aCoordinates.size() != this->m_NumberOfDimensions || aDimension >= this->m_NumberOfDimensions) throw MultidimensionalArray::DIMENSIONS_DONT_MATCH;
+	if (aCoordinates[aDimension] >= this->m_DimLengths[aDimension]) throw MultidimensionalArray::DIMENSIONS_DONT_MATCH;
+
+	return ArrayView<T>(this->m_Elements.data() + this->calculateElementPosition(aCoordinates), this->m_DimLengths[aDimension] - aCoordinates[aDimension], this->calculateStride(aDimension));
+}
+
+/** Returns a read only view of the elements along any dimension (e.g. a column of a matrix when aDimension = 0)
+* @param aCoordinates The coordinates of the first element of the view
+* @param aDimension The dimension the view runs along. The view ends at the last element of the dimension.
+*/
+template<typename T, typename Storage>
+ArrayView<const T> MultidimensionalArray<T, Storage>::sliceView(const std::vector<std::size_t>& aCoordinates, const std::size_t aDimension) const
+{
+	if (aCoordinates.size() != this->m_NumberOfDimensions || aDimension >= this->m_NumberOfDimensions) throw MultidimensionalArray::DIMENSIONS_DONT_MATCH;
+	if (aCoordinates[aDimension] >= this->m_DimLengths[aDimension]) throw MultidimensionalArray::DIMENSIONS_DONT_MATCH;
+
+	return ArrayView<const T>(this->m_Elements.data() + this->calculateElementPosition(aCoordinates), this->m_DimLengths[aDimension] - aCoordinates[aDimension], this->calculateStride(aDimension));
+}
+
+/** Returns a view of the elements of a matrix along a dimension without building a coordinate vector (the same as
+*   sliceView({ aRow, aColumn }, aDimension))
+* @param aRow The row of the first element of the view
+* @param aColumn The column of the first element of the view
+* @param aDimension The dimension the view runs along (0 down a column, 1 along a row)
+*/
+template<typename T, typename Storage>
+ArrayView<T> MultidimensionalArray<T, Storage>::sliceView(const std::size_t aRow, const std::size_t aColumn, const std::size_t aDimension)
+{
+	const std::size_t lPosition = this->calculateMatrixPosition(aRow, aColumn, aDimension);
+	const std::size_t lStart = (aDimension == 0) ? aRow : aColumn;
+	return ArrayView<T>(this->m_Elements.data() + lPosition, this->m_DimLengths[aDimension] - lStart, this->calculateStride(aDimension));
+}
+
+/** Returns a read only view of the elements of a matrix along a dimension without building a coordinate vector
+* @param aRow The row of the first element of the view
+* @param aColumn The column of the first element of the view
+* @param aDimension The dimension the view runs along (0 down a column, 1 along a row)
+*/
+template<typename T, typename Storage>
+ArrayView<const T> MultidimensionalArray<T, Storage>::sliceView(const std::size_t aRow, const std::size_t aColumn, const std::size_t aDimension) const
+{
+	const std::size_t lPosition = this->calculateMatrixPosition(aRow, aColumn, aDimension);
+	const std::size_t lStart = (aDimension == 0) ? aRow : aColumn;
+	return ArrayView<const T>(this->m_Elements.data() + lPosition, this->m_DimLengths[aDimension] - lStart, this->calculateStride(aDimension));
+}
+
+/** Returns a view of a block of the last two dimensions (a sub-matrix)
+* @param aCoordinates The coordinates of the top left element of the block
+* @param aNumberOfRows The number of rows (elements along the second to last dimension) in the block
+* @param aNumberOfColumns The number of columns (elements along the last dimension) in the block
+*/
+template<typename T, typename Storage>
+ArrayBlockView<T> MultidimensionalArray<T, Storage>::blockView(const std::vector<std::size_t>& aCoordinates, const std::size_t aNumberOfRows, const std::size_t aNumberOfColumns)
+{
+	if (this->m_NumberOfDimensions < 2 || aCoordinates.size() != this->m_NumberOfDimensions) throw MultidimensionalArray::DIMENSIONS_DONT_MATCH;
+	if (aCoordinates[this->m_NumberOfDimensions - 2] + aNumberOfRows > this->m_DimLengths[this->m_NumberOfDimensions - 2]) throw MultidimensionalArray::DIMENSIONS_DONT_MATCH;
+	if (aCoordinates[this->m_NumberOfDimensions - 1] + aNumberOfColumns > this->m_DimLengths[this->m_NumberOfDimensions - 1]) throw MultidimensionalArray::DIMENSIONS_DONT_MATCH;
+
+	return ArrayBlockView<T>(this->m_Elements.data() + this->calculateElementPosition(aCoordinates), aNumberOfRows, aNumberOfColumns, this->m_DimLengths[this->m_NumberOfDimensions - 1]);
+}
+
+/** Returns a read only view of a block of the last two dimensions (a sub-matrix)
+* @param aCoordinates The coordinates of the top left element of the block
+* @param aNumberOfRows The number of rows (elements along the second to last dimension) in the block
+* @param aNumberOfColumns The number of columns (elements along the last dimension) in the block
+*/
+template<typename T, typename Storage>
+ArrayBlockView<const T> MultidimensionalArray<T, Storage>::blockView(const std::vector<std::size_t>& aCoordinates, const std::size_t aNumberOfRows, const std::size_t aNumberOfColumns) const
+{
+	if (this->m_NumberOfDimensions < 2 || aCoordinates.size() != this->m_NumberOfDimensions) throw MultidimensionalArray::DIMENSIONS_DONT_MATCH;
+	if (aCoordinates[this->m_NumberOfDimensions - 2] + aNumberOfRows > this->m_DimLengths[this->m_NumberOfDimensions - 2]) throw MultidimensionalArray::DIMENSIONS_DONT_MATCH;
+	if (aCoordinates[this->m_NumberOfDimensions - 1] + aNumberOfColumns > this->m_DimLengths[this->m_NumberOfDimensions - 1]) throw MultidimensionalArray::DIMENSIONS_DONT_MATCH;
+
+	return ArrayBlockView<const T>(this->m_Elements.data() + this->calculateElementPosition(aCoordinates), aNumberOfRows, aNumberOfColumns, this->m_DimLengths[this->m_NumberOfDimensions - 1]);
+}
+
+/** Returns the sum of all the elements
+* @param aPolicy The execution policy
+*/
+template<typename T, typename Storage>
+T MultidimensionalArray<T, Storage>::sum(const ExecutionPolicy& aPolicy) const
+{
+	return reduceElements<SumReduction>(this->m_Elements.data(), this->m_Elements.size(), aPolicy);
+}
+
+/** Returns the smallest element
+* @param aPolicy The execution policy
+*/
+template<typename T, typename Storage>
+T MultidimensionalArray<T, Storage>::minimum(const ExecutionPolicy& aPolicy) const
+{
+	if (this->m_Elements.empty()) throw MultidimensionalArray::DIMENSIONS_DONT_MATCH;
+
+	return reduceElements<MinimumReduction>(this->m_Elements.data(), this->m_Elements.size(), aPolicy);
+}
+
+/** Returns the largest element
+* @param aPolicy The execution policy
+*/
+template<typename T, typename Storage>
+T MultidimensionalArray<T, Storage>::maximum(const ExecutionPolicy& aPolicy) const
+{
+	if (this->m_Elements.empty()) throw MultidimensionalArray::DIMENSIONS_DONT_MATCH;
+
+	return reduceElements<MaximumReduction>(this->m_Elements.data(), this->m_Elements.size(), aPolicy);
+}
+
+/** Combines all the elements with a function, e.g. reduce(1.0, std::multiplies<double>()) for the product.
+* In parallel each block is combined separately and then the results of the blocks, so aCombine must be associative
+* and aIdentity must not change a value it is combined with.
+* @param aIdentity The result for an array with no elements
+* @param aCombine A function (T, T) -> T
+* @param aPolicy The execution policy
+*/
+template<typename T, typename Storage>
+template<typename Function>
+T MultidimensionalArray<T, Storage>::reduce(const T aIdentity, Function aCombine, const ExecutionPolicy& aPolicy) const
+{
+	const T* const lData = this->m_Elements.data();
+	std::vector<T> lPartials(aPolicy.calculateNumberOfBlocks(this->m_Elements.size()), aIdentity);
+	aPolicy.forEachBlock(this->m_Elements.size(), [lData, &lPartials, &aCombine](const std::size_t aBlock, const std::size_t aBegin, const std::size_t aEnd)
+	{
+		T lResult = lPartials[aBlock];
+		for (std::size_t lCount = aBegin; lCount < aEnd; lCount++)
+		{
+			lResult = aCombine(lResult, lData[lCount]);
+		}
+		lPartials[aBlock] = lResult;
+	});
+
+	T lResult = aIdentity;
+	for (std::size_t lCount = 0; lCount < lPartials.size(); lCount++)
+	{
+		lResult = aCombine(lResult, lPartials[lCount]);
+	}
+	return lResult;
+}
+
+/** Returns the sums along a dimension (e.g. the row sums of a matrix when aDimension = 1)
+* @param aDimension The dimension to sum along
+* @param aPolicy The execution policy
+* @return An array with the same dimensions except aDimension has a length of 1
+*/
+template<typename T, typename Storage>
+MultidimensionalArray<T> MultidimensionalArray<T, Storage>::sum(const std::size_t aDimension, const ExecutionPolicy& aPolicy) const
+{
+	return this->reduceDimension<SumReduction>(aDimension, aPolicy);
+}
+
+/** Returns the smallest elements along a dimension
+* @param aDimension The dimension to search along
+* @param aPolicy The execution policy
+* @return An array with the same dimensions except aDimension has a length of 1
+*/
+template<typename T, typename Storage>
+MultidimensionalArray<T> MultidimensionalArray<T, Storage>::minimum(const std::size_t aDimension, const ExecutionPolicy& aPolicy) const
+{
+	return this->reduceDimension<MinimumReduction>(aDimension, aPolicy);
+}
+
+/** Returns the largest elements along a dimension
+* @param aDimension The dimension to search along
+* @param aPolicy The execution policy
+* @return An array with the same dimensions except aDimension has a length of 1
+*/
+template<typename T, typename Storage>
+MultidimensionalArray<T> MultidimensionalArray<T, Storage>::maximum(const std::size_t aDimension, const ExecutionPolicy& aPolicy) const
+{
+	return this->reduceDimension<MaximumReduction>(aDimension, aPolicy);
+}
+
+/** Returns the index of the largest element along a dimension (the first one if there is a tie)
+* @param aDimension The dimension to search along
+* @return An array with the same dimensions except aDimension has a length of 1
+*/
+template<typename T, typename Storage>
+MultidimensionalArray<std::size_t> MultidimensionalArray<T, Storage>::argmax(const std::size_t aDimension) const
+{
+	std::size_t lOuter, lLength, lInner;
+	this->calculateReductionLengths(aDimension, lOuter, lLength, lInner);
+
+	std::vector<std::size_t> lDimLengths(this->m_DimLengths.begin(), this->m_DimLengths.end());
+	lDimLengths[aDimension] = 1;
+	MultidimensionalArray<std::size_t> lResult(this->m_NumberOfDimensions, lDimLengths);
+
+	std::vector<T> lBest(lInner);
+	for (std::size_t lCountO = 0; lCountO < lOuter; lCountO++)
+	{
+		const T* const lSource = this->m_Elements.data() + lCountO * lLength * lInner;
+		std::size_t* const lDestination = lResult.data() + lCountO * lInner;
+		if (lInner == 1)
+		{
+			lDestination[0] = LinearAlgebra::ArgMax(lSource, lLength);
+			continue;
+		}
+
+		std::copy(lSource, lSource + lInner, lBest.begin());
+		for (std::size_t lCountK = 1; lCountK < lLength; lCountK++)
+		{
+			for (std::size_t lCountI = 0; lCountI < lInner; lCountI++)
+			{
+				if (lSource[lCountK * lInner + lCountI] > lBest[lCountI])
+				{
+					lBest[lCountI] = lSource[lCountK * lInner + lCountI];
+					lDestination[lCountI] = lCountK;
+				}
+			}
+		}
+	}
+	return lResult;
+}
 
-	// calculate the start and ending positions of a row
-	std::vector<unsigned long>lStartCoordinates(aCoordinatesOfRow);
-	lStartCoordinates.push_back(0);
+/** Returns the sums of the products of the elements of two arrays along a dimension
+* @param aRight An array with the same dimensions
+* @param aDimension The dimension to sum along
+* @return An array with the same dimensions except aDimension has a length of 1
+*/
+template<typename T, typename Storage>
+template<typename S>
+MultidimensionalArray<T> MultidimensionalArray<T, Storage>::dot(const MultidimensionalArray<T, S>& aRight, const std::size_t aDimension) const
+{
+	if (!expressionShapesMatch(*this, aRight)) throw MultidimensionalArray::DIMENSIONS_DONT_MATCH;
 
-	std::vector<unsigned long>lEndCoordinates(aCoordinatesOfRow);
-	lEndCoordinates.push_back(this->m_DimLengths[this->m_NumberOfDimensions - 1]);
+	std::size_t lOuter, lLength, lInner;
+	this->calculateReductionLengths(aDimension, lOuter, lLength, lInner);
 
-	// calculate the vector positions of the start and end coordinates
-	unsigned long lStart = calculateElementPosition(lStartCoordinates);
-	unsigned long lEnd = calculateElementPosition(lEndCoordinates);
+	std::vector<std::size_t> lDimLengths(this->m_DimLengths.begin(), this->m_DimLengths.end());
+	lDimLengths[aDimension] = 1;
+	MultidimensionalArray<T> lResult(this->m_NumberOfDimensions, lDimLengths);
 
-	std::vector<T> lResult(this->m_DimLengths[this->m_NumberOfDimensions - 1]);
-	for (unsigned long lCount = lStart; lCount < lEnd; lCount++)
+	for (std::size_t lCountO = 0; lCountO < lOuter; lCountO++)
 	{
-		 lResult[lCount - lStart] = this->m_Elements[lCount];
+		const std::size_t lOffset = lCountO * lLength * lInner;
+		T* const lDestination = lResult.data() + lCountO * lInner;
+		if (lInner == 1)
+		{
+			lDestination[0] = LinearAlgebra::Dot(this->m_Elements.data() + lOffset, aRight.data() + lOffset, lLength);
+			continue;
+		}
+
+		for (std::size_t lCountK = 0; lCountK < lLength; lCountK++)
+		{
+			LinearAlgebra::MultiplyAddTo(this->m_Elements.data() + lOffset + lCountK * lInner, aRight.data() + lOffset + lCountK * lInner, lDestination, lInner);
+		}
 	}
 	return lResult;
 }
 
+/** Divides the elements so they sum to 1 along a dimension (e.g. normalizes the rows of a matrix when aDimension = 1).
+* Elements that sum to 0 are left unchanged.
+* @param aDimension The dimension to normalize along
+* @param aPolicy The execution policy
+*/
+template<typename T, typename Storage>
+void MultidimensionalArray<T, Storage>::normalize(const std::size_t aDimension, const ExecutionPolicy& aPolicy)
+{
+	std::size_t lOuter, lLength, lInner;
+	this->calculateReductionLengths(aDimension, lOuter, lLength, lInner);
+	const MultidimensionalArray<T> lSums = this->sum(aDimension, aPolicy);
+	const T* const lSum = lSums.data();
+	T* const lData = this->m_Elements.data();
+
+	// each block walks its elements a run at a time: a run is the part of a row of lInner elements (or of the lLength
+	// elements being normalized when lInner = 1) that is inside the block
+	aPolicy.forEachBlock(this->m_Elements.size(), [lSum, lData, lLength, lInner](const std::size_t, const std::size_t aBegin, const std::size_t aEnd)
+	{
+		std::size_t lPosition = aBegin;
+		while (lPosition < aEnd)
+		{
+			if (lInner == 1)
+			{
+				const std::size_t lCountO = lPosition / lLength;
+				const std::size_t lRunEnd = ((lCountO + 1) * lLength < aEnd) ? (lCountO + 1) * lLength : aEnd;
+				if (lSum[lCountO] != T()) LinearAlgebra::Scale(static_cast<T>(1) / lSum[lCountO], lData + lPosition, lRunEnd - lPosition);
+				lPosition = lRunEnd;
+				continue;
+			}
+
+			const std::size_t lRow = lPosition / lInner;
+			const std::size_t lRunEnd = ((lRow + 1) * lInner < aEnd) ? (lRow + 1) * lInner : aEnd;
+			const T* const lRowSum = lSum + (lRow / lLength) * lInner;
+			for (; lPosition < lRunEnd; lPosition++)
+			{
+				const std::size_t lColumn = lPosition - lRow * lInner;
+				if (lRowSum[lColumn] != T()) lData[lPosition] /= lRowSum[lColumn];
+			}
+		}
+	});
+}
+
 /** Sets the element located at the coordinates
 * @param aCoordinates The coordinates for the element
 */
-template<typename T>
-void MultidimensionalArray<T>::setElement(const std::vector<unsigned long> aCoordinates, const T aValue)
+template<typename T, typename Storage>
+void MultidimensionalArray<T, Storage>::setElement(const std::vector<std::size_t>& aCoordinates, const T aValue)
 {
 	if (aCoordinates.size() != this->m_NumberOfDimensions) throw MultidimensionalArray::DIMENSIONS_DONT_MATCH;
 
-	unsigned long lElementPosition = calculateElementPosition(aCoordinates);
+	std::size_t lElementPosition = calculateElementPosition(aCoordinates);
 
 	this->m_Elements[lElementPosition] = aValue;
 }
@@ -217,37 +729,81 @@ void MultidimensionalArray<T>::setElement(const std::vector<unsigned long> aCoor
 * @param aCoordinates The coordinates of the row to set
 * @param aValues The new values of the row
 */
-template<typename T>
-void MultidimensionalArray<T>::setRow(const std::vector<unsigned long> aCoordinatesOfRow, const std::vector<T> aValues)
+template<typename T, typename Storage>
+void MultidimensionalArray<T, Storage>::setRow(const std::vector<std::size_t>& aCoordinatesOfRow, const std::vector<T>& aValues)
 {
-	// The length of aCoordinatesOfRow must equal the total number of dimensions - 1
-	if (aCoordinatesOfRow.size() != this->m_NumberOfDimensions - 1) throw MultidimensionalArray::DIMENSIONS_DONT_MATCH;
-
 	// the length of aValues must be the same length of the last dimension
 	if (aValues.size() != this->getNumberOfElementsOfDimension(this->m_NumberOfDimensions - 1)) throw MultidimensionalArray::DIMENSIONS_DONT_MATCH;
 
-	// calculate the start and ending positions of a row
-	std::vector<unsigned long>lStartCoordinates(aCoordinatesOfRow);
-	lStartCoordinates.push_back(0);
+	this->rowView(aCoordinatesOfRow).assign(aValues);
+}
 
-	std::vector<unsigned long>lEndCoordinates(aCoordinatesOfRow);
-	lEndCoordinates.push_back(this->m_DimLengths[this->m_NumberOfDimensions - 1]);
+/** Sets every element to a value
+* @param aValue The value
+* @param aPolicy The execution policy
+*/
+template<typename T, typename Storage>
+void MultidimensionalArray<T, Storage>::fill(const T aValue, const ExecutionPolicy& aPolicy)
+{
+	T* const lData = this->m_Elements.data();
+	aPolicy.forEachBlock(this->m_Elements.size(), [lData, aValue](const std::size_t, const std::size_t aBegin, const std::size_t aEnd)
+	{
+		std::fill(lData + aBegin, lData + aEnd, aValue);
+	});
+}
 
-	// calculate the vector positions of the start and end coordinates
-	unsigned long lStart = calculateElementPosition(lStartCoordinates);
-	unsigned long lEnd = calculateElementPosition(lEndCoordinates);
+/** Replaces every element with a function of the element
+* @param aFunction A function T -> T (called from several threads at once with a parallel policy)
+* @param aPolicy The execution policy
+*/
+template<typename T, typename Storage>
+template<typename Function>
+void MultidimensionalArray<T, Storage>::transform(Function aFunction, const ExecutionPolicy& aPolicy)
+{
+	T* const lData = this->m_Elements.data();
+	aPolicy.forEachBlock(this->m_Elements.size(), [lData, &aFunction](const std::size_t, const std::size_t aBegin, const std::size_t aEnd)
+	{
+		for (std::size_t lCount = aBegin; lCount < aEnd; lCount++)
+		{
+			lData[lCount] = aFunction(lData[lCount]);
+		}
+	});
+}
 
-	for (unsigned long lCount = lStart; lCount < lEnd; lCount++)
+/** Calculates every element of an expression into the array with an execution policy (operator= with a policy).
+* The array is resized if its dimensions don't match the expression.
+* @param aExpression The expression
+* @param aPolicy The execution policy
+*/
+template<typename T, typename Storage>
+template<typename E>
+MultidimensionalArray<T, Storage>& MultidimensionalArray<T, Storage>::assign(const ArrayExpression<E>& aExpression, const ExecutionPolicy& aPolicy)
+{
+	const E& lExpression = aExpression.derived();
+	if (!expressionShapesMatch(*this, lExpression))
 	{
-		this->m_Elements[lCount] = aValues[lCount - lStart];
+		// the expression can not refer to this array when the dimensions are different so it is safe to resize first
+		std::vector<std::size_t> lDimLengths(lExpression.getNumberOfDimensions());
+		for (std::size_t lCount = 0; lCount < lDimLengths.size(); lCount++)
+		{
+			lDimLengths[lCount] = lExpression.getNumberOfElementsOfDimension(lCount);
+		}
+		*this = MultidimensionalArray(static_cast<std::size_t>(lDimLengths.size()), lDimLengths);
 	}
+
+	T* const lData = this->m_Elements.data();
+	aPolicy.forEachBlock(this->m_Elements.size(), [lData, &lExpression](const std::size_t, const std::size_t aBegin, const std::size_t aEnd)
+	{
+		evaluateExpression<ExpressionAssign>(lData, lExpression, aBegin, aEnd);
+	});
+	return *this;
 }
 
 /** Assingment operator
 * @param aRight The right side of the = operator
 */
-template<typename T>
-MultidimensionalArray<T>& MultidimensionalArray<T>::operator=(const MultidimensionalArray& aRight)
+template<typename T, typename Storage>
+MultidimensionalArray<T, Storage>& MultidimensionalArray<T, Storage>::operator=(const MultidimensionalArray& aRight)
 {
 	this->m_Elements = aRight.m_Elements;
 	this->m_DimLengths = aRight.m_DimLengths;
@@ -256,14 +812,246 @@ MultidimensionalArray<T>& MultidimensionalArray<T>::operator=(const Multidimensi
 	return *this;
 }
 
+/** Move assignment operator
+* @param aRight The right side of the = operator
+*/
+template<typename T, typename Storage>
+MultidimensionalArray<T, Storage>& MultidimensionalArray<T, Storage>::operator=(MultidimensionalArray&& aRight)
+{
+	if (this == &aRight) return *this;
+
+	this->m_Elements = std::move(aRight.m_Elements);
+	this->m_DimLengths = std::move(aRight.m_DimLengths);
+	this->m_NumberOfDimensions = aRight.m_NumberOfDimensions;
+	this->m_TotalNumberOfElements = aRight.m_TotalNumberOfElements;
+
+	aRight.m_NumberOfDimensions = 0;
+	aRight.m_TotalNumberOfElements = 0;
+	aRight.m_Elements.clear();
+	aRight.m_DimLengths.clear();
+	return *this;
+}
+
+/** Assignment operator that calculates every element of an expression in a single loop.
+* The array is resized if its dimensions don't match the expression.
+* @param aRight The right side of the = operator
+*/
+template<typename T, typename Storage>
+template<typename E>
+MultidimensionalArray<T, Storage>& MultidimensionalArray<T, Storage>::operator=(const ArrayExpression<E>& aRight)
+{
+	const E& lExpression = aRight.derived();
+	if (!expressionShapesMatch(*this, lExpression))
+	{
+		// the expression can not refer to this array when the dimensions are different so it is safe to resize first
+		*this = MultidimensionalArray(lExpression);
+		return *this;
+	}
+
+	evaluateExpression<ExpressionAssign>(this->m_Elements.data(), lExpression);
+	return *this;
+}
+
+/** Adds an expression to the array element-wise
+* @param aRight The right side of the += operator
+*/
+template<typename T, typename Storage>
+template<typename E>
+MultidimensionalArray<T, Storage>& MultidimensionalArray<T, Storage>::operator+=(const ArrayExpression<E>& aRight)
+{
+	if (!expressionShapesMatch(*this, aRight.derived())) throw MultidimensionalArray::DIMENSIONS_DONT_MATCH;
+
+	evaluateExpression<ExpressionAdd>(this->m_Elements.data(), aRight);
+	return *this;
+}
+
+/** Subtracts an expression from the array element-wise
+* @param aRight The right side of the -= operator
+*/
+template<typename T, typename Storage>
+template<typename E>
+MultidimensionalArray<T, Storage>& MultidimensionalArray<T, Storage>::operator-=(const ArrayExpression<E>& aRight)
+{
+	if (!expressionShapesMatch(*this, aRight.derived())) throw MultidimensionalArray::DIMENSIONS_DONT_MATCH;
+
+	evaluateExpression<ExpressionSubtract>(this->m_Elements.data(), aRight);
+	return *this;
+}
+
+/** Multiplies the array by an expression element-wise
+* @param aRight The right side of the *= operator
+*/
+template<typename T, typename Storage>
+template<typename E>
+MultidimensionalArray<T, Storage>& MultidimensionalArray<T, Storage>::operator*=(const ArrayExpression<E>& aRight)
+{
+	if (!expressionShapesMatch(*this, aRight.derived())) throw MultidimensionalArray::DIMENSIONS_DONT_MATCH;
+
+	evaluateExpression<ExpressionMultiply>(this->m_Elements.data(), aRight);
+	return *this;
+}
+
+/** Divides the array by an expression element-wise
+* @param aRight The right side of the /= operator
+*/
+template<typename T, typename Storage>
+template<typename E>
+MultidimensionalArray<T, Storage>& MultidimensionalArray<T, Storage>::operator/=(const ArrayExpression<E>& aRight)
+{
+	if (!expressionShapesMatch(*this, aRight.derived())) throw MultidimensionalArray::DIMENSIONS_DONT_MATCH;
+
+	evaluateExpression<ExpressionDivide>(this->m_Elements.data(), aRight);
+	return *this;
+}
+
+/** Adds a scalar to every element
+* @param aRight The right side of the += operator
+*/
+template<typename T, typename Storage>
+MultidimensionalArray<T, Storage>& MultidimensionalArray<T, Storage>::operator+=(const T aRight)
+{
+	evaluateScalar<ExpressionAdd>(this->m_Elements.data(), this->m_Elements.size(), aRight);
+	return *this;
+}
+
+/** Subtracts a scalar from every element
+* @param aRight The right side of the -= operator
+*/
+template<typename T, typename Storage>
+MultidimensionalArray<T, Storage>& MultidimensionalArray<T, Storage>::operator-=(const T aRight)
+{
+	evaluateScalar<ExpressionSubtract>(this->m_Elements.data(), this->m_Elements.size(), aRight);
+	return *this;
+}
+
+/** Multiplies every element by a scalar
+* @param aRight The right side of the *= operator
+*/
+template<typename T, typename Storage>
+MultidimensionalArray<T, Storage>& MultidimensionalArray<T, Storage>::operator*=(const T aRight)
+{
+	evaluateScalar<ExpressionMultiply>(this->m_Elements.data(), this->m_Elements.size(), aRight);
+	return *this;
+}
+
+/** Divides every element by a scalar
+* @param aRight The right side of the /= operator
+*/
+template<typename T, typename Storage>
+MultidimensionalArray<T, Storage>& MultidimensionalArray<T, Storage>::operator/=(const T aRight)
+{
+	evaluateScalar<ExpressionDivide>(this->m_Elements.data(), this->m_Elements.size(), aRight);
+	return *this;
+}
+
+/** Reduces the elements along a dimension
+* @param aDimension The dimension to reduce along
+* @param aPolicy The execution policy
+* @return An array with the same dimensions except aDimension has a length of 1
+*/
+template<typename T, typename Storage>
+template<typename Reduction>
+MultidimensionalArray<T> MultidimensionalArray<T, Storage>::reduceDimension(const std::size_t aDimension, const ExecutionPolicy& aPolicy) const
+{
+	std::size_t lOuter, lLength, lInner;
+	this->calculateReductionLengths(aDimension, lOuter, lLength, lInner);
+
+	std::vector<std::size_t> lDimLengths(this->m_DimLengths.begin(), this->m_DimLengths.end());
+	lDimLengths[aDimension] = 1;
+	MultidimensionalArray<T> lResult(this->m_NumberOfDimensions, lDimLengths);
+	const T* const lData = this->m_Elements.data();
+	T* const lResultData = lResult.data();
+
+	if (lInner == 1)
+	{
+		// reducing along the last dimension: the elements are next to each other
+		if (lOuter == 1)
+		{
+			lResultData[0] = reduceElements<Reduction>(lData, lLength, aPolicy);
+			return lResult;
+		}
+
+		aPolicy.forItemsOfLength(lLength).forEachBlock(lOuter, [lData, lResultData, lLength](const std::size_t, const std::size_t aBegin, const std::size_t aEnd)
+		{
+			for (std::size_t lCountO = aBegin; lCountO < aEnd; lCountO++)
+			{
+				lResultData[lCountO] = Reduction::reduce(lData + lCountO * lLength, lLength);
+			}
+		});
+		return lResult;
+	}
+
+	// otherwise combine whole rows of lInner elements at a time. The blocks split the lOuter * lInner results, and
+	// each block walks its results a run (the part of one outer row of results inside the block) at a time. A block
+	// has at least 256 results so it reads a few whole cache lines from each row instead of a scattered few elements.
+	aPolicy.forItemsOfLength(lLength, 256).forEachBlock(lOuter * lInner, [lData, lResultData, lLength, lInner](const std::size_t, const std::size_t aBegin, const std::size_t aEnd)
+	{
+		std::size_t lPosition = aBegin;
+		while (lPosition < aEnd)
+		{
+			const std::size_t lCountO = lPosition / lInner;
+			const std::size_t lRunEnd = ((lCountO + 1) * lInner < aEnd) ? (lCountO + 1) * lInner : aEnd;
+			const std::size_t lColumn = lPosition - lCountO * lInner;
+			const T* const lSource = lData + lCountO * lLength * lInner + lColumn;
+			std::copy(lSource, lSource + (lRunEnd - lPosition), lResultData + lPosition);
+			for (std::size_t lCountK = 1; lCountK < lLength; lCountK++)
+			{
+				Reduction::accumulate(lSource + lCountK * lInner, lResultData + lPosition, lRunEnd - lPosition);
+			}
+			lPosition = lRunEnd;
+		}
+	});
+	return lResult;
+}
+
+/** Reduces contiguous elements. In parallel every block is reduced and then the results of the blocks.
+* @param aData The elements
+* @param aLength The number of elements
+* @param aPolicy The execution policy
+*/
+template<typename T, typename Storage>
+template<typename Reduction>
+T MultidimensionalArray<T, Storage>::reduceElements(const T* const aData, const std::size_t aLength, const ExecutionPolicy& aPolicy)
+{
+	const std::size_t lNumberOfBlocks = aPolicy.calculateNumberOfBlocks(aLength);
+	if (lNumberOfBlocks <= 1) return Reduction::reduce(aData, aLength);
+
+	std::vector<T> lPartials(lNumberOfBlocks);
+	aPolicy.forEachBlock(aLength, [aData, &lPartials](const std::size_t aBlock, const std::size_t aBegin, const std::size_t aEnd)
+	{
+		lPartials[aBlock] = Reduction::reduce(aData + aBegin, aEnd - aBegin);
+	});
+	return Reduction::reduce(lPartials.data(), lNumberOfBlocks);
+}
+
+/** Splits the array around a dimension for the reductions. The element at (o, k, i) is at o * aLength * aInner + k * aInner + i.
+* @param aDimension The dimension
+* @param aOuter Will be returned with the product of the lengths of the dimensions before aDimension
+* @param aLength Will be returned with the length of aDimension
+* @param aInner Will be returned with the product of the lengths of the dimensions after aDimension
+*/
+template<typename T, typename Storage>
+void MultidimensionalArray<T, Storage>::calculateReductionLengths(const std::size_t aDimension, std::size_t& aOuter, std::size_t& aLength, std::size_t& aInner) const
+{
+	if (aDimension >= this->m_NumberOfDimensions || this->m_DimLengths[aDimension] == 0) throw MultidimensionalArray::DIMENSIONS_DONT_MATCH;
+
+	aOuter = 1;
+	for (std::size_t lCount = 0; lCount < aDimension; lCount++)
+	{
+		aOuter = aOuter * this->m_DimLengths[lCount];
+	}
+	aLength = this->m_DimLengths[aDimension];
+	aInner = this->calculateStride(aDimension);
+}
+
 /** Calculates the position in m_Elements based on coordinates
 * @param aCoordinates the coordinates of the position
 */
-template<typename T>
-unsigned MultidimensionalArray<T>::calculateElementPosition(const std::vector<unsigned long> aCoordinates) const
+template<typename T, typename Storage>
+std::size_t MultidimensionalArray<T, Storage>::calculateElementPosition(const std::vector<std::size_t>& aCoordinates) const
 {
-	unsigned long lElementPosition = aCoordinates[this->m_NumberOfDimensions - 1];
-	unsigned long lSkip = 1;
+	std::size_t lElementPosition = aCoordinates[this->m_NumberOfDimensions - 1];
+	std::size_t lSkip = 1;
 	for (long lCount = this->m_NumberOfDimensions - 2; lCount >= 0; lCount--)
 	{
 		if (aCoordinates[lCount] >= this->m_DimLengths[lCount]) throw MultidimensionalArray::DIMENSIONS_DONT_MATCH;
@@ -273,5 +1061,71 @@ unsigned MultidimensionalArray<T>::calculateElementPosition(const std::vector<un
 	return lElementPosition;
 }
 
+/** Calculates the distance in m_Elements between two elements that are next to each other in a dimension
+* @param aDimension The dimension
+*/
+template<typename T, typename Storage>
+std::size_t MultidimensionalArray<T, Storage>::calculateStride(const std::size_t aDimension) const
+{
+	std::size_t lSkip = 1;
+	for (std::size_t lCount = aDimension + 1; lCount < this->m_NumberOfDimensions; lCount++)
+	{
+		lSkip = lSkip * this->m_DimLengths[lCount];
+	}
+	return lSkip;
+}
+
+/** Calculates the position in m_Elements of the first element of a row
+* @param aCoordinatesOfRow The coordinates of the row (one for each dimension except the last)
+*/
+template<typename T, typename Storage>
+std::size_t MultidimensionalArray<T, Storage>::calculateRowPosition(const std::vector<std::size_t>& aCoordinatesOfRow) const
+{
+	// The length of aCoordinatesOfRow must equal the total number of dimensions - 1
+	if (aCoordinatesOfRow.size() != this->m_NumberOfDimensions - 1) throw MultidimensionalArray::DIMENSIONS_DONT_MATCH;
+
+	std::size_t lElementPosition = 0;
+	std::size_t lSkip = this->m_DimLengths[this->m_NumberOfDimensions - 1];
+	for (long lCount = this->m_NumberOfDimensions - 2; lCount >= 0; lCount--)
+	{
+		if (aCoordinatesOfRow[lCount] >= this->m_DimLengths[lCount]) throw MultidimensionalArray::DIMENSIONS_DONT_MATCH;
+		lElementPosition = lElementPosition + aCoordinatesOfRow[lCount] * lSkip;
+		lSkip = lSkip * this->m_DimLengths[lCount];
+	}
+	return lElementPosition;
+}
+
+/** Calculates the position in m_Elements of the first element of a row
+* @param aRow The index of the row (the rows are counted in memory order)
+*/
+template<typename T, typename Storage>
+std::size_t MultidimensionalArray<T, Storage>::calculateRowPosition(const std::size_t aRow) const
+{
+	if (this->m_NumberOfDimensions == 0) throw MultidimensionalArray::DIMENSIONS_DONT_MATCH;
+
+	std::size_t lNumberOfRows = 1;
+	for (std::size_t lCount = 0; lCount + 1 < this->m_NumberOfDimensions; lCount++)
+	{
+		lNumberOfRows = lNumberOfRows * this->m_DimLengths[lCount];
+	}
+	if (aRow >= lNumberOfRows) throw MultidimensionalArray::DIMENSIONS_DONT_MATCH;
+
+	return aRow * this->m_DimLengths[this->m_NumberOfDimensions - 1];
+}
+
+/** Checks a slice of a matrix and calculates the position in m_Elements of its first element
+* @param aRow The row of the first element
+* @param aColumn The column of the first element
+* @param aDimension The dimension the slice runs along
+*/
+template<typename T, typename Storage>
+std::size_t MultidimensionalArray<T, Storage>::calculateMatrixPosition(const std::size_t aRow, const std::size_t aColumn, const std::size_t aDimension) const
+{
+	if (this->m_NumberOfDimensions != 2 || aDimension >= 2) throw MultidimensionalArray::DIMENSIONS_DONT_MATCH;
+	if (aRow >= this->m_DimLengths[0] || aColumn >= this->m_DimLengths[1]) throw MultidimensionalArray::DIMENSIONS_DONT_MATCH;
+
+	return aRow * this->m_DimLengths[1] + aColumn;
+}
+
 
 #endif
@@ -3,27 +3,55 @@
 #ifndef MYLIST_H
 #define MYLIST_H
 
+#include "NodePool.h"
+#include <cstddef> // std::size_t
+#include <memory> // std::allocator_traits
+#include <new> // placement new
+#include <utility> // std::forward, std::move, std::swap
 
 #pragma unmanaged
 
 template<typename T> class MyListIterator;
 
+/** Makes room for aNumberOfNodes nodes in an allocator that can reserve them (e.g. NodePoolAllocator)
+*/
+template<typename Allocator>
+auto MyListReserveNodes(Allocator& aAllocator, const std::size_t aNumberOfNodes, int) -> decltype(aAllocator.reserve(aNumberOfNodes), void())
+{
+	aAllocator.reserve(aNumberOfNodes);
+}
+
+/** Does nothing for an allocator that cannot reserve nodes
+*/
+template<typename Allocator>
+void MyListReserveNodes(Allocator&, const std::size_t, long)
+{
+}
+
 template<typename T>
 struct Node
 {
 	T Data;
 	Node<T>* Next;
 	Node<T>* Previous;
+
+	template<typename... Args>
+	explicit Node(Args&&... aArgs) : Data(std::forward<Args>(aArgs)...), Next(nullptr), Previous(nullptr) {}
 };
 
 ////////////////////////////////////////////////////////////////////////////////
 
 ////////////////////////////////////////////////////////////////////////////////
 
-/**
+/** A doubly linked list. end() is a node of its own, so an iterator stays valid until its element is erased (even
+*   when elements are inserted, erased or spliced around it), and inserting, erasing and splicing at an iterator
+*   only relink nodes.
 *
+*   The nodes come from Allocator, by default a NodePool of the list (see NodePool.h) that lists constructed with the
+*   same allocator share (a copy of the list gets a pool of its own). Splicing between lists with different allocators moves the
+*   elements into new nodes, so iterators to them are invalidated.
 */
-template<typename T>
+template<typename T, typename Allocator = NodePoolAllocator<Node<T>>>
 class MyList
 {
 	friend class MyListIterator<T>;
@@ -34,35 +62,72 @@ private:
 	Node<T>* m_Front;
 	Node<T>* m_Back;
 	int m_NumberOfElements;
-
+	Allocator m_Allocator;
+
+	template<typename... Args>
+	Node<T>* createNode(Args&&... aArgs);
+	void destroyNode(Node<T>* aNode);
+	MyListIterator<T> link(Node<T>* aLoc, Node<T>* aNode);
+	void unlink(Node<T>* aNode);
+	void spliceNodes(Node<T>* aLoc, MyList<T, Allocator>& aOther, Node<T>* aFirst, Node<T>* aLast, const int aNumberOfElements);
+	void linkChain(Node<T>* aChain);
+	template<typename Compare>
+	static void mergeNodes(Node<T>*& aLeft, Node<T>* aRight, Compare& aCompare);
+	static Node<T>* concatenateNodes(Node<T>* aLeft, Node<T>* aRight);
 
 public:
 	MyList();
-	MyList(const MyList<T>& aCopy);
+	explicit MyList(const Allocator& aAllocator);
+	MyList(const MyList<T, Allocator>& aCopy);
+	MyList(MyList<T, Allocator>&& aMove);
 	~MyList();
-	
+
 	void pushBack(const T& aData);
+	void pushBack(T&& aData);
 	void pushFront(const T& aData);
+	void pushFront(T&& aData);
+	template<typename... Args>
+	MyListIterator<T> emplace(const MyListIterator<T>& aLoc, Args&&... aArgs);
+	template<typename... Args>
+	T& emplaceBack(Args&&... aArgs);
 	MyListIterator<T> insert(const MyListIterator<T>& aLoc, const T& aData);
+	MyListIterator<T> insert(const MyListIterator<T>& aLoc, T&& aData);
+	template<typename Iterator>
+	void append(Iterator aFirst, Iterator aLast);
+	void append(const MyList<T, Allocator>& aOther);
+	void append(MyList<T, Allocator>&& aOther);
+	void reserve(const int aNumberOfElements);
 	void popFront();
 	void popBack();
 	MyListIterator<T> erase(MyListIterator<T> aLoc);
+	void clear();
+
+	void splice(const MyListIterator<T>& aLoc, MyList<T, Allocator>& aOther);
+	void splice(const MyListIterator<T>& aLoc, MyList<T, Allocator>& aOther, const MyListIterator<T>& aElement);
+	void splice(const MyListIterator<T>& aLoc, MyList<T, Allocator>& aOther, const MyListIterator<T>& aFirst, const MyListIterator<T>& aLast);
+	void swap(MyList<T, Allocator>& aOther);
+	void sort();
+	template<typename Compare>
+	void sort(Compare aCompare);
 
 	int size() const;
+	bool empty() const;
+	const Allocator& getAllocator() const;
 	MyListIterator<T> find(MyListIterator<T> aStart, MyListIterator<T> aEnd, const T& aValue) const;
 
 	MyListIterator<T> begin() const;
 	MyListIterator<T> end() const;
 
-	MyList<T>& operator=(const MyList<T>& aRight);
+	MyList<T, Allocator>& operator=(const MyList<T, Allocator>& aRight);
+	MyList<T, Allocator>& operator=(MyList<T, Allocator>&& aRight);
 };
 
 ////////////////////////////////////////////////////////////////////////////////
 
-template<typename T> 
+template<typename T>
 class MyListIterator
 {
-	friend class MyList<T>;
+	template<typename, typename> friend class MyList;
 
 private:
 	Node<T>* m_Ptr;
@@ -89,26 +154,40 @@ public:
 
 ////////////////////////////////////////////////////////////////////////////////
 
-template<typename T>
-MyList<T>::MyList()
+template<typename T, typename Allocator>
+MyList<T, Allocator>::MyList()
 {
-	this->m_Front = new Node<T>;
-	this->m_Front->Next = nullptr;
-	this->m_Front->Previous = nullptr;
+	this->m_Front = this->createNode();
 	this->m_Back = m_Front;
 	this->m_NumberOfElements = 0;
 }
 
-template<typename T>
-MyList<T>::MyList(const MyList<T>& aCopy)
+/** Constructor for MyList with the allocator of its nodes (e.g. to share a NodePool with other lists)
+* @param aAllocator The allocator
+*/
+template<typename T, typename Allocator>
+MyList<T, Allocator>::MyList(const Allocator& aAllocator)
+	: m_Allocator(aAllocator)
+{
+	this->m_Front = this->createNode();
+	this->m_Back = m_Front;
+	this->m_NumberOfElements = 0;
+}
+
+/** Copy constructor for MyList (the copy gets the allocator select_on_container_copy_construction returns, e.g. a
+*   NodePoolAllocator with a new pool)
+* @param aCopy The object to copy
+*/
+template<typename T, typename Allocator>
+MyList<T, Allocator>::MyList(const MyList<T, Allocator>& aCopy)
+	: m_Allocator(std::allocator_traits<Allocator>::select_on_container_copy_construction(aCopy.m_Allocator))
 {
 	Node<T>* current = aCopy.m_Front;
 
-	this->m_Front = new Node<T>;
-	this->m_Front->Next = nullptr;
-	this->m_Front->Previous = nullptr;
+	this->m_Front = this->createNode();
 	this->m_Back = m_Front;
 	this->m_NumberOfElements = 0;
+	this->reserve(aCopy.m_NumberOfElements);
 
 	while (current != aCopy.m_Back)
 	{
@@ -117,158 +196,531 @@ MyList<T>::MyList(const MyList<T>& aCopy)
 	}
 }
 
-template<typename T>
-MyList<T>::~MyList()
+/** Move constructor for MyList (the moved list is left empty)
+* @param aMove The object to move
+*/
+template<typename T, typename Allocator>
+MyList<T, Allocator>::MyList(MyList<T, Allocator>&& aMove)
+	: m_Allocator(aMove.m_Allocator)
+{
+	this->m_Front = this->createNode();
+	this->m_Back = m_Front;
+	this->m_NumberOfElements = 0;
+
+	this->swap(aMove);
+}
+
+template<typename T, typename Allocator>
+MyList<T, Allocator>::~MyList()
 {
 	Node<T>* temp;
 	while (this->m_Front != nullptr)
 	{
 		temp = this->m_Front;
 		this->m_Front = m_Front->Next;
-		delete temp;
+		this->destroyNode(temp);
 	}
 	this->m_Front = nullptr;
 	this->m_Back = nullptr;
 }
 
-template<typename T>
-void MyList<T>::pushBack(const T& aData)
+/** Allocates and constructs a node
+* @param aArgs The arguments of the constructor of T
+*/
+template<typename T, typename Allocator>
+template<typename... Args>
+Node<T>* MyList<T, Allocator>::createNode(Args&&... aArgs)
 {
-	Node<T>* NewNode = new Node<T>;
-	NewNode->Data = aData;
-	NewNode->Next = this->m_Back;
-	NewNode->Previous = this->m_Back->Previous;
-	this->m_Back->Previous = NewNode;
-
-	this->m_NumberOfElements++;
-
-	if (this->m_NumberOfElements == 1)
+	Node<T>* NewNode = this->m_Allocator.allocate(1);
+	try
 	{
-		this->m_Front = this->m_Back->Previous;
+		new (NewNode) Node<T>(std::forward<Args>(aArgs)...);
 	}
-	else
+	catch (...)
 	{
-		NewNode->Previous->Next = NewNode;
+		this->m_Allocator.deallocate(NewNode, 1);
+		throw;
 	}
+	return NewNode;
 }
 
-template<typename T>
-void MyList<T>::pushFront(const T& aData)
+/** Destroys and frees a node
+* @param aNode The node
+*/
+template<typename T, typename Allocator>
+void MyList<T, Allocator>::destroyNode(Node<T>* aNode)
+{
+	aNode->~Node<T>();
+	this->m_Allocator.deallocate(aNode, 1);
+}
+
+/** Links a new node in front of aLoc
+* @param aLoc The node to link in front of (m_Back to link at the end)
+* @param aNode The new node
+* @return The location of the new node
+*/
+template<typename T, typename Allocator>
+MyListIterator<T> MyList<T, Allocator>::link(Node<T>* aLoc, Node<T>* aNode)
 {
-	Node<T>* NewNode = new Node<T>;
-	NewNode->Data = aData;
-	NewNode->Next = this->m_Front;
-	NewNode->Previous = nullptr;
+	aNode->Next = aLoc;
+	aNode->Previous = aLoc->Previous;
+	if (aLoc->Previous == nullptr) this->m_Front = aNode;
+	else aLoc->Previous->Next = aNode;
+	aLoc->Previous = aNode;
 
-	this->m_Front->Previous = NewNode;
-	this->m_Front = NewNode;
-	
 	this->m_NumberOfElements++;
+
+	return MyListIterator<T>(aNode);
 }
 
-template<typename T>
-MyListIterator<T> MyList<T>::insert(const MyListIterator<T>& aLoc, const T& aData)
+/** Unlinks a node from the list (without deleting it)
+* @param aNode The node (not m_Back)
+*/
+template<typename T, typename Allocator>
+void MyList<T, Allocator>::unlink(Node<T>* aNode)
+{
+	if (aNode->Previous == nullptr) this->m_Front = aNode->Next;
+	else aNode->Previous->Next = aNode->Next;
+	aNode->Next->Previous = aNode->Previous;
+
+	this->m_NumberOfElements--;
+}
+
+template<typename T, typename Allocator>
+void MyList<T, Allocator>::pushBack(const T& aData)
+{
+	this->link(this->m_Back, this->createNode(aData));
+}
+
+template<typename T, typename Allocator>
+void MyList<T, Allocator>::pushBack(T&& aData)
+{
+	this->link(this->m_Back, this->createNode(std::move(aData)));
+}
+
+template<typename T, typename Allocator>
+void MyList<T, Allocator>::pushFront(const T& aData)
 {
-	if (aLoc.m_Ptr == this->m_Front)
+	this->link(this->m_Front, this->createNode(aData));
+}
+
+template<typename T, typename Allocator>
+void MyList<T, Allocator>::pushFront(T&& aData)
+{
+	this->link(this->m_Front, this->createNode(std::move(aData)));
+}
+
+/** Constructs an element in place in front of aLoc
+* @param aLoc The location to insert at
+* @param aArgs The arguments of the constructor of T
+* @return The location of the new element
+*/
+template<typename T, typename Allocator>
+template<typename... Args>
+MyListIterator<T> MyList<T, Allocator>::emplace(const MyListIterator<T>& aLoc, Args&&... aArgs)
+{
+	return this->link(aLoc.m_Ptr, this->createNode(std::forward<Args>(aArgs)...));
+}
+
+/** Constructs an element in place at the end of the list
+* @param aArgs The arguments of the constructor of T
+* @return The new element
+*/
+template<typename T, typename Allocator>
+template<typename... Args>
+T& MyList<T, Allocator>::emplaceBack(Args&&... aArgs)
+{
+	Node<T>* NewNode = this->createNode(std::forward<Args>(aArgs)...);
+	this->link(this->m_Back, NewNode);
+	return NewNode->Data;
+}
+
+template<typename T, typename Allocator>
+MyListIterator<T> MyList<T, Allocator>::insert(const MyListIterator<T>& aLoc, const T& aData)
+{
+	return this->link(aLoc.m_Ptr, this->createNode(aData));
+}
+
+template<typename T, typename Allocator>
+MyListIterator<T> MyList<T, Allocator>::insert(const MyListIterator<T>& aLoc, T&& aData)
+{
+	return this->link(aLoc.m_Ptr, this->createNode(std::move(aData)));
+}
+
+/** Appends copies of a range of elements (counted first, so the nodes for all of them are reserved at once)
+* @param aFirst The first element to append
+* @param aLast One past the last element to append
+*/
+template<typename T, typename Allocator>
+template<typename Iterator>
+void MyList<T, Allocator>::append(Iterator aFirst, Iterator aLast)
+{
+	int lNumberOfElements = 0;
+	for (Iterator it = aFirst; it != aLast; ++it)
 	{
-		this->pushFront(aData);
-		return this->begin();
+		lNumberOfElements++;
 	}
-	else if (aLoc.m_Ptr == this->m_Back)
+	this->reserve(lNumberOfElements);
+
+	// counted so that appending a list to itself stops at its old end
+	Iterator current = aFirst;
+	for (int lCount = 0; lCount < lNumberOfElements; lCount++)
 	{
-		this->pushBack(aData);
-		return (this->end())--;
+		this->link(this->m_Back, this->createNode(*current));
+		++current;
 	}
-	else
+}
+
+/** Appends copies of the elements of a list (may be this list)
+* @param aOther The list to append
+*/
+template<typename T, typename Allocator>
+void MyList<T, Allocator>::append(const MyList<T, Allocator>& aOther)
+{
+	this->append(aOther.begin(), aOther.end());
+}
+
+/** Appends the elements of another list without copying them (see splice)
+* @param aOther The list to append (left empty)
+*/
+template<typename T, typename Allocator>
+void MyList<T, Allocator>::append(MyList<T, Allocator>&& aOther)
+{
+	if (&aOther == this) return;
+	this->splice(this->end(), aOther);
+}
+
+/** Makes room for aNumberOfElements more elements, so adding them allocates at most one slab of nodes (only if the
+*   allocator can reserve nodes, e.g. NodePoolAllocator)
+* @param aNumberOfElements The number of elements
+*/
+template<typename T, typename Allocator>
+void MyList<T, Allocator>::reserve(const int aNumberOfElements)
+{
+	if (aNumberOfElements > 1) MyListReserveNodes(this->m_Allocator, static_cast<std::size_t>(aNumberOfElements), 0);
+}
+
+template<typename T, typename Allocator>
+void MyList<T, Allocator>::popFront()
+{
+	if (this->m_NumberOfElements == 0) return;
+
+	Node<T>* RemoveNode = this->m_Front;
+	this->unlink(RemoveNode);
+	this->destroyNode(RemoveNode);
+}
+
+template<typename T, typename Allocator>
+void MyList<T, Allocator>::popBack()
+{
+	if (this->m_NumberOfElements == 0) return;
+
+	Node<T>* RemoveNode = this->m_Back->Previous;
+	this->unlink(RemoveNode);
+	this->destroyNode(RemoveNode);
+}
+
+template<typename T, typename Allocator>
+MyListIterator<T> MyList<T, Allocator>::erase(MyListIterator<T> aLoc)
+{
+	Node<T>* RemoveNode = aLoc.m_Ptr;
+	MyListIterator<T> Result(RemoveNode->Next);
+	this->unlink(RemoveNode);
+	this->destroyNode(RemoveNode);
+	return Result;
+}
+
+/** Erases every element
+*/
+template<typename T, typename Allocator>
+void MyList<T, Allocator>::clear()
+{
+	while (this->m_NumberOfElements > 0)
 	{
-		Node<T>* CurrentNode = this->m_Front->Next;
-		while (CurrentNode != aLoc.m_Ptr)
+		this->popFront();
+	}
+}
+
+/** Moves the nodes aFirst to aLast (inclusive) of aOther in front of aLoc
+* @param aLoc The node to move them in front of
+* @param aOther The list the nodes are in (may be this list if aLoc is not one of the nodes)
+* @param aFirst The first node to move
+* @param aLast The last node to move
+* @param aNumberOfElements The number of nodes from aFirst to aLast
+*/
+template<typename T, typename Allocator>
+void MyList<T, Allocator>::spliceNodes(Node<T>* aLoc, MyList<T, Allocator>& aOther, Node<T>* aFirst, Node<T>* aLast, const int aNumberOfElements)
+{
+	if (aLoc == aLast->Next) return;
+
+	// a node can only be freed by the allocator it came from, so the elements of a list with another allocator are
+	// moved into new nodes instead
+	if (!(this->m_Allocator == aOther.m_Allocator))
+	{
+		Node<T>* const lEnd = aLast->Next;
+		Node<T>* current = aFirst;
+		while (current != lEnd)
 		{
-			CurrentNode = CurrentNode->Next;
+			Node<T>* const lNext = current->Next;
+			this->link(aLoc, this->createNode(std::move(current->Data)));
+			aOther.unlink(current);
+			aOther.destroyNode(current);
+			current = lNext;
 		}
+		return;
+	}
 
-		Node<T>* NewNode = new Node<T>;
-		NewNode->Data = aData;
-		NewNode->Next = CurrentNode;
-		NewNode->Previous = CurrentNode->Previous;
+	// unlink them from aOther
+	if (aFirst->Previous == nullptr) aOther.m_Front = aLast->Next;
+	else aFirst->Previous->Next = aLast->Next;
+	aLast->Next->Previous = aFirst->Previous;
+	aOther.m_NumberOfElements -= aNumberOfElements;
+
+	// link them in front of aLoc
+	aFirst->Previous = aLoc->Previous;
+	if (aLoc->Previous == nullptr) this->m_Front = aFirst;
+	else aLoc->Previous->Next = aFirst;
+	aLast->Next = aLoc;
+	aLoc->Previous = aLast;
+	this->m_NumberOfElements += aNumberOfElements;
+}
 
-		CurrentNode->Previous->Next = NewNode;
-		CurrentNode->Previous = NewNode;
+/** Moves every element of aOther in front of aLoc without copying them
+* @param aLoc The location to move the elements to
+* @param aOther The list to move the elements from (another list)
+*/
+template<typename T, typename Allocator>
+void MyList<T, Allocator>::splice(const MyListIterator<T>& aLoc, MyList<T, Allocator>& aOther)
+{
+	if (aOther.m_NumberOfElements == 0) return;
 
-		this->m_NumberOfElements++;
+	this->spliceNodes(aLoc.m_Ptr, aOther, aOther.m_Front, aOther.m_Back->Previous, aOther.m_NumberOfElements);
+}
 
-		return MyListIterator<T>(NewNode);
-	}
+/** Moves one element of aOther in front of aLoc without copying it
+* @param aLoc The location to move the element to
+* @param aOther The list the element is in (may be this list)
+* @param aElement The element to move
+*/
+template<typename T, typename Allocator>
+void MyList<T, Allocator>::splice(const MyListIterator<T>& aLoc, MyList<T, Allocator>& aOther, const MyListIterator<T>& aElement)
+{
+	if (aLoc.m_Ptr == aElement.m_Ptr) return;
+
+	this->spliceNodes(aLoc.m_Ptr, aOther, aElement.m_Ptr, aElement.m_Ptr, 1);
 }
 
-template<typename T>
-void MyList<T>::popFront()
+/** Moves the elements aFirst up to (not including) aLast of aOther in front of aLoc without copying them.
+*   Takes time proportional to the number of elements moved if aOther is another list (to count them), otherwise O(1).
+* @param aLoc The location to move the elements to
+* @param aOther The list the elements are in (may be this list if aLoc is not one of the elements)
+* @param aFirst The first element to move
+* @param aLast One past the last element to move
+*/
+template<typename T, typename Allocator>
+void MyList<T, Allocator>::splice(const MyListIterator<T>& aLoc, MyList<T, Allocator>& aOther, const MyListIterator<T>& aFirst, const MyListIterator<T>& aLast)
 {
-	if (this->m_NumberOfElements == 0) return;
+	if (aFirst.m_Ptr == aLast.m_Ptr) return;
 
-	Node<T>* NewFront = this->m_Front->Next;
-	NewFront->Previous = nullptr;
-	delete this->m_Front;
-	this->m_Front = NewFront;
+	int lNumberOfElements = 0;
+	if (&aOther != this)
+	{
+		for (Node<T>* current = aFirst.m_Ptr; current != aLast.m_Ptr; current = current->Next)
+		{
+			lNumberOfElements++;
+		}
+	}
+	this->spliceNodes(aLoc.m_Ptr, aOther, aFirst.m_Ptr, aLast.m_Ptr->Previous, lNumberOfElements);
+}
 
-	this->m_NumberOfElements--;
+/** Swaps the elements (and allocators) of two lists (iterators stay valid and move to the other list with their element)
+* @param aOther The other list
+*/
+template<typename T, typename Allocator>
+void MyList<T, Allocator>::swap(MyList<T, Allocator>& aOther)
+{
+	std::swap(this->m_Front, aOther.m_Front);
+	std::swap(this->m_Back, aOther.m_Back);
+	std::swap(this->m_NumberOfElements, aOther.m_NumberOfElements);
+	std::swap(this->m_Allocator, aOther.m_Allocator);
 }
 
-template<typename T>
-void MyList<T>::popBack()
+/** Sorts the elements with operator< (see sort(Compare))
+*/
+template<typename T, typename Allocator>
+void MyList<T, Allocator>::sort()
 {
-	if (this->m_NumberOfElements == 0) return;
-	
-	if (this->m_Back->Previous == this->m_Front)
+	this->sort([](const T& aLeft, const T& aRight)->bool {return aLeft < aRight; });
+}
+
+/** Sorts the elements with a stable merge sort that only relinks the nodes, so no element is copied or moved and
+*   iterators stay valid. Runs of 1, 2, 4... elements are merged bottom up in O(n log n) time and O(1) space.
+*   If aCompare throws, the list keeps every element in an unspecified order.
+* @param aCompare Returns true if its first argument goes before its second
+*/
+template<typename T, typename Allocator>
+template<typename Compare>
+void MyList<T, Allocator>::sort(Compare aCompare)
+{
+	if (this->m_NumberOfElements < 2) return;
+
+	// take the elements off as a chain linked by Next only
+	Node<T>* lChain = this->m_Front;
+	this->m_Back->Previous->Next = nullptr;
+
+	// lRuns[i] is a sorted run of 2^i elements, and a higher run holds elements from earlier in the list
+	Node<T>* lRuns[64] = {};
+	Node<T>* lSorted = nullptr;
+	try
 	{
-		delete this->m_Front;
-		this->m_Front = this->m_Back;
+		while (lChain != nullptr)
+		{
+			Node<T>* lRun = lChain;
+			lChain = lChain->Next;
+			lRun->Next = nullptr;
+
+			int lLevel = 0;
+			while (lRuns[lLevel] != nullptr)
+			{
+				MyList<T, Allocator>::mergeNodes(lRuns[lLevel], lRun, aCompare);
+				lRun = lRuns[lLevel];
+				lRuns[lLevel] = nullptr;
+				lLevel++;
+			}
+			lRuns[lLevel] = lRun;
+		}
+
+		for (int lLevel = 0; lLevel < 64; lLevel++)
+		{
+			if (lRuns[lLevel] == nullptr) continue;
+			Node<T>* const lLater = lSorted;
+			lSorted = nullptr;
+			MyList<T, Allocator>::mergeNodes(lRuns[lLevel], lLater, aCompare);
+			lSorted = lRuns[lLevel];
+			lRuns[lLevel] = nullptr;
+		}
 	}
-	else
+	catch (...)
 	{
-		Node<T>* NewBack = this->m_Back->Previous->Previous;
-		delete this->m_Back->Previous;
-		this->m_Back->Previous = NewBack;
-		NewBack->Next = this->m_Back;
+		// put every node back in the list before passing the exception on
+		for (int lLevel = 0; lLevel < 64; lLevel++)
+		{
+			lSorted = MyList<T, Allocator>::concatenateNodes(lRuns[lLevel], lSorted);
+		}
+		this->linkChain(MyList<T, Allocator>::concatenateNodes(lSorted, lChain));
+		throw;
 	}
 
-	this->m_NumberOfElements--;
+	this->linkChain(lSorted);
 }
 
-template<typename T>
-MyListIterator<T> MyList<T>::erase(MyListIterator<T> aLoc)
+/** Merges a sorted chain of nodes linked by Next only into another, taking equal elements from aLeft first
+* @param aLeft The chain of the earlier elements, replaced by the merged chain (holding every node even if aCompare
+*              throws)
+* @param aRight The chain of the later elements
+* @param aCompare Returns true if its first argument goes before its second
+*/
+template<typename T, typename Allocator>
+template<typename Compare>
+void MyList<T, Allocator>::mergeNodes(Node<T>*& aLeft, Node<T>* aRight, Compare& aCompare)
 {
-	if (aLoc.m_Ptr == this->m_Front)
+	if (aRight == nullptr) return;
+
+	Node<T>* lLeft = aLeft;
+	Node<T>* lTail = nullptr;
+	try
 	{
-		this->popFront();
-		return this->begin();
+		// the first node of the merged chain
+		if (aCompare(aRight->Data, lLeft->Data))
+		{
+			aLeft = aRight;
+			aRight = aRight->Next;
+		}
+		else
+		{
+			lLeft = lLeft->Next;
+		}
+		lTail = aLeft;
+
+		while (lLeft != nullptr && aRight != nullptr)
+		{
+			if (aCompare(aRight->Data, lLeft->Data))
+			{
+				lTail->Next = aRight;
+				lTail = aRight;
+				aRight = aRight->Next;
+			}
+			else
+			{
+				lTail->Next = lLeft;
+				lTail = lLeft;
+				lLeft = lLeft->Next;
+			}
+		}
 	}
-	else if (aLoc.m_Ptr == this->m_Back->Previous)
+	catch (...)
 	{
-		this->popBack();
-		return this->end();
+		if (lTail == nullptr) aLeft = MyList<T, Allocator>::concatenateNodes(lLeft, aRight);
+		else lTail->Next = MyList<T, Allocator>::concatenateNodes(lLeft, aRight);
+		throw;
 	}
-	else
+	lTail->Next = (lLeft != nullptr) ? lLeft : aRight;
+}
+
+/** Joins two chains of nodes linked by Next only
+* @param aLeft The first chain (may be nullptr)
+* @param aRight The chain to put after it (may be nullptr)
+*/
+template<typename T, typename Allocator>
+Node<T>* MyList<T, Allocator>::concatenateNodes(Node<T>* aLeft, Node<T>* aRight)
+{
+	if (aLeft == nullptr) return aRight;
+
+	Node<T>* lLast = aLeft;
+	while (lLast->Next != nullptr) lLast = lLast->Next;
+	lLast->Next = aRight;
+	return aLeft;
+}
+
+/** Links a chain of nodes linked by Next only in front of end() as the elements of the list (setting Previous)
+* @param aChain The chain (holding every element of the list)
+*/
+template<typename T, typename Allocator>
+void MyList<T, Allocator>::linkChain(Node<T>* aChain)
+{
+	this->m_Front = aChain;
+	aChain->Previous = nullptr;
+
+	Node<T>* current = aChain;
+	while (current->Next != nullptr)
 	{
-		Node<T>* RemoveNode = aLoc.m_Ptr;
-		RemoveNode->Previous->Next = RemoveNode->Next;
-		RemoveNode->Next->Previous = RemoveNode->Previous;
-		MyListIterator<T> Result(RemoveNode->Next);
-		this->m_NumberOfElements--;
-		delete RemoveNode;
-		return Result;
+		current->Next->Previous = current;
+		current = current->Next;
 	}
-	return MyListIterator<T>(nullptr);
+	current->Next = this->m_Back;
+	this->m_Back->Previous = current;
 }
 
-template<typename T>
-int MyList<T>::size() const
+template<typename T, typename Allocator>
+int MyList<T, Allocator>::size() const
 {
 	return this->m_NumberOfElements;
 }
 
-template<typename T>
-MyListIterator<T> MyList<T>::find(MyListIterator<T> aStart, MyListIterator<T> aEnd, const T& aValue) const
+template<typename T, typename Allocator>
+bool MyList<T, Allocator>::empty() const
+{
+	return this->m_NumberOfElements == 0;
+}
+
+template<typename T, typename Allocator>
+const Allocator& MyList<T, Allocator>::getAllocator() const
+{
+	return this->m_Allocator;
+}
+
+template<typename T, typename Allocator>
+MyListIterator<T> MyList<T, Allocator>::find(MyListIterator<T> aStart, MyListIterator<T> aEnd, const T& aValue) const
 {
 	for (MyListIterator<T> it = aStart; it != aEnd; it++)
 	{
@@ -280,29 +732,27 @@ MyListIterator<T> MyList<T>::find(MyListIterator<T> aStart, MyListIterator<T> aE
 	return aEnd;
 }
 
-template<typename T>
-MyListIterator<T> MyList<T>::begin() const
+template<typename T, typename Allocator>
+MyListIterator<T> MyList<T, Allocator>::begin() const
 {
 	return MyListIterator<T>(this->m_Front);
 }
 
-template<typename T>
-MyListIterator<T> MyList<T>::end() const
+template<typename T, typename Allocator>
+MyListIterator<T> MyList<T, Allocator>::end() const
 {
 	return MyListIterator<T>(this->m_Back);
 }
 
-template<typename T>
-MyList<T>& MyList<T>::operator=(const MyList<T>& aRight)
+template<typename T, typename Allocator>
+MyList<T, Allocator>& MyList<T, Allocator>::operator=(const MyList<T, Allocator>& aRight)
 {
-	Node<T>* current = aRight.m_Front;
+	if (this == &aRight) return *this;
 
-	this->m_Front = new Node<T>;
-	this->m_Front->Next = nullptr;
-	this->m_Front->Previous = nullptr;
-	this->m_Back = m_Front;
-	this->m_NumberOfElements = 0;
+	this->clear();
+	this->reserve(aRight.m_NumberOfElements);
 
+	Node<T>* current = aRight.m_Front;
 	while (current != aRight.m_Back)
 	{
 		this->pushBack(current->Data);
@@ -312,6 +762,16 @@ MyList<T>& MyList<T>::operator=(const MyList<T>& aRight)
 	return *this;
 }
 
+/** Move assignment operator (takes the nodes of aRight, which is left with the old elements of this list)
+* @param aRight The right side of the = operator
+*/
+template<typename T, typename Allocator>
+MyList<T, Allocator>& MyList<T, Allocator>::operator=(MyList<T, Allocator>&& aRight)
+{
+	this->swap(aRight);
+	return *this;
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -406,4 +866,4 @@ MyListIterator<T>& MyListIterator<T>::operator=(const MyListIterator<T>& aRight)
 	return *(this);
 }
 
-#endif
\ No newline at end of file
+#endif
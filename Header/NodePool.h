@@ -0,0 +1,189 @@
+/**
+*  @file    NodePool.h
+*  @author  Jordan Nesley
+**/
+
+#ifndef NODEPOOL_H
+#define NODEPOOL_H
+
+#include <cstddef> // std::size_t, std::max_align_t
+#include <memory> // std::shared_ptr, std::make_shared
+#include <new> // operator new, placement new
+#include <utility> // std::forward
+#include <vector>
+
+#pragma unmanaged
+
+/** Hands out memory for nodes of one size (e.g. the nodes of a linked list) from slabs of many nodes, so creating a
+*   node is a pointer bump and erasing one pushes it on a free list for the next node to reuse. The slabs start small
+*   (a pool for a list of a few elements stays small) and double up to MAXIMUM_SLAB_LENGTH nodes; they are only given
+*   back when the pool is destroyed. reserve makes room for many nodes with one slab (e.g. before appending a range).
+*
+*   A pool is not thread safe: the lists sharing one must be used from one thread at a time.
+*/
+class NodePool
+{
+public:
+	static const std::size_t INITIAL_SLAB_LENGTH = 8;
+	static const std::size_t MAXIMUM_SLAB_LENGTH = 1024;
+
+	NodePool(const std::size_t aNodeSize, const std::size_t aNodeAlignment);
+	NodePool(const NodePool&) = delete;
+	~NodePool();
+
+	NodePool& operator=(const NodePool&) = delete;
+
+	void* allocate();
+	void deallocate(void* const aNode);
+	void reserve(const std::size_t aNumberOfNodes);
+
+	std::size_t getNodeSize() const;
+	std::size_t getNumberOfSlabs() const;
+	std::size_t getCapacity() const;
+
+private:
+	struct FreeNode
+	{
+		FreeNode* Next;
+	};
+
+	FreeNode* m_FreeNodes;
+	std::size_t m_NumberOfFreeNodes;
+	unsigned char* m_SlabPosition;
+	unsigned char* m_SlabEnd;
+	std::vector<void*> m_Slabs;
+	std::size_t m_NodeSize;
+	std::size_t m_NextSlabLength;
+	std::size_t m_Capacity;
+
+	void addSlab(const std::size_t aMinimumLength);
+};
+
+/** Returns memory for one node
+*/
+inline void* NodePool::allocate()
+{
+	if (this->m_FreeNodes != nullptr)
+	{
+		FreeNode* const lNode = this->m_FreeNodes;
+		this->m_FreeNodes = lNode->Next;
+		this->m_NumberOfFreeNodes--;
+		return lNode;
+	}
+
+	if (this->m_SlabPosition == this->m_SlabEnd) this->addSlab(1);
+	void* const lNode = this->m_SlabPosition;
+	this->m_SlabPosition += this->m_NodeSize;
+	return lNode;
+}
+
+/** Gives back the memory of a node for the next allocate to reuse
+* @param aNode Memory returned by allocate of this pool
+*/
+inline void NodePool::deallocate(void* const aNode)
+{
+	FreeNode* const lNode = static_cast<FreeNode*>(aNode);
+	lNode->Next = this->m_FreeNodes;
+	this->m_FreeNodes = lNode;
+	this->m_NumberOfFreeNodes++;
+}
+
+/** The default node allocator of MyList: single nodes come from a NodePool, anything else from operator new.
+*
+*   Every default constructed allocator has a pool of its own. Copies of the allocator share the pool, so lists built
+*   with the same allocator share one pool (see Graph). Lists can only splice nodes between each other if they share
+*   a pool. A copy of a list gets a new pool (see select_on_container_copy_construction) unless it is built with an
+*   allocator passed explicitly.
+*/
+template<typename T>
+class NodePoolAllocator
+{
+	static_assert(alignof(T) <= alignof(std::max_align_t), "NodePoolAllocator does not support over-aligned nodes");
+
+private:
+	std::shared_ptr<NodePool> m_Pool;
+
+public:
+	typedef T value_type;
+
+	NodePoolAllocator() : m_Pool(std::make_shared<NodePool>(sizeof(T), alignof(T))) {}
+
+	/** Allocates memory for aNumberOfElements nodes
+	*/
+	T* allocate(const std::size_t aNumberOfElements)
+	{
+		if (aNumberOfElements == 1) return static_cast<T*>(this->m_Pool->allocate());
+		return static_cast<T*>(::operator new(aNumberOfElements * sizeof(T)));
+	}
+
+	/** Frees memory returned by allocate
+	*/
+	void deallocate(T* const aPointer, const std::size_t aNumberOfElements)
+	{
+		if (aNumberOfElements == 1) this->m_Pool->deallocate(aPointer);
+		else ::operator delete(aPointer);
+	}
+
+	/** Makes room in the pool for aNumberOfNodes single nodes with at most one slab
+	*/
+	void reserve(const std::size_t aNumberOfNodes) { this->m_Pool->reserve(aNumberOfNodes); }
+
+	/** Returns the pool the nodes come from
+	*/
+	const NodePool& getPool() const { return *this->m_Pool; }
+
+	/** Returns the allocator for a copy of a list (see std::allocator_traits): an allocator with a new pool, so the copy
+	*   does not grow (or get freed into) the pool of the original from another thread or object
+	*/
+	NodePoolAllocator<T> select_on_container_copy_construction() const { return NodePoolAllocator<T>(); }
+
+	bool operator==(const NodePoolAllocator<T>& aRight) const { return this->m_Pool == aRight.m_Pool; }
+	bool operator!=(const NodePoolAllocator<T>& aRight) const { return this->m_Pool != aRight.m_Pool; }
+};
+
+/** Creates objects of one type in a NodePool, e.g. objects that link themselves into an IntrusiveList. The objects
+*   must be destroyed (see destroy) before the pool is, or their destructors never run.
+*/
+template<typename T>
+class ObjectPool
+{
+	static_assert(alignof(T) <= alignof(std::max_align_t), "ObjectPool does not support over-aligned objects");
+
+private:
+	NodePool m_Pool;
+
+public:
+	ObjectPool() : m_Pool(sizeof(T), alignof(T)) {}
+
+	/** Creates an object
+	* @param aArgs The arguments of the constructor of the object
+	*/
+	template<typename... Args>
+	T* create(Args&&... aArgs)
+	{
+		void* const lMemory = this->m_Pool.allocate();
+		try
+		{
+			return new (lMemory) T(std::forward<Args>(aArgs)...);
+		}
+		catch (...)
+		{
+			this->m_Pool.deallocate(lMemory);
+			throw;
+		}
+	}
+
+	/** Destroys an object returned by create
+	*/
+	void destroy(T* const aObject)
+	{
+		aObject->~T();
+		this->m_Pool.deallocate(aObject);
+	}
+
+	/** Returns the pool the objects come from
+	*/
+	const NodePool& getPool() const { return this->m_Pool; }
+};
+
+#endif
@@ -35,6 +35,10 @@ class Parent
 		unsigned getRank() const;
 		void setRank(const unsigned aRank);
 		std::vector<std::unique_ptr<ParentPropertyBase>> getProperties() const;
+		std::vector<double> getValues() const;
+		std::vector<double> getNormalizedValues() const;
+		void getLimits(std::vector<double>& aMaxValues, std::vector<double>& aMinValues) const;
+		void setValues(const double* const aValues);
 
 		Parent Crossover(const Parent aMate, const unsigned aSeed) const;
 		void Randomize(const unsigned aSeed);
@@ -33,6 +33,7 @@ class ParentPropertyDouble : public ParentPropertyBase
 		double getValue() const;
 		double getMax() const;
 		double getMin() const;
+		void setValue(const double aValue);
 
 		ParentPropertyBase* Crossover(const ParentPropertyBase * const aParentProperty, const unsigned aSeed) const;
 		void Randomize(const unsigned aSeed);
@@ -0,0 +1,68 @@
+/**
+*  @file    ProcessPoolEvaluator.h
+*  @author  Jordan Nesley
+**/
+
+#ifndef PROCESSPOOLEVALUATOR_H
+#define PROCESSPOOLEVALUATOR_H
+
+#include "FitnessEvaluatorBase.h"
+#include "DebugLogger.h"
+#include <vector>
+#include <string>
+#include <deque>
+#include <chrono>
+
+#pragma unmanaged
+
+#ifndef _WIN32
+
+#include <sys/types.h> // pid_t
+
+/** Evaluates fitness with a pool of persistent worker processes (e.g. an external simulator).
+*   Each worker is started once and reads parents from stdin, one per line as space separated property values,
+*   and writes one fitness value per line to stdout in the same order. Parents are streamed to the workers
+*   in batches and a worker that crashes, or sends nothing back for longer than the timeout, is restarted and its
+*   unfinished parents are sent again.
+*/
+class ProcessPoolEvaluator : public FitnessEvaluatorBase
+{
+	private:
+		struct Worker
+		{
+			pid_t ProcessId;
+			int Socket;
+			std::string WriteBuffer;
+			std::string ReadBuffer;
+			std::deque<unsigned> Jobs;
+			std::chrono::steady_clock::time_point LastActivity; // when the worker last read a parent or wrote a fitness
+		};
+
+		std::vector<std::string> m_Command;
+		unsigned m_NumberOfWorkers;
+		unsigned m_BatchSize;
+		unsigned m_MaxRetries;
+		unsigned m_Timeout;
+		std::vector<Worker> m_Workers;
+
+		void startWorker(Worker& aWorker);
+		void stopWorker(Worker& aWorker);
+
+	public:
+		static const unsigned STOP_TIMEOUT = 1000; // milliseconds a stopped worker gets to exit after SIGTERM before SIGKILL
+
+		ProcessPoolEvaluator(const std::vector<std::string>& aCommand, const unsigned aNumberOfWorkers, const unsigned aBatchSize = 16, const unsigned aMaxRetries = 3, const unsigned aTimeout = 60000);
+		~ProcessPoolEvaluator() override;
+
+		void Evaluate(const std::vector<double>& aValues, const unsigned aNumberOfProperties, std::vector<double>& aFitness) override;
+
+		enum Exeception
+		{
+			CONSTRUCTOR_EXCEPTION,
+			WORKER_START_EXCEPTION,
+		};
+};
+
+#endif
+
+#endif
@@ -0,0 +1,35 @@
+/**
+*  @file    RealCrossover.h
+*  @author  Jordan Nesley
+**/
+
+#ifndef REALCROSSOVER_H
+#define REALCROSSOVER_H
+
+#include "GeneticAlgorithmParameters.h"
+#include "Utilities.h"
+#include <vector>
+#include <math.h>
+
+#pragma unmanaged
+
+/** Real coded crossover operators that cross over a whole generation at once. The parents' property values are stored
+*   one row per child (row i of the mothers is crossed with row i of the fathers to make row i of the children) and all
+*   the random numbers are generated up front so the inner loops are simple enough to be vectorized (all but SBX, whose
+*   pow is a scalar library call).
+*/
+class RealCrossover
+{
+private:
+	static void arithmetic(const double* const aMothers, const double* const aFathers, double* const aChildren, const double* const aRandom, const unsigned aNumberOfChildren, const unsigned aNumberOfProperties);
+	static void blx(const double* const aMothers, const double* const aFathers, double* const aChildren, const double* const aRandom, const std::size_t aNumberOfValues, const double aAlpha);
+	static void sbx(const double* const aMothers, const double* const aFathers, double* const aChildren, const double* const aRandom, const std::size_t aNumberOfValues, const double aDistributionIndex);
+	static void uniform(const double* const aMothers, const double* const aFathers, double* const aChildren, const double* const aRandom, const std::size_t aNumberOfValues);
+	static void clamp(double* const aChildren, const double* const aMaxValues, const double* const aMinValues, const unsigned aNumberOfChildren, const unsigned aNumberOfProperties);
+
+public:
+	static void Crossover(const CrossoverType aCrossoverType, const double aCrossoverParameter, const std::vector<double>& aMothers, const std::vector<double>& aFathers,
+		std::vector<double>& aChildren, const std::vector<double>& aMaxValues, const std::vector<double>& aMinValues, const unsigned aSeed);
+};
+
+#endif
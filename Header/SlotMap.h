@@ -0,0 +1,305 @@
+/**
+*  @file    SlotMap.h
+*  @author  Jordan Nesley
+**/
+
+#ifndef SLOTMAP_H
+#define SLOTMAP_H
+
+#include <cstddef> // std::size_t
+#include <cstdint> // std::uint32_t
+#include <memory> // std::unique_ptr
+#include <new> // placement new
+#include <type_traits> // std::aligned_storage
+#include <utility> // std::forward, std::move
+#include <vector>
+
+#pragma unmanaged
+
+/** A reference to an element of a SlotMap: the index of its slot and the generation of the slot when the element was
+*   put in it. A default constructed handle refers to nothing.
+*/
+struct SlotMapHandle
+{
+	std::uint32_t Index;
+	std::uint32_t Generation; // odd while the slot holds the element, 0 for no element
+
+	SlotMapHandle() : Index(0), Generation(0) {}
+	SlotMapHandle(const std::uint32_t aIndex, const std::uint32_t aGeneration) : Index(aIndex), Generation(aGeneration) {}
+
+	bool isNull() const { return this->Generation == 0; }
+	bool operator==(const SlotMapHandle& aRight) const { return this->Index == aRight.Index && this->Generation == aRight.Generation; }
+	bool operator!=(const SlotMapHandle& aRight) const { return !(*this == aRight); }
+};
+
+/** Stores elements in slots that are reused after their element is erased, and hands out a SlotMapHandle for every
+*   element. A slot counts the elements it has held (its generation), so a handle to an erased element never refers to
+*   the element that reuses its slot: get returns nullptr for it instead of dangling. Looking up a handle is an index
+*   into a chunk.
+*
+*   The slots are allocated CHUNK_LENGTH at a time and never move, so pointers to the elements (e.g. the links of an
+*   IntrusiveList) stay valid until the element is erased.
+*/
+template<typename T>
+class SlotMap
+{
+public:
+	static const std::size_t CHUNK_LENGTH = 256;
+
+	typedef SlotMapHandle Handle;
+
+	SlotMap();
+	SlotMap(const SlotMap&) = delete;
+	~SlotMap();
+
+	SlotMap& operator=(const SlotMap&) = delete;
+
+	template<typename... Args>
+	Handle emplace(Args&&... aArgs);
+	Handle insert(const T& aElement);
+	Handle insert(T&& aElement);
+	bool erase(const Handle& aHandle);
+	void clear();
+
+	T* get(const Handle& aHandle);
+	const T* get(const Handle& aHandle) const;
+	bool contains(const Handle& aHandle) const;
+	Handle getHandle(const T& aElement) const;
+	T& operator[](const Handle& aHandle);
+	const T& operator[](const Handle& aHandle) const;
+
+	std::size_t size() const;
+	bool empty() const;
+
+	enum Exeception
+	{
+		INVALID_HANDLE_EXCEPTION,
+	};
+
+private:
+	// the element is the first member, so the slot of an element is at the address of the element
+	struct Slot
+	{
+		typename std::aligned_storage<sizeof(T), alignof(T)>::type Element;
+		std::uint32_t Generation; // odd while the slot holds an element
+		std::uint32_t Index;
+
+		T* element() { return reinterpret_cast<T*>(&this->Element); }
+		const T* element() const { return reinterpret_cast<const T*>(&this->Element); }
+	};
+
+	std::vector<std::unique_ptr<Slot[]>> m_Chunks;
+	std::vector<std::uint32_t> m_FreeSlots;
+	std::size_t m_NumberOfSlots;
+	std::size_t m_NumberOfElements;
+
+	Slot& slot(const std::uint32_t aIndex) { return this->m_Chunks[aIndex / CHUNK_LENGTH][aIndex % CHUNK_LENGTH]; }
+	const Slot& slot(const std::uint32_t aIndex) const { return this->m_Chunks[aIndex / CHUNK_LENGTH][aIndex % CHUNK_LENGTH]; }
+	Slot* find(const Handle& aHandle) const;
+	Slot& freeSlot();
+};
+
+template<typename T>
+const std::size_t SlotMap<T>::CHUNK_LENGTH;
+
+/** Default constructor for SlotMap
+*/
+template<typename T>
+SlotMap<T>::SlotMap()
+{
+	this->m_NumberOfSlots = 0;
+	this->m_NumberOfElements = 0;
+}
+
+/** Destructor for SlotMap: destroys the elements left
+*/
+template<typename T>
+SlotMap<T>::~SlotMap()
+{
+	this->clear();
+}
+
+/** Returns the slot a handle refers to
+* @param aHandle The handle
+* @return The slot, or nullptr if the element of the handle has been erased
+*/
+template<typename T>
+typename SlotMap<T>::Slot* SlotMap<T>::find(const Handle& aHandle) const
+{
+	if (aHandle.Index >= this->m_NumberOfSlots) return nullptr;
+
+	const Slot& lSlot = this->slot(aHandle.Index);
+	if (lSlot.Generation != aHandle.Generation || aHandle.Generation % 2 == 0) return nullptr;
+	return const_cast<Slot*>(&lSlot);
+}
+
+/** Returns an empty slot (adding a chunk if every slot is taken)
+*/
+template<typename T>
+typename SlotMap<T>::Slot& SlotMap<T>::freeSlot()
+{
+	if (this->m_FreeSlots.empty())
+	{
+		if (this->m_NumberOfSlots % CHUNK_LENGTH == 0)
+		{
+			std::unique_ptr<Slot[]> lChunk(new Slot[CHUNK_LENGTH]);
+			for (std::size_t lCount = 0; lCount < CHUNK_LENGTH; lCount++)
+			{
+				lChunk[lCount].Generation = 0;
+				lChunk[lCount].Index = static_cast<std::uint32_t>(this->m_NumberOfSlots + lCount);
+			}
+			this->m_Chunks.push_back(std::move(lChunk));
+		}
+		this->m_FreeSlots.push_back(static_cast<std::uint32_t>(this->m_NumberOfSlots));
+		this->m_NumberOfSlots++;
+	}
+
+	return this->slot(this->m_FreeSlots.back());
+}
+
+/** Constructs a new element
+* @param aArgs The arguments of the constructor of the element
+* @return The handle of the element
+*/
+template<typename T>
+template<typename... Args>
+SlotMapHandle SlotMap<T>::emplace(Args&&... aArgs)
+{
+	Slot& lSlot = this->freeSlot();
+	new (&lSlot.Element) T(std::forward<Args>(aArgs)...);
+	this->m_FreeSlots.pop_back();
+
+	lSlot.Generation++;
+	this->m_NumberOfElements++;
+	return Handle(lSlot.Index, lSlot.Generation);
+}
+
+/** Adds a copy of an element
+* @param aElement The element
+* @return The handle of the element
+*/
+template<typename T>
+SlotMapHandle SlotMap<T>::insert(const T& aElement)
+{
+	return this->emplace(aElement);
+}
+
+/** Moves an element into the map
+* @param aElement The element
+* @return The handle of the element
+*/
+template<typename T>
+SlotMapHandle SlotMap<T>::insert(T&& aElement)
+{
+	return this->emplace(std::move(aElement));
+}
+
+/** Destroys an element (its slot is reused by a later element)
+* @param aHandle The handle of the element
+* @return False if the element had already been erased
+*/
+template<typename T>
+bool SlotMap<T>::erase(const Handle& aHandle)
+{
+	Slot* const lSlot = this->find(aHandle);
+	if (lSlot == nullptr) return false;
+
+	lSlot->element()->~T();
+	lSlot->Generation++;
+	this->m_FreeSlots.push_back(lSlot->Index);
+	this->m_NumberOfElements--;
+	return true;
+}
+
+/** Destroys every element (the slots are kept, and handles to the elements stay invalid)
+*/
+template<typename T>
+void SlotMap<T>::clear()
+{
+	for (std::size_t lCount = 0; lCount < this->m_NumberOfSlots && this->m_NumberOfElements > 0; lCount++)
+	{
+		Slot& lSlot = this->slot(static_cast<std::uint32_t>(lCount));
+		if (lSlot.Generation % 2 == 1) this->erase(Handle(lSlot.Index, lSlot.Generation));
+	}
+}
+
+/** Returns the element of a handle
+* @param aHandle The handle
+* @return The element, or nullptr if it has been erased
+*/
+template<typename T>
+T* SlotMap<T>::get(const Handle& aHandle)
+{
+	Slot* const lSlot = this->find(aHandle);
+	return (lSlot == nullptr) ? nullptr : lSlot->element();
+}
+
+/** Returns the element of a handle
+* @param aHandle The handle
+* @return The element, or nullptr if it has been erased
+*/
+template<typename T>
+const T* SlotMap<T>::get(const Handle& aHandle) const
+{
+	const Slot* const lSlot = this->find(aHandle);
+	return (lSlot == nullptr) ? nullptr : lSlot->element();
+}
+
+/** Returns whether the element of a handle is in the map
+* @param aHandle The handle
+*/
+template<typename T>
+bool SlotMap<T>::contains(const Handle& aHandle) const
+{
+	return this->find(aHandle) != nullptr;
+}
+
+/** Returns the handle of an element of the map
+* @param aElement The element (it must be in the map)
+*/
+template<typename T>
+SlotMapHandle SlotMap<T>::getHandle(const T& aElement) const
+{
+	const Slot* const lSlot = reinterpret_cast<const Slot*>(&aElement);
+	return Handle(lSlot->Index, lSlot->Generation);
+}
+
+/** Returns the element of a handle
+* @param aHandle The handle (throws INVALID_HANDLE_EXCEPTION if its element has been erased)
+*/
+template<typename T>
+T& SlotMap<T>::operator[](const Handle& aHandle)
+{
+	T* const lElement = this->get(aHandle);
+	if (lElement == nullptr) throw INVALID_HANDLE_EXCEPTION;
+	return *lElement;
+}
+
+/** Returns the element of a handle
+* @param aHandle The handle (throws INVALID_HANDLE_EXCEPTION if its element has been erased)
+*/
+template<typename T>
+const T& SlotMap<T>::operator[](const Handle& aHandle) const
+{
+	const T* const lElement = this->get(aHandle);
+	if (lElement == nullptr) throw INVALID_HANDLE_EXCEPTION;
+	return *lElement;
+}
+
+/** Returns the number of elements
+*/
+template<typename T>
+std::size_t SlotMap<T>::size() const
+{
+	return this->m_NumberOfElements;
+}
+
+/** Returns whether the map has no elements
+*/
+template<typename T>
+bool SlotMap<T>::empty() const
+{
+	return this->m_NumberOfElements == 0;
+}
+
+#endif
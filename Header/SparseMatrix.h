@@ -0,0 +1,423 @@
+/**
+*  @file    SparseMatrix.h
+*  @author  Jordan Nesley
+**/
+
+#ifndef SPARSEMATRIX_H
+#define SPARSEMATRIX_H
+
+#include "MultidimensionalArray.h"
+#include <vector>
+#include <cstddef> // std::size_t
+#include <algorithm> // std::fill, std::lower_bound
+#include <utility> //std::move
+
+#pragma unmanaged
+
+/** A two dimensional array that only stores its non-zero elements, in compressed sparse row (CSR) form: the values and
+*   column indices of every row one after the other, and where each row starts. Memory and the cost of the products
+*   grow with the number of non-zero elements instead of rows * columns.
+*
+*   The element API matches a 2 dimensional MultidimensionalArray. Reading an element is a binary search of its row;
+*   setting an element that was zero (or setting one to zero) shifts every element after it, so large matrices should be
+*   built from a dense array or directly from the CSR arrays.
+*
+*   The products only ever walk along rows of the matrix, so multiplyTransposed covers the column (CSC) access pattern.
+*/
+template<typename T>
+class SparseMatrix
+{
+private:
+	std::size_t m_NumberOfRows;
+	std::size_t m_NumberOfColumns;
+	std::vector<std::size_t> m_RowStarts; // m_NumberOfRows + 1 positions in m_Columns/m_Values
+	std::vector<std::size_t> m_Columns;
+	std::vector<T> m_Values;
+
+	std::size_t findElement(const std::size_t aRow, const std::size_t aColumn) const;
+
+public:
+	typedef T value_type;
+
+	SparseMatrix();
+	SparseMatrix(const std::size_t aNumberOfRows, const std::size_t aNumberOfColumns);
+	SparseMatrix(const std::size_t aNumberOfRows, const std::size_t aNumberOfColumns, std::vector<std::size_t> aRowStarts, std::vector<std::size_t> aColumns, std::vector<T> aValues);
+	template<typename Storage>
+	explicit SparseMatrix(const MultidimensionalArray<T, Storage>& aArray);
+
+	T getElement(const std::vector<std::size_t>& aCoordinates) const;
+	std::size_t getTotalNumberOfElements() const;
+	std::size_t getNumberOfDimensions() const;
+	std::size_t getNumberOfElementsOfDimension(const std::size_t aDimension) const;
+	std::vector<std::size_t> getNumberOfElementsOfAllDimensions() const;
+	std::size_t getNumberOfNonZeros() const;
+	double getDensity() const;
+
+	const std::vector<std::size_t>& getRowStarts() const;
+	const std::vector<std::size_t>& getColumns() const;
+	const std::vector<T>& getValues() const;
+
+	void setElement(const std::vector<std::size_t>& aCoordinates, const T aValue);
+
+	// the products take vectors and dense matrices of any element type (e.g. float with a double matrix)
+	template<typename V>
+	V dotRow(const std::size_t aRow, const V* const aVector) const;
+	template<typename V>
+	void multiplyVector(const V* const aVector, V* const aResult) const;
+	template<typename V>
+	void multiplyVectorTransposed(const V* const aVector, V* const aResult) const;
+	template<typename D, typename R>
+	void multiply(const D* const aDense, const std::size_t aNumberOfColumns, R* const aResult) const;
+	template<typename D, typename R>
+	void multiplyTransposed(const D* const aDense, const std::size_t aNumberOfColumns, R* const aResult) const;
+
+	MultidimensionalArray<T> toMultidimensionalArray() const;
+
+	enum Exeception
+	{
+		CONSTRUCTOR_EXCEPTION,
+		DIMENSIONS_DONT_MATCH,
+		OUT_OF_RANGE,
+	};
+};
+
+/** Default constructor for SparseMatrix
+*/
+template<typename T>
+SparseMatrix<T>::SparseMatrix()
+{
+	this->m_NumberOfRows = 0;
+	this->m_NumberOfColumns = 0;
+	this->m_RowStarts = std::vector<std::size_t>(1, 0);
+}
+
+/** Constructor for a SparseMatrix with every element 0
+* @param aNumberOfRows The number of rows
+* @param aNumberOfColumns The number of columns
+*/
+template<typename T>
+SparseMatrix<T>::SparseMatrix(const std::size_t aNumberOfRows, const std::size_t aNumberOfColumns)
+{
+	this->m_NumberOfRows = aNumberOfRows;
+	this->m_NumberOfColumns = aNumberOfColumns;
+	this->m_RowStarts = std::vector<std::size_t>(aNumberOfRows + 1, 0);
+}
+
+/** Constructor for SparseMatrix from the CSR arrays
+* @param aNumberOfRows The number of rows
+* @param aNumberOfColumns The number of columns
+* @param aRowStarts The position in aColumns/aValues of the first element of each row, followed by the number of elements
+* @param aColumns The column of each element (increasing within a row)
+* @param aValues The value of each element
+*/
+template<typename T>
+SparseMatrix<T>::SparseMatrix(const std::size_t aNumberOfRows, const std::size_t aNumberOfColumns, std::vector<std::size_t> aRowStarts, std::vector<std::size_t> aColumns, std::vector<T> aValues)
+{
+	if (aRowStarts.size() != aNumberOfRows + 1 || aRowStarts[0] != 0 || aColumns.size() != aValues.size() || aRowStarts[aNumberOfRows] != aValues.size()) throw SparseMatrix::CONSTRUCTOR_EXCEPTION;
+
+	for (std::size_t lRow = 0; lRow < aNumberOfRows; lRow++)
+	{
+		if (aRowStarts[lRow] > aRowStarts[lRow + 1]) throw SparseMatrix::CONSTRUCTOR_EXCEPTION;
+		for (std::size_t lPosition = aRowStarts[lRow]; lPosition < aRowStarts[lRow + 1]; lPosition++)
+		{
+			if (aColumns[lPosition] >= aNumberOfColumns) throw SparseMatrix::CONSTRUCTOR_EXCEPTION;
+			if (lPosition > aRowStarts[lRow] && aColumns[lPosition] <= aColumns[lPosition - 1]) throw SparseMatrix::CONSTRUCTOR_EXCEPTION;
+		}
+	}
+
+	this->m_NumberOfRows = aNumberOfRows;
+	this->m_NumberOfColumns = aNumberOfColumns;
+	this->m_RowStarts = std::move(aRowStarts);
+	this->m_Columns = std::move(aColumns);
+	this->m_Values = std::move(aValues);
+}
+
+/** Constructor for SparseMatrix that keeps the non-zero elements of a 2 dimensional array
+* @param aArray The array
+*/
+template<typename T>
+template<typename Storage>
+SparseMatrix<T>::SparseMatrix(const MultidimensionalArray<T, Storage>& aArray)
+{
+	if (aArray.getNumberOfDimensions() != 2) throw SparseMatrix::DIMENSIONS_DONT_MATCH;
+
+	this->m_NumberOfRows = aArray.getNumberOfElementsOfDimension(0);
+	this->m_NumberOfColumns = aArray.getNumberOfElementsOfDimension(1);
+	this->m_RowStarts = std::vector<std::size_t>(this->m_NumberOfRows + 1, 0);
+
+	const T* const lData = aArray.data();
+	for (std::size_t lRow = 0; lRow < this->m_NumberOfRows; lRow++)
+	{
+		for (std::size_t lColumn = 0; lColumn < this->m_NumberOfColumns; lColumn++)
+		{
+			const T lValue = lData[lRow * this->m_NumberOfColumns + lColumn];
+			if (lValue != T())
+			{
+				this->m_Columns.push_back(lColumn);
+				this->m_Values.push_back(lValue);
+			}
+		}
+		this->m_RowStarts[lRow + 1] = this->m_Values.size();
+	}
+}
+
+/** Returns the element located at the specified coordinates
+* @param aCoordinates The coordinates for the element {row, column}
+* @return The element
+*/
+template<typename T>
+T SparseMatrix<T>::getElement(const std::vector<std::size_t>& aCoordinates) const
+{
+	if (aCoordinates.size() != 2) throw SparseMatrix::DIMENSIONS_DONT_MATCH;
+	if (aCoordinates[0] >= this->m_NumberOfRows || aCoordinates[1] >= this->m_NumberOfColumns) throw SparseMatrix::OUT_OF_RANGE;
+
+	const std::size_t lPosition = this->findElement(aCoordinates[0], aCoordinates[1]);
+	if (lPosition == this->m_RowStarts[aCoordinates[0] + 1] || this->m_Columns[lPosition] != aCoordinates[1]) return T();
+
+	return this->m_Values[lPosition];
+}
+
+/** Returns the total number of elements of the matrix (including the zeros)
+*/
+template<typename T>
+std::size_t SparseMatrix<T>::getTotalNumberOfElements() const
+{
+	return this->m_NumberOfRows * this->m_NumberOfColumns;
+}
+
+/** Returns the number of dimensions (2)
+*/
+template<typename T>
+std::size_t SparseMatrix<T>::getNumberOfDimensions() const
+{
+	return 2;
+}
+
+/** Returns the length of a dimension
+* @param aDimension 0 for the number of rows, 1 for the number of columns
+*/
+template<typename T>
+std::size_t SparseMatrix<T>::getNumberOfElementsOfDimension(const std::size_t aDimension) const
+{
+	if (aDimension > 1) throw SparseMatrix::DIMENSIONS_DONT_MATCH;
+
+	return (aDimension == 0) ? this->m_NumberOfRows : this->m_NumberOfColumns;
+}
+
+/** Returns the lengths of both dimensions
+*/
+template<typename T>
+std::vector<std::size_t> SparseMatrix<T>::getNumberOfElementsOfAllDimensions() const
+{
+	return { this->m_NumberOfRows, this->m_NumberOfColumns };
+}
+
+/** Returns the number of stored (non-zero) elements
+*/
+template<typename T>
+std::size_t SparseMatrix<T>::getNumberOfNonZeros() const
+{
+	return this->m_Values.size();
+}
+
+/** Returns the fraction of the elements that are stored (0 to 1)
+*/
+template<typename T>
+double SparseMatrix<T>::getDensity() const
+{
+	if (this->getTotalNumberOfElements() == 0) return 0.0;
+
+	return static_cast<double>(this->m_Values.size()) / this->getTotalNumberOfElements();
+}
+
+/** Returns the position in m_Columns of the first element of each row followed by the number of stored elements
+*/
+template<typename T>
+const std::vector<std::size_t>& SparseMatrix<T>::getRowStarts() const
+{
+	return this->m_RowStarts;
+}
+
+/** Returns the column of each stored element
+*/
+template<typename T>
+const std::vector<std::size_t>& SparseMatrix<T>::getColumns() const
+{
+	return this->m_Columns;
+}
+
+/** Returns the value of each stored element
+*/
+template<typename T>
+const std::vector<T>& SparseMatrix<T>::getValues() const
+{
+	return this->m_Values;
+}
+
+/** Sets the element located at the coordinates. Setting an element to 0 removes it.
+* @param aCoordinates The coordinates for the element {row, column}
+*/
+template<typename T>
+void SparseMatrix<T>::setElement(const std::vector<std::size_t>& aCoordinates, const T aValue)
+{
+	if (aCoordinates.size() != 2) throw SparseMatrix::DIMENSIONS_DONT_MATCH;
+	if (aCoordinates[0] >= this->m_NumberOfRows || aCoordinates[1] >= this->m_NumberOfColumns) throw SparseMatrix::OUT_OF_RANGE;
+
+	const std::size_t lRow = aCoordinates[0];
+	const std::size_t lPosition = this->findElement(lRow, aCoordinates[1]);
+	const bool lFound = lPosition != this->m_RowStarts[lRow + 1] && this->m_Columns[lPosition] == aCoordinates[1];
+
+	if (lFound && aValue != T())
+	{
+		this->m_Values[lPosition] = aValue;
+	}
+	else if (lFound)
+	{
+		this->m_Columns.erase(this->m_Columns.begin() + lPosition);
+		this->m_Values.erase(this->m_Values.begin() + lPosition);
+		for (std::size_t lCount = lRow + 1; lCount <= this->m_NumberOfRows; lCount++)
+		{
+			this->m_RowStarts[lCount]--;
+		}
+	}
+	else if (aValue != T())
+	{
+		this->m_Columns.insert(this->m_Columns.begin() + lPosition, aCoordinates[1]);
+		this->m_Values.insert(this->m_Values.begin() + lPosition, aValue);
+		for (std::size_t lCount = lRow + 1; lCount <= this->m_NumberOfRows; lCount++)
+		{
+			this->m_RowStarts[lCount]++;
+		}
+	}
+}
+
+/** Returns the dot product of a row and a dense vector
+* @param aRow The row
+* @param aVector The vector (the length of a row)
+*/
+template<typename T>
+template<typename V>
+V SparseMatrix<T>::dotRow(const std::size_t aRow, const V* const aVector) const
+{
+	decltype(T() * V()) lResult = decltype(T() * V())();
+	for (std::size_t lPosition = this->m_RowStarts[aRow]; lPosition < this->m_RowStarts[aRow + 1]; lPosition++)
+	{
+		lResult += this->m_Values[lPosition] * aVector[this->m_Columns[lPosition]];
+	}
+	return static_cast<V>(lResult);
+}
+
+/** Matrix-vector product: aResult = matrix * aVector
+* @param aVector The vector (the number of columns long)
+* @param aResult Will be returned with the product (the number of rows long, must not overlap aVector)
+*/
+template<typename T>
+template<typename V>
+void SparseMatrix<T>::multiplyVector(const V* const aVector, V* const aResult) const
+{
+	for (std::size_t lRow = 0; lRow < this->m_NumberOfRows; lRow++)
+	{
+		aResult[lRow] = this->dotRow(lRow, aVector);
+	}
+}
+
+/** Transposed matrix-vector product: aResult = transpose(matrix) * aVector
+* @param aVector The vector (the number of rows long)
+* @param aResult Will be returned with the product (the number of columns long, must not overlap aVector)
+*/
+template<typename T>
+template<typename V>
+void SparseMatrix<T>::multiplyVectorTransposed(const V* const aVector, V* const aResult) const
+{
+	std::fill(aResult, aResult + this->m_NumberOfColumns, V());
+	for (std::size_t lRow = 0; lRow < this->m_NumberOfRows; lRow++)
+	{
+		const V lScale = aVector[lRow];
+		for (std::size_t lPosition = this->m_RowStarts[lRow]; lPosition < this->m_RowStarts[lRow + 1]; lPosition++)
+		{
+			aResult[this->m_Columns[lPosition]] += this->m_Values[lPosition] * lScale;
+		}
+	}
+}
+
+/** Sparse-dense matrix product: aResult = matrix * aDense. Each row of the result is a sum of scaled rows of aDense.
+* @param aDense A row major matrix (the number of columns x aNumberOfColumns)
+* @param aNumberOfColumns The number of columns of aDense and aResult
+* @param aResult Will be returned with the row major product (the number of rows x aNumberOfColumns)
+*/
+template<typename T>
+template<typename D, typename R>
+void SparseMatrix<T>::multiply(const D* const aDense, const std::size_t aNumberOfColumns, R* const aResult) const
+{
+	std::fill(aResult, aResult + this->m_NumberOfRows * aNumberOfColumns, R());
+	for (std::size_t lRow = 0; lRow < this->m_NumberOfRows; lRow++)
+	{
+		R* const lResultRow = aResult + lRow * aNumberOfColumns;
+		for (std::size_t lPosition = this->m_RowStarts[lRow]; lPosition < this->m_RowStarts[lRow + 1]; lPosition++)
+		{
+			const T lScale = this->m_Values[lPosition];
+			const D* const lDenseRow = aDense + this->m_Columns[lPosition] * aNumberOfColumns;
+			for (std::size_t lCount = 0; lCount < aNumberOfColumns; lCount++)
+			{
+				lResultRow[lCount] += lScale * lDenseRow[lCount];
+			}
+		}
+	}
+}
+
+/** Transposed sparse-dense matrix product: aResult = transpose(matrix) * aDense
+* @param aDense A row major matrix (the number of rows x aNumberOfColumns)
+* @param aNumberOfColumns The number of columns of aDense and aResult
+* @param aResult Will be returned with the row major product (the number of columns x aNumberOfColumns)
+*/
+template<typename T>
+template<typename D, typename R>
+void SparseMatrix<T>::multiplyTransposed(const D* const aDense, const std::size_t aNumberOfColumns, R* const aResult) const
+{
+	std::fill(aResult, aResult + this->m_NumberOfColumns * aNumberOfColumns, R());
+	for (std::size_t lRow = 0; lRow < this->m_NumberOfRows; lRow++)
+	{
+		const D* const lDenseRow = aDense + lRow * aNumberOfColumns;
+		for (std::size_t lPosition = this->m_RowStarts[lRow]; lPosition < this->m_RowStarts[lRow + 1]; lPosition++)
+		{
+			const T lScale = this->m_Values[lPosition];
+			R* const lResultRow = aResult + this->m_Columns[lPosition] * aNumberOfColumns;
+			for (std::size_t lCount = 0; lCount < aNumberOfColumns; lCount++)
+			{
+				lResultRow[lCount] += lScale * lDenseRow[lCount];
+			}
+		}
+	}
+}
+
+/** Copies the matrix into a dense 2 dimensional MultidimensionalArray
+*/
+template<typename T>
+MultidimensionalArray<T> SparseMatrix<T>::toMultidimensionalArray() const
+{
+	MultidimensionalArray<T> lResult(2, { this->m_NumberOfRows, this->m_NumberOfColumns });
+	T* const lData = lResult.data();
+	for (std::size_t lRow = 0; lRow < this->m_NumberOfRows; lRow++)
+	{
+		for (std::size_t lPosition = this->m_RowStarts[lRow]; lPosition < this->m_RowStarts[lRow + 1]; lPosition++)
+		{
+			lData[lRow * this->m_NumberOfColumns + this->m_Columns[lPosition]] = this->m_Values[lPosition];
+		}
+	}
+	return lResult;
+}
+
+/** Finds where an element is, or would be inserted, in m_Columns
+* @param aRow The row of the element
+* @param aColumn The column of the element
+* @return The position of the first element of the row with a column >= aColumn
+*/
+template<typename T>
+std::size_t SparseMatrix<T>::findElement(const std::size_t aRow, const std::size_t aColumn) const
+{
+	const std::vector<std::size_t>::const_iterator lBegin = this->m_Columns.begin() + this->m_RowStarts[aRow];
+	const std::vector<std::size_t>::const_iterator lEnd = this->m_Columns.begin() + this->m_RowStarts[aRow + 1];
+	return std::lower_bound(lBegin, lEnd, aColumn) - this->m_Columns.begin();
+}
+
+#endif
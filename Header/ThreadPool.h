@@ -0,0 +1,65 @@
+/**
+*  @file    ThreadPool.h
+*  @author  Jordan Nesley
+**/
+
+#ifndef THREADPOOL_H
+#define THREADPOOL_H
+
+#include <vector>
+#include <cstddef> // std::size_t
+#include <functional> // std::function
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <atomic>
+#include <exception> // std::exception_ptr
+
+#pragma unmanaged
+
+/** A pool of worker threads shared by everything in the library that runs in parallel (see ExecutionPolicy).
+*   The threads are started the first time the pool is used and wait for work between calls. The pool is never
+*   destroyed (joining threads from a static destructor can deadlock, e.g. while a DLL is unloaded): call shutdown to
+*   stop the workers before unloading the library, otherwise they end with the process.
+*
+*   Has a singleton design pattern
+*/
+class ThreadPool
+{
+private:
+	// private constructor
+	ThreadPool();
+	~ThreadPool();
+
+	// These lines override default class properties that would allow copies of the singleton class to be made
+	ThreadPool(ThreadPool const&) = delete;
+	void operator=(ThreadPool const&) = delete;
+
+	void workerLoop();
+	void runBlocks();
+	static void runInOrder(const std::size_t aNumberOfBlocks, const std::function<void(std::size_t)>& aTask);
+
+	std::vector<std::thread> m_Threads;
+
+	std::mutex m_CallMutex; // held by the thread running parallelFor
+	std::mutex m_Mutex; // guards everything below
+	std::condition_variable m_WorkAvailable;
+	std::condition_variable m_WorkDone;
+
+	const std::function<void(std::size_t)>* m_Task;
+	std::size_t m_NumberOfBlocks;
+	std::atomic<std::size_t> m_NextBlock;
+	std::size_t m_NumberOfBusyThreads;
+	unsigned long m_Generation; // incremented for every parallelFor so a worker runs each one once
+	std::exception_ptr m_Exception;
+	bool m_Stop;
+
+public:
+	static ThreadPool& getInstance();
+
+	std::size_t getNumberOfThreads() const;
+	void parallelFor(const std::size_t aNumberOfBlocks, const std::function<void(std::size_t)>& aTask);
+	void shutdown();
+};
+
+#endif
@@ -0,0 +1,797 @@
+/**
+*  @file    UnrolledList.h
+*  @author  Jordan Nesley
+**/
+
+#ifndef UNROLLEDLIST_H
+#define UNROLLEDLIST_H
+
+#include "NodePool.h"
+#include <cstddef> // std::size_t
+#include <cstdint> // std::uint64_t
+#include <memory> // std::allocator_traits
+#include <new> // placement new
+#include <type_traits> // std::aligned_storage
+#include <utility> // std::forward, std::move
+#ifdef _MSC_VER
+#include <intrin.h> // _BitScanForward64, _BitScanReverse64
+#endif
+
+#pragma unmanaged
+
+/** Returns the lowest set bit of aMask (not 0)
+*/
+inline unsigned UnrolledListLowestSlot(const std::uint64_t aMask)
+{
+#ifdef _MSC_VER
+	unsigned long lIndex;
+	_BitScanForward64(&lIndex, aMask);
+	return static_cast<unsigned>(lIndex);
+#else
+	return static_cast<unsigned>(__builtin_ctzll(aMask));
+#endif
+}
+
+/** Returns the highest set bit of aMask (not 0)
+*/
+inline unsigned UnrolledListHighestSlot(const std::uint64_t aMask)
+{
+#ifdef _MSC_VER
+	unsigned long lIndex;
+	_BitScanReverse64(&lIndex, aMask);
+	return static_cast<unsigned>(lIndex);
+#else
+	return 63u - static_cast<unsigned>(__builtin_clzll(aMask));
+#endif
+}
+
+/** The default number of elements in a node of an UnrolledList: about 256 bytes of elements (4 cache lines), at least
+*   4 and at most 64 elements
+*/
+constexpr std::size_t UnrolledListCapacity(const std::size_t aElementSize)
+{
+	return (256 / aElementSize < 4) ? 4 : ((256 / aElementSize > 64) ? 64 : 256 / aElementSize);
+}
+
+/** The links of a node of an UnrolledList (the end of a list is a node with no elements)
+*/
+struct UnrolledListLinks
+{
+	UnrolledListLinks* Next;
+	UnrolledListLinks* Previous;
+	std::uint64_t Occupied; // a bit for every slot holding an element
+	unsigned Count; // the number of elements
+	unsigned End; // one past the last slot used
+};
+
+template<typename T, std::size_t Capacity>
+struct UnrolledListNode : public UnrolledListLinks
+{
+	typename std::aligned_storage<sizeof(T), alignof(T)>::type Slots[Capacity];
+
+	T* element(const unsigned aSlot) { return reinterpret_cast<T*>(&this->Slots[aSlot]); }
+};
+
+template<typename T, std::size_t Capacity> class UnrolledListIterator;
+
+////////////////////////////////////////////////////////////////////////////////
+
+////////////////////////////////////////////////////////////////////////////////
+
+/** A doubly linked list that keeps up to Capacity elements next to each other in every node, so walking it touches a
+*   cache line per few elements instead of one per element (see MyList for the list with one element per node). It
+*   has the same interface as MyList.
+*
+*   By default a node keeps its elements packed at its front: inserting or erasing moves the elements after it in
+*   the same node (and a full node is split in half), which invalidates the iterators to them. With StableIterators
+*   elements are never moved by erasing (a hole is left that a later insertion next to it can reuse) or by pushBack,
+*   pushFront or insertion next to a hole or at the front of a node, so iterators stay valid until their element is
+*   erased. Inserting in the middle of a node where the slot in front of the position is taken is then the one
+*   operation that moves elements (the ones after the position move to a new node).
+*
+*   The nodes come from Allocator, by default a NodePool of the list that lists constructed with the same allocator
+*   share (a copy of the list gets a pool of its own, see NodePool.h).
+*/
+template<typename T, std::size_t Capacity = UnrolledListCapacity(sizeof(T)), bool StableIterators = false,
+	typename Allocator = NodePoolAllocator<UnrolledListNode<T, Capacity>>>
+class UnrolledList
+{
+	static_assert(Capacity >= 2 && Capacity <= 64, "the Capacity of an UnrolledList must be from 2 to 64");
+
+public:
+	typedef UnrolledListIterator<T, Capacity> Iterator;
+
+private:
+	typedef UnrolledListNode<T, Capacity> NodeType;
+
+	UnrolledListLinks m_End;
+	int m_NumberOfElements;
+	Allocator m_Allocator;
+
+	static NodeType* node(UnrolledListLinks* aLinks) { return static_cast<NodeType*>(aLinks); }
+	static std::uint64_t slotsBelow(const unsigned aSlot) { return (aSlot >= 64) ? ~std::uint64_t(0) : (std::uint64_t(1) << aSlot) - 1; }
+
+	void initialize();
+	void takeNodes(UnrolledList& aOther);
+	NodeType* createNode(UnrolledListLinks* aLoc);
+	void destroyNode(UnrolledListLinks* aNode);
+	Iterator first(UnrolledListLinks* aNode) const;
+	void moveElements(NodeType* aFrom, const std::uint64_t aSlots, NodeType* aTo);
+	template<typename... Args>
+	Iterator construct(NodeType* aNode, const unsigned aSlot, Args&&... aArgs);
+	template<typename... Args>
+	Iterator emplaceCompact(UnrolledListLinks* aLoc, unsigned aSlot, Args&&... aArgs);
+	template<typename... Args>
+	Iterator emplaceStable(UnrolledListLinks* aLoc, unsigned aSlot, Args&&... aArgs);
+
+public:
+	UnrolledList();
+	explicit UnrolledList(const Allocator& aAllocator);
+	UnrolledList(const UnrolledList& aCopy);
+	UnrolledList(UnrolledList&& aMove) noexcept;
+	~UnrolledList();
+
+	void pushBack(const T& aData);
+	void pushBack(T&& aData);
+	void pushFront(const T& aData);
+	void pushFront(T&& aData);
+	template<typename... Args>
+	Iterator emplace(const Iterator& aLoc, Args&&... aArgs);
+	template<typename... Args>
+	T& emplaceBack(Args&&... aArgs);
+	Iterator insert(const Iterator& aLoc, const T& aData);
+	Iterator insert(const Iterator& aLoc, T&& aData);
+	void popFront();
+	void popBack();
+	Iterator erase(Iterator aLoc);
+	void clear();
+	void swap(UnrolledList& aOther) noexcept;
+
+	int size() const;
+	bool empty() const;
+	const Allocator& getAllocator() const;
+	Iterator find(Iterator aStart, Iterator aEnd, const T& aValue) const;
+
+	Iterator begin() const;
+	Iterator end() const;
+
+	UnrolledList& operator=(const UnrolledList& aRight);
+	UnrolledList& operator=(UnrolledList&& aRight) noexcept;
+};
+
+////////////////////////////////////////////////////////////////////////////////
+
+template<typename T, std::size_t Capacity>
+class UnrolledListIterator
+{
+	template<typename, std::size_t, bool, typename> friend class UnrolledList;
+
+private:
+	UnrolledListLinks* m_Node;
+	unsigned m_Slot;
+	UnrolledListIterator(UnrolledListLinks* aNode, const unsigned aSlot);
+public:
+	UnrolledListIterator();
+	UnrolledListIterator(const UnrolledListIterator<T, Capacity>& aCopy);
+
+	UnrolledListIterator<T, Capacity> next() const;
+	UnrolledListIterator<T, Capacity> prev() const;
+
+	T& operator*();
+	const T& operator*() const;
+	bool operator==(const UnrolledListIterator<T, Capacity>& aRight) const;
+	bool operator!=(const UnrolledListIterator<T, Capacity>& aRight) const;
+	UnrolledListIterator<T, Capacity>& operator++();
+	UnrolledListIterator<T, Capacity> operator++(int);
+	UnrolledListIterator<T, Capacity>& operator--();
+	UnrolledListIterator<T, Capacity> operator--(int);
+	UnrolledListIterator<T, Capacity>& operator=(const UnrolledListIterator<T, Capacity>& aRight);
+};
+
+////////////////////////////////////////////////////////////////////////////////
+
+////////////////////////////////////////////////////////////////////////////////
+
+/** Default constructor for UnrolledList
+*/
+template<typename T, std::size_t Capacity, bool StableIterators, typename Allocator>
+UnrolledList<T, Capacity, StableIterators, Allocator>::UnrolledList()
+{
+	this->initialize();
+}
+
+/** Constructor for UnrolledList with the allocator of its nodes (e.g. to share a NodePool with other lists)
+* @param aAllocator The allocator
+*/
+template<typename T, std::size_t Capacity, bool StableIterators, typename Allocator>
+UnrolledList<T, Capacity, StableIterators, Allocator>::UnrolledList(const Allocator& aAllocator)
+	: m_Allocator(aAllocator)
+{
+	this->initialize();
+}
+
+/** Copy constructor for UnrolledList (the copy is packed and gets the allocator select_on_container_copy_construction
+*   returns, e.g. a NodePoolAllocator with a new pool)
+* @param aCopy The object to copy
+*/
+template<typename T, std::size_t Capacity, bool StableIterators, typename Allocator>
+UnrolledList<T, Capacity, StableIterators, Allocator>::UnrolledList(const UnrolledList& aCopy)
+	: m_Allocator(std::allocator_traits<Allocator>::select_on_container_copy_construction(aCopy.m_Allocator))
+{
+	this->initialize();
+	for (Iterator it = aCopy.begin(); it != aCopy.end(); it++)
+	{
+		this->emplaceBack(*it);
+	}
+}
+
+/** Move constructor for UnrolledList (the moved list is left empty)
+* @param aMove The object to move
+*/
+template<typename T, std::size_t Capacity, bool StableIterators, typename Allocator>
+UnrolledList<T, Capacity, StableIterators, Allocator>::UnrolledList(UnrolledList&& aMove) noexcept
+	: m_Allocator(aMove.m_Allocator)
+{
+	this->initialize();
+	this->takeNodes(aMove);
+}
+
+/** Destructor for UnrolledList
+*/
+template<typename T, std::size_t Capacity, bool StableIterators, typename Allocator>
+UnrolledList<T, Capacity, StableIterators, Allocator>::~UnrolledList()
+{
+	this->clear();
+}
+
+/** Makes the list empty (without freeing anything)
+*/
+template<typename T, std::size_t Capacity, bool StableIterators, typename Allocator>
+void UnrolledList<T, Capacity, StableIterators, Allocator>::initialize()
+{
+	this->m_End.Next = &this->m_End;
+	this->m_End.Previous = &this->m_End;
+	this->m_End.Occupied = 0;
+	this->m_End.Count = 0;
+	this->m_End.End = 0;
+	this->m_NumberOfElements = 0;
+}
+
+/** Takes the nodes of aOther (which is left empty) into this empty list
+* @param aOther The list to take the nodes from (its allocator must be equal to this one)
+*/
+template<typename T, std::size_t Capacity, bool StableIterators, typename Allocator>
+void UnrolledList<T, Capacity, StableIterators, Allocator>::takeNodes(UnrolledList& aOther)
+{
+	if (aOther.m_NumberOfElements == 0) return;
+
+	this->m_End.Next = aOther.m_End.Next;
+	this->m_End.Previous = aOther.m_End.Previous;
+	this->m_End.Next->Previous = &this->m_End;
+	this->m_End.Previous->Next = &this->m_End;
+	this->m_NumberOfElements = aOther.m_NumberOfElements;
+
+	aOther.initialize();
+}
+
+/** Allocates an empty node and links it in front of aLoc
+* @param aLoc The node to link the new node in front of
+*/
+template<typename T, std::size_t Capacity, bool StableIterators, typename Allocator>
+UnrolledListNode<T, Capacity>* UnrolledList<T, Capacity, StableIterators, Allocator>::createNode(UnrolledListLinks* aLoc)
+{
+	NodeType* NewNode = new (this->m_Allocator.allocate(1)) NodeType;
+	NewNode->Occupied = 0;
+	NewNode->Count = 0;
+	NewNode->End = 0;
+	NewNode->Next = aLoc;
+	NewNode->Previous = aLoc->Previous;
+	aLoc->Previous->Next = NewNode;
+	aLoc->Previous = NewNode;
+	return NewNode;
+}
+
+/** Unlinks and frees a node (its elements must already be destroyed)
+* @param aNode The node
+*/
+template<typename T, std::size_t Capacity, bool StableIterators, typename Allocator>
+void UnrolledList<T, Capacity, StableIterators, Allocator>::destroyNode(UnrolledListLinks* aNode)
+{
+	aNode->Previous->Next = aNode->Next;
+	aNode->Next->Previous = aNode->Previous;
+	NodeType* const lNode = node(aNode);
+	lNode->~NodeType();
+	this->m_Allocator.deallocate(lNode, 1);
+}
+
+/** Returns the first element of aNode (end() for the end of the list)
+* @param aNode The node
+*/
+template<typename T, std::size_t Capacity, bool StableIterators, typename Allocator>
+UnrolledListIterator<T, Capacity> UnrolledList<T, Capacity, StableIterators, Allocator>::first(UnrolledListLinks* aNode) const
+{
+	return Iterator(aNode, (aNode->Occupied == 0) ? 0 : UnrolledListLowestSlot(aNode->Occupied));
+}
+
+/** Moves the elements in aSlots of aFrom to the end of aTo (in order)
+* @param aFrom The node to move the elements from
+* @param aSlots A bit for every slot to move
+* @param aTo The node to move the elements to (with room for them)
+*/
+template<typename T, std::size_t Capacity, bool StableIterators, typename Allocator>
+void UnrolledList<T, Capacity, StableIterators, Allocator>::moveElements(NodeType* aFrom, const std::uint64_t aSlots, NodeType* aTo)
+{
+	std::uint64_t lSlots = aSlots;
+	while (lSlots != 0)
+	{
+		const unsigned lSlot = UnrolledListLowestSlot(lSlots);
+		lSlots &= lSlots - 1;
+
+		new (aTo->element(aTo->End)) T(std::move(*aFrom->element(lSlot)));
+		aFrom->element(lSlot)->~T();
+		aTo->Occupied |= std::uint64_t(1) << aTo->End;
+		aTo->End++;
+		aTo->Count++;
+		aFrom->Count--;
+	}
+	aFrom->Occupied &= ~aSlots;
+	aFrom->End = (aFrom->Occupied == 0) ? 0 : UnrolledListHighestSlot(aFrom->Occupied) + 1;
+}
+
+/** Constructs an element in a free slot of a node
+* @param aNode The node
+* @param aSlot The slot (before End or End itself)
+* @param aArgs The arguments of the constructor of T
+*/
+template<typename T, std::size_t Capacity, bool StableIterators, typename Allocator>
+template<typename... Args>
+UnrolledListIterator<T, Capacity> UnrolledList<T, Capacity, StableIterators, Allocator>::construct(NodeType* aNode, const unsigned aSlot, Args&&... aArgs)
+{
+	new (aNode->element(aSlot)) T(std::forward<Args>(aArgs)...);
+	aNode->Occupied |= std::uint64_t(1) << aSlot;
+	aNode->Count++;
+	if (aSlot >= aNode->End) aNode->End = aSlot + 1;
+	this->m_NumberOfElements++;
+	return Iterator(aNode, aSlot);
+}
+
+/** Inserts an element in front of aSlot of aLoc keeping the elements of every node packed at its front
+* @param aLoc The node to insert in (the end of the list to insert at the back)
+* @param aSlot The slot to insert in front of
+* @param aArgs The arguments of the constructor of T
+*/
+template<typename T, std::size_t Capacity, bool StableIterators, typename Allocator>
+template<typename... Args>
+UnrolledListIterator<T, Capacity> UnrolledList<T, Capacity, StableIterators, Allocator>::emplaceCompact(UnrolledListLinks* aLoc, unsigned aSlot, Args&&... aArgs)
+{
+	if (aLoc == &this->m_End)
+	{
+		UnrolledListLinks* lLast = this->m_End.Previous;
+		if (lLast == &this->m_End || lLast->End == Capacity) lLast = this->createNode(&this->m_End);
+		return this->construct(node(lLast), lLast->End, std::forward<Args>(aArgs)...);
+	}
+
+	// constructed first so nothing has moved if the constructor throws
+	T lValue(std::forward<Args>(aArgs)...);
+
+	NodeType* lNode = node(aLoc);
+	if (lNode->Count == Capacity)
+	{
+		// split the node in half
+		NodeType* const lNewNode = this->createNode(lNode->Next);
+		this->moveElements(lNode, ~slotsBelow(Capacity / 2) & slotsBelow(Capacity), lNewNode);
+		if (aSlot > Capacity / 2)
+		{
+			lNode = lNewNode;
+			aSlot -= Capacity / 2;
+		}
+	}
+
+	// move the elements from aSlot on one slot back
+	for (unsigned lSlot = lNode->End; lSlot > aSlot; lSlot--)
+	{
+		new (lNode->element(lSlot)) T(std::move(*lNode->element(lSlot - 1)));
+		lNode->element(lSlot - 1)->~T();
+	}
+	lNode->End++;
+	lNode->Occupied = slotsBelow(lNode->End) & ~(std::uint64_t(1) << aSlot);
+	return this->construct(lNode, aSlot, std::move(lValue));
+}
+
+/** Inserts an element in front of aSlot of aLoc without moving any element if possible
+* @param aLoc The node to insert in (the end of the list to insert at the back)
+* @param aSlot The slot to insert in front of
+* @param aArgs The arguments of the constructor of T
+*/
+template<typename T, std::size_t Capacity, bool StableIterators, typename Allocator>
+template<typename... Args>
+UnrolledListIterator<T, Capacity> UnrolledList<T, Capacity, StableIterators, Allocator>::emplaceStable(UnrolledListLinks* aLoc, unsigned aSlot, Args&&... aArgs)
+{
+	if (aLoc == &this->m_End)
+	{
+		UnrolledListLinks* lLast = this->m_End.Previous;
+		if (lLast == &this->m_End || lLast->End == Capacity) lLast = this->createNode(&this->m_End);
+		return this->construct(node(lLast), lLast->End, std::forward<Args>(aArgs)...);
+	}
+
+	NodeType* const lNode = node(aLoc);
+
+	// a hole right in front of aSlot
+	if (aSlot > 0 && (lNode->Occupied & (std::uint64_t(1) << (aSlot - 1))) == 0)
+	{
+		return this->construct(lNode, aSlot - 1, std::forward<Args>(aArgs)...);
+	}
+
+	// the front of a node: at the back of the node before it, or in a new node
+	if ((lNode->Occupied & slotsBelow(aSlot)) == 0)
+	{
+		UnrolledListLinks* const lPrevious = lNode->Previous;
+		if (lPrevious != &this->m_End && lPrevious->End < Capacity)
+		{
+			return this->construct(node(lPrevious), lPrevious->End, std::forward<Args>(aArgs)...);
+		}
+
+		// a new front of the list fills from its back so the next pushFront goes in front of it
+		NodeType* const lNewNode = this->createNode(lNode);
+		return this->construct(lNewNode, (lPrevious == &this->m_End) ? static_cast<unsigned>(Capacity - 1) : 0u, std::forward<Args>(aArgs)...);
+	}
+
+	// the slot in front of aSlot is taken: the elements from aSlot on move to a new node
+	T lValue(std::forward<Args>(aArgs)...);
+	NodeType* const lNewNode = this->createNode(lNode->Next);
+	this->moveElements(lNode, lNode->Occupied & ~slotsBelow(aSlot), lNewNode);
+	return this->construct(lNode, aSlot, std::move(lValue));
+}
+
+template<typename T, std::size_t Capacity, bool StableIterators, typename Allocator>
+void UnrolledList<T, Capacity, StableIterators, Allocator>::pushBack(const T& aData)
+{
+	this->emplaceBack(aData);
+}
+
+template<typename T, std::size_t Capacity, bool StableIterators, typename Allocator>
+void UnrolledList<T, Capacity, StableIterators, Allocator>::pushBack(T&& aData)
+{
+	this->emplaceBack(std::move(aData));
+}
+
+template<typename T, std::size_t Capacity, bool StableIterators, typename Allocator>
+void UnrolledList<T, Capacity, StableIterators, Allocator>::pushFront(const T& aData)
+{
+	this->emplace(this->begin(), aData);
+}
+
+template<typename T, std::size_t Capacity, bool StableIterators, typename Allocator>
+void UnrolledList<T, Capacity, StableIterators, Allocator>::pushFront(T&& aData)
+{
+	this->emplace(this->begin(), std::move(aData));
+}
+
+/** Constructs an element in place in front of aLoc
+* @param aLoc The location to insert at
+* @param aArgs The arguments of the constructor of T
+* @return The location of the new element
+*/
+template<typename T, std::size_t Capacity, bool StableIterators, typename Allocator>
+template<typename... Args>
+UnrolledListIterator<T, Capacity> UnrolledList<T, Capacity, StableIterators, Allocator>::emplace(const Iterator& aLoc, Args&&... aArgs)
+{
+	if (StableIterators) return this->emplaceStable(aLoc.m_Node, aLoc.m_Slot, std::forward<Args>(aArgs)...);
+	return this->emplaceCompact(aLoc.m_Node, aLoc.m_Slot, std::forward<Args>(aArgs)...);
+}
+
+/** Constructs an element in place at the end of the list
+* @param aArgs The arguments of the constructor of T
+* @return The new element
+*/
+template<typename T, std::size_t Capacity, bool StableIterators, typename Allocator>
+template<typename... Args>
+T& UnrolledList<T, Capacity, StableIterators, Allocator>::emplaceBack(Args&&... aArgs)
+{
+	UnrolledListLinks* lLast = this->m_End.Previous;
+	if (lLast == &this->m_End || lLast->End == Capacity) lLast = this->createNode(&this->m_End);
+	return *this->construct(node(lLast), lLast->End, std::forward<Args>(aArgs)...);
+}
+
+template<typename T, std::size_t Capacity, bool StableIterators, typename Allocator>
+UnrolledListIterator<T, Capacity> UnrolledList<T, Capacity, StableIterators, Allocator>::insert(const Iterator& aLoc, const T& aData)
+{
+	return this->emplace(aLoc, aData);
+}
+
+template<typename T, std::size_t Capacity, bool StableIterators, typename Allocator>
+UnrolledListIterator<T, Capacity> UnrolledList<T, Capacity, StableIterators, Allocator>::insert(const Iterator& aLoc, T&& aData)
+{
+	return this->emplace(aLoc, std::move(aData));
+}
+
+template<typename T, std::size_t Capacity, bool StableIterators, typename Allocator>
+void UnrolledList<T, Capacity, StableIterators, Allocator>::popFront()
+{
+	if (this->m_NumberOfElements == 0) return;
+	this->erase(this->begin());
+}
+
+template<typename T, std::size_t Capacity, bool StableIterators, typename Allocator>
+void UnrolledList<T, Capacity, StableIterators, Allocator>::popBack()
+{
+	if (this->m_NumberOfElements == 0) return;
+	this->erase(this->end().prev());
+}
+
+/** Erases an element
+* @param aLoc The location of the element
+* @return The location of the element after it
+*/
+template<typename T, std::size_t Capacity, bool StableIterators, typename Allocator>
+UnrolledListIterator<T, Capacity> UnrolledList<T, Capacity, StableIterators, Allocator>::erase(Iterator aLoc)
+{
+	NodeType* const lNode = node(aLoc.m_Node);
+	const unsigned lSlot = aLoc.m_Slot;
+
+	lNode->element(lSlot)->~T();
+	lNode->Occupied &= ~(std::uint64_t(1) << lSlot);
+	lNode->Count--;
+	this->m_NumberOfElements--;
+
+	if (lNode->Count == 0)
+	{
+		UnrolledListLinks* const lNext = lNode->Next;
+		this->destroyNode(lNode);
+		return this->first(lNext);
+	}
+
+	if (StableIterators)
+	{
+		if (lSlot + 1 == lNode->End) lNode->End = UnrolledListHighestSlot(lNode->Occupied) + 1;
+		const std::uint64_t lAfter = lNode->Occupied & ~slotsBelow(lSlot + 1);
+		if (lAfter == 0) return this->first(lNode->Next);
+		return Iterator(lNode, UnrolledListLowestSlot(lAfter));
+	}
+
+	// move the elements after lSlot one slot forward
+	for (unsigned lCount = lSlot + 1; lCount < lNode->End; lCount++)
+	{
+		new (lNode->element(lCount - 1)) T(std::move(*lNode->element(lCount)));
+		lNode->element(lCount)->~T();
+	}
+	lNode->End--;
+	lNode->Occupied = slotsBelow(lNode->End);
+
+	// merge a node with the next one once they both fit in half a node
+	UnrolledListLinks* const lNext = lNode->Next;
+	if (lNext != &this->m_End && lNode->Count + lNext->Count <= Capacity / 2)
+	{
+		this->moveElements(node(lNext), lNext->Occupied, lNode);
+		this->destroyNode(lNext);
+	}
+
+	if (lSlot < lNode->End) return Iterator(lNode, lSlot);
+	return this->first(lNode->Next);
+}
+
+/** Erases every element
+*/
+template<typename T, std::size_t Capacity, bool StableIterators, typename Allocator>
+void UnrolledList<T, Capacity, StableIterators, Allocator>::clear()
+{
+	while (this->m_End.Next != &this->m_End)
+	{
+		NodeType* const lNode = node(this->m_End.Next);
+		std::uint64_t lSlots = lNode->Occupied;
+		while (lSlots != 0)
+		{
+			lNode->element(UnrolledListLowestSlot(lSlots))->~T();
+			lSlots &= lSlots - 1;
+		}
+		this->destroyNode(lNode);
+	}
+	this->m_NumberOfElements = 0;
+}
+
+/** Swaps the elements (and allocators) of two lists (iterators to elements stay valid and move to the other list)
+* @param aOther The other list
+*/
+template<typename T, std::size_t Capacity, bool StableIterators, typename Allocator>
+void UnrolledList<T, Capacity, StableIterators, Allocator>::swap(UnrolledList& aOther) noexcept
+{
+	UnrolledList lTemp(std::move(aOther));
+	aOther = std::move(*this);
+	*this = std::move(lTemp);
+}
+
+template<typename T, std::size_t Capacity, bool StableIterators, typename Allocator>
+int UnrolledList<T, Capacity, StableIterators, Allocator>::size() const
+{
+	return this->m_NumberOfElements;
+}
+
+template<typename T, std::size_t Capacity, bool StableIterators, typename Allocator>
+bool UnrolledList<T, Capacity, StableIterators, Allocator>::empty() const
+{
+	return this->m_NumberOfElements == 0;
+}
+
+template<typename T, std::size_t Capacity, bool StableIterators, typename Allocator>
+const Allocator& UnrolledList<T, Capacity, StableIterators, Allocator>::getAllocator() const
+{
+	return this->m_Allocator;
+}
+
+template<typename T, std::size_t Capacity, bool StableIterators, typename Allocator>
+UnrolledListIterator<T, Capacity> UnrolledList<T, Capacity, StableIterators, Allocator>::find(Iterator aStart, Iterator aEnd, const T& aValue) const
+{
+	for (Iterator it = aStart; it != aEnd; it++)
+	{
+		if (*it == aValue)
+		{
+			return it;
+		}
+	}
+	return aEnd;
+}
+
+template<typename T, std::size_t Capacity, bool StableIterators, typename Allocator>
+UnrolledListIterator<T, Capacity> UnrolledList<T, Capacity, StableIterators, Allocator>::begin() const
+{
+	return this->first(this->m_End.Next);
+}
+
+template<typename T, std::size_t Capacity, bool StableIterators, typename Allocator>
+UnrolledListIterator<T, Capacity> UnrolledList<T, Capacity, StableIterators, Allocator>::end() const
+{
+	return Iterator(const_cast<UnrolledListLinks*>(&this->m_End), 0);
+}
+
+template<typename T, std::size_t Capacity, bool StableIterators, typename Allocator>
+UnrolledList<T, Capacity, StableIterators, Allocator>& UnrolledList<T, Capacity, StableIterators, Allocator>::operator=(const UnrolledList& aRight)
+{
+	if (this == &aRight) return *this;
+
+	this->clear();
+	for (Iterator it = aRight.begin(); it != aRight.end(); it++)
+	{
+		this->emplaceBack(*it);
+	}
+
+	return *this;
+}
+
+/** Move assignment operator (takes the nodes and allocator of aRight, which is left empty)
+* @param aRight The right side of the = operator
+*/
+template<typename T, std::size_t Capacity, bool StableIterators, typename Allocator>
+UnrolledList<T, Capacity, StableIterators, Allocator>& UnrolledList<T, Capacity, StableIterators, Allocator>::operator=(UnrolledList&& aRight) noexcept
+{
+	if (this == &aRight) return *this;
+
+	this->clear();
+	this->m_Allocator = aRight.m_Allocator;
+	this->takeNodes(aRight);
+
+	return *this;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+////////////////////////////////////////////////////////////////////////////////
+
+template<typename T, std::size_t Capacity>
+UnrolledListIterator<T, Capacity>::UnrolledListIterator()
+{
+	this->m_Node = nullptr;
+	this->m_Slot = 0;
+}
+
+template<typename T, std::size_t Capacity>
+UnrolledListIterator<T, Capacity>::UnrolledListIterator(const UnrolledListIterator<T, Capacity>& aCopy)
+{
+	this->m_Node = aCopy.m_Node;
+	this->m_Slot = aCopy.m_Slot;
+}
+
+template<typename T, std::size_t Capacity>
+UnrolledListIterator<T, Capacity>::UnrolledListIterator(UnrolledListLinks* aNode, const unsigned aSlot)
+{
+	this->m_Node = aNode;
+	this->m_Slot = aSlot;
+}
+
+template<typename T, std::size_t Capacity>
+UnrolledListIterator<T, Capacity> UnrolledListIterator<T, Capacity>::next() const
+{
+	UnrolledListIterator<T, Capacity> Result(*this);
+	return ++Result;
+}
+
+template<typename T, std::size_t Capacity>
+UnrolledListIterator<T, Capacity> UnrolledListIterator<T, Capacity>::prev() const
+{
+	UnrolledListIterator<T, Capacity> Result(*this);
+	return --Result;
+}
+
+template<typename T, std::size_t Capacity>
+T& UnrolledListIterator<T, Capacity>::operator*()
+{
+	return *static_cast<UnrolledListNode<T, Capacity>*>(this->m_Node)->element(this->m_Slot);
+}
+
+template<typename T, std::size_t Capacity>
+const T& UnrolledListIterator<T, Capacity>::operator*() const
+{
+	return *static_cast<UnrolledListNode<T, Capacity>*>(this->m_Node)->element(this->m_Slot);
+}
+
+template<typename T, std::size_t Capacity>
+bool UnrolledListIterator<T, Capacity>::operator==(const UnrolledListIterator<T, Capacity>& aRight) const
+{
+	return (this->m_Node == aRight.m_Node && this->m_Slot == aRight.m_Slot);
+}
+
+template<typename T, std::size_t Capacity>
+bool UnrolledListIterator<T, Capacity>::operator!=(const UnrolledListIterator<T, Capacity>& aRight) const
+{
+	return !(*this == aRight);
+}
+
+template<typename T, std::size_t Capacity>
+UnrolledListIterator<T, Capacity>& UnrolledListIterator<T, Capacity>::operator++()
+{
+	// the next element of this node (usually the next slot), otherwise the first element of the next node
+	const unsigned lNext = this->m_Slot + 1;
+	if (lNext < this->m_Node->End)
+	{
+		const std::uint64_t lAfter = this->m_Node->Occupied >> lNext;
+		this->m_Slot = ((lAfter & 1) != 0) ? lNext : lNext + UnrolledListLowestSlot(lAfter);
+	}
+	else
+	{
+		this->m_Node = this->m_Node->Next;
+		this->m_Slot = (this->m_Node->Occupied == 0) ? 0 : UnrolledListLowestSlot(this->m_Node->Occupied);
+	}
+	return *this;
+}
+
+template<typename T, std::size_t Capacity>
+UnrolledListIterator<T, Capacity> UnrolledListIterator<T, Capacity>::operator++(int)
+{
+	UnrolledListIterator<T, Capacity> Result(*this);
+	++(*this);
+	return Result;
+}
+
+template<typename T, std::size_t Capacity>
+UnrolledListIterator<T, Capacity>& UnrolledListIterator<T, Capacity>::operator--()
+{
+	// the previous element of this node, otherwise the last element of the previous node
+	const std::uint64_t lBefore = this->m_Node->Occupied & ((std::uint64_t(1) << this->m_Slot) - 1);
+	if (lBefore != 0)
+	{
+		this->m_Slot = UnrolledListHighestSlot(lBefore);
+	}
+	else
+	{
+		this->m_Node = this->m_Node->Previous;
+		this->m_Slot = (this->m_Node->Occupied == 0) ? 0 : UnrolledListHighestSlot(this->m_Node->Occupied);
+	}
+	return *this;
+}
+
+template<typename T, std::size_t Capacity>
+UnrolledListIterator<T, Capacity> UnrolledListIterator<T, Capacity>::operator--(int)
+{
+	UnrolledListIterator<T, Capacity> Result(*this);
+	--(*this);
+	return Result;
+}
+
+template<typename T, std::size_t Capacity>
+UnrolledListIterator<T, Capacity>& UnrolledListIterator<T, Capacity>::operator=(const UnrolledListIterator<T, Capacity>& aRight)
+{
+	this->m_Node = aRight.m_Node;
+	this->m_Slot = aRight.m_Slot;
+	return *(this);
+}
+
+#endif
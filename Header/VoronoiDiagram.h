@@ -5,6 +5,10 @@
 #include <vector>
 #include "MyList.h"
 #include "Graph_Graph.h"
+#include "UnrolledList.h"
+#include "IntrusiveList.h"
+#include "NodePool.h"
+#include "SlotMap.h"
 #include "Position.h"
 #include "MapPolygon.h"
 #include <algorithm>
@@ -22,37 +26,99 @@ private:
 		Position Center;
 	};
 
-	struct EdgeTracker
+	struct EdgeTracker;
+	struct LeftParabolaTag {};
+	struct RightParabolaTag {};
+
+	// the edge trackers whose left (or right) arc is a given arc, linked from the arc
+	typedef IntrusiveList<EdgeTracker, LeftParabolaTag> LeftEdgeList;
+	typedef IntrusiveList<EdgeTracker, RightParabolaTag> RightEdgeList;
+
+	// an arc of the beach line: the part of the parabola of a polygon center that is nearest to the sweep line
+	struct Arc : public IntrusiveListHook<>
+	{
+		int Center; // the index of the polygon center
+		LeftEdgeList LeftEdges; // the edge trackers with this arc on their left
+		RightEdgeList RightEdges; // the edge trackers with this arc on their right
+
+		explicit Arc(const int aCenter) : Center(aCenter) {}
+	};
+
+	typedef IntrusiveList<Arc> ParabolaList;
+	typedef ParabolaList::Iterator ParabolaIterator;
+	typedef SlotMap<Arc>::Handle ArcHandle;
+
+	// an edge being traced out by the breakpoint between two arcs. The arcs are handles, so a tracker whose arc has
+	// been removed never matches the arc that reuses its slot
+	struct EdgeTracker : public IntrusiveListHook<>, public IntrusiveListHook<LeftParabolaTag>, public IntrusiveListHook<RightParabolaTag>
 	{
-		MyListIterator<int> LeftParabola;
-		MyListIterator<int> RightParabola;
+		ArcHandle LeftParabola;
+		ArcHandle RightParabola;
 		int NodeIndex;
+		std::size_t Sequence; // the order of the tracker in the list of edge trackers
 	};
 
-	struct PolygonTracker
+	typedef IntrusiveList<EdgeTracker> EdgeTrackerList;
+	typedef NodePoolAllocator<UnrolledListNode<Edge, 8>> PolygonEdgeAllocator;
+	typedef NodePoolAllocator<UnrolledListNode<int, 16>> PolygonNodeAllocator;
+
+	// the edges and nodes of a polygon being built (walked for every new node), a cache line per node of the lists
+	struct PolygonTracker : public IntrusiveListHook<>
 	{
-		MyList<Edge> Edges;
-		MyList<int> Nodes;
+		UnrolledList<Edge, 8> Edges;
+		UnrolledList<int, 16> Nodes;
+
+		PolygonTracker(const PolygonEdgeAllocator& aEdgeAllocator, const PolygonNodeAllocator& aNodeAllocator) : Edges(aEdgeAllocator), Nodes(aNodeAllocator) {}
 	};
 
-	static void ProcessCircleEvents(double aSweepLine, std::vector<Position>& aPolygonCenters, MyList<int>& aParabolaList, MyList<EdgeTracker>& aEdgeTracker,
-		MyList<PolygonTracker>& aPolygonTrackerList, MyList<MapPolygon>& aPolygonList, Graph<Position, int>& aGraph);
-	static void ProcessSiteEvents(int& aCurrent, double aSweepLine, std::vector<Position>& aPolygonCenters, MyList<int>& aParabolaList, MyList<EdgeTracker>& aEdgeTracker);
-	static void ProcessEdgesForParabolaInsertion(const MyListIterator<int>& aInsertLocation, MyList<EdgeTracker>& aEdgeTracker);
+	typedef IntrusiveList<PolygonTracker> PolygonTrackerList;
+
+	// the state of the sweep: the arcs and trackers link themselves into the lists and come from the slot map and the
+	// pools, so the sweep allocates a chunk per many of them instead of a list node per element
+	struct Sweep
+	{
+		// ~Sweep depends on the order of these members (they are destroyed in reverse): the lists are destroyed before
+		// the slot map and pools their elements live in, and Arcs is declared first so it is destroyed last, after the
+		// trackers ~Sweep destroys have unlinked themselves from the edge lists of their arcs
+		SlotMap<Arc> Arcs;
+		ObjectPool<EdgeTracker> EdgeTrackerPool;
+		ObjectPool<PolygonTracker> PolygonTrackerPool;
+		PolygonEdgeAllocator PolygonEdges; // one pool for the edge lists of every polygon tracker
+		PolygonNodeAllocator PolygonNodes; // one pool for the node lists of every polygon tracker
+
+		ParabolaList Parabolas;
+		EdgeTrackerList EdgeTrackers;
+		PolygonTrackerList PolygonTrackers;
+		std::size_t NextSequence;
 
+		Sweep() : NextSequence(0) {}
+		~Sweep();
 
-	static void InsertNewNode(MyListIterator<int>& aRemoveLocation, const Position& aNewNodePosition, std::vector<Position>& aPolygonCenters, MyList<int>& aParabolaList,
-		MyList<EdgeTracker>& aEdgeTracker, MyList<PolygonTracker>& aPolygonTrackerList, MyList<MapPolygon>& aPolygonList, Graph<Position, int>& aGraph);
+		ParabolaIterator insertParabola(const ParabolaIterator& aLoc, const int aCenter);
+		ParabolaIterator eraseParabola(const ParabolaIterator& aLoc);
+		EdgeTracker* createEdgeTracker(const ParabolaIterator& aLeftParabola, const ParabolaIterator& aRightParabola, const int aNodeIndex);
+		void addEdgeTrackers(EdgeTrackerList& aNewEdges);
+		std::vector<EdgeTracker*> getEdgeTrackers(const ParabolaIterator& aParabola);
+		void setLeftParabola(EdgeTracker& aTracker, const ParabolaIterator& aParabola);
+		PolygonTracker* createPolygonTracker();
+	};
+
+	static void ProcessCircleEvents(double aSweepLine, std::vector<Position>& aPolygonCenters, Sweep& aSweep, MyList<MapPolygon>& aPolygonList, Graph<Position, int>& aGraph);
+	static void ProcessSiteEvents(int& aCurrent, double aSweepLine, std::vector<Position>& aPolygonCenters, Sweep& aSweep);
+	static void ProcessEdgesForParabolaInsertion(const ParabolaIterator& aInsertLocation, Sweep& aSweep);
 
-	static void PostProcessing(std::vector<Position>& aPolygonCenters, MyList<int>& aParabolaList, MyList<EdgeTracker>& aEdgeTracker, MyList<PolygonTracker>& aPolygonTrackerList,
+
+	static void InsertNewNode(ParabolaIterator& aRemoveLocation, const Position& aNewNodePosition, std::vector<Position>& aPolygonCenters, Sweep& aSweep,
 		MyList<MapPolygon>& aPolygonList, Graph<Position, int>& aGraph);
 
-	static MyList<EdgeTracker> CreateEdgeTrackers(const MyListIterator<int>& aRemoveLocation,
+	static void PostProcessing(std::vector<Position>& aPolygonCenters, Sweep& aSweep, MyList<MapPolygon>& aPolygonList, Graph<Position, int>& aGraph);
+
+	static void CreateEdgeTrackers(const ParabolaIterator& aRemoveLocation,
 		const int& aNewNodeIndex, const Position& aNewNodePosition, const std::vector<Position>& aPolygonCenters,
-		const MyList<EdgeTracker>& aEdgeTrackerList, MyList<int>& aParabolaList);
+		Sweep& aSweep, EdgeTrackerList& aNewEdges);
 
-	static void CompleteEdges(MyListIterator<int>& aRemoveLocation, const int& aNewNodeIndex, Graph<Position, int>& aGraph,
-		MyList<EdgeTracker>& aEdgeTrackerList, MyList<PolygonTracker>& aPolygonTracker, MyList<MapPolygon>& aPolygonList, MyList<int>& aParabolaList);
+	static void CompleteEdges(ParabolaIterator& aRemoveLocation, const int& aNewNodeIndex, Graph<Position, int>& aGraph,
+		Sweep& aSweep, MyList<MapPolygon>& aPolygonList);
 
 	static Circle CreateCircle(const Position& a, const Position& b, const Position& c);
 	static int getIntersections(const Position& aPosition1, const Position& aPosition2, const double& aSweep, Position& aIntersection1, Position& aIntersection2);
@@ -17,6 +17,25 @@ GeneticAlgorithm::GeneticAlgorithm(const unsigned int aSeed, const GeneticAlgori
 	this->m_Seed = aSeed;
 	this->m_GAParameters = aGAParameters;
 	this->m_Function = aFitnessFunction;
+	this->m_Evaluator = nullptr;
+	this->m_NumberOfEvaluations = 0;
+
+	this->m_BestParent = Parent();
+	this->m_BestParent.setFitness(DBL_MAX);
+}
+
+/** Constructor for Genetic Algorithm.
+* @param aSeed The seed number to use for randomization.
+* @param aGAParameters The parameters that define the genetic algorithm.
+* @param aEvaluator The evaluator that calculates the fitness of a whole generation of parents at once.
+*/
+GeneticAlgorithm::GeneticAlgorithm(const unsigned int aSeed, const GeneticAlgorithmParameters aGAParameters, std::shared_ptr<FitnessEvaluatorBase> aEvaluator)
+{
+	this->m_Seed = aSeed;
+	this->m_GAParameters = aGAParameters;
+	this->m_Function = nullptr;
+	this->m_Evaluator = aEvaluator;
+	this->m_NumberOfEvaluations = 0;
 
 	this->m_BestParent = Parent();
 	this->m_BestParent.setFitness(DBL_MAX);
@@ -35,10 +54,7 @@ void GeneticAlgorithm::Start()
 
 	for (unsigned lGenCount = 0; lGenCount < this->m_GAParameters.getNumberOfGenerations(); lGenCount++)
 	{
-		for (unsigned lParentCount = 0; lParentCount < this->m_ParentArray.size(); lParentCount++)
-		{
-			this->m_ParentArray[lParentCount].setFitness(this->m_Function(this->m_ParentArray[lParentCount].getProperties()));
-		}
+		this->evaluateParents();
 
 		rankParents(this->m_ParentArray);
 
@@ -47,32 +63,155 @@ void GeneticAlgorithm::Start()
 			this->m_BestParent = this->m_ParentArray[0];
 		}
 
+		// adjust the fitness of crowded parents so the population does not converge onto a single peak
+		if (this->m_GAParameters.getNichingType() != NichingType::NoNiching)
+		{
+			applyNiching(this->m_ParentArray, this->m_GAParameters);
+			rankParents(this->m_ParentArray);
+		}
+
 		if (lGenCount != this->m_GAParameters.getNumberOfGenerations())
 		{
-			this->m_ParentArray = breed(this->m_ParentArray, this->m_Seed++);
+			this->m_ParentArray = breed(this->m_ParentArray, this->m_GAParameters, this->m_Seed++);
 		}
 	}
 
 }
 
-/** Sorts the array of parents based on the fitness score. Position in the array is equal to the ranking.
-* @param aParentArray The array of parents to sort. Note: The array will be modified.
+/** Calculates the fitness of every parent in the current generation. If the fitness is noisy the fitness is the mean
+* of several samples, and extra samples are only taken for parents that racing has not yet placed on one side of
+* the selection boundary with confidence.
 */
-void GeneticAlgorithm::rankParents(std::vector<Parent>& aParentArray)
+void GeneticAlgorithm::evaluateParents()
 {
-	// sorts the array of parents based on the fitness score. Position in the array is equal to the ranking.
-	for (unsigned lCount1 = 0; lCount1 < aParentArray.size()-1; lCount1++)
+	std::vector<unsigned> lAllParents(this->m_ParentArray.size());
+	for (unsigned lParentCount = 0; lParentCount < lAllParents.size(); lParentCount++)
+	{
+		lAllParents[lParentCount] = lParentCount;
+	}
+
+	std::vector<double> lFitness;
+	if (!this->m_GAParameters.isNoisyFitness())
+	{
+		this->sampleFitness(lAllParents, lFitness);
+		for (unsigned lParentCount = 0; lParentCount < this->m_ParentArray.size(); lParentCount++)
+		{
+			this->m_ParentArray[lParentCount].setFitness(lFitness[lParentCount]);
+		}
+		return;
+	}
+
+	std::vector<double> lSum(this->m_ParentArray.size(), 0.0);
+	std::vector<double> lSumSquared(this->m_ParentArray.size(), 0.0);
+	std::vector<unsigned> lNumberOfSamples(this->m_ParentArray.size(), 0);
+	std::vector<double> lMean(this->m_ParentArray.size());
+	std::vector<double> lHalfWidth(this->m_ParentArray.size());
+	std::vector<unsigned> lOrder(lAllParents);
+	std::vector<unsigned> lUncertain(lAllParents);
+	unsigned lBoundary = (unsigned)ceil(this->m_GAParameters.getRacingRatio() * this->m_ParentArray.size());
+
+	for (unsigned lSampleCount = 0; !lUncertain.empty(); lSampleCount++)
 	{
-		Parent lTemp = aParentArray[lCount1 + 1];
-		for (int lCount2 = lCount1; lCount2 >= 0; lCount2--)
+		// take one more sample of every uncertain parent
+		this->sampleFitness(lUncertain, lFitness);
+		for (unsigned lCount = 0; lCount < lUncertain.size(); lCount++)
+		{
+			unsigned lParent = lUncertain[lCount];
+			lSum[lParent] += lFitness[lCount];
+			lSumSquared[lParent] += lFitness[lCount] * lFitness[lCount];
+			lNumberOfSamples[lParent]++;
+		}
+
+		if (lSampleCount + 1 < this->m_GAParameters.getInitialSamples()) continue;
+
+		// calculate the confidence interval of every parent's mean fitness
+		for (unsigned lParent = 0; lParent < lMean.size(); lParent++)
 		{
-			if (aParentArray[lCount2].getFitness() > lTemp.getFitness())
+			double lCount = lNumberOfSamples[lParent];
+			lMean[lParent] = lSum[lParent] / lCount;
+			double lVariance = (lSumSquared[lParent] - lCount * lMean[lParent] * lMean[lParent]) / (lCount - 1.0);
+			lHalfWidth[lParent] = this->m_GAParameters.getConfidenceBound() * sqrt((lVariance > 0.0 ? lVariance : 0.0) / lCount);
+		}
+
+		std::sort(lOrder.begin(), lOrder.end(), [&lMean](const unsigned a, const unsigned b)->bool {return lMean[a] < lMean[b]; });
+
+		// find the confidence bounds of the two groups on each side of the selection boundary
+		double lWorstLowerBoundOutside = DBL_MAX;
+		double lWorstUpperBoundInside = -DBL_MAX;
+		for (unsigned lRank = 0; lRank < lOrder.size(); lRank++)
+		{
+			unsigned lParent = lOrder[lRank];
+			if (lRank < lBoundary)
 			{
-				aParentArray[lCount2 + 1] = aParentArray[lCount2];
-				aParentArray[lCount2] = lTemp;
+				if (lMean[lParent] + lHalfWidth[lParent] > lWorstUpperBoundInside) lWorstUpperBoundInside = lMean[lParent] + lHalfWidth[lParent];
 			}
+			else
+			{
+				if (lMean[lParent] - lHalfWidth[lParent] < lWorstLowerBoundOutside) lWorstLowerBoundOutside = lMean[lParent] - lHalfWidth[lParent];
+			}
+		}
+
+		// a parent is resolved once it is clearly better than every parent outside the best group (clearly elite)
+		// or clearly worse than every parent inside it (clearly bad). Only the unresolved parents are sampled again.
+		lUncertain.clear();
+		for (unsigned lRank = 0; lRank < lOrder.size(); lRank++)
+		{
+			unsigned lParent = lOrder[lRank];
+			if (lNumberOfSamples[lParent] >= this->m_GAParameters.getMaxSamples()) continue;
+
+			bool lClearlyElite = (lRank < lBoundary) && (lMean[lParent] + lHalfWidth[lParent] < lWorstLowerBoundOutside);
+			bool lClearlyBad = (lRank >= lBoundary) && (lMean[lParent] - lHalfWidth[lParent] > lWorstUpperBoundInside);
+			if (!lClearlyElite && !lClearlyBad) lUncertain.push_back(lParent);
+		}
+	}
+
+	for (unsigned lParentCount = 0; lParentCount < this->m_ParentArray.size(); lParentCount++)
+	{
+		this->m_ParentArray[lParentCount].setFitness(lMean[lParentCount]);
+	}
+}
+
+/** Takes one fitness sample of each of the selected parents.
+* @param aParentIndices The indices of the parents to evaluate.
+* @param aFitness Will be returned with the fitness of each selected parent (in the same order).
+*/
+void GeneticAlgorithm::sampleFitness(const std::vector<unsigned>& aParentIndices, std::vector<double>& aFitness)
+{
+	aFitness.resize(aParentIndices.size());
+	this->m_NumberOfEvaluations += aParentIndices.size();
+
+	if (this->m_Evaluator)
+	{
+		// hand all the parents to the evaluator in one call
+		unsigned lNumberOfProperties = aParentIndices.empty() ? 0 : this->m_ParentArray[aParentIndices[0]].getValues().size();
+		std::vector<double> lValues;
+		lValues.reserve(aParentIndices.size() * lNumberOfProperties);
+		for (unsigned lCount = 0; lCount < aParentIndices.size(); lCount++)
+		{
+			std::vector<double> lParentValues = this->m_ParentArray[aParentIndices[lCount]].getValues();
+			lValues.insert(lValues.end(), lParentValues.begin(), lParentValues.end());
+		}
+
+		this->m_Evaluator->Evaluate(lValues, lNumberOfProperties, aFitness);
+		if (aFitness.size() != aParentIndices.size()) throw 69;
+	}
+	else
+	{
+		for (unsigned lCount = 0; lCount < aParentIndices.size(); lCount++)
+		{
+			aFitness[lCount] = this->m_Function(this->m_ParentArray[aParentIndices[lCount]].getProperties());
 		}
 	}
+}
+
+/** Sorts the array of parents based on the fitness score. Position in the array is equal to the ranking.
+* @param aParentArray The array of parents to sort. Note: The array will be modified.
+*/
+void GeneticAlgorithm::rankParents(std::vector<Parent>& aParentArray)
+{
+	// sorts the array of parents based on the fitness score. Position in the array is equal to the ranking.
+	// stable, so parents with equal fitness keep their order
+	std::stable_sort(aParentArray.begin(), aParentArray.end(), [](const Parent& a, const Parent& b)->bool {return b.getFitness() > a.getFitness(); });
 
 	for (unsigned lCount = 0; lCount < aParentArray.size(); lCount++)
 	{
@@ -81,11 +220,97 @@ void GeneticAlgorithm::rankParents(std::vector<Parent>& aParentArray)
 
 }
 
+/** Adjusts the fitness of each parent based on how crowded its niche is. Neighbors are found with a k-d tree
+* over the normalized parent properties, so each generation costs O(N log N) instead of O(N^2) distance calculations.
+* @param aParentArray The ranked array of parents. Note: The fitness values will be modified.
+* @param aGAParameters The parameters that define the niching method.
+*/
+void GeneticAlgorithm::applyNiching(std::vector<Parent>& aParentArray, const GeneticAlgorithmParameters& aGAParameters)
+{
+	if (aParentArray.size() < 2 || aGAParameters.getNicheRadius() <= 0.0) return;
+
+	double lRadius = aGAParameters.getNicheRadius();
+	unsigned lNumberOfProperties = aParentArray[0].getNormalizedValues().size();
+	if (lNumberOfProperties == 0) return;
+
+	std::vector<double> lPoints;
+	lPoints.reserve(aParentArray.size() * lNumberOfProperties);
+	for (unsigned lCount = 0; lCount < aParentArray.size(); lCount++)
+	{
+		std::vector<double> lValues = aParentArray[lCount].getNormalizedValues();
+		lPoints.insert(lPoints.end(), lValues.begin(), lValues.end());
+	}
+
+	KDTree lTree(lPoints, lNumberOfProperties);
+
+	if (aGAParameters.getNichingType() == NichingType::FitnessSharing)
+	{
+		// the niche count uses the triangular sharing function sh(d) = 1 - d/radius (the parent itself counts as 1)
+		std::vector<double> lNicheCount(aParentArray.size(), 0.0);
+		for (unsigned lCount = 0; lCount < aParentArray.size(); lCount++)
+		{
+			std::vector<unsigned> lNeighbors = lTree.radiusSearch(lCount, lRadius);
+			for (unsigned lCountN = 0; lCountN < lNeighbors.size(); lCountN++)
+			{
+				lNicheCount[lCount] += 1.0 - lTree.distance(lCount, lNeighbors[lCountN]) / lRadius;
+			}
+		}
+
+		// lower fitness is better so crowded parents are penalized by multiplying their fitness by the niche count. The
+		// fitness is shifted to be at least 1 first if any is not positive, or a parent with fitness 0 (or below) would
+		// not be penalized at all
+		double lMinimum = aParentArray[0].getFitness();
+		for (unsigned lCount = 1; lCount < aParentArray.size(); lCount++)
+		{
+			if (aParentArray[lCount].getFitness() < lMinimum) lMinimum = aParentArray[lCount].getFitness();
+		}
+		double lShift = (lMinimum > 0.0) ? 0.0 : 1.0 - lMinimum;
+
+		for (unsigned lCount = 0; lCount < aParentArray.size(); lCount++)
+		{
+			double lFitness = aParentArray[lCount].getFitness();
+			aParentArray[lCount].setFitness((lFitness + lShift) * lNicheCount[lCount] - lShift);
+		}
+	}
+	else if (aGAParameters.getNichingType() == NichingType::Clearing)
+	{
+		// clearing (Petrowski): the array is ranked, so walking it in order makes every parent that has not been cleared
+		// the best (the center) of a new niche. Only the best aNicheCapacity parents within the radius of the center keep
+		// their fitness, the rest are cleared. A parent kept by one niche can still be the center of its own.
+		std::vector<bool> lCleared(aParentArray.size(), false);
+		for (unsigned lCount = 0; lCount < aParentArray.size(); lCount++)
+		{
+			if (lCleared[lCount]) continue;
+
+			std::vector<unsigned> lNeighbors = lTree.radiusSearch(lCount, lRadius);
+			std::sort(lNeighbors.begin(), lNeighbors.end());
+
+			unsigned lNumberOfWinners = 1;
+			for (unsigned lCountN = 0; lCountN < lNeighbors.size(); lCountN++)
+			{
+				unsigned lNeighbor = lNeighbors[lCountN];
+				if (lNeighbor <= lCount || lCleared[lNeighbor]) continue;
+
+				if (lNumberOfWinners < aGAParameters.getNicheCapacity())
+				{
+					lNumberOfWinners++;
+				}
+				else
+				{
+					lCleared[lNeighbor] = true;
+					aParentArray[lNeighbor].setFitness(DBL_MAX);
+				}
+			}
+		}
+	}
+}
+
 /** Breeds the parents to make a new generation of parents.
 * @param aParentArray The parent array to breed.
-* @param aNumberToSelect The number of parents to select for breeding.
+* @param aGAParameters The parameters that define the crossover method.
+* @param aSeed The seed for the random number generator.
 */
-std::vector<Parent> GeneticAlgorithm::breed(const std::vector<Parent>& aParentArray, unsigned aSeed)
+std::vector<Parent> GeneticAlgorithm::breed(const std::vector<Parent>& aParentArray, const GeneticAlgorithmParameters& aGAParameters, unsigned aSeed)
 {
 	std::vector<Parent> lNewGeneration(aParentArray.size());
 	std::vector<std::tuple<unsigned, unsigned>> lCouple(aParentArray.size());
@@ -122,7 +347,37 @@ std::vector<Parent> GeneticAlgorithm::breed(const std::vector<Parent>& aParentAr
 		}
 
 		// cross over the parents .... get freaky!
-		lNewGeneration[lCount] = aParentArray[std::get<0>(lCouple[lCount])].Crossover(aParentArray[std::get<1>(lCouple[lCount])], aSeed++);
+		if (aGAParameters.getCrossoverType() == CrossoverType::PropertyCrossover)
+		{
+			lNewGeneration[lCount] = aParentArray[std::get<0>(lCouple[lCount])].Crossover(aParentArray[std::get<1>(lCouple[lCount])], aSeed++);
+		}
+	}
+
+	if (aGAParameters.getCrossoverType() != CrossoverType::PropertyCrossover)
+	{
+		// cross over the whole generation at once using rows of property values
+		std::vector<double> lMaxValues, lMinValues;
+		aParentArray[0].getLimits(lMaxValues, lMinValues);
+		unsigned lNumberOfProperties = lMaxValues.size();
+
+		std::vector<double> lMothers, lFathers, lChildren;
+		lMothers.reserve(lNewGeneration.size() * lNumberOfProperties);
+		lFathers.reserve(lNewGeneration.size() * lNumberOfProperties);
+		for (unsigned lCount = 0; lCount < lNewGeneration.size(); lCount++)
+		{
+			std::vector<double> lMother = aParentArray[std::get<0>(lCouple[lCount])].getValues();
+			std::vector<double> lFather = aParentArray[std::get<1>(lCouple[lCount])].getValues();
+			lMothers.insert(lMothers.end(), lMother.begin(), lMother.end());
+			lFathers.insert(lFathers.end(), lFather.begin(), lFather.end());
+		}
+
+		RealCrossover::Crossover(aGAParameters.getCrossoverType(), aGAParameters.getCrossoverParameter(), lMothers, lFathers, lChildren, lMaxValues, lMinValues, aSeed);
+
+		for (unsigned lCount = 0; lCount < lNewGeneration.size(); lCount++)
+		{
+			lNewGeneration[lCount] = Parent(aParentArray[std::get<0>(lCouple[lCount])]);
+			lNewGeneration[lCount].setValues(&lChildren[(std::size_t)lCount * lNumberOfProperties]);
+		}
 	}
 
 	return lNewGeneration;
@@ -135,3 +390,11 @@ Parent GeneticAlgorithm::GetBestParent()
 {
 	return this->m_BestParent;
 }
+
+/** Returns the total number of fitness evaluations made
+* @return The number of evaluations
+*/
+unsigned long GeneticAlgorithm::GetNumberOfEvaluations() const
+{
+	return this->m_NumberOfEvaluations;
+}
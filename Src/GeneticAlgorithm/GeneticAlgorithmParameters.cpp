@@ -15,6 +15,15 @@ GeneticAlgorithmParameters::GeneticAlgorithmParameters()
 	this->m_NumberOfParents = 0;
 	this->m_RandomParentRatio = 0;
 	this->m_ParentTemplate = std::vector<std::shared_ptr<ParentPropertyBase>>();
+	this->m_NichingType = NichingType::NoNiching;
+	this->m_NicheRadius = 0.0;
+	this->m_NicheCapacity = 1;
+	this->m_InitialSamples = 1;
+	this->m_MaxSamples = 1;
+	this->m_ConfidenceBound = 1.96;
+	this->m_RacingRatio = 0.25;
+	this->m_CrossoverType = CrossoverType::PropertyCrossover;
+	this->m_CrossoverParameter = 0.0;
 }
 
 /** Constructor for GeneticAlgorithmParameters.
@@ -30,6 +39,15 @@ GeneticAlgorithmParameters::GeneticAlgorithmParameters(const unsigned int aNumbe
 	this->m_NumberOfParents = aNumberOfParents;
 	this->m_RandomParentRatio = aRandomParentRatio;
 	this->m_ParentTemplate = aParentPropertyTemplate;
+	this->m_NichingType = NichingType::NoNiching;
+	this->m_NicheRadius = 0.0;
+	this->m_NicheCapacity = 1;
+	this->m_InitialSamples = 1;
+	this->m_MaxSamples = 1;
+	this->m_ConfidenceBound = 1.96;
+	this->m_RacingRatio = 0.25;
+	this->m_CrossoverType = CrossoverType::PropertyCrossover;
+	this->m_CrossoverParameter = 0.0;
 }
 
 /** Copy Constructor for GeneticAlgorithmParameters.
@@ -41,6 +59,15 @@ GeneticAlgorithmParameters::GeneticAlgorithmParameters(const GeneticAlgorithmPar
 	this->m_NumberOfParents = aCopy.m_NumberOfParents;
 	this->m_RandomParentRatio = aCopy.m_RandomParentRatio;
 	this->m_ParentTemplate = aCopy.m_ParentTemplate;
+	this->m_NichingType = aCopy.m_NichingType;
+	this->m_NicheRadius = aCopy.m_NicheRadius;
+	this->m_NicheCapacity = aCopy.m_NicheCapacity;
+	this->m_InitialSamples = aCopy.m_InitialSamples;
+	this->m_MaxSamples = aCopy.m_MaxSamples;
+	this->m_ConfidenceBound = aCopy.m_ConfidenceBound;
+	this->m_RacingRatio = aCopy.m_RacingRatio;
+	this->m_CrossoverType = aCopy.m_CrossoverType;
+	this->m_CrossoverParameter = aCopy.m_CrossoverParameter;
 }
 
 /** Move Constructor for GeneticAlgorithmParameters.
@@ -52,11 +79,29 @@ GeneticAlgorithmParameters::GeneticAlgorithmParameters(GeneticAlgorithmParameter
 	this->m_NumberOfParents = std::move(aMove.m_NumberOfParents);
 	this->m_RandomParentRatio = std::move(aMove.m_RandomParentRatio);
 	this->m_ParentTemplate = std::move(aMove.m_ParentTemplate);
+	this->m_NichingType = aMove.m_NichingType;
+	this->m_NicheRadius = aMove.m_NicheRadius;
+	this->m_NicheCapacity = aMove.m_NicheCapacity;
+	this->m_InitialSamples = aMove.m_InitialSamples;
+	this->m_MaxSamples = aMove.m_MaxSamples;
+	this->m_ConfidenceBound = aMove.m_ConfidenceBound;
+	this->m_RacingRatio = aMove.m_RacingRatio;
+	this->m_CrossoverType = aMove.m_CrossoverType;
+	this->m_CrossoverParameter = aMove.m_CrossoverParameter;
 
 	aMove.m_NumberOfGenerations = 0;
 	aMove.m_NumberOfParents = 0;
 	aMove.m_RandomParentRatio = 0;
 	aMove.m_ParentTemplate = std::vector<std::shared_ptr<ParentPropertyBase>>();
+	aMove.m_NichingType = NichingType::NoNiching;
+	aMove.m_NicheRadius = 0.0;
+	aMove.m_NicheCapacity = 1;
+	aMove.m_InitialSamples = 1;
+	aMove.m_MaxSamples = 1;
+	aMove.m_ConfidenceBound = 1.96;
+	aMove.m_RacingRatio = 0.25;
+	aMove.m_CrossoverType = CrossoverType::PropertyCrossover;
+	aMove.m_CrossoverParameter = 0.0;
 }
 
 /** Swap function for the GeneticAlgorithmParameters class.
@@ -69,6 +114,15 @@ void GeneticAlgorithmParameters::swap(GeneticAlgorithmParameters& aFirst, Geneti
 	std::swap(aFirst.m_NumberOfParents, aSecond.m_NumberOfParents);
 	std::swap(aFirst.m_RandomParentRatio, aSecond.m_RandomParentRatio);
 	std::swap(aFirst.m_ParentTemplate, aSecond.m_ParentTemplate);
+	std::swap(aFirst.m_NichingType, aSecond.m_NichingType);
+	std::swap(aFirst.m_NicheRadius, aSecond.m_NicheRadius);
+	std::swap(aFirst.m_NicheCapacity, aSecond.m_NicheCapacity);
+	std::swap(aFirst.m_InitialSamples, aSecond.m_InitialSamples);
+	std::swap(aFirst.m_MaxSamples, aSecond.m_MaxSamples);
+	std::swap(aFirst.m_ConfidenceBound, aSecond.m_ConfidenceBound);
+	std::swap(aFirst.m_RacingRatio, aSecond.m_RacingRatio);
+	std::swap(aFirst.m_CrossoverType, aSecond.m_CrossoverType);
+	std::swap(aFirst.m_CrossoverParameter, aSecond.m_CrossoverParameter);
 }
 
 /** Returns the number of generations.
@@ -103,6 +157,127 @@ std::vector<std::shared_ptr<ParentPropertyBase>> GeneticAlgorithmParameters::get
 	return this->m_ParentTemplate;
 }
 
+/** Returns the niching method.
+* @return The niching method.
+*/
+NichingType GeneticAlgorithmParameters::getNichingType() const
+{
+	return this->m_NichingType;
+}
+
+/** Returns the niche radius.
+* @return The niche radius (measured in the normalized property space where every property ranges from 0.0 to 1.0).
+*/
+double GeneticAlgorithmParameters::getNicheRadius() const
+{
+	return this->m_NicheRadius;
+}
+
+/** Returns the niche capacity.
+* @return The number of parents that keep their fitness in each niche (only used for clearing).
+*/
+unsigned int GeneticAlgorithmParameters::getNicheCapacity() const
+{
+	return this->m_NicheCapacity;
+}
+
+/** Returns the number of fitness samples every parent gets.
+* @return The initial number of samples.
+*/
+unsigned int GeneticAlgorithmParameters::getInitialSamples() const
+{
+	return this->m_InitialSamples;
+}
+
+/** Returns the maximum number of fitness samples a parent can get.
+* @return The maximum number of samples.
+*/
+unsigned int GeneticAlgorithmParameters::getMaxSamples() const
+{
+	return this->m_MaxSamples;
+}
+
+/** Returns the confidence bound used to decide if a parent's rank is certain.
+* @return The confidence bound (number of standard errors).
+*/
+double GeneticAlgorithmParameters::getConfidenceBound() const
+{
+	return this->m_ConfidenceBound;
+}
+
+/** Returns the fraction of the population that racing separates from the rest.
+* @return The racing ratio.
+*/
+double GeneticAlgorithmParameters::getRacingRatio() const
+{
+	return this->m_RacingRatio;
+}
+
+/** Returns whether the fitness function is noisy (parents are sampled more than once).
+* @return True if the fitness is noisy.
+*/
+bool GeneticAlgorithmParameters::isNoisyFitness() const
+{
+	return this->m_MaxSamples > 1;
+}
+
+/** Sets the niching method used to preserve diversity in the population.
+* @param aNichingType The niching method.
+* @param aNicheRadius The niche radius (measured in the normalized property space where every property ranges from 0.0 to 1.0).
+* @param aNicheCapacity The number of parents that keep their fitness in each niche (only used for clearing).
+*/
+void GeneticAlgorithmParameters::setNiching(const NichingType aNichingType, const double aNicheRadius, const unsigned int aNicheCapacity)
+{
+	this->m_NichingType = aNichingType;
+	this->m_NicheRadius = aNicheRadius;
+	this->m_NicheCapacity = (aNicheCapacity == 0) ? 1 : aNicheCapacity;
+}
+
+/** Returns the crossover method.
+* @return The crossover method.
+*/
+CrossoverType GeneticAlgorithmParameters::getCrossoverType() const
+{
+	return this->m_CrossoverType;
+}
+
+/** Returns the parameter of the crossover method.
+* @return The crossover parameter (alpha for BLXCrossover, the distribution index for SBXCrossover, otherwise unused).
+*/
+double GeneticAlgorithmParameters::getCrossoverParameter() const
+{
+	return this->m_CrossoverParameter;
+}
+
+/** Sets the crossover method.
+* @param aCrossoverType The crossover method.
+* @param aCrossoverParameter The crossover parameter (alpha for BLXCrossover e.g. 0.5, the distribution index for SBXCrossover e.g. 2.0, otherwise unused).
+* Throws if the distribution index of SBXCrossover is negative.
+*/
+void GeneticAlgorithmParameters::setCrossover(const CrossoverType aCrossoverType, const double aCrossoverParameter)
+{
+	// SBX raises to the power 1/(index+1), which divides by zero at -1 and is not a distribution for any negative index
+	if (aCrossoverType == CrossoverType::SBXCrossover && !(aCrossoverParameter >= 0.0)) throw 69;
+
+	this->m_CrossoverType = aCrossoverType;
+	this->m_CrossoverParameter = aCrossoverParameter;
+}
+
+/** Sets up racing for a noisy fitness function. Every parent is sampled aInitialSamples times, then only the parents
+* that can not yet be told apart from the selection boundary (the best aRacingRatio of the population) are sampled again, up to aMaxSamples.
+* @param aInitialSamples The number of fitness samples every parent gets (at least 2).
+* @param aMaxSamples The maximum number of fitness samples a parent can get.
+* @param aConfidenceBound The half width of the confidence interval in standard errors (1.96 is about 95%).
+* @param aRacingRatio The fraction of the population that has to be separated from the rest (the parents most likely to be bred).
+*/
+void GeneticAlgorithmParameters::setNoisyFitness(const unsigned int aInitialSamples, const unsigned int aMaxSamples, const double aConfidenceBound, const double aRacingRatio)
+{
+	this->m_InitialSamples = (aInitialSamples < 2) ? 2 : aInitialSamples;
+	this->m_MaxSamples = (aMaxSamples < this->m_InitialSamples) ? this->m_InitialSamples : aMaxSamples;
+	this->m_ConfidenceBound = aConfidenceBound;
+	this->m_RacingRatio = (aRacingRatio <= 0.0 || aRacingRatio >= 1.0) ? 0.25 : aRacingRatio;
+}
+
 /** Assignment operator
 * @param The right side of the = operator
 */
@@ -112,5 +287,14 @@ GeneticAlgorithmParameters& GeneticAlgorithmParameters::operator=(const GeneticA
 	this->m_NumberOfParents = aRight.m_NumberOfParents;
 	this->m_RandomParentRatio = aRight.m_RandomParentRatio;
 	this->m_NumberOfGenerations = aRight.m_NumberOfGenerations;
+	this->m_NichingType = aRight.m_NichingType;
+	this->m_NicheRadius = aRight.m_NicheRadius;
+	this->m_NicheCapacity = aRight.m_NicheCapacity;
+	this->m_InitialSamples = aRight.m_InitialSamples;
+	this->m_MaxSamples = aRight.m_MaxSamples;
+	this->m_ConfidenceBound = aRight.m_ConfidenceBound;
+	this->m_RacingRatio = aRight.m_RacingRatio;
+	this->m_CrossoverType = aRight.m_CrossoverType;
+	this->m_CrossoverParameter = aRight.m_CrossoverParameter;
 	return *this;
 }
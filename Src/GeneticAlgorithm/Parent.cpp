@@ -4,6 +4,7 @@
 **/
 
 #include "Parent.h"
+#include "ParentPropertyDouble.h"
 
 #pragma unmanaged
 
@@ -152,6 +153,102 @@ std::vector<std::unique_ptr<ParentPropertyBase>> Parent::getProperties() const
 	return lResult;
 }
 
+/** Returns the parent's property values.
+* @return The property values.
+*/
+std::vector<double> Parent::getValues() const
+{
+	std::vector<double> lResult(this->m_ParentProperties.size());
+
+	for (unsigned lCount = 0; lCount < lResult.size(); lCount++)
+	{
+		switch (this->m_ParentProperties[lCount]->Type())
+		{
+		case PropertyType::Double:
+			lResult[lCount] = dynamic_cast<const ParentPropertyDouble*>(this->m_ParentProperties[lCount].get())->getValue();
+			break;
+		default:
+			lResult[lCount] = 0.0;
+			break;
+		}
+	}
+
+	return lResult;
+}
+
+/** Returns the max and min values of each of the parent's properties.
+* @param aMaxValues Will be returned with the max value of each property.
+* @param aMinValues Will be returned with the min value of each property.
+*/
+void Parent::getLimits(std::vector<double>& aMaxValues, std::vector<double>& aMinValues) const
+{
+	aMaxValues.resize(this->m_ParentProperties.size());
+	aMinValues.resize(this->m_ParentProperties.size());
+
+	for (unsigned lCount = 0; lCount < this->m_ParentProperties.size(); lCount++)
+	{
+		switch (this->m_ParentProperties[lCount]->Type())
+		{
+		case PropertyType::Double:
+		{
+			const ParentPropertyDouble * const lDoublePropertyPtr = dynamic_cast<const ParentPropertyDouble*>(this->m_ParentProperties[lCount].get());
+			aMaxValues[lCount] = lDoublePropertyPtr->getMax();
+			aMinValues[lCount] = lDoublePropertyPtr->getMin();
+			break;
+		}
+		default:
+			aMaxValues[lCount] = 0.0;
+			aMinValues[lCount] = 0.0;
+			break;
+		}
+	}
+}
+
+/** Sets the values of the parent's properties.
+* @param aValues The new values, one for each property.
+*/
+void Parent::setValues(const double* const aValues)
+{
+	for (unsigned lCount = 0; lCount < this->m_ParentProperties.size(); lCount++)
+	{
+		switch (this->m_ParentProperties[lCount]->Type())
+		{
+		case PropertyType::Double:
+			dynamic_cast<ParentPropertyDouble*>(this->m_ParentProperties[lCount].get())->setValue(aValues[lCount]);
+			break;
+		default:
+			break;
+		}
+	}
+}
+
+/** Returns the parent's property values mapped onto the range 0.0 to 1.0 (using each property's max and min).
+* @return The normalized property values.
+*/
+std::vector<double> Parent::getNormalizedValues() const
+{
+	std::vector<double> lResult(this->m_ParentProperties.size());
+
+	for (unsigned lCount = 0; lCount < lResult.size(); lCount++)
+	{
+		switch (this->m_ParentProperties[lCount]->Type())
+		{
+		case PropertyType::Double:
+		{
+			const ParentPropertyDouble * const lDoublePropertyPtr = dynamic_cast<const ParentPropertyDouble*>(this->m_ParentProperties[lCount].get());
+			double lRange = lDoublePropertyPtr->getMax() - lDoublePropertyPtr->getMin();
+			lResult[lCount] = (lRange == 0.0) ? 0.0 : (lDoublePropertyPtr->getValue() - lDoublePropertyPtr->getMin()) / lRange;
+			break;
+		}
+		default:
+			lResult[lCount] = 0.0;
+			break;
+		}
+	}
+
+	return lResult;
+}
+
 /** Assignment operator
 * @param aRight The object to the right of the operator sign
 */
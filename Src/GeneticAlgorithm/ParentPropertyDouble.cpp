@@ -91,6 +91,14 @@ double ParentPropertyDouble::getMin() const
 	return this->m_MinValue;
 }
 
+/** Sets the value of the property.
+* @param aValue The new value (clamped to the min and max of the property).
+*/
+void ParentPropertyDouble::setValue(const double aValue)
+{
+	this->m_Value = (aValue > this->m_MaxValue) ? this->m_MaxValue : ((aValue < this->m_MinValue) ? this->m_MinValue : aValue);
+}
+
 /** Perform the crossing of the two properties.
 * @param aParentProperty The property to cross with
 * @param aSeed The seed for the random number generator
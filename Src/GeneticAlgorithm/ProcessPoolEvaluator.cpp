@@ -0,0 +1,356 @@
+/**
+*  @file    ProcessPoolEvaluator.cpp
+*  @author  Jordan Nesley
+**/
+
+#include "ProcessPoolEvaluator.h"
+
+#pragma unmanaged
+
+#ifndef _WIN32
+
+#include <sys/socket.h>
+#include <sys/wait.h>
+#include <poll.h>
+#include <unistd.h>
+#include <signal.h>
+#include <errno.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <float.h> // DBL_MAX
+#include <limits.h> // INT_MAX
+
+/** Constructor for ProcessPoolEvaluator. Starts all the worker processes.
+* @param aCommand The program to run for each worker followed by its arguments.
+* @param aNumberOfWorkers The number of worker processes (usually the number of cores).
+* @param aBatchSize The maximum number of parents sent to a worker before its results are read back.
+* @param aMaxRetries The number of times a parent is sent again after its worker crashes before it is given up on.
+* @param aTimeout The milliseconds a worker with unfinished parents may go without reading a parent or writing a fitness
+*                 before it is treated as crashed (must be more than the time the slowest fitness takes).
+*/
+ProcessPoolEvaluator::ProcessPoolEvaluator(const std::vector<std::string>& aCommand, const unsigned aNumberOfWorkers, const unsigned aBatchSize, const unsigned aMaxRetries, const unsigned aTimeout)
+{
+	if (aCommand.empty() || aNumberOfWorkers == 0 || aTimeout == 0) throw ProcessPoolEvaluator::CONSTRUCTOR_EXCEPTION;
+
+	this->m_Command = aCommand;
+	this->m_NumberOfWorkers = aNumberOfWorkers;
+	this->m_BatchSize = (aBatchSize == 0) ? 1 : aBatchSize;
+	this->m_MaxRetries = aMaxRetries;
+	this->m_Timeout = aTimeout;
+	this->m_Workers = std::vector<Worker>(aNumberOfWorkers);
+
+	unsigned lCount = 0;
+	try
+	{
+		for (; lCount < this->m_Workers.size(); lCount++)
+		{
+			this->startWorker(this->m_Workers[lCount]);
+		}
+	}
+	catch (...)
+	{
+		// the destructor does not run for a constructor that throws, so stop the workers started so far here
+		for (unsigned lStarted = 0; lStarted < lCount; lStarted++)
+		{
+			this->stopWorker(this->m_Workers[lStarted]);
+		}
+		throw;
+	}
+}
+
+/** Destructor for ProcessPoolEvaluator. Stops all the worker processes.
+*/
+ProcessPoolEvaluator::~ProcessPoolEvaluator()
+{
+	// ask every worker to exit first, so they shut down at the same time instead of one after another
+	for (unsigned lCount = 0; lCount < this->m_Workers.size(); lCount++)
+	{
+		if (this->m_Workers[lCount].ProcessId > 0) kill(this->m_Workers[lCount].ProcessId, SIGTERM);
+	}
+
+	for (unsigned lCount = 0; lCount < this->m_Workers.size(); lCount++)
+	{
+		this->stopWorker(this->m_Workers[lCount]);
+	}
+}
+
+/** Returns the path of a program the way execvp finds it: the name itself if it contains a '/', otherwise the first
+*   executable file of that name in a directory of PATH.
+* @param aProgram The name of the program.
+*/
+static std::string findProgram(const std::string& aProgram)
+{
+	if (aProgram.find('/') != std::string::npos) return aProgram;
+
+	const char* lPath = getenv("PATH");
+	std::string lDirectories = (lPath == nullptr) ? "/bin:/usr/bin" : lPath;
+	std::size_t lStart = 0;
+	while (true)
+	{
+		std::size_t lEnd = lDirectories.find(':', lStart);
+		std::string lDirectory = lDirectories.substr(lStart, (lEnd == std::string::npos) ? std::string::npos : lEnd - lStart);
+		std::string lCandidate = (lDirectory.empty() ? std::string(".") : lDirectory) + "/" + aProgram;
+		if (access(lCandidate.c_str(), X_OK) == 0) return lCandidate;
+
+		if (lEnd == std::string::npos) break;
+		lStart = lEnd + 1;
+	}
+
+	// not found: execv fails and the worker exits with 127 like it would with execvp
+	return aProgram;
+}
+
+/** Starts a worker process connected to the evaluator through a unix socket on its stdin and stdout.
+* @param aWorker The worker to start.
+*/
+void ProcessPoolEvaluator::startWorker(Worker& aWorker)
+{
+	// everything that allocates is done before fork: in a multithreaded parent the child may only make async-signal-safe
+	// calls, or it can deadlock on a lock (e.g. of malloc) held by another thread at the time of the fork
+	std::string lProgram = findProgram(this->m_Command[0]);
+	std::vector<char*> lArguments(this->m_Command.size() + 1, nullptr);
+	for (unsigned lCount = 0; lCount < this->m_Command.size(); lCount++)
+	{
+		lArguments[lCount] = const_cast<char*>(this->m_Command[lCount].c_str());
+	}
+
+	int lSockets[2];
+	if (socketpair(AF_UNIX, SOCK_STREAM | SOCK_CLOEXEC, 0, lSockets) != 0) throw ProcessPoolEvaluator::WORKER_START_EXCEPTION;
+
+	pid_t lProcessId = fork();
+	if (lProcessId < 0)
+	{
+		close(lSockets[0]);
+		close(lSockets[1]);
+		throw ProcessPoolEvaluator::WORKER_START_EXCEPTION;
+	}
+
+	if (lProcessId == 0)
+	{
+		// the worker process
+		dup2(lSockets[1], STDIN_FILENO);
+		dup2(lSockets[1], STDOUT_FILENO);
+		execv(lProgram.c_str(), lArguments.data());
+		_exit(127);
+	}
+
+	close(lSockets[1]);
+	aWorker.ProcessId = lProcessId;
+	aWorker.Socket = lSockets[0];
+	aWorker.WriteBuffer.clear();
+	aWorker.ReadBuffer.clear();
+	aWorker.Jobs.clear();
+}
+
+/** Stops a worker process and waits for it to exit. A worker that is still running STOP_TIMEOUT milliseconds after
+*   SIGTERM (e.g. it ignores the signal) is killed.
+* @param aWorker The worker to stop.
+*/
+void ProcessPoolEvaluator::stopWorker(Worker& aWorker)
+{
+	if (aWorker.Socket >= 0) close(aWorker.Socket);
+	if (aWorker.ProcessId > 0)
+	{
+		kill(aWorker.ProcessId, SIGTERM);
+
+		bool lExited = false;
+		for (unsigned lWaited = 0; !lExited && lWaited <= ProcessPoolEvaluator::STOP_TIMEOUT; lWaited += 10)
+		{
+			pid_t lResult = waitpid(aWorker.ProcessId, nullptr, WNOHANG);
+			if (lResult == aWorker.ProcessId || (lResult < 0 && errno != EINTR)) lExited = true;
+			else usleep(10000);
+		}
+
+		if (!lExited)
+		{
+			kill(aWorker.ProcessId, SIGKILL);
+			while (waitpid(aWorker.ProcessId, nullptr, 0) < 0 && errno == EINTR) {}
+		}
+	}
+
+	aWorker.ProcessId = -1;
+	aWorker.Socket = -1;
+}
+
+/** Evaluates the fitness of every parent using the worker processes. Results are collected as the workers finish them.
+* @param aValues The property values of all the parents stored one after another.
+* @param aNumberOfProperties The number of properties of each parent.
+* @param aFitness Will be returned with the fitness of each parent. Parents that could not be evaluated get DBL_MAX.
+*/
+void ProcessPoolEvaluator::Evaluate(const std::vector<double>& aValues, const unsigned aNumberOfProperties, std::vector<double>& aFitness)
+{
+	unsigned lNumberOfParents = (aNumberOfProperties == 0) ? 0 : aValues.size() / aNumberOfProperties;
+	aFitness.assign(lNumberOfParents, DBL_MAX);
+
+	// a previous call that ended early (poll failed, or a worker could not be restarted) can leave parents in flight whose
+	// results would be credited to the parents of this call: restart every worker that still has some
+	for (unsigned lCountW = 0; lCountW < this->m_Workers.size(); lCountW++)
+	{
+		Worker& lWorker = this->m_Workers[lCountW];
+		if (!lWorker.Jobs.empty() || !lWorker.ReadBuffer.empty() || lWorker.ProcessId <= 0)
+		{
+			if (lWorker.ProcessId > 0) kill(lWorker.ProcessId, SIGKILL);
+			this->stopWorker(lWorker);
+			this->startWorker(lWorker);
+		}
+		lWorker.Jobs.clear();
+		lWorker.ReadBuffer.clear();
+		lWorker.WriteBuffer.clear();
+	}
+
+	std::deque<unsigned> lQueue;
+	for (unsigned lCount = 0; lCount < lNumberOfParents; lCount++)
+	{
+		lQueue.push_back(lCount);
+	}
+	std::vector<unsigned> lRetries(lNumberOfParents, 0);
+	unsigned lRemaining = lNumberOfParents;
+
+	std::vector<pollfd> lPollList(this->m_Workers.size());
+	char lNumber[32];
+	char lReadBuffer[4096];
+
+	while (lRemaining > 0)
+	{
+		// top up each worker with a batch of parents
+		for (unsigned lCountW = 0; lCountW < this->m_Workers.size(); lCountW++)
+		{
+			Worker& lWorker = this->m_Workers[lCountW];
+			if (lWorker.Jobs.empty() && !lQueue.empty()) lWorker.LastActivity = std::chrono::steady_clock::now();
+
+			while (lWorker.Jobs.size() < this->m_BatchSize && !lQueue.empty())
+			{
+				unsigned lJob = lQueue.front();
+				lQueue.pop_front();
+				lWorker.Jobs.push_back(lJob);
+
+				for (unsigned lCountP = 0; lCountP < aNumberOfProperties; lCountP++)
+				{
+					snprintf(lNumber, sizeof(lNumber), (lCountP == 0) ? "%.17g" : " %.17g", aValues[lJob * aNumberOfProperties + lCountP]);
+					lWorker.WriteBuffer += lNumber;
+				}
+				lWorker.WriteBuffer += '\n';
+			}
+
+			lPollList[lCountW].fd = lWorker.Jobs.empty() ? -1 : lWorker.Socket;
+			lPollList[lCountW].events = POLLIN | (lWorker.WriteBuffer.empty() ? 0 : POLLOUT);
+			lPollList[lCountW].revents = 0;
+		}
+
+		// wake up in time to restart the first worker whose timeout runs out
+		std::chrono::steady_clock::time_point lNow = std::chrono::steady_clock::now();
+		long long lTimeout = -1;
+		for (unsigned lCountW = 0; lCountW < this->m_Workers.size(); lCountW++)
+		{
+			if (lPollList[lCountW].fd < 0) continue;
+
+			long long lLeft = std::chrono::duration_cast<std::chrono::milliseconds>(this->m_Workers[lCountW].LastActivity + std::chrono::milliseconds(this->m_Timeout) - lNow).count();
+			if (lLeft < 0) lLeft = 0;
+			if (lTimeout < 0 || lLeft < lTimeout) lTimeout = lLeft;
+		}
+		if (lTimeout > INT_MAX) lTimeout = INT_MAX;
+
+		if (poll(lPollList.data(), lPollList.size(), static_cast<int>(lTimeout)) < 0)
+		{
+			if (errno == EINTR) continue;
+			DebugLogger::getInstance().logMessage(DebugLogger::MessageLoggerType::Error, __FUNCTION__, "poll failed");
+			break;
+		}
+
+		lNow = std::chrono::steady_clock::now();
+		for (unsigned lCountW = 0; lCountW < this->m_Workers.size(); lCountW++)
+		{
+			Worker& lWorker = this->m_Workers[lCountW];
+			short lEvents = lPollList[lCountW].revents;
+			bool lCrashed = false;
+			bool lHung = false;
+
+			if (lPollList[lCountW].fd < 0) continue;
+			if (lEvents == 0)
+			{
+				if (lNow - lWorker.LastActivity < std::chrono::milliseconds(this->m_Timeout)) continue;
+				lCrashed = true;
+				lHung = true;
+			}
+
+			if ((lEvents & POLLOUT) && !lWorker.WriteBuffer.empty())
+			{
+				ssize_t lSent = send(lWorker.Socket, lWorker.WriteBuffer.data(), lWorker.WriteBuffer.size(), MSG_NOSIGNAL | MSG_DONTWAIT);
+				if (lSent > 0)
+				{
+					lWorker.WriteBuffer.erase(0, lSent);
+					lWorker.LastActivity = lNow;
+				}
+				else if (lSent < 0 && errno != EAGAIN && errno != EWOULDBLOCK && errno != EINTR)
+				{
+					lCrashed = true;
+				}
+			}
+
+			if (!lCrashed && (lEvents & (POLLIN | POLLHUP | POLLERR)))
+			{
+				ssize_t lReceived = recv(lWorker.Socket, lReadBuffer, sizeof(lReadBuffer), MSG_DONTWAIT);
+				if (lReceived > 0)
+				{
+					lWorker.ReadBuffer.append(lReadBuffer, lReceived);
+					lWorker.LastActivity = lNow;
+
+					// every complete line is the fitness of the oldest parent sent to the worker
+					std::size_t lEndOfLine;
+					while (!lCrashed && (lEndOfLine = lWorker.ReadBuffer.find('\n')) != std::string::npos)
+					{
+						std::string lLine = lWorker.ReadBuffer.substr(0, lEndOfLine);
+						lWorker.ReadBuffer.erase(0, lEndOfLine + 1);
+
+						char* lEnd;
+						double lFitness = strtod(lLine.c_str(), &lEnd);
+						if (lEnd == lLine.c_str() || lWorker.Jobs.empty())
+						{
+							lCrashed = true;
+						}
+						else
+						{
+							aFitness[lWorker.Jobs.front()] = lFitness;
+							lWorker.Jobs.pop_front();
+							lRemaining--;
+						}
+					}
+				}
+				else if (lReceived == 0 || (errno != EAGAIN && errno != EWOULDBLOCK && errno != EINTR))
+				{
+					lCrashed = true;
+				}
+			}
+
+			if (lCrashed)
+			{
+				DebugLogger::getInstance().logMessage(DebugLogger::MessageLoggerType::Warning, __FUNCTION__, lHung ? "Worker not responding, restarting" : "Worker crashed, restarting");
+
+				std::deque<unsigned> lUnfinished = lWorker.Jobs;
+				kill(lWorker.ProcessId, SIGKILL);
+				this->stopWorker(lWorker);
+				this->startWorker(lWorker);
+
+				// send the unfinished parents again (in front of the queue so they keep their order)
+				while (!lUnfinished.empty())
+				{
+					unsigned lJob = lUnfinished.back();
+					lUnfinished.pop_back();
+
+					lRetries[lJob]++;
+					if (lRetries[lJob] > this->m_MaxRetries)
+					{
+						DebugLogger::getInstance().logMessage(DebugLogger::MessageLoggerType::Error, __FUNCTION__, "Parent could not be evaluated");
+						lRemaining--;
+					}
+					else
+					{
+						lQueue.push_front(lJob);
+					}
+				}
+			}
+		}
+	}
+}
+
+#endif
@@ -0,0 +1,153 @@
+/**
+*  @file    RealCrossover.cpp
+*  @author  Jordan Nesley
+**/
+
+#include "RealCrossover.h"
+
+#pragma unmanaged
+
+/** Crosses over a whole generation of parents.
+* @param aCrossoverType The crossover method (PropertyCrossover is not handled here).
+* @param aCrossoverParameter The crossover parameter (alpha for BLXCrossover, the distribution index for SBXCrossover).
+* @param aMothers The property values of the first parent of each child (one row per child).
+* @param aFathers The property values of the second parent of each child (one row per child).
+* @param aChildren Will be returned with the property values of the children (one row per child).
+* @param aMaxValues The max value of each property.
+* @param aMinValues The min value of each property.
+* @param aSeed The seed for the random number generator.
+*/
+void RealCrossover::Crossover(const CrossoverType aCrossoverType, const double aCrossoverParameter, const std::vector<double>& aMothers, const std::vector<double>& aFathers,
+	std::vector<double>& aChildren, const std::vector<double>& aMaxValues, const std::vector<double>& aMinValues, const unsigned aSeed)
+{
+	unsigned lNumberOfProperties = aMaxValues.size();
+	if (lNumberOfProperties == 0 || aMothers.size() != aFathers.size() || aMothers.size() % lNumberOfProperties != 0) throw 69;
+
+	unsigned lNumberOfChildren = aMothers.size() / lNumberOfProperties;
+	aChildren.resize(aMothers.size());
+
+	switch (aCrossoverType)
+	{
+	case CrossoverType::ArithmeticCrossover:
+	{
+		std::vector<double> lRandom = Utilities::RandomNumber(aSeed, lNumberOfChildren, 1.0, 0.0);
+		arithmetic(aMothers.data(), aFathers.data(), aChildren.data(), lRandom.data(), lNumberOfChildren, lNumberOfProperties);
+		break;
+	}
+	case CrossoverType::BLXCrossover:
+	{
+		std::vector<double> lRandom = Utilities::RandomNumber(aSeed, aMothers.size(), 1.0, 0.0);
+		blx(aMothers.data(), aFathers.data(), aChildren.data(), lRandom.data(), aMothers.size(), aCrossoverParameter);
+		break;
+	}
+	case CrossoverType::SBXCrossover:
+	{
+		std::vector<double> lRandom = Utilities::RandomNumber(aSeed, aMothers.size(), 1.0, 0.0);
+		sbx(aMothers.data(), aFathers.data(), aChildren.data(), lRandom.data(), aMothers.size(), aCrossoverParameter);
+		break;
+	}
+	case CrossoverType::UniformCrossover:
+	{
+		std::vector<double> lRandom = Utilities::RandomNumber(aSeed, aMothers.size(), 1.0, 0.0);
+		uniform(aMothers.data(), aFathers.data(), aChildren.data(), lRandom.data(), aMothers.size());
+		break;
+	}
+	default:
+		throw 69;
+	}
+
+	clamp(aChildren.data(), aMaxValues.data(), aMinValues.data(), lNumberOfChildren, lNumberOfProperties);
+}
+
+/** Whole arithmetic crossover: child = r*mother + (1-r)*father with one random weight per child.
+*/
+void RealCrossover::arithmetic(const double* const aMothers, const double* const aFathers, double* const aChildren, const double* const aRandom, const unsigned aNumberOfChildren, const unsigned aNumberOfProperties)
+{
+	for (unsigned lCountC = 0; lCountC < aNumberOfChildren; lCountC++)
+	{
+		const double lWeight = aRandom[lCountC];
+		const double* __restrict lMother = aMothers + (std::size_t)lCountC * aNumberOfProperties;
+		const double* __restrict lFather = aFathers + (std::size_t)lCountC * aNumberOfProperties;
+		double* __restrict lChild = aChildren + (std::size_t)lCountC * aNumberOfProperties;
+		for (unsigned lCountP = 0; lCountP < aNumberOfProperties; lCountP++)
+		{
+			lChild[lCountP] = lFather[lCountP] + lWeight * (lMother[lCountP] - lFather[lCountP]);
+		}
+	}
+}
+
+/** Blend crossover (BLX-alpha): each child value is drawn uniformly from the parents' interval extended by alpha times its length on both sides.
+*/
+void RealCrossover::blx(const double* const aMothers, const double* const aFathers, double* const aChildren, const double* const aRandom, const std::size_t aNumberOfValues, const double aAlpha)
+{
+	const double* __restrict lMothers = aMothers;
+	const double* __restrict lFathers = aFathers;
+	const double* __restrict lRandom = aRandom;
+	double* __restrict lChildren = aChildren;
+	const double lScale = 1.0 + 2.0 * aAlpha;
+
+	for (std::size_t lCount = 0; lCount < aNumberOfValues; lCount++)
+	{
+		double lLow = (lMothers[lCount] < lFathers[lCount]) ? lMothers[lCount] : lFathers[lCount];
+		double lHigh = (lMothers[lCount] < lFathers[lCount]) ? lFathers[lCount] : lMothers[lCount];
+		double lLength = lHigh - lLow;
+		lChildren[lCount] = lLow - aAlpha * lLength + lRandom[lCount] * lScale * lLength;
+	}
+}
+
+/** Simulated binary crossover (SBX): child = 0.5*((1+beta)*mother + (1-beta)*father) where beta follows the
+* polynomial distribution with the given distribution index (at least 0). The loop is not vectorized: pow is a scalar
+* library call.
+*/
+void RealCrossover::sbx(const double* const aMothers, const double* const aFathers, double* const aChildren, const double* const aRandom, const std::size_t aNumberOfValues, const double aDistributionIndex)
+{
+	const double* __restrict lMothers = aMothers;
+	const double* __restrict lFathers = aFathers;
+	const double* __restrict lRandom = aRandom;
+	double* __restrict lChildren = aChildren;
+	const double lExponent = 1.0 / (aDistributionIndex + 1.0);
+
+	for (std::size_t lCount = 0; lCount < aNumberOfValues; lCount++)
+	{
+		// both sides of the distribution are calculated and one is selected instead of branching on the random draw
+		double lRandomValue = lRandom[lCount];
+		double lLowerBase = 2.0 * lRandomValue;
+		double lUpperBase = 1.0 / (2.0 * (1.0 - lRandomValue) + 1e-300);
+		double lBase = (lRandomValue <= 0.5) ? lLowerBase : lUpperBase;
+		double lBeta = pow(lBase, lExponent);
+		lChildren[lCount] = 0.5 * ((1.0 + lBeta) * lMothers[lCount] + (1.0 - lBeta) * lFathers[lCount]);
+	}
+}
+
+/** Uniform crossover: each child value is copied from the mother or the father with equal probability.
+*/
+void RealCrossover::uniform(const double* const aMothers, const double* const aFathers, double* const aChildren, const double* const aRandom, const std::size_t aNumberOfValues)
+{
+	const double* __restrict lMothers = aMothers;
+	const double* __restrict lFathers = aFathers;
+	const double* __restrict lRandom = aRandom;
+	double* __restrict lChildren = aChildren;
+
+	for (std::size_t lCount = 0; lCount < aNumberOfValues; lCount++)
+	{
+		lChildren[lCount] = (lRandom[lCount] < 0.5) ? lMothers[lCount] : lFathers[lCount];
+	}
+}
+
+/** Clamps the children's values to the limits of each property.
+*/
+void RealCrossover::clamp(double* const aChildren, const double* const aMaxValues, const double* const aMinValues, const unsigned aNumberOfChildren, const unsigned aNumberOfProperties)
+{
+	const double* __restrict lMaxValues = aMaxValues;
+	const double* __restrict lMinValues = aMinValues;
+
+	for (unsigned lCountC = 0; lCountC < aNumberOfChildren; lCountC++)
+	{
+		double* __restrict lChild = aChildren + (std::size_t)lCountC * aNumberOfProperties;
+		for (unsigned lCountP = 0; lCountP < aNumberOfProperties; lCountP++)
+		{
+			double lValue = (lChild[lCountP] > lMaxValues[lCountP]) ? lMaxValues[lCountP] : lChild[lCountP];
+			lChild[lCountP] = (lValue < lMinValues[lCountP]) ? lMinValues[lCountP] : lValue;
+		}
+	}
+}
@@ -1,25 +1,24 @@
 // Fill out your copyright notice in the Description page of Project Settings.
 
 #include "VoronoiDiagram.h"
+#include <cmath> // pow, sqrt
 
 /** The Fortune Algorithm
 */
 Graph<Position, int> VoronoiDiagram::CreateDiagram(const std::vector<Position>& aPolygonCenters, MyList<MapPolygon>& aPolygons)
 {
-	MyList<int> m_ParabolaList;
 	std::vector<Position> m_PolygonCenters = aPolygonCenters;
-	MyList<EdgeTracker> m_EdgeTracker;
+	Sweep m_Sweep;
 	Graph<Position, int> m_Graph;
-	MyList<PolygonTracker> m_PolygonTrackerList;
 	MyList<MapPolygon> m_PolygonList;
 	
 	//Sort the Polygon centers based on their x coordinates
 	//lPolygonCenters.sort([](const Position& a, const Position& b)->bool {return a.Y < b.Y; });
 	//std::sort(m_PolygonCenters.begin(), m_PolygonCenters.end(), [](const Position& a, const Position& b)->bool {return a.Y > b.Y; });
 	std::sort(m_PolygonCenters.begin(), m_PolygonCenters.end(),([](const Position& a, const Position& b)->bool {return a.Y > b.Y; }));
-	m_ParabolaList.insert(m_ParabolaList.begin(), 0);
-	m_ParabolaList.insert(m_ParabolaList.begin(), 1);
-	m_ParabolaList.insert(m_ParabolaList.begin(), 0);
+	m_Sweep.insertParabola(m_Sweep.Parabolas.begin(), 0);
+	m_Sweep.insertParabola(m_Sweep.Parabolas.begin(), 1);
+	m_Sweep.insertParabola(m_Sweep.Parabolas.begin(), 0);
 	int lCurrent = 2;
 
 	while (lCurrent < m_PolygonCenters.size())
@@ -27,40 +26,138 @@ Graph<Position, int> VoronoiDiagram::CreateDiagram(const std::vector<Position>&
 		double lSweepLine = m_PolygonCenters[lCurrent].Y;
 
 		// process any circle events
-		ProcessCircleEvents(lSweepLine, m_PolygonCenters, m_ParabolaList, m_EdgeTracker, m_PolygonTrackerList, m_PolygonList, m_Graph);
+		ProcessCircleEvents(lSweepLine, m_PolygonCenters, m_Sweep, m_PolygonList, m_Graph);
 
 		// process the new site event
-		ProcessSiteEvents(lCurrent, lSweepLine, m_PolygonCenters, m_ParabolaList, m_EdgeTracker);
+		ProcessSiteEvents(lCurrent, lSweepLine, m_PolygonCenters, m_Sweep);
 	}
 
-	PostProcessing(m_PolygonCenters, m_ParabolaList, m_EdgeTracker, m_PolygonTrackerList, m_PolygonList, m_Graph);
+	PostProcessing(m_PolygonCenters, m_Sweep, m_PolygonList, m_Graph);
 
 	aPolygons = m_PolygonList;
 	return m_Graph;
 }
 
+/** Destructor for Sweep: destroys the trackers left in the lists (the arcs are destroyed with the slot map)
+*/
+VoronoiDiagram::Sweep::~Sweep()
+{
+	this->EdgeTrackers.clearAndDispose([this](EdgeTracker* aTracker) { this->EdgeTrackerPool.destroy(aTracker); });
+	this->PolygonTrackers.clearAndDispose([this](PolygonTracker* aTracker) { this->PolygonTrackerPool.destroy(aTracker); });
+	this->Parabolas.clear();
+}
+
+/** Inserts a new arc into the beach line
+* @param aLoc The location to insert the arc in front of
+* @param aCenter The index of the polygon center of the arc
+* @return The location of the new arc
+*/
+VoronoiDiagram::ParabolaIterator VoronoiDiagram::Sweep::insertParabola(const ParabolaIterator& aLoc, const int aCenter)
+{
+	return this->Parabolas.insert(aLoc, *this->Arcs.get(this->Arcs.emplace(aCenter)));
+}
+
+/** Removes an arc from the beach line (handles to it are no longer found in the slot map)
+* @param aLoc The location of the arc
+* @return The location of the arc after it
+*/
+VoronoiDiagram::ParabolaIterator VoronoiDiagram::Sweep::eraseParabola(const ParabolaIterator& aLoc)
+{
+	const ArcHandle lHandle = this->Arcs.getHandle(*aLoc);
+	const ParabolaIterator Result = this->Parabolas.erase(aLoc);
+	this->Arcs.erase(lHandle);
+	return Result;
+}
+
+/** Creates an edge tracker (not yet in a list, see addEdgeTrackers)
+* @param aLeftParabola The arc on the left of the edge
+* @param aRightParabola The arc on the right of the edge
+* @param aNodeIndex The index of the graph node the edge starts at
+*/
+VoronoiDiagram::EdgeTracker* VoronoiDiagram::Sweep::createEdgeTracker(const ParabolaIterator& aLeftParabola, const ParabolaIterator& aRightParabola, const int aNodeIndex)
+{
+	EdgeTracker* const lTracker = this->EdgeTrackerPool.create();
+	lTracker->LeftParabola = this->Arcs.getHandle(*aLeftParabola);
+	lTracker->RightParabola = this->Arcs.getHandle(*aRightParabola);
+	lTracker->NodeIndex = aNodeIndex;
+	lTracker->Sequence = 0;
+	return lTracker;
+}
+
+/** Moves new edge trackers to the back of the list of edge trackers and links them to their arcs
+* @param aNewEdges The new edge trackers (left empty)
+*/
+void VoronoiDiagram::Sweep::addEdgeTrackers(EdgeTrackerList& aNewEdges)
+{
+	for (auto it = aNewEdges.begin(); it != aNewEdges.end(); it++)
+	{
+		// an arc removed since the tracker was created can never be matched again
+		(*it).Sequence = this->NextSequence++;
+		Arc* const lLeft = this->Arcs.get((*it).LeftParabola);
+		Arc* const lRight = this->Arcs.get((*it).RightParabola);
+		if (lLeft != nullptr) lLeft->LeftEdges.pushBack(*it);
+		if (lRight != nullptr) lRight->RightEdges.pushBack(*it);
+	}
+
+	this->EdgeTrackers.splice(this->EdgeTrackers.end(), aNewEdges);
+}
+
+/** Returns the edge trackers with an arc on their left or right, in the order of the list of edge trackers
+* @param aParabola The location of the arc
+*/
+std::vector<VoronoiDiagram::EdgeTracker*> VoronoiDiagram::Sweep::getEdgeTrackers(const ParabolaIterator& aParabola)
+{
+	std::vector<EdgeTracker*> Result;
+	for (auto it = (*aParabola).LeftEdges.begin(); it != (*aParabola).LeftEdges.end(); it++) Result.push_back(&(*it));
+	for (auto it = (*aParabola).RightEdges.begin(); it != (*aParabola).RightEdges.end(); it++)
+	{
+		if ((*it).LeftParabola != (*it).RightParabola) Result.push_back(&(*it));
+	}
+
+	std::sort(Result.begin(), Result.end(), [](const EdgeTracker* a, const EdgeTracker* b)->bool {return a->Sequence < b->Sequence; });
+	return Result;
+}
+
+/** Moves the left side of an edge tracker to another arc
+* @param aTracker The edge tracker
+* @param aParabola The location of the arc
+*/
+void VoronoiDiagram::Sweep::setLeftParabola(EdgeTracker& aTracker, const ParabolaIterator& aParabola)
+{
+	Arc& lArc = *ParabolaIterator(aParabola);
+	aTracker.LeftParabola = this->Arcs.getHandle(lArc);
+	lArc.LeftEdges.pushBack(aTracker);
+}
+
+/** Creates a polygon tracker (not yet in a list) whose lists share the pools of the sweep
+*/
+VoronoiDiagram::PolygonTracker* VoronoiDiagram::Sweep::createPolygonTracker()
+{
+	return this->PolygonTrackerPool.create(this->PolygonEdges, this->PolygonNodes);
+}
+
 /** Finish up creating the diagram by processing any circle events left
 */
-void VoronoiDiagram::PostProcessing(std::vector<Position>& aPolygonCenters, MyList<int>& aParabolaList, MyList<EdgeTracker>& aEdgeTracker, MyList<PolygonTracker>& aPolygonTrackerList, MyList<MapPolygon>& aPolygonList, Graph<Position, int>& aGraph)
+void VoronoiDiagram::PostProcessing(std::vector<Position>& aPolygonCenters, Sweep& aSweep, MyList<MapPolygon>& aPolygonList, Graph<Position, int>& aGraph)
 {
-	MyListIterator<int> lRemoveLocation;
+	ParabolaIterator lRemoveLocation;
 	struct Circle lCircle {};
 	bool CheckCircle = true;
 
 	while (CheckCircle)
 	{
 		lCircle = { -1.0, 0.0, 0.0 };
-		lRemoveLocation = aParabolaList.begin();
-		for (MyListIterator<int> il = aParabolaList.begin().next(); il != aParabolaList.end().prev(); il++)
+		lRemoveLocation = aSweep.Parabolas.begin();
+		for (ParabolaIterator il = aSweep.Parabolas.begin().next(); il != aSweep.Parabolas.end().prev(); il++)
 		{
-			if (*(il.prev()) != *(il.next()))
+			if ((*il.prev()).Center != (*il.next()).Center)
 			{
-				double lDeterminant = calculateDeterminant(aPolygonCenters[*(il.prev())], aPolygonCenters[(*il)], aPolygonCenters[*(il.next())]);
+				double lDeterminant = calculateDeterminant(aPolygonCenters[(*il.prev()).Center], aPolygonCenters[(*il).Center], aPolygonCenters[(*il.next()).Center]);
 				if (lDeterminant < 0.0)
 				{
 					// should calculate the intersections of the two parabolas, would need to increment the sweep line in this case
-					struct Circle lTempCircle = CreateCircle(aPolygonCenters[*(il.prev())], aPolygonCenters[*(il)], aPolygonCenters[*(il.next())]);
-					if (lRemoveLocation == aParabolaList.begin() || (lCircle.Radius > 0.0 && (lTempCircle.Center.Y - lTempCircle.Radius) > (lCircle.Center.Y- lCircle.Radius)))
+					struct Circle lTempCircle = CreateCircle(aPolygonCenters[(*il.prev()).Center], aPolygonCenters[(*il).Center], aPolygonCenters[(*il.next()).Center]);
+					if (lRemoveLocation == aSweep.Parabolas.begin() || (lCircle.Radius > 0.0 && (lTempCircle.Center.Y - lTempCircle.Radius) > (lCircle.Center.Y- lCircle.Radius)))
 					{
 						lCircle = lTempCircle;
 						lRemoveLocation = il;
@@ -69,13 +166,13 @@ void VoronoiDiagram::PostProcessing(std::vector<Position>& aPolygonCenters, MyLi
 			}
 		}
 
-		if (lRemoveLocation != aParabolaList.begin())
+		if (lRemoveLocation != aSweep.Parabolas.begin())
 		{
 			// add the new node to the graph
-			InsertNewNode(lRemoveLocation, lCircle.Center, aPolygonCenters, aParabolaList, aEdgeTracker, aPolygonTrackerList, aPolygonList, aGraph);
+			InsertNewNode(lRemoveLocation, lCircle.Center, aPolygonCenters, aSweep, aPolygonList, aGraph);
 
 			// reset the remove location
-			lRemoveLocation = aParabolaList.begin();
+			lRemoveLocation = aSweep.Parabolas.begin();
 		}
 		else
 		{
@@ -88,31 +185,31 @@ void VoronoiDiagram::PostProcessing(std::vector<Position>& aPolygonCenters, MyLi
 /** Process any circle events in the parabola list
 * @param aSweepLine The value of the sweep line
 */
-void VoronoiDiagram::ProcessCircleEvents(double aSweepLine, std::vector<Position>& aPolygonCenters, MyList<int>& aParabolaList, MyList<EdgeTracker>& aEdgeTracker, MyList<PolygonTracker>& aPolygonTrackerList, MyList<MapPolygon>& aPolygonList, Graph<Position, int>& aGraph)
+void VoronoiDiagram::ProcessCircleEvents(double aSweepLine, std::vector<Position>& aPolygonCenters, Sweep& aSweep, MyList<MapPolygon>& aPolygonList, Graph<Position, int>& aGraph)
 {
-	MyListIterator<int> lRemoveLocation;
+	ParabolaIterator lRemoveLocation;
 	struct Circle lCircle;
 	bool CheckCircle = true;
 
 	// Process any circle events
-	if (aParabolaList.size() > 2)
+	if (aSweep.Parabolas.size() > 2)
 	{
 		while (CheckCircle)
 		{
 			lCircle = { -1.0, 0.0, 0.0 };
-			lRemoveLocation = aParabolaList.begin();
-			for (MyListIterator<int> il = aParabolaList.begin().next(); il != aParabolaList.end().prev(); il++)
+			lRemoveLocation = aSweep.Parabolas.begin();
+			for (ParabolaIterator il = aSweep.Parabolas.begin().next(); il != aSweep.Parabolas.end().prev(); il++)
 			{
-				if (*(il.prev()) != *(il.next()))
+				if ((*il.prev()).Center != (*il.next()).Center)
 				{
-					double lDeterminant = calculateDeterminant(aPolygonCenters[*(il.prev())], aPolygonCenters[(*il)], aPolygonCenters[*(il.next())]);
+					double lDeterminant = calculateDeterminant(aPolygonCenters[(*il.prev()).Center], aPolygonCenters[(*il).Center], aPolygonCenters[(*il.next()).Center]);
 					if (lDeterminant < 0.0)
 					{
 						// should calculate the intersections of the two parabolas, would need to increment the sweep line in this case
-						struct Circle lTempCircle = CreateCircle(aPolygonCenters[*(il.prev())], aPolygonCenters[*(il)], aPolygonCenters[*(il.next())]);
+						struct Circle lTempCircle = CreateCircle(aPolygonCenters[(*il.prev()).Center], aPolygonCenters[(*il).Center], aPolygonCenters[(*il.next()).Center]);
 						if (Utilities::Abs(lTempCircle.Center.Y - aSweepLine) >= lTempCircle.Radius)
 						{
-							if (lRemoveLocation == aParabolaList.begin() || (lCircle.Radius > 0.0 && (lTempCircle.Center.Y - lTempCircle.Radius) > (lCircle.Center.Y - lCircle.Radius)))
+							if (lRemoveLocation == aSweep.Parabolas.begin() || (lCircle.Radius > 0.0 && (lTempCircle.Center.Y - lTempCircle.Radius) > (lCircle.Center.Y - lCircle.Radius)))
 							{
 								lCircle = lTempCircle;
 								lRemoveLocation = il;
@@ -122,13 +219,13 @@ void VoronoiDiagram::ProcessCircleEvents(double aSweepLine, std::vector<Position
 				}
 			}
 
-			if (lRemoveLocation != aParabolaList.begin())
+			if (lRemoveLocation != aSweep.Parabolas.begin())
 			{
 				// add the new node to the graph
-				InsertNewNode(lRemoveLocation, lCircle.Center, aPolygonCenters, aParabolaList, aEdgeTracker, aPolygonTrackerList, aPolygonList, aGraph);
+				InsertNewNode(lRemoveLocation, lCircle.Center, aPolygonCenters, aSweep, aPolygonList, aGraph);
 
 				// reset the remove location
-				lRemoveLocation = aParabolaList.begin();
+				lRemoveLocation = aSweep.Parabolas.begin();
 			}
 			else
 			{
@@ -143,110 +240,104 @@ void VoronoiDiagram::ProcessCircleEvents(double aSweepLine, std::vector<Position
 * @param aRemoveLocation The location in the parabola list of the parabla being removed
 * @param aNewNodePosition The position of the new node
 */
-void VoronoiDiagram::InsertNewNode(MyListIterator<int>& aRemoveLocation, const Position& aNewNodePosition, std::vector<Position>& aPolygonCenters, MyList<int>& aParabolaList, MyList<EdgeTracker>& aEdgeTracker, MyList<PolygonTracker>& aPolygonTrackerList, MyList<MapPolygon>& aPolygonList, Graph<Position, int>& aGraph)
+void VoronoiDiagram::InsertNewNode(ParabolaIterator& aRemoveLocation, const Position& aNewNodePosition, std::vector<Position>& aPolygonCenters, Sweep& aSweep, MyList<MapPolygon>& aPolygonList, Graph<Position, int>& aGraph)
 {
 	// add the new node to the graph
 	GraphNode<Position> lNewNode = GraphNode<Position>(0, aNewNodePosition);
 	int lNodeIndex = aGraph.addNode(lNewNode);
 
 	// calculate the edge trackers
-	MyList<EdgeTracker> NewEdges = CreateEdgeTrackers(aRemoveLocation, lNodeIndex, aNewNodePosition, aPolygonCenters, aEdgeTracker, aParabolaList);
+	EdgeTrackerList NewEdges;
+	CreateEdgeTrackers(aRemoveLocation, lNodeIndex, aNewNodePosition, aPolygonCenters, aSweep, NewEdges);
 
 	// complete any edges and polygons
-	CompleteEdges(aRemoveLocation, lNodeIndex, aGraph, aEdgeTracker, aPolygonTrackerList, aPolygonList, aParabolaList);
+	CompleteEdges(aRemoveLocation, lNodeIndex, aGraph, aSweep, aPolygonList);
 
-	for (auto it = NewEdges.begin(); it != NewEdges.end(); it++)
-	{
-		aEdgeTracker.pushBack(*it);
-	}
+	aSweep.addEdgeTrackers(NewEdges);
 }
 
-void VoronoiDiagram::CompleteEdges(MyListIterator<int>& aRemoveLocation, const int& aNewNodeIndex, Graph<Position, int>& aGraph,
-	MyList<EdgeTracker>& aEdgeTrackerList, MyList<PolygonTracker>& aPolygonTracker, MyList<MapPolygon>& aPolygonList, MyList<int>& aParabolaList)
+void VoronoiDiagram::CompleteEdges(ParabolaIterator& aRemoveLocation, const int& aNewNodeIndex, Graph<Position, int>& aGraph,
+	Sweep& aSweep, MyList<MapPolygon>& aPolygonList)
 {
 	{
 		bool loop = true;
 		bool VectorOrderCondition = false;
-		MyList<MyListIterator<PolygonTracker>> EditedPolygons;
+		MyList<PolygonTrackerList::Iterator> EditedPolygons;
 		bool PolygonFound = false;
-		MyListIterator<EdgeTracker> ik = aEdgeTrackerList.begin();
 
-		while (ik != aEdgeTrackerList.end())
+		// only the edge trackers of the removed parabola are part of an edge, so look them up from the parabola
+		std::vector<EdgeTracker*> lRemovedEdges = aSweep.getEdgeTrackers(aRemoveLocation);
+		for (std::size_t lCount = 0; lCount < lRemovedEdges.size(); lCount++)
 		{
-			// if the removed parabola is part of an edge then create the edge in the graph and link the nodes
-			if (((*ik).LeftParabola == aRemoveLocation || (*ik).RightParabola == aRemoveLocation))
-			{
-				aGraph.addEdge((*ik).NodeIndex, aNewNodeIndex, 0);
-				aGraph.addEdge(aNewNodeIndex, (*ik).NodeIndex, 0);
+			EdgeTrackerList::Iterator ik = EdgeTrackerList::iteratorTo(*lRemovedEdges[lCount]);
+
+			// the removed parabola is part of the edge so create the edge in the graph and link the nodes
+			aGraph.addEdge((*ik).NodeIndex, aNewNodeIndex, 0);
+			aGraph.addEdge(aNewNodeIndex, (*ik).NodeIndex, 0);
 
-				// Search the all of hte Polygon Trackers to see if the new edge is connected to any of the previous polygons
-				// It can be at most connected to two edges.
-				for (auto ip = aPolygonTracker.begin(); ip != aPolygonTracker.end(); ip++)
+			// Search the all of hte Polygon Trackers to see if the new edge is connected to any of the previous polygons
+			// It can be at most connected to two edges.
+			for (auto ip = aSweep.PolygonTrackers.begin(); ip != aSweep.PolygonTrackers.end(); ip++)
+			{
+				for (auto in = (*ip).Nodes.begin(); in != (*ip).Nodes.end(); in++)
 				{
-					for (auto in = (*ip).Nodes.begin(); in != (*ip).Nodes.end(); in++)
+					Edge temp = {};
+					if ((*in) == (*ik).NodeIndex)
 					{
-						Edge temp = {};
-						if ((*in) == (*ik).NodeIndex)
+						bool CorrectPolygon = true;
+						for (auto ie = (*ip).Edges.begin(); ie != (*ip).Edges.end(); ie++)
 						{
-							bool CorrectPolygon = true;
-							for (auto ie = (*ip).Edges.begin(); ie != (*ip).Edges.end(); ie++)
-							{
-								Position A = aGraph.getNode((*ie).Node1).getData();
-								Position B = aGraph.getNode((*ie).Node2).getData();
-								Position C = aGraph.getNode(aNewNodeIndex).getData();
-								if ((*ik).NodeIndex == (*ie).Node1 || (*ik).NodeIndex == (*ie).Node2) temp = (*ie);
+							Position A = aGraph.getNode((*ie).Node1).getData();
+							Position B = aGraph.getNode((*ie).Node2).getData();
+							Position C = aGraph.getNode(aNewNodeIndex).getData();
+							if ((*ik).NodeIndex == (*ie).Node1 || (*ik).NodeIndex == (*ie).Node2) temp = (*ie);
 
-								if (calculateDeterminant(A, B, C) < 0)
-								{
-									CorrectPolygon = false;
-									break;
-								}
+							if (calculateDeterminant(A, B, C) < 0)
+							{
+								CorrectPolygon = false;
+								break;
 							}
+						}
 
-							if (CorrectPolygon)
+						if (CorrectPolygon)
+						{
+							bool Alreadycontaintnode = false;
+							for (auto ie = (*ip).Nodes.begin(); ie != (*ip).Nodes.end(); ie++)
 							{
-								bool Alreadycontaintnode = false;
-								for (auto ie = (*ip).Nodes.begin(); ie != (*ip).Nodes.end(); ie++)
+								if (*(ie) == aNewNodeIndex)
 								{
-									if (*(ie) == aNewNodeIndex)
-									{
-										Alreadycontaintnode = true;
-										break;
-									}
+									Alreadycontaintnode = true;
+									break;
 								}
+							}
 
-								if (!Alreadycontaintnode)(*ip).Nodes.pushBack(aNewNodeIndex);
+							if (!Alreadycontaintnode)(*ip).Nodes.pushBack(aNewNodeIndex);
 
-								if (!PolygonFound) EditedPolygons.pushBack(ip);
-								PolygonFound = true;
+							if (!PolygonFound) EditedPolygons.pushBack(ip);
+							PolygonFound = true;
 
-								if (temp.Node1 == (*ik).NodeIndex)
-								{
-									(*ip).Edges.pushBack({ aNewNodeIndex, (*ik).NodeIndex });
-									VectorOrderCondition = true;
-								}
-								else
-								{
-									(*ip).Edges.pushBack({ (*ik).NodeIndex, aNewNodeIndex });
-									VectorOrderCondition = false;
-								}
-								break;
+							if (temp.Node1 == (*ik).NodeIndex)
+							{
+								(*ip).Edges.pushBack({ aNewNodeIndex, (*ik).NodeIndex });
+								VectorOrderCondition = true;
+							}
+							else
+							{
+								(*ip).Edges.pushBack({ (*ik).NodeIndex, aNewNodeIndex });
+								VectorOrderCondition = false;
 							}
+							break;
 						}
 					}
 				}
-
-				// remove the edge after it has been created
-				ik = aEdgeTrackerList.erase(ik);
-			}
-			else
-			{
-				ik++;
 			}
+
+			// remove the edge after it has been created
+			aSweep.EdgeTrackers.eraseAndDispose(ik, [&aSweep](EdgeTracker* aTracker) { aSweep.EdgeTrackerPool.destroy(aTracker); });
 		}
 	}
 
-	aRemoveLocation = aParabolaList.erase(aRemoveLocation).prev();
+	aRemoveLocation = aSweep.eraseParabola(aRemoveLocation).prev();
 
 	MyList<EdgeData<int>> EdgesCreated = aGraph.getAllEdges(aNewNodeIndex);
 	for (auto ik = EdgesCreated.begin(); ik != EdgesCreated.end(); ik++)
@@ -254,7 +345,7 @@ void VoronoiDiagram::CompleteEdges(MyListIterator<int>& aRemoveLocation, const i
 		bool CreatePolygon1 = true;
 		bool CreatePolygon2 = true;
 		bool PolygonFound = false;
-		for (auto ip = aPolygonTracker.begin(); ip != aPolygonTracker.end(); ip++)
+		for (auto ip = aSweep.PolygonTrackers.begin(); ip != aSweep.PolygonTrackers.end(); ip++)
 		{
 			for (auto ie = (*ip).Edges.begin(); ie != (*ip).Edges.end(); ie++)
 			{
@@ -270,35 +361,35 @@ void VoronoiDiagram::CompleteEdges(MyListIterator<int>& aRemoveLocation, const i
 		}
 		if (CreatePolygon1)
 		{
-			PolygonTracker NewPolygon;
-			NewPolygon.Nodes.pushBack((*ik).StartNode);
-			NewPolygon.Nodes.pushBack((*ik).EndNode);
-			NewPolygon.Edges.pushBack({ (*ik).StartNode  , (*ik).EndNode });
-			aPolygonTracker.pushBack(NewPolygon);
+			PolygonTracker* NewPolygon = aSweep.createPolygonTracker();
+			NewPolygon->Nodes.pushBack((*ik).StartNode);
+			NewPolygon->Nodes.pushBack((*ik).EndNode);
+			NewPolygon->Edges.pushBack({ (*ik).StartNode  , (*ik).EndNode });
+			aSweep.PolygonTrackers.pushBack(*NewPolygon);
 		}
 		if (CreatePolygon2)
 		{
-			PolygonTracker NewPolygon;
-			NewPolygon.Nodes.pushBack((*ik).StartNode);
-			NewPolygon.Nodes.pushBack((*ik).EndNode);
-			NewPolygon.Edges.pushBack({ (*ik).EndNode, (*ik).StartNode });
-			aPolygonTracker.pushBack(NewPolygon);
+			PolygonTracker* NewPolygon = aSweep.createPolygonTracker();
+			NewPolygon->Nodes.pushBack((*ik).StartNode);
+			NewPolygon->Nodes.pushBack((*ik).EndNode);
+			NewPolygon->Edges.pushBack({ (*ik).EndNode, (*ik).StartNode });
+			aSweep.PolygonTrackers.pushBack(*NewPolygon);
 		}
 	}
 
 	// Check to see if any of the polygons are complete
-	auto it = aPolygonTracker.begin();
-	while (it != aPolygonTracker.end())
+	auto it = aSweep.PolygonTrackers.begin();
+	while (it != aSweep.PolygonTrackers.end())
 	{
 		if ((*it).Nodes.size() == (*it).Edges.size())
 		{
 			// add the new polygon to the polygon list
 			MapPolygon NewPolygon = {};
-			NewPolygon.Nodes = (*it).Nodes;
-			NewPolygon.Edges = (*it).Edges;
+			NewPolygon.Nodes.append((*it).Nodes.begin(), (*it).Nodes.end());
+			NewPolygon.Edges.append((*it).Edges.begin(), (*it).Edges.end());
 
 			aPolygonList.pushBack(NewPolygon);
-			it = aPolygonTracker.erase(it);
+			it = aSweep.PolygonTrackers.eraseAndDispose(it, [&aSweep](PolygonTracker* aTracker) { aSweep.PolygonTrackerPool.destroy(aTracker); });
 		}
 		else
 		{
@@ -307,105 +398,95 @@ void VoronoiDiagram::CompleteEdges(MyListIterator<int>& aRemoveLocation, const i
 	}
 }
 
-MyList<VoronoiDiagram::EdgeTracker> VoronoiDiagram::CreateEdgeTrackers(const MyListIterator<int>& aRemoveLocation, const int& aNewNodeIndex, const Position& aNewNodePosition, const std::vector<Position>& aPolygonCenters, const MyList<EdgeTracker>& aEdgeTrackerList, MyList<int>& aParabolaList)
+void VoronoiDiagram::CreateEdgeTrackers(const ParabolaIterator& aRemoveLocation, const int& aNewNodeIndex, const Position& aNewNodePosition, const std::vector<Position>& aPolygonCenters, Sweep& aSweep, EdgeTrackerList& aNewEdges)
 {
-	MyList<EdgeTracker> Result;
-	EdgeTracker Edge1, Edge2, Edge3;
+	ParabolaIterator Edge2, Edge3;
 	int Edge2Left, Edge2Right;
 	int Edge3Left, Edge3Right;
 	bool Edge2Valid = false, Edge3Valid = false;
 
-	Edge1.LeftParabola = aRemoveLocation.prev();
-	Edge1.RightParabola = aRemoveLocation.next();
-	Edge1.NodeIndex = aNewNodeIndex;
-	Result.pushBack(Edge1);
+	aNewEdges.pushBack(*aSweep.createEdgeTracker(aRemoveLocation.prev(), aRemoveLocation.next(), aNewNodeIndex));
 
-	if (aPolygonCenters[*aRemoveLocation.prev()].Y < aPolygonCenters[*aRemoveLocation.next()].Y)
+	if (aPolygonCenters[(*aRemoveLocation.prev()).Center].Y < aPolygonCenters[(*aRemoveLocation.next()).Center].Y)
 	{
-		if (aPolygonCenters[*aRemoveLocation].X < aNewNodePosition.X)
+		if (aPolygonCenters[(*aRemoveLocation).Center].X < aNewNodePosition.X)
 		{
-			Edge2Left = *aRemoveLocation;
-			Edge2Right = *aRemoveLocation.prev();
+			Edge2Left = (*aRemoveLocation).Center;
+			Edge2Right = (*aRemoveLocation.prev()).Center;
 
-			Edge3Left = *aRemoveLocation.next();
-			Edge3Right = *aRemoveLocation;
+			Edge3Left = (*aRemoveLocation.next()).Center;
+			Edge3Right = (*aRemoveLocation).Center;
 		}
 		else
 		{
-			Edge2Left = *aRemoveLocation;
-			Edge2Right = *aRemoveLocation.prev();
+			Edge2Left = (*aRemoveLocation).Center;
+			Edge2Right = (*aRemoveLocation.prev()).Center;
 
-			Edge3Left = *aRemoveLocation.next();
-			Edge3Right = *aRemoveLocation;
+			Edge3Left = (*aRemoveLocation.next()).Center;
+			Edge3Right = (*aRemoveLocation).Center;
 		}
 	}
 	else
 	{
-		if (aPolygonCenters[*aRemoveLocation].X < aNewNodePosition.X)
+		if (aPolygonCenters[(*aRemoveLocation).Center].X < aNewNodePosition.X)
 		{
-			Edge2Left = *aRemoveLocation;
-			Edge2Right = *aRemoveLocation.prev();
+			Edge2Left = (*aRemoveLocation).Center;
+			Edge2Right = (*aRemoveLocation.prev()).Center;
 
-			Edge3Left = *aRemoveLocation.next();
-			Edge3Right = *aRemoveLocation;
+			Edge3Left = (*aRemoveLocation.next()).Center;
+			Edge3Right = (*aRemoveLocation).Center;
 		}
 		else
 		{
-			Edge2Left = *aRemoveLocation.next();
-			Edge2Right = *aRemoveLocation;
+			Edge2Left = (*aRemoveLocation.next()).Center;
+			Edge2Right = (*aRemoveLocation).Center;
 
-			Edge3Left = *aRemoveLocation;
-			Edge3Right = *aRemoveLocation.prev();
+			Edge3Left = (*aRemoveLocation).Center;
+			Edge3Right = (*aRemoveLocation.prev()).Center;
 		}
 	}
 
-	for (auto it = aParabolaList.begin(); it != aParabolaList.end().prev(); it++)
+	for (auto it = aSweep.Parabolas.begin(); it != aSweep.Parabolas.end().prev(); it++)
 	{
-		if ((*it) == Edge2Left && (*it.next() == Edge2Right))
+		if ((*it).Center == Edge2Left && ((*it.next()).Center == Edge2Right))
 		{
 			Edge2Valid = true;
-			Edge2.LeftParabola = it;
-			Edge2.RightParabola = it.next();
-			Edge2.NodeIndex = aNewNodeIndex;
+			Edge2 = it;
 		}
-		if ((*it) == Edge3Left && (*it.next() == Edge3Right))
+		if ((*it).Center == Edge3Left && ((*it.next()).Center == Edge3Right))
 		{
 			Edge3Valid = true;
-			Edge3.LeftParabola = it;
-			Edge3.RightParabola = it.next();
-			Edge3.NodeIndex = aNewNodeIndex;
+			Edge3 = it;
 		}
 	}
-	if (Edge2Valid) Result.pushBack(Edge2);
-	if (Edge3Valid) Result.pushBack(Edge3);
-
-	return Result;
+	if (Edge2Valid) aNewEdges.pushBack(*aSweep.createEdgeTracker(Edge2, Edge2.next(), aNewNodeIndex));
+	if (Edge3Valid) aNewEdges.pushBack(*aSweep.createEdgeTracker(Edge3, Edge3.next(), aNewNodeIndex));
 }
 
 /** Perform the processing needed to add a new parabola to the list
 * @param aCurrent The location in the polygon center list of the new parabola focus
 * @param aSweepLine The value of the sweep line
 */
-void VoronoiDiagram::ProcessSiteEvents(int& aCurrent, double aSweepLine, std::vector<Position>& aPolygonCenters, MyList<int>& aParabolaList, MyList<EdgeTracker>& aEdgeTracker)
+void VoronoiDiagram::ProcessSiteEvents(int& aCurrent, double aSweepLine, std::vector<Position>& aPolygonCenters, Sweep& aSweep)
 {
-	MyListIterator<int> it;
+	ParabolaIterator it;
 	Position lOldIntersection = {};
 	bool lInserted = false;
 
 	// Process the point event
-	for (MyListIterator<int> ik = aParabolaList.begin().next(); ik != aParabolaList.end(); ik++)
+	for (ParabolaIterator ik = aSweep.Parabolas.begin().next(); ik != aSweep.Parabolas.end(); ik++)
 	{
 		Position lIntersection1, lIntersection2;
-		int lNumberOfIntersections = getIntersections(aPolygonCenters[*(ik.prev())], aPolygonCenters[*(ik)], aSweepLine, lIntersection1, lIntersection2);
+		int lNumberOfIntersections = getIntersections(aPolygonCenters[(*ik.prev()).Center], aPolygonCenters[(*ik).Center], aSweepLine, lIntersection1, lIntersection2);
 
 		if (lNumberOfIntersections == 0) throw 1; // same x, different y
 		if (lNumberOfIntersections == 1) // same y, different x
 		{
 			if (aPolygonCenters[aCurrent].X < lIntersection1.X)
 			{
-				it = aParabolaList.insert(ik, aCurrent);
-				aParabolaList.insert(ik, *(it.next()));
-				ProcessEdgesForParabolaInsertion(it, aEdgeTracker);
+				it = aSweep.insertParabola(ik, aCurrent);
+				aSweep.insertParabola(ik, (*it.next()).Center);
+				ProcessEdgesForParabolaInsertion(it, aSweep);
 				aCurrent++;
 				lInserted = true;
 				break;
@@ -414,14 +495,15 @@ void VoronoiDiagram::ProcessSiteEvents(int& aCurrent, double aSweepLine, std::ve
 		}
 		if (lNumberOfIntersections == 2)
 		{
-			it = aParabolaList.find(aParabolaList.begin(), ik, *ik);
-			if (ik != aParabolaList.begin().next() && (it != ik || lOldIntersection.X > lIntersection1.X))
+			it = aSweep.Parabolas.begin();
+			while (it != ik && (*it).Center != (*ik).Center) it++;
+			if (ik != aSweep.Parabolas.begin().next() && (it != ik || lOldIntersection.X > lIntersection1.X))
 			{
 				if (aPolygonCenters[aCurrent].X < lIntersection2.X)
 				{
-					it = aParabolaList.insert(ik, aCurrent);
-					aParabolaList.insert(ik, *(it.prev()));
-					ProcessEdgesForParabolaInsertion(it, aEdgeTracker);
+					it = aSweep.insertParabola(ik, aCurrent);
+					aSweep.insertParabola(ik, (*it.prev()).Center);
+					ProcessEdgesForParabolaInsertion(it, aSweep);
 					aCurrent++;
 					lInserted = true;
 					break;
@@ -432,9 +514,9 @@ void VoronoiDiagram::ProcessSiteEvents(int& aCurrent, double aSweepLine, std::ve
 			{
 				if (aPolygonCenters[aCurrent].X < lIntersection1.X)
 				{
-					it = aParabolaList.insert(ik, aCurrent);
-					aParabolaList.insert(ik, *(it.prev()));
-					ProcessEdgesForParabolaInsertion(it, aEdgeTracker);
+					it = aSweep.insertParabola(ik, aCurrent);
+					aSweep.insertParabola(ik, (*it.prev()).Center);
+					ProcessEdgesForParabolaInsertion(it, aSweep);
 					aCurrent++;
 					lInserted = true;
 					break;
@@ -446,10 +528,10 @@ void VoronoiDiagram::ProcessSiteEvents(int& aCurrent, double aSweepLine, std::ve
 	if (!lInserted)
 	{
 		// insert it on top of the last parabola
-		it = aParabolaList.end();
-		it = aParabolaList.insert(aParabolaList.end(), aCurrent);
-		aParabolaList.insert(aParabolaList.end(), *it.prev());
-		ProcessEdgesForParabolaInsertion(it, aEdgeTracker);
+		it = aSweep.Parabolas.end();
+		it = aSweep.insertParabola(aSweep.Parabolas.end(), aCurrent);
+		aSweep.insertParabola(aSweep.Parabolas.end(), (*it.prev()).Center);
+		ProcessEdgesForParabolaInsertion(it, aSweep);
 		aCurrent++;
 	}
 }
@@ -457,18 +539,19 @@ void VoronoiDiagram::ProcessSiteEvents(int& aCurrent, double aSweepLine, std::ve
 /** Perform any processing on the current edges for a new parabola in the list
 * @parama InsertLocation The location in the parabola list of the new parabola
 */
-void VoronoiDiagram::ProcessEdgesForParabolaInsertion(const MyListIterator<int>& aInsertLocation, MyList<EdgeTracker>& aEdgeTracker)
+void VoronoiDiagram::ProcessEdgesForParabolaInsertion(const ParabolaIterator& aInsertLocation, Sweep& aSweep)
 {
 	// If the left parabola of any edge is equal to the left of the new insertion then
 	// set the letf parabola of the edge to the parabola to the edge after the insertion
-	for (MyListIterator<EdgeTracker> ik = aEdgeTracker.begin(); ik != aEdgeTracker.end(); ik++)
+	// (the first such edge in the list of edge trackers, found from the parabola)
+	LeftEdgeList& lLeftEdges = (*aInsertLocation.prev()).LeftEdges;
+	EdgeTracker* lFirst = nullptr;
+	for (auto ik = lLeftEdges.begin(); ik != lLeftEdges.end(); ik++)
 	{
-		if ((*ik).LeftParabola == aInsertLocation.prev())
-		{
-			(*ik).LeftParabola = aInsertLocation.next();
-			break;
-		}
+		if (lFirst == nullptr || (*ik).Sequence < lFirst->Sequence) lFirst = &(*ik);
 	}
+
+	if (lFirst != nullptr) aSweep.setLeftParabola(*lFirst, aInsertLocation.next());
 }
 
 /** Calculate the determinant between two vectors. (Vector one = AB, Vector two = BC)
@@ -24,7 +24,7 @@ GuassianMixtureModel::GuassianMixtureModel()
 * @param aGMMStates The number of states for the output.
 * @param aData The input data that will be sorted into discrete states.
 */
-GuassianMixtureModel::GuassianMixtureModel(const unsigned& aGMMStates, const std::vector<double> aData)
+GuassianMixtureModel::GuassianMixtureModel(const unsigned& aGMMStates, const std::vector<double>& aData)
 {
 	this->m_GMMStates = aGMMStates;
 	this->m_DataLength = aData.size();
@@ -49,7 +49,7 @@ GuassianMixtureModel::GuassianMixtureModel(const unsigned& aGMMStates, const std
 * @param aMax Will be returned with the maximum value of the data.
 * @param aMin Will be returned with the minimum value of the data.
 */
-std::vector<double> GuassianMixtureModel::scaleData(const std::vector<double> aData, double* aMax, double* aMin)
+std::vector<double> GuassianMixtureModel::scaleData(const std::vector<double>& aData, double* aMax, double* aMin)
 {
 	std::vector<double> lResult = std::vector<double>(aData.size());
 
@@ -67,19 +67,15 @@ std::vector<double> GuassianMixtureModel::scaleData(const std::vector<double> aD
 * @param aMax Will be returned with the maximum value of the data.
 * @param aMin Will be returned with the minimum value of the data.
 */
-void GuassianMixtureModel::calculateMaxAndMin(const std::vector<double> aData, double* aMax, double* aMin)
+void GuassianMixtureModel::calculateMaxAndMin(const std::vector<double>& aData, double* aMax, double* aMin)
 {
 	*aMax = -DBL_MAX;
 	*aMin = DBL_MAX;
 
-	double lTemp;
+	if (aData.empty()) return;
 
-	for (unsigned lCount = 0; lCount < aData.size(); lCount++)
-	{
-		lTemp = aData[lCount];
-		if (lTemp > *aMax) *aMax = lTemp;
-		if (lTemp < *aMin) *aMin = lTemp;
-	}
+	*aMax = LinearAlgebra::Max(aData.data(), aData.size());
+	*aMin = LinearAlgebra::Min(aData.data(), aData.size());
 }
 
 /** Calculates the increment parameter for GuassianMixtureModel
@@ -108,13 +104,16 @@ double GuassianMixtureModel::calculateTau(const double& aIncrement)
 * @param aIncrement The increment parameter of GuassianMixtureModel.
 * @param aTau The tau parameter of GuassianMixtureModel.
 */
-MultidimensionalArray<double> GuassianMixtureModel::calculateDiscreteStates(const std::vector<double> aData, const double& aMin, const unsigned& aGMMStates, const double& aIncrement, const double& aTau)
+SparseMatrix<double> GuassianMixtureModel::calculateDiscreteStates(const std::vector<double>& aData, const double& aMin, const unsigned& aGMMStates, const double& aIncrement, const double& aTau)
 {
 	double lLocation;
 	double temp;
-	MultidimensionalArray<double> lResult(2, { aData.size(), aGMMStates });
 	double lMax;
 
+	// every row has exactly one element so row i starts at i
+	std::vector<std::size_t> lRowStarts(aData.size() + 1);
+	std::vector<std::size_t> lSelectedStates(aData.size());
+
 	unsigned lSelectedState = 0;
 	for (unsigned lCount1 = 0; lCount1 < aData.size(); lCount1++)
 	{
@@ -135,10 +134,11 @@ MultidimensionalArray<double> GuassianMixtureModel::calculateDiscreteStates(cons
 		}
 
 		// set the selected state of the observation to 1.0
-		lResult.setElement({ lCount1, lSelectedState }, 1.0);
+		lRowStarts[lCount1 + 1] = lCount1 + 1;
+		lSelectedStates[lCount1] = lSelectedState;
 	}
 
-	return lResult;
+	return SparseMatrix<double>(aData.size(), aGMMStates, lRowStarts, lSelectedStates, std::vector<double>(aData.size(), 1.0));
 }
 
 /** undoes the guassian mixture model and returns the an array of data
@@ -147,24 +147,22 @@ MultidimensionalArray<double> GuassianMixtureModel::calculateDiscreteStates(cons
 * @param aMax The min parameter.
 * @param aGMMStates The number of discrete states.
 */
-std::vector<double> GuassianMixtureModel::inverseGuassianMixtureModel(const MultidimensionalArray<double>& aDiscreteStates, const double& aMax, const double& aMin, const unsigned& aGMMStates)
+std::vector<double> GuassianMixtureModel::inverseGuassianMixtureModel(const SparseMatrix<double>& aDiscreteStates, const double& aMax, const double& aMin, const unsigned& aGMMStates)
 {
 	unsigned lDataLength = aDiscreteStates.getNumberOfElementsOfDimension(0);
 	double lIncrement = GuassianMixtureModel::calculateIncrement(aMax, aMin, aGMMStates);
 
-	std::vector<double> lResult(lDataLength);
-
-	for (unsigned lCount1 = 0; lCount1 < lDataLength; lCount1++)
+	// the value at the center of each discrete state
+	std::vector<double> lLocations(aGMMStates);
+	for (unsigned lCount2 = 0; lCount2 < aGMMStates; lCount2++)
 	{
-		lResult[lCount1] = 0.0;
-
-		// combine the discrete states by calculating the expectation value for each row
-		for (unsigned lCount2 = 0; lCount2 < aGMMStates; lCount2++)
-		{
-			lResult[lCount1] = lResult[lCount1] + (aMin + lIncrement * lCount2)*aDiscreteStates.getElement({ lCount1, lCount2 });
-		}
+		lLocations[lCount2] = aMin + lIncrement * lCount2;
 	}
 
+	// combine the discrete states by calculating the expectation value for each row
+	std::vector<double> lResult(lDataLength);
+	aDiscreteStates.multiplyVector(lLocations.data(), lResult.data());
+
 	return lResult;
 }
 
@@ -178,6 +176,13 @@ std::vector<double> GuassianMixtureModel::inverseGuassianMixtureModel() const
 /** Returns the discrete states
 */
 MultidimensionalArray<double> GuassianMixtureModel::getStates() const
+{
+	return this->m_States.toMultidimensionalArray();
+}
+
+/** Returns the discrete states without copying them into a dense array
+*/
+const SparseMatrix<double>& GuassianMixtureModel::getSparseStates() const
 {
 	return this->m_States;
 }
\ No newline at end of file
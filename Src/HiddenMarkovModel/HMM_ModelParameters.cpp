@@ -19,6 +19,20 @@ HMMModelParameters::HMMModelParameters()
 	m_EmissionMatrix = MultidimensionalArray<double>();
 }
 
+/** Throws if the transition matrix is not N x N or the emission matrix does not have N rows, where N is the number of
+*   hidden states (the length of the initial distribution)
+* @param aInitialDistribution The initial distribution
+* @param aTransitionMatrix The transition matrix
+* @param aEmissionMatrix The emission matrix
+*/
+void HMMModelParameters::validateDimensions(const std::vector<double>& aInitialDistribution, const MultidimensionalArray<double>& aTransitionMatrix, const MultidimensionalArray<double>& aEmissionMatrix)
+{
+	std::size_t lNumberOfHiddenStates = aInitialDistribution.size();
+
+	if (aTransitionMatrix.getNumberOfElementsOfDimension(0) != lNumberOfHiddenStates || aTransitionMatrix.getNumberOfElementsOfDimension(1) != lNumberOfHiddenStates) throw 69;
+	if (aEmissionMatrix.getNumberOfElementsOfDimension(0) != lNumberOfHiddenStates) throw 69;
+}
+
 /** Constructor for HMMModelParameters
 * @param aNumberOfHiddenStates The number of hidden states
 * @param aNumberOfEmissionStates The number of emission states
@@ -28,20 +42,31 @@ HMMModelParameters::HMMModelParameters()
 */
 HMMModelParameters::HMMModelParameters(const std::vector<double>& aInitialDistribution, const MultidimensionalArray<double>& aTransitionMatrix, const MultidimensionalArray<double>& aEmissionMatrix)
 {
-	std::size_t lNumberOfHiddenStates = aInitialDistribution.size();
-	std::size_t lNumberOfEmissionStates = aEmissionMatrix.getNumberOfElementsOfDimension(1);
+	validateDimensions(aInitialDistribution, aTransitionMatrix, aEmissionMatrix);
 
-	// check the input values
-	if (aTransitionMatrix.getNumberOfElementsOfDimension(0) != lNumberOfHiddenStates && aTransitionMatrix.getNumberOfElementsOfDimension(1) != lNumberOfHiddenStates) throw 69;
-	if (aEmissionMatrix.getNumberOfElementsOfDimension(0) != lNumberOfHiddenStates && aEmissionMatrix.getNumberOfElementsOfDimension(1) != lNumberOfEmissionStates) throw 69;
-
-	m_NumberOfHiddenStates = lNumberOfHiddenStates;
-	m_NumberOfEmissionStates = lNumberOfEmissionStates;
+	m_NumberOfHiddenStates = aInitialDistribution.size();
+	m_NumberOfEmissionStates = aEmissionMatrix.getNumberOfElementsOfDimension(1);
 	m_InitialDistribution = aInitialDistribution;
 	m_TransitionMatrix = aTransitionMatrix;
 	m_EmissionMatrix = aEmissionMatrix;
 }
 
+/** Constructor for HMMModelParameters that takes ownership of the parameters instead of copying them
+* @param aInitialDistribution The initial distribution
+* @param aTransitionMatrix The transition matrix
+* @param aEmissionMatrix The emission matrix
+*/
+HMMModelParameters::HMMModelParameters(std::vector<double>&& aInitialDistribution, MultidimensionalArray<double>&& aTransitionMatrix, MultidimensionalArray<double>&& aEmissionMatrix)
+{
+	validateDimensions(aInitialDistribution, aTransitionMatrix, aEmissionMatrix);
+
+	m_NumberOfHiddenStates = aInitialDistribution.size();
+	m_NumberOfEmissionStates = aEmissionMatrix.getNumberOfElementsOfDimension(1);
+	m_InitialDistribution = std::move(aInitialDistribution);
+	m_TransitionMatrix = std::move(aTransitionMatrix);
+	m_EmissionMatrix = std::move(aEmissionMatrix);
+}
+
 /** Returns the number of hidden states
 */
 unsigned HMMModelParameters::getNumberOfHiddenStates() const
@@ -59,21 +84,21 @@ unsigned HMMModelParameters::getNumberOfEmissionStates() const
 
 /** Returns the emission Matrix
 */
-MultidimensionalArray<double> HMMModelParameters::getEmissionMatrix() const
+const MultidimensionalArray<double>& HMMModelParameters::getEmissionMatrix() const
 {
 	return m_EmissionMatrix;
 }
 
 /** Returns the Transition Matrix
 */
-MultidimensionalArray<double> HMMModelParameters::getTransitionMatrix() const
+const MultidimensionalArray<double>& HMMModelParameters::getTransitionMatrix() const
 {
 	return m_TransitionMatrix;
 }
 
 /** Returns the Initial Distribution
 */
-std::vector<double> HMMModelParameters::getInitialDistribution() const
+const std::vector<double>& HMMModelParameters::getInitialDistribution() const
 {
 	return m_InitialDistribution;
 }
@@ -86,6 +111,14 @@ void HMMModelParameters::setTransitionMatrix(const MultidimensionalArray<double>
 	m_TransitionMatrix = aTransitionMatrix;
 }
 
+/** sets the transition matrix without copying it
+* @param aTransitionMatrix The new transition matrix
+*/
+void HMMModelParameters::setTransitionMatrix(MultidimensionalArray<double>&& aTransitionMatrix)
+{
+	m_TransitionMatrix = std::move(aTransitionMatrix);
+}
+
 /** sets the emission matrix
 * @param aEmissionMatrix The new emission matrix
 */
@@ -94,6 +127,14 @@ void HMMModelParameters::setEmissionMatrix(const MultidimensionalArray<double>&
 	m_EmissionMatrix = aEmissionMatrix;
 }
 
+/** sets the emission matrix without copying it
+* @param aEmissionMatrix The new emission matrix
+*/
+void HMMModelParameters::setEmissionMatrix(MultidimensionalArray<double>&& aEmissionMatrix)
+{
+	m_EmissionMatrix = std::move(aEmissionMatrix);
+}
+
 /** sets the initial distribution matrix
 * @param aInitialDistribution The new initial distribution matrix
 */
@@ -102,6 +143,14 @@ void HMMModelParameters::setInitialDistributionMatrix(const std::vector<double>&
 	m_InitialDistribution = aInitialDistribution;
 }
 
+/** sets the initial distribution matrix without copying it
+* @param aInitialDistribution The new initial distribution matrix
+*/
+void HMMModelParameters::setInitialDistributionMatrix(std::vector<double>&& aInitialDistribution)
+{
+	m_InitialDistribution = std::move(aInitialDistribution);
+}
+
 /** Checks all the parameters of the HMM to make sure they make sense
 * @return The success of the check (True = all model parameters are good)
 */
@@ -118,11 +167,7 @@ bool HMMModelParameters::checkParameters() const
 bool HMMModelParameters::checkInitialDistribution() const
 {
 	bool lResult;
-	double lSum = 0.0;
-	for (unsigned lCountN = 0; lCountN < this->m_InitialDistribution.size(); lCountN++)
-	{
-		lSum += this->m_InitialDistribution[lCountN];
-	}
+	const double lSum = LinearAlgebra::Sum(this->m_InitialDistribution.data(), this->m_InitialDistribution.size());
 
 	lResult = (lSum > 0.9999 && lSum < 1.0001);
 	if (!lResult) DebugLogger::getInstance().logMessage(DebugLogger::MessageLoggerType::Error, __FUNCTION__, "Initial Distribution does not make sense");
@@ -135,16 +180,15 @@ bool HMMModelParameters::checkInitialDistribution() const
 */
 bool HMMModelParameters::checkEmissionMatrix() const
 {
-	double lSum = 0.0;
 	bool lResult = true;
-	for (unsigned lCountN = 0; lCountN < this->m_EmissionMatrix.getNumberOfElementsOfDimension(0); lCountN++)
+	if (this->m_EmissionMatrix.getTotalNumberOfElements() > 0)
 	{
-		lSum = 0.0;
-		for (unsigned lCountM = 0; lCountM < this->m_EmissionMatrix.getNumberOfElementsOfDimension(1); lCountM++)
+		const MultidimensionalArray<double> lSums = this->m_EmissionMatrix.sum(1);
+		for (unsigned lCountN = 0; lCountN < lSums.getTotalNumberOfElements(); lCountN++)
 		{
-			lSum += this->m_EmissionMatrix.getElement({ lCountN, lCountM });
+			const double lSum = lSums.data()[lCountN];
+			lResult = lResult && ((lSum > .9999 && lSum < 1.0001) || (lSum == 0.0));
 		}
-		lResult = lResult && ((lSum > .9999 && lSum < 1.0001) || (lSum == 0.0));
 	}
 
 	if (!lResult) DebugLogger::getInstance().logMessage(DebugLogger::MessageLoggerType::Error, __FUNCTION__, "Emission Matrix does not make sense");
@@ -157,17 +201,15 @@ bool HMMModelParameters::checkEmissionMatrix() const
 */
 bool HMMModelParameters::checkTransitionMatrix() const
 {
-	double lSum = 0.0;
 	bool lResult = true;
-	for (unsigned lCountN1 = 0; lCountN1 < this->m_TransitionMatrix.getNumberOfElementsOfDimension(0); lCountN1++)
+	if (this->m_TransitionMatrix.getTotalNumberOfElements() > 0)
 	{
-		lSum = 0.0;
-		for (unsigned lCountN2 = 0; lCountN2 < this->m_TransitionMatrix.getNumberOfElementsOfDimension(1); lCountN2++)
+		const MultidimensionalArray<double> lSums = this->m_TransitionMatrix.sum(1);
+		for (unsigned lCountN = 0; lCountN < lSums.getTotalNumberOfElements(); lCountN++)
 		{
-			lSum += this->m_TransitionMatrix.getElement({ lCountN1, lCountN2 });
+			const double lSum = lSums.data()[lCountN];
+			lResult = lResult && (lSum > .9999 && lSum < 1.0001);
 		}
-
-		lResult = lResult && (lSum > .9999 && lSum < 1.0001);
 	}
 
 	if (!lResult) DebugLogger::getInstance().logMessage(DebugLogger::MessageLoggerType::Error, __FUNCTION__, "Transition Matrix does not make sense");
@@ -5,15 +5,21 @@
 
 
 #include "HiddenMarkovModel.h"
+#include "Einsum.h"
+#include "ChunkedStorage.h"
 
 #pragma unmanaged
 
+const double HiddenMarkovModel::SPARSE_TRANSITION_DENSITY = 0.25;
+
 /** Constructor of the hidden markov model
 */
-HiddenMarkovModel::HiddenMarkovModel(const HMMModelParameters& aModelParameters, const std::vector<double> aData)
+HiddenMarkovModel::HiddenMarkovModel(const HMMModelParameters& aModelParameters, const std::vector<double>& aData)
 {
 	m_ModelParameters = aModelParameters;
 	m_GMM = GuassianMixtureModel(m_ModelParameters.getNumberOfEmissionStates(), aData);
+	m_Precision = HiddenMarkovModel::DOUBLE_PRECISION;
+	m_ExecutionPolicy = ExecutionPolicy();
 }
 
 /** Constructor of the hidden markov model
@@ -22,10 +28,12 @@ HiddenMarkovModel::HiddenMarkovModel(const HMMModelParameters& aModelParameters,
 * @param aEmissionMatrix The emission matrix
 * @param aData The to model after
 */
-HiddenMarkovModel::HiddenMarkovModel(const std::vector<double>& aInitialDistribution, const MultidimensionalArray<double>& aTransitionMatrix, const MultidimensionalArray<double>& aEmissionMatrix, const std::vector<double> aData)
+HiddenMarkovModel::HiddenMarkovModel(const std::vector<double>& aInitialDistribution, const MultidimensionalArray<double>& aTransitionMatrix, const MultidimensionalArray<double>& aEmissionMatrix, const std::vector<double>& aData)
 {
 	m_ModelParameters = HMMModelParameters(aInitialDistribution, aTransitionMatrix, aEmissionMatrix);
 	m_GMM = GuassianMixtureModel(m_ModelParameters.getNumberOfEmissionStates(), aData);
+	m_Precision = HiddenMarkovModel::DOUBLE_PRECISION;
+	m_ExecutionPolicy = ExecutionPolicy();
 }
 
 /** Starts training the hidden markov model
@@ -36,7 +44,8 @@ HiddenMarkovModel::HiddenMarkovModel(const std::vector<double>& aInitialDistribu
 */
 void HiddenMarkovModel::startTraining(const unsigned& aBaumWelchIterations, const bool aConvergenceCheck, const double aConvergenceValue)
 {
-	unsigned lTimeIterations = this->m_GMM.getStates().getNumberOfElementsOfDimension(0) - 1;
+	const SparseMatrix<double>& lObservations = this->m_GMM.getSparseStates();
+	std::size_t lTimeIterations = lObservations.getNumberOfElementsOfDimension(0) - 1;
 	double lFitness = 0.0;
 	double lOldFitness = 0.0;
 
@@ -44,15 +53,12 @@ void HiddenMarkovModel::startTraining(const unsigned& aBaumWelchIterations, cons
 
 	for (unsigned lBWCount = 0; lBWCount < aBaumWelchIterations; lBWCount++)
 	{
-		this->m_ModelParameters = BaumWelchAlorithm(m_GMM.getStates(), this->m_ModelParameters);
+		this->m_ModelParameters = BaumWelchAlorithm(lObservations, this->m_ModelParameters, this->m_Precision, this->m_ExecutionPolicy);
 
-		// Get the fitness after the Baum Welch Algorithm
-		lForwardAlgorithmResult = ForwardAlgorithm(this->m_GMM.getStates(), this->m_ModelParameters, lTimeIterations);
-		lFitness = 0.0;
-		for (unsigned lCountN = 0; lCountN < this->m_ModelParameters.getNumberOfHiddenStates(); lCountN++)
-		{
-			lFitness += lForwardAlgorithmResult[lCountN];
-		}
+		// Get the fitness after the Baum Welch Algorithm (the sparse copy of the transition matrix is made once per parameter set)
+		const SparseMatrix<double> lSparseTransitionMatrix(this->m_ModelParameters.getTransitionMatrix());
+		lForwardAlgorithmResult = ForwardAlgorithm(lObservations, this->m_ModelParameters, lSparseTransitionMatrix, lTimeIterations);
+		lFitness = LinearAlgebra::Sum(lForwardAlgorithmResult.data(), this->m_ModelParameters.getNumberOfHiddenStates());
 
 		// Do the convergence check on the fitness score
 		if (aConvergenceCheck)
@@ -68,19 +74,90 @@ void HiddenMarkovModel::startTraining(const unsigned& aBaumWelchIterations, cons
 	}
 }
 
+/** Sets the precision Baum Welch uses for its per time iteration arrays during training
+* @param aPrecision The precision (DOUBLE_PRECISION by default)
+*/
+void HiddenMarkovModel::setPrecision(const Precision aPrecision)
+{
+	this->m_Precision = aPrecision;
+}
+
+/** Returns the precision Baum Welch uses during training
+*/
+HiddenMarkovModel::Precision HiddenMarkovModel::getPrecision() const
+{
+	return this->m_Precision;
+}
+
+/** Sets how Baum Welch runs its sums over the time iterations during training (e.g. PARALLEL to use the ThreadPool)
+* @param aPolicy The execution policy (sequential by default)
+*/
+void HiddenMarkovModel::setExecutionPolicy(const ExecutionPolicy& aPolicy)
+{
+	this->m_ExecutionPolicy = aPolicy;
+}
+
+/** Returns how Baum Welch runs its sums over the time iterations during training
+*/
+const ExecutionPolicy& HiddenMarkovModel::getExecutionPolicy() const
+{
+	return this->m_ExecutionPolicy;
+}
+
+/** Returns the current (trained) model parameters
+*/
+const HMMModelParameters& HiddenMarkovModel::getModelParameters() const
+{
+	return this->m_ModelParameters;
+}
+
+/** Runs one Baum Welch iteration from the current model parameters in double and in the selected precision and returns
+*   the largest difference between any of the resulting parameters (0 for DOUBLE_PRECISION). Use it on a representative
+*   data set to decide whether a reduced precision is accurate enough.
+*/
+double HiddenMarkovModel::calculatePrecisionDelta() const
+{
+	const SparseMatrix<double>& lObservations = this->m_GMM.getSparseStates();
+	const HMMModelParameters lReference = BaumWelchAlorithm(lObservations, this->m_ModelParameters, HiddenMarkovModel::DOUBLE_PRECISION, this->m_ExecutionPolicy);
+	const HMMModelParameters lReduced = BaumWelchAlorithm(lObservations, this->m_ModelParameters, this->m_Precision, this->m_ExecutionPolicy);
+
+	const std::vector<double>& lReferenceDistribution = lReference.getInitialDistribution();
+	const std::vector<double>& lReducedDistribution = lReduced.getInitialDistribution();
+	const MultidimensionalArray<double> lTransitionDelta = lReference.getTransitionMatrix() - lReduced.getTransitionMatrix();
+	const MultidimensionalArray<double> lEmissionDelta = lReference.getEmissionMatrix() - lReduced.getEmissionMatrix();
+
+	double lResult = 0.0;
+	for (std::size_t lCount = 0; lCount < lReferenceDistribution.size(); lCount++)
+	{
+		const double lDelta = Utilities::Abs(lReferenceDistribution[lCount] - lReducedDistribution[lCount]);
+		if (lDelta > lResult) lResult = lDelta;
+	}
+	const double lDeltas[4] = { lTransitionDelta.maximum(), -lTransitionDelta.minimum(), lEmissionDelta.maximum(), -lEmissionDelta.minimum() };
+	for (unsigned lCount = 0; lCount < 4; lCount++)
+	{
+		if (lDeltas[lCount] > lResult) lResult = lDeltas[lCount];
+	}
+	return lResult;
+}
+
 /** Creates a sequence of observations based on the model parameters of the HMM
 * @param aModelParameters The model parameters of the hidden markov model
 * @param aTimeIterations The number of output states
 */
-MultidimensionalArray<double> HiddenMarkovModel::OutputObservations(const HMMModelParameters aModelParameters, const unsigned aTimeIterations)
+MultidimensionalArray<double> HiddenMarkovModel::OutputObservations(const HMMModelParameters& aModelParameters, const std::size_t aTimeIterations)
 {
 	MultidimensionalArray<double> lResult(2, { aTimeIterations, aModelParameters.getNumberOfEmissionStates() });
+	const MultidimensionalArray<double>& lTransitionMatrix = aModelParameters.getTransitionMatrix();
+	const MultidimensionalArray<double>& lEmissionMatrix = aModelParameters.getEmissionMatrix();
 
-	std::vector<double> lHiddenStates = aModelParameters.getInitialDistribution();;
-	unsigned lTCount = 0;
+	const std::vector<double>& lInitialDistribution = aModelParameters.getInitialDistribution();
+	StateVector lHiddenStates;
+	lHiddenStates.assign(lInitialDistribution.begin(), lInitialDistribution.end());
+	StateVector lTemp(aModelParameters.getNumberOfHiddenStates());
+	std::size_t lTCount = 0;
 
 	// calculate the observations created at t=0
-	lResult.setRow({ 0 }, CalculateObservations(lHiddenStates, aModelParameters.getEmissionMatrix()));
+	CalculateObservations(ArrayView<const double>(lHiddenStates.data(), lHiddenStates.size()), lEmissionMatrix, lResult.rowView(0));
 
 	// increment the time count
 	lTCount++;
@@ -88,16 +165,9 @@ MultidimensionalArray<double> HiddenMarkovModel::OutputObservations(const HMMMod
 
 	while (lTCount < aTimeIterations)
 	{
-		std::vector<double> lTemp(aModelParameters.getNumberOfHiddenStates());
-		for (unsigned lCountN1 = 0; lCountN1 < aModelParameters.getNumberOfHiddenStates(); lCountN1++)
-		{
-			for (unsigned lCountN2 = 0; lCountN2 < aModelParameters.getNumberOfHiddenStates(); lCountN2++)
-			{
-				lTemp[lCountN1] = lTemp[lCountN1] + aModelParameters.getTransitionMatrix().getElement({ lCountN2, lCountN1 })*lHiddenStates[lCountN2];
-			}
-		}
-		lHiddenStates = lTemp;
-		lResult.setRow({ lTCount }, CalculateObservations(lHiddenStates, aModelParameters.getEmissionMatrix()));
+		LinearAlgebra::GemvTransposed(lTransitionMatrix.data(), lHiddenStates.size(), lHiddenStates.size(), lHiddenStates.data(), lTemp.data());
+		lHiddenStates.swap(lTemp);
+		CalculateObservations(ArrayView<const double>(lHiddenStates.data(), lHiddenStates.size()), lEmissionMatrix, lResult.rowView(lTCount));
 		lTCount++;
 	}
 
@@ -107,62 +177,61 @@ MultidimensionalArray<double> HiddenMarkovModel::OutputObservations(const HMMMod
 /** Calculates the observation states at a single time instant
 * @param aHiddenState The hidden state distribution at the time instant
 * @param aEmissionMAtrix The emission matrix of the HMM
+* @param aObservation Will be returned with the observation states (a view of the row of the output)
 * @comment Uses a hard clustering for the guassian mixture model
 */
-std::vector<double> HiddenMarkovModel::CalculateObservations(std::vector<double> aHiddenState, MultidimensionalArray<double> aEmissionMatrix)
+void HiddenMarkovModel::CalculateObservations(ArrayView<const double> aHiddenState, const MultidimensionalArray<double>& aEmissionMatrix, ArrayView<double> aObservation)
 {
 	std::size_t lNumberOfEmissionStates = aEmissionMatrix.getNumberOfElementsOfDimension(1);
-	std::size_t lNumberOfHiddenStates = aHiddenState.size();
 
-	std::vector<double> lResult(lNumberOfEmissionStates);
-	std::vector<double> lTemp(lNumberOfEmissionStates);
 	double lMax = -DBL_MAX;
-	unsigned lSelectedState = 0;
+	std::size_t lSelectedState = 0;
 
-	for (unsigned lCountN = 0; lCountN < lNumberOfHiddenStates; lCountN++)
-	{
-		for (unsigned lCountM = 0; lCountM < lNumberOfEmissionStates; lCountM++)
-		{
-			lTemp[lCountM] = lTemp[lCountM] + aHiddenState[lCountN]*aEmissionMatrix.getElement({ lCountN, lCountM });
-		}
-	}
+	// the probability of each observation state is calculated into the output row and then replaced by the hard clustering
+	if (!aObservation.isContiguous() || aObservation.size() != lNumberOfEmissionStates) throw 69;
+	LinearAlgebra::GemvTransposed(aEmissionMatrix.data(), aHiddenState.size(), lNumberOfEmissionStates, aHiddenState.data(), aObservation.data());
 
 	// perform the hard clustering
-	for (unsigned lCount = 0; lCount < lNumberOfEmissionStates; lCount++)
+	for (std::size_t lCountM = 0; lCountM < lNumberOfEmissionStates; lCountM++)
 	{
-		if (lTemp[lCount] > lMax)
+		if (aObservation[lCountM] > lMax)
 		{
-			lMax = lTemp[lCount];
-			lSelectedState = lCount;
+			lMax = aObservation[lCountM];
+			lSelectedState = lCountM;
 		}
 	}
 
-	lResult[lSelectedState] = 1.0;
-
-	return lResult;
+	aObservation.fill(0.0);
+	aObservation[lSelectedState] = 1.0;
 }
 
 /** The Forward Algorithm: Calculates the probability that a sequence of observations given the model parameters of the HMM
 * @param aObservations The discrete states of observations
 * @param aModelParameters The model parameters of the hidden markov model
+* @param aSparseTransitionMatrix The transition matrix of aModelParameters as a SparseMatrix (made once by the caller per parameter set)
 * @param aTimerIterations The number of time iterations to run the forward algorithm
 */
-std::vector<double> HiddenMarkovModel::ForwardAlgorithm(MultidimensionalArray<double> aObservations, HMMModelParameters aModelParameters, unsigned aTimerIterations)
+std::vector<double> HiddenMarkovModel::ForwardAlgorithm(const SparseMatrix<double>& aObservations, const HMMModelParameters& aModelParameters, const SparseMatrix<double>& aSparseTransitionMatrix, const std::size_t aTimerIterations)
 {
 	if (aTimerIterations > aObservations.getNumberOfElementsOfDimension(0) - 1) throw 69;
+	if (aSparseTransitionMatrix.getNumberOfElementsOfDimension(0) != aModelParameters.getNumberOfHiddenStates() || aSparseTransitionMatrix.getNumberOfElementsOfDimension(1) != aModelParameters.getNumberOfHiddenStates()) throw 69;
 
 	std::size_t lNumberOfHiddenStates = aModelParameters.getNumberOfHiddenStates();
-	std::size_t lNumberOfEmissionStates = aModelParameters.getNumberOfEmissionStates();
-	unsigned lTimeIterations = aTimerIterations + 1;
-	unsigned lTCount = 0;
+	std::size_t lTimeIterations = aTimerIterations + 1;
+	std::size_t lTCount = 0;
+	const MultidimensionalArray<double>& lTransitionMatrix = aModelParameters.getTransitionMatrix();
+	const MultidimensionalArray<double>& lEmissionMatrix = aModelParameters.getEmissionMatrix();
+	const std::vector<double>& lInitialDistribution = aModelParameters.getInitialDistribution();
+	const bool lUseSparseTransitions = aSparseTransitionMatrix.getDensity() <= HiddenMarkovModel::SPARSE_TRANSITION_DENSITY;
 
-	std::vector<double> lAlpha = std::vector<double>(lNumberOfHiddenStates);
+	StateVector lAlpha(lNumberOfHiddenStates);
+	StateVector lTemp(lNumberOfHiddenStates);
 
 	//Step 1: Initialization
 	//Calculate teh first step of the forward algorithm
-	for (unsigned lCountN = 0; lCountN < lNumberOfHiddenStates; lCountN++)
+	for (std::size_t lCountN = 0; lCountN < lNumberOfHiddenStates; lCountN++)
 	{
-		lAlpha[lCountN] = aModelParameters.getInitialDistribution()[lCountN] * HiddenStateEmission(lCountN, lTCount, aObservations, aModelParameters.getEmissionMatrix());
+		lAlpha[lCountN] = lInitialDistribution[lCountN] * HiddenStateEmission(lCountN, lTCount, aObservations, lEmissionMatrix);
 	}
 
 	// increment the tcount variable
@@ -172,65 +241,56 @@ std::vector<double> HiddenMarkovModel::ForwardAlgorithm(MultidimensionalArray<do
 	//Calculate each time step
 	while (lTCount < lTimeIterations)
 	{
-		std::vector<double> lTemp = std::vector<double>(lNumberOfHiddenStates);
-
-		for (unsigned lCountN1 = 0; lCountN1 < lNumberOfHiddenStates; lCountN1++)
+		if (lUseSparseTransitions) aSparseTransitionMatrix.multiplyVectorTransposed(lAlpha.data(), lTemp.data());
+		else LinearAlgebra::GemvTransposed(lTransitionMatrix.data(), lNumberOfHiddenStates, lNumberOfHiddenStates, lAlpha.data(), lTemp.data());
+		for (std::size_t lCountN1 = 0; lCountN1 < lNumberOfHiddenStates; lCountN1++)
 		{
-			lTemp[lCountN1] =  0.0;
-			for (unsigned lCountN2 = 0; lCountN2 < lNumberOfHiddenStates; lCountN2++)
-			{
-				lTemp[lCountN1] = lTemp[lCountN1] + aModelParameters.getTransitionMatrix().getElement({ lCountN2, lCountN1 }) * lAlpha[lCountN2];
-			}
-			lTemp[lCountN1] = lTemp[lCountN1] * HiddenStateEmission(lCountN1, lTCount, aObservations, aModelParameters.getEmissionMatrix());
+			lTemp[lCountN1] = lTemp[lCountN1] * HiddenStateEmission(lCountN1, lTCount, aObservations, lEmissionMatrix);
 		}
-		lAlpha = lTemp;
+		lAlpha.swap(lTemp);
 		lTCount++;
 	}
-	return lAlpha;
+	return std::vector<double>(lAlpha.begin(), lAlpha.end());
 }
 
 /** The Backward Algorithm: Calculates the probability that a sequence of observations given the model parameters of the HMM
 * @param aObservations The discrete states of observations
 * @param aModelParameters The model parameters of the hidden markov model
+* @param aSparseTransitionMatrix The transition matrix of aModelParameters as a SparseMatrix (made once by the caller per parameter set)
 * @param aTimerIterations The number of time iterations to run the forward algorithm
 */
-std::vector<double> HiddenMarkovModel::BackwardAlgorithm(MultidimensionalArray<double> aObservations, HMMModelParameters aModelParameters, unsigned aTimerIterations)
+std::vector<double> HiddenMarkovModel::BackwardAlgorithm(const SparseMatrix<double>& aObservations, const HMMModelParameters& aModelParameters, const SparseMatrix<double>& aSparseTransitionMatrix, const std::size_t aTimerIterations)
 {
 	if (aTimerIterations > aObservations.getNumberOfElementsOfDimension(0) - 1) throw 69;
+	if (aSparseTransitionMatrix.getNumberOfElementsOfDimension(0) != aModelParameters.getNumberOfHiddenStates() || aSparseTransitionMatrix.getNumberOfElementsOfDimension(1) != aModelParameters.getNumberOfHiddenStates()) throw 69;
 
 	std::size_t lNumberOfHiddenStates = aModelParameters.getNumberOfHiddenStates();
-	std::size_t lNumberOfEmissionStates = aModelParameters.getNumberOfEmissionStates();
+	const MultidimensionalArray<double>& lTransitionMatrix = aModelParameters.getTransitionMatrix();
+	const MultidimensionalArray<double>& lEmissionMatrix = aModelParameters.getEmissionMatrix();
+	const bool lUseSparseTransitions = aSparseTransitionMatrix.getDensity() <= HiddenMarkovModel::SPARSE_TRANSITION_DENSITY;
 
-	// Set lTcount to the last time
-	unsigned lTcount = aObservations.getNumberOfElementsOfDimension(0) - 1;
-
-	std::vector<double> lBeta(lNumberOfHiddenStates);
+	StateVector lBeta(lNumberOfHiddenStates);
+	StateVector lTemp(lNumberOfHiddenStates);
 
 	// Step 1: Initialization
-	for (unsigned lCountN = 0; lCountN < lNumberOfHiddenStates; lCountN++)
+	for (std::size_t lCountN = 0; lCountN < lNumberOfHiddenStates; lCountN++)
 	{
 		lBeta[lCountN] = 1.0;
 	}
 
-	//decrement lTcount
-	lTcount--;
-
 	//Step 2: Induction
-	//calculate each time step
-	std::vector<double> lTemp(lNumberOfHiddenStates);
-	while (lTcount >= aTimerIterations)
+	//calculate each time step from the last time down to aTimerIterations (lTcount is the time of the previous beta)
+	for (std::size_t lTcount = aObservations.getNumberOfElementsOfDimension(0) - 1; lTcount > aTimerIterations; lTcount--)
 	{
-		for (unsigned lCountN1 = 0; lCountN1 < lNumberOfHiddenStates; lCountN1++)
+		for (std::size_t lCountN2 = 0; lCountN2 < lNumberOfHiddenStates; lCountN2++)
 		{
-			for (unsigned lCountN2 = 0; lCountN2 < lNumberOfHiddenStates; lCountN2++)
-			{
-				lTemp[lCountN1] = lTemp[lCountN1] + aModelParameters.getTransitionMatrix().getElement({ lCountN1, lCountN2 }) * lBeta[lCountN2] * HiddenStateEmission(lCountN2, lTcount + 1, aObservations, aModelParameters.getEmissionMatrix());
-			}
+			lBeta[lCountN2] = lBeta[lCountN2] * HiddenStateEmission(lCountN2, lTcount, aObservations, lEmissionMatrix);
 		}
-		lBeta = lTemp;
-		lTcount--;
+		if (lUseSparseTransitions) aSparseTransitionMatrix.multiplyVector(lBeta.data(), lTemp.data());
+		else LinearAlgebra::Gemv(lTransitionMatrix.data(), lNumberOfHiddenStates, lNumberOfHiddenStates, lBeta.data(), lTemp.data());
+		lBeta.swap(lTemp);
 	}
-	return lBeta;
+	return std::vector<double>(lBeta.begin(), lBeta.end());
 }
 
 /** Calculates the probability of a hidden state producing the observation
@@ -239,149 +299,205 @@ std::vector<double> HiddenMarkovModel::BackwardAlgorithm(MultidimensionalArray<d
 * @param aObservations The discrete states of observations
 * @param aEmissionMatrix The emission matrix of the hidden markov model
 */
-double HiddenMarkovModel::HiddenStateEmission(const unsigned aCountN, const unsigned aCountT, const MultidimensionalArray<double> aObservations, const MultidimensionalArray<double> aEmissionMatrix)
+double HiddenMarkovModel::HiddenStateEmission(const std::size_t aCountN, const std::size_t aCountT, const SparseMatrix<double>& aObservations, const MultidimensionalArray<double>& aEmissionMatrix)
 {
-	double lResult = 0.0;
-	for (unsigned lCountM = 0; lCountM < aObservations.getNumberOfElementsOfDimension(1); lCountM++)
-	{
-		lResult = lResult + aObservations.getElement({ aCountT, lCountM }) * aEmissionMatrix.getElement({ aCountN, lCountM });
-	}
-
-	return lResult;
+	return aObservations.dotRow(aCountT, aEmissionMatrix.data() + aCountN * aEmissionMatrix.getNumberOfElementsOfDimension(1));
 }
 
-/** The Baum Welch Algorithm for the hidden markov model
+/** The Baum Welch Algorithm for the hidden markov model. The model parameters are always double; Real is the element type
+*   of the trellis (emission, alpha, beta and gamma for every time iteration) and of the transition matrix used with it.
+*   The trellis is where the memory traffic is, so float halves it and BFloat16 quarters it, while the sums over time
+*   are still accumulated in double.
+*
+*   alpha and beta are scaled at every time iteration (alpha to sum to 1, beta by the same factors) so they do not
+*   underflow for long observation sequences, even in float.
 * @param aObservations The discrete states of observations
 * @param aModelParameters The hidden markov model parameters
+* @param aPolicy How the sums over the time iterations run (sequential by default)
 */
-HMMModelParameters HiddenMarkovModel::BaumWelchAlorithm(const MultidimensionalArray<double> aObservations, const HMMModelParameters aModelParameters)
+template<typename Real>
+HMMModelParameters HiddenMarkovModel::BaumWelchAlorithm(const SparseMatrix<double>& aObservations, const HMMModelParameters& aModelParameters, const ExecutionPolicy& aPolicy)
 {
 	std::size_t lNumberOfHiddenStates = aModelParameters.getNumberOfHiddenStates();
 	std::size_t lNumberOfEmissionStates = aModelParameters.getNumberOfEmissionStates();
-	unsigned lTimeIterations = aObservations.getNumberOfElementsOfDimension(0);
+	std::size_t lTimeIterations = aObservations.getNumberOfElementsOfDimension(0);
+
+	if (aObservations.getNumberOfElementsOfDimension(1) != lNumberOfEmissionStates) throw 69;
+
+	// fixed rank copies of the inputs so the inner loops can index elements without allocating
+	const FixedRankArray<double, 2> lTransitionMatrix(aModelParameters.getTransitionMatrix());
+	const FixedRankArray<double, 2> lEmissionMatrix(aModelParameters.getEmissionMatrix());
+	const FixedRankArray<Real, 2> lTrellisTransitionMatrix(lTransitionMatrix);
+	const std::vector<double>& lInitialDistribution = aModelParameters.getInitialDistribution();
+	const std::vector<Real> lTrellisInitialDistribution(lInitialDistribution.begin(), lInitialDistribution.end());
+	const SparseMatrix<double> lSparseTransitionMatrix(aModelParameters.getTransitionMatrix());
+	const bool lUseSparseTransitions = lSparseTransitionMatrix.getDensity() <= HiddenMarkovModel::SPARSE_TRANSITION_DENSITY;
+
+	// the trellises are committed in chunks so very long observation sequences (e.g. 10^8 time iterations) do not
+	// need one huge block from the heap, and zero filling them is free
+	typedef FixedRankArray<Real, 2, ChunkedStorage<Real>> Trellis;
+
+	//lEmission = the probability of hidden state i producing the observation at time t
+	Trellis lEmission({ lTimeIterations, lNumberOfHiddenStates }, Real());
 
 	//lGamma = the probability of being in hidden state i at time t
-	MultidimensionalArray<double> lGamma(2, { lTimeIterations, lNumberOfHiddenStates });
+	Trellis lGamma({ lTimeIterations, lNumberOfHiddenStates }, Real());
 
-	//lEta = The probability of being in hidden state i at time t and hidden state j at time t+1
-	MultidimensionalArray<double> lEta(3, { lTimeIterations - 1, lNumberOfHiddenStates, lNumberOfHiddenStates });
+	//lAlpha = The result of the forward algorithm at time t (scaled to sum to 1)
+	Trellis lAlpha({ lTimeIterations, lNumberOfHiddenStates }, Real());
 
-	//lAlpha = The result of the forward algorithm at time t
-	MultidimensionalArray<double> lAlpha(2, { lTimeIterations, lNumberOfHiddenStates });
+	//lBeta = the result of the backward algorithm at time t (scaled by the same factors as lAlpha after time t)
+	Trellis lBeta({ lTimeIterations, lNumberOfHiddenStates }, Real());
 
-	//lBeta = the result of the backward algorithm at time t+1
-	MultidimensionalArray<double> lBeta(2, { lTimeIterations, lNumberOfHiddenStates });
+	//lScale = the factor alpha was scaled by at time t
+	std::vector<double> lScale(lTimeIterations);
 
 	//TransitionFrequency1 = the expected number of transitions from hidden state i
-	std::vector<double> TransitionFrequency1(lNumberOfHiddenStates);
+	StateVector TransitionFrequency1(lNumberOfHiddenStates);
 
 	//TransitionFrequency2 = the expected number of transitions from hidden state i to hidden state j
-	MultidimensionalArray<double> TransitionFrequency2(2, { lNumberOfHiddenStates, lNumberOfHiddenStates });
-
-	//lTransitionFrequency3 = the expected number of times in state i and observing symbol m
-	MultidimensionalArray<double> lTransitionFrequency3(2, { lNumberOfHiddenStates, lNumberOfEmissionStates });
+	FixedRankArray<double, 2> TransitionFrequency2({ lNumberOfHiddenStates, lNumberOfHiddenStates }, 0.0);
 
-	std::vector<double> lFrequency4(lNumberOfHiddenStates);
+	//lTransitionFrequency3 = the expected number of times in state i and observing symbol m (stored transposed: symbol m, state i)
+	FixedRankArray<double, 2> lTransitionFrequency3({ lNumberOfEmissionStates, lNumberOfHiddenStates }, 0.0);
 
-	// The total probability of the total observation sequence happening
-	double lProbabilityOfObservationSequence = 0.0;
+	StateVector lFrequency4(lNumberOfHiddenStates);
 
-	double lHiddenStateEmission;
+	// The total probability of the total observation sequence happening times the product of the scale factors
+	// (calculated at each time iteration)
+	std::vector<Real> lProbabilityOfObservationSequence(lTimeIterations);
 
-	// calculate lAlpha and lBeta for all time iterations
-	for (unsigned lTcount = 0; lTcount < lTimeIterations; lTcount++)
+	// calculate the emission probabilities for all time iterations: lEmission = observations * transpose(emission matrix)
+	// (the observations are one-hot so each row just copies a row of the transpose)
+	FixedRankArray<Real, 2> lEmissionMatrixTransposed({ lNumberOfEmissionStates, lNumberOfHiddenStates }, Real());
+	for (std::size_t lCountN = 0; lCountN < lNumberOfHiddenStates; lCountN++)
 	{
-		lAlpha.setRow({ lTcount }, ForwardAlgorithm(aObservations, aModelParameters, lTcount));
-		lBeta.setRow({ lTcount }, BackwardAlgorithm(aObservations, aModelParameters, lTcount));
+		for (std::size_t lCountM = 0; lCountM < lNumberOfEmissionStates; lCountM++)
+		{
+			lEmissionMatrixTransposed(lCountM, lCountN) = static_cast<Real>(lEmissionMatrix(lCountN, lCountM));
+		}
 	}
+	aObservations.multiply(lEmissionMatrixTransposed.data(), lNumberOfHiddenStates, lEmission.data());
 
-	for (unsigned lTCount = 0; lTCount < lTimeIterations - 1; lTCount++)
+	// calculate lAlpha for all time iterations (the forward algorithm)
+	// the scale is rounded to Real before it is stored so lScale is exactly what alpha and beta were multiplied by
+	for (std::size_t lTCount = 0; lTCount < lTimeIterations; lTCount++)
 	{
-		lProbabilityOfObservationSequence = 0.0;
-		for (unsigned lCountN = 0; lCountN < lNumberOfHiddenStates; lCountN++)
+		Real* const lAlphaRow = lAlpha.data() + lTCount * lNumberOfHiddenStates;
+		if (lTCount == 0)
 		{
-			lProbabilityOfObservationSequence += lAlpha.getElement({ lTCount, lCountN }) * lBeta.getElement({ lTCount, lCountN });
+			LinearAlgebra::Multiply(lTrellisInitialDistribution.data(), lEmission.data(), lAlphaRow, lNumberOfHiddenStates);
 		}
-
-		for (unsigned lCountN1 = 0; lCountN1 < lNumberOfHiddenStates; lCountN1++)
+		else
 		{
-			lGamma.setElement({ lTCount, lCountN1 }, (lAlpha.getElement({ lTCount, lCountN1 }) * lBeta.getElement({ lTCount, lCountN1 })) / lProbabilityOfObservationSequence);
-			for (unsigned lCountN2 = 0; lCountN2 < lNumberOfHiddenStates; lCountN2++)
-			{
-				lHiddenStateEmission = HiddenStateEmission(lCountN2, lTCount + 1, aObservations, aModelParameters.getEmissionMatrix());
-				lEta.setElement({ lTCount, lCountN1, lCountN2 }, lAlpha.getElement({ lTCount, lCountN1 }) * aModelParameters.getTransitionMatrix().getElement({ lCountN1, lCountN2 })*lHiddenStateEmission*lBeta.getElement({ lTCount + 1, lCountN2 }));
-				lEta.setElement({ lTCount, lCountN1, lCountN2 }, lEta.getElement({ lTCount, lCountN1, lCountN2 }) / lProbabilityOfObservationSequence);
-			}
+			if (lUseSparseTransitions) lSparseTransitionMatrix.multiplyVectorTransposed(lAlphaRow - lNumberOfHiddenStates, lAlphaRow);
+			else LinearAlgebra::GemvTransposed(lTrellisTransitionMatrix.data(), lNumberOfHiddenStates, lNumberOfHiddenStates, lAlphaRow - lNumberOfHiddenStates, lAlphaRow);
+			LinearAlgebra::Multiply(lAlphaRow, lEmission.data() + lTCount * lNumberOfHiddenStates, lAlphaRow, lNumberOfHiddenStates);
 		}
+
+		const Real lAlphaScale = static_cast<Real>(1.0 / static_cast<double>(LinearAlgebra::Sum(lAlphaRow, lNumberOfHiddenStates)));
+		LinearAlgebra::Scale(lAlphaScale, lAlphaRow, lNumberOfHiddenStates);
+		lScale[lTCount] = static_cast<double>(lAlphaScale);
 	}
 
-	//Calculate the last time iteration for lGamma
-	lProbabilityOfObservationSequence = 0.0;
-	for (unsigned lCountN = 0; lCountN < lNumberOfHiddenStates; lCountN++)
+	// calculate lBeta for all time iterations (the backward algorithm)
+	// lEmissionBeta = the emission probability times beta (the part of eta that only depends on the next hidden state)
+	Trellis lEmissionBeta({ lTimeIterations, lNumberOfHiddenStates }, Real());
+	for (std::size_t lCountN = 0; lCountN < lNumberOfHiddenStates; lCountN++)
 	{
-		lProbabilityOfObservationSequence += lAlpha.getElement({ lTimeIterations - 1, lCountN }) *lBeta.getElement({ lTimeIterations - 1, lCountN });
+		lBeta(lTimeIterations - 1, lCountN) = static_cast<Real>(1.0);
 	}
-	for (unsigned lCountN = 0; lCountN < lNumberOfHiddenStates; lCountN++)
+	for (std::size_t lTCount = lTimeIterations - 1; lTCount > 0; lTCount--)
 	{
-		lGamma.setElement({ lTimeIterations - 1, lCountN }, (lAlpha.getElement({ lTimeIterations - 1, lCountN }) * lBeta.getElement({ lTimeIterations - 1, lCountN })) / lProbabilityOfObservationSequence);
+		Real* const lEmissionBetaRow = lEmissionBeta.data() + lTCount * lNumberOfHiddenStates;
+		Real* const lPreviousBetaRow = lBeta.data() + (lTCount - 1) * lNumberOfHiddenStates;
+		LinearAlgebra::Multiply(lEmission.data() + lTCount * lNumberOfHiddenStates, lBeta.data() + lTCount * lNumberOfHiddenStates, lEmissionBetaRow, lNumberOfHiddenStates);
+		if (lUseSparseTransitions) lSparseTransitionMatrix.multiplyVector(lEmissionBetaRow, lPreviousBetaRow);
+		else LinearAlgebra::Gemv(lTrellisTransitionMatrix.data(), lNumberOfHiddenStates, lNumberOfHiddenStates, lEmissionBetaRow, lPreviousBetaRow);
+		LinearAlgebra::Scale(static_cast<Real>(lScale[lTCount]), lPreviousBetaRow, lNumberOfHiddenStates);
 	}
 
-	//Calculate TransitionFrequency2, TransitionFrequency1
-	for (unsigned lCountN1 = 0; lCountN1 < lNumberOfHiddenStates; lCountN1++)
+	for (std::size_t lTCount = 0; lTCount < lTimeIterations; lTCount++)
 	{
-		for (unsigned lCountN2 = 0; lCountN2 < lNumberOfHiddenStates; lCountN2++)
-		{
-			TransitionFrequency2.setElement({ lCountN1, lCountN2 }, 0.0);
-			for (unsigned lCountT = 0; lCountT < lTimeIterations - 1; lCountT++)
-			{
-				TransitionFrequency2.setElement({ lCountN1, lCountN2 }, TransitionFrequency2.getElement({ lCountN1, lCountN2 }) + lEta.getElement({ lCountT, lCountN1, lCountN2 }));
-				lFrequency4[lCountN1] = lFrequency4[lCountN1] + lEta.getElement({ lCountT, lCountN1, lCountN2 });
-			}
-		}
+		lProbabilityOfObservationSequence[lTCount] = LinearAlgebra::Dot(lAlpha.data() + lTCount * lNumberOfHiddenStates, lBeta.data() + lTCount * lNumberOfHiddenStates, lNumberOfHiddenStates);
+	}
+
+	lGamma = lAlpha * lBeta / columnBroadcast(lProbabilityOfObservationSequence, lGamma);
+
+	//Calculate TransitionFrequency2 by summing eta over time without storing eta for every time iteration
+	//eta(t, i, j) = The probability of being in hidden state i at time t and hidden state j at time t+1
+	//             = alpha(t, i) * a(i, j) * emission(t + 1, j) * beta(t + 1, j) * scale(t + 1) / P
+	const std::size_t lNumberOfTransitions = lTimeIterations - 1;
+	std::vector<double> lEtaScale(lNumberOfTransitions);
+	for (std::size_t lTCount = 0; lTCount < lNumberOfTransitions; lTCount++)
+	{
+		lEtaScale[lTCount] = lScale[lTCount + 1] / static_cast<double>(lProbabilityOfObservationSequence[lTCount]);
 	}
 
-	// Calculate TransitionFrequency1 and lTransitionFrequency3
-	for (unsigned lCountT = 0; lCountT < lTimeIterations; lCountT++)
+	if (!lUseSparseTransitions)
+	{
+		const EinsumPlan lEta("ti,ij,tj,t->ij", { { lNumberOfTransitions, lNumberOfHiddenStates }, { lNumberOfHiddenStates, lNumberOfHiddenStates }, { lNumberOfTransitions, lNumberOfHiddenStates }, { lNumberOfTransitions } });
+		lEta.accumulate(TransitionFrequency2.data(), aPolicy, lAlpha.data(), lTransitionMatrix.data(), lEmissionBeta.data() + lNumberOfHiddenStates, lEtaScale.data());
+	}
+	else
 	{
-		for (unsigned lCountN = 0; lCountN < lNumberOfHiddenStates; lCountN++)
+		// only the non-zero transitions contribute when the transition matrix is sparse
+		const std::vector<std::size_t>& lRowStarts = lSparseTransitionMatrix.getRowStarts();
+		const std::vector<std::size_t>& lColumns = lSparseTransitionMatrix.getColumns();
+		const std::vector<double>& lValues = lSparseTransitionMatrix.getValues();
+		for (std::size_t lTCount = 0; lTCount < lNumberOfTransitions; lTCount++)
 		{
-			TransitionFrequency1[lCountN] = TransitionFrequency1[lCountN] + lGamma.getElement({ lCountT, lCountN });
-			for (unsigned lCountM = 0; lCountM < lNumberOfEmissionStates; lCountM++)
+			ArrayView<const Real> lAlphaRow = lAlpha.rowView(lTCount);
+			ArrayView<const Real> lEmissionBetaRow = lEmissionBeta.rowView(lTCount + 1);
+			for (std::size_t lCountN1 = 0; lCountN1 < lNumberOfHiddenStates; lCountN1++)
 			{
-				lTransitionFrequency3.setElement({ lCountN, lCountM }, lTransitionFrequency3.getElement({ lCountN, lCountM }) + lGamma.getElement({ lCountT, lCountN }) * aObservations.getElement({ lCountT, lCountM }));
+				const double lRowScale = static_cast<double>(lAlphaRow[lCountN1]) * lEtaScale[lTCount];
+				for (std::size_t lPosition = lRowStarts[lCountN1]; lPosition < lRowStarts[lCountN1 + 1]; lPosition++)
+				{
+					TransitionFrequency2(lCountN1, lColumns[lPosition]) += lRowScale * lValues[lPosition] * static_cast<double>(lEmissionBetaRow[lColumns[lPosition]]);
+				}
 			}
 		}
 	}
 
+	//Calculate lFrequency4 = the expected number of transitions out of hidden state i
+	const EinsumPlan lTransitionsOut("ij->i", { { lNumberOfHiddenStates, lNumberOfHiddenStates } });
+	lTransitionsOut.accumulate(lFrequency4.data(), aPolicy, TransitionFrequency2.data());
+
+	// Calculate TransitionFrequency1 (= gamma summed over time) and lTransitionFrequency3 (= transpose(observations) * gamma, one gamma row per observation)
+	const EinsumPlan lStateFrequency("ti->i", { { lTimeIterations, lNumberOfHiddenStates } });
+	lStateFrequency.accumulate(TransitionFrequency1.data(), aPolicy, lGamma.data());
+	aObservations.multiplyTransposed(lGamma.data(), lNumberOfHiddenStates, lTransitionFrequency3.data());
+
 	//Calculate the new model parameters of the hidden markov model
 	std::vector<double> lNewInitialDistribution(lNumberOfHiddenStates);
-	MultidimensionalArray<double> lNewTransitionMatrix(2, { lNumberOfHiddenStates, lNumberOfHiddenStates });
-	MultidimensionalArray<double> lNewEmissionMatrix(2, { lNumberOfHiddenStates, lNumberOfEmissionStates });
-	for (unsigned lCountN1 = 0; lCountN1 < lNumberOfHiddenStates; lCountN1++)
+	FixedRankArray<double, 2> lNewTransitionMatrix({ lNumberOfHiddenStates, lNumberOfHiddenStates }, 0.0);
+	FixedRankArray<double, 2> lNewEmissionMatrix({ lNumberOfHiddenStates, lNumberOfEmissionStates }, 0.0);
+	for (std::size_t lCountN1 = 0; lCountN1 < lNumberOfHiddenStates; lCountN1++)
 	{
-		lNewInitialDistribution[lCountN1] = lGamma.getElement({ 0, lCountN1 });
-		for (unsigned lCountN2 = 0; lCountN2 < lNumberOfHiddenStates; lCountN2++)
+		lNewInitialDistribution[lCountN1] = static_cast<double>(lGamma(0, lCountN1));
+		for (std::size_t lCountN2 = 0; lCountN2 < lNumberOfHiddenStates; lCountN2++)
 		{
 			// if there are never any transisitons from the state then it can not transition to another state
 			if (lFrequency4[lCountN1] == 0.0)
 			{
-				lNewTransitionMatrix.setElement({ lCountN1, lCountN2 }, 0.0);
+				lNewTransitionMatrix(lCountN1, lCountN2) = 0.0;
 			}
 			else
 			{
-				lNewTransitionMatrix.setElement({ lCountN1, lCountN2 }, TransitionFrequency2.getElement({ lCountN1, lCountN2 }) / lFrequency4[lCountN1]);
+				lNewTransitionMatrix(lCountN1, lCountN2) = TransitionFrequency2(lCountN1, lCountN2) / lFrequency4[lCountN1];
 			}
 		}
-		for (unsigned lCountM = 0; lCountM < lNumberOfEmissionStates; lCountM++)
+		for (std::size_t lCountM = 0; lCountM < lNumberOfEmissionStates; lCountM++)
 		{
 			// if there are never any transitions from the state it can not emit an ovservation
 			if (TransitionFrequency1[lCountN1] == 0.0)
 			{
-				lNewEmissionMatrix.setElement({ lCountN1, lCountM }, 0.0);
+				lNewEmissionMatrix(lCountN1, lCountM) = 0.0;
 			}
 			else
 			{
-				lNewEmissionMatrix.setElement({ lCountN1, lCountM }, lTransitionFrequency3.getElement({ lCountN1, lCountM }) / TransitionFrequency1[lCountN1]);
+				lNewEmissionMatrix(lCountN1, lCountM) = lTransitionFrequency3(lCountM, lCountN1) / TransitionFrequency1[lCountN1];
 			}
 		}
 	}
@@ -389,27 +505,51 @@ HMMModelParameters HiddenMarkovModel::BaumWelchAlorithm(const MultidimensionalAr
 
 	// if there a hidden state never transitions to another state (always transitions into itself) then use the previous state transitions for this state
 	// Note: We are avoiding a state always transitioning into itself because this leads to a convergence of all states transitioning into this state
-	for (unsigned lCount = 0; lCount < lNumberOfHiddenStates; lCount++)
+	for (std::size_t lCount = 0; lCount < lNumberOfHiddenStates; lCount++)
 	{
 		double lSum = 0;
-		for (unsigned lCountN2 = 0; lCountN2 < lNumberOfHiddenStates; lCountN2++)
+		for (std::size_t lCountN2 = 0; lCountN2 < lNumberOfHiddenStates; lCountN2++)
 		{
-			lSum += lNewTransitionMatrix.getElement({ lCount, lCountN2 });
+			lSum += lNewTransitionMatrix(lCount, lCountN2);
 		}
 		if (lSum == 0.0)
 		{
-			for (unsigned lCountN2 = 0; lCountN2 < lNumberOfHiddenStates; lCountN2++)
+			for (std::size_t lCountN2 = 0; lCountN2 < lNumberOfHiddenStates; lCountN2++)
 			{
-				lNewTransitionMatrix.setElement({ lCount, lCountN2 }, aModelParameters.getTransitionMatrix().getElement({ lCount, lCountN2 }));
+				lNewTransitionMatrix(lCount, lCountN2) = lTransitionMatrix(lCount, lCountN2);
 			}
 		}
 	}
 
 	// create the new model parameter object
-	HMMModelParameters lResult(lNewInitialDistribution, lNewTransitionMatrix, lNewEmissionMatrix);
+	HMMModelParameters lResult(std::move(lNewInitialDistribution), lNewTransitionMatrix.toMultidimensionalArray(), lNewEmissionMatrix.toMultidimensionalArray());
 
 	// Check the new model parameters
 	if (!lResult.checkParameters()) DebugLogger::getInstance().logMessage(DebugLogger::MessageLoggerType::Error, __FUNCTION__, "The new model parameters do not make sense");
 
-	return HMMModelParameters();
-}
\ No newline at end of file
+	return lResult;
+}
+
+template HMMModelParameters HiddenMarkovModel::BaumWelchAlorithm<double>(const SparseMatrix<double>& aObservations, const HMMModelParameters& aModelParameters, const ExecutionPolicy& aPolicy);
+template HMMModelParameters HiddenMarkovModel::BaumWelchAlorithm<float>(const SparseMatrix<double>& aObservations, const HMMModelParameters& aModelParameters, const ExecutionPolicy& aPolicy);
+template HMMModelParameters HiddenMarkovModel::BaumWelchAlorithm<BFloat16>(const SparseMatrix<double>& aObservations, const HMMModelParameters& aModelParameters, const ExecutionPolicy& aPolicy);
+
+/** The Baum Welch Algorithm for the hidden markov model with the trellis in the selected precision
+* @param aObservations The discrete states of observations
+* @param aModelParameters The hidden markov model parameters
+* @param aPrecision The precision
+* @param aPolicy How the sums over the time iterations run
+*/
+HMMModelParameters HiddenMarkovModel::BaumWelchAlorithm(const SparseMatrix<double>& aObservations, const HMMModelParameters& aModelParameters, const Precision aPrecision, const ExecutionPolicy& aPolicy)
+{
+	switch (aPrecision)
+	{
+	case HiddenMarkovModel::SINGLE_PRECISION:
+		return BaumWelchAlorithm<float>(aObservations, aModelParameters, aPolicy);
+	case HiddenMarkovModel::BFLOAT16_PRECISION:
+		return BaumWelchAlorithm<BFloat16>(aObservations, aModelParameters, aPolicy);
+	default:
+		return BaumWelchAlorithm<double>(aObservations, aModelParameters, aPolicy);
+	}
+}
+
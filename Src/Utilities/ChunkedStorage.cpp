@@ -0,0 +1,192 @@
+/**
+*  @file    ChunkedStorage.cpp
+*  @author  Jordan Nesley
+**/
+
+#include "ChunkedStorage.h"
+#include <cstdint> // std::uintptr_t
+
+#ifdef _WIN32
+#define NOMINMAX
+#include <windows.h>
+#else
+#include <sys/mman.h>
+#include <unistd.h> // sysconf
+#endif
+
+#pragma unmanaged
+
+const std::size_t ChunkedMemory::DEFAULT_CHUNK_SIZE;
+
+/** Default constructor for ChunkedMemory (nothing reserved)
+*/
+ChunkedMemory::ChunkedMemory()
+{
+	this->m_Data = nullptr;
+	this->m_ReservedSize = 0;
+	this->m_CommittedSize = 0;
+	this->m_ChunkSize = ChunkedMemory::DEFAULT_CHUNK_SIZE;
+	this->m_UseHugePages = false;
+#ifndef _WIN32
+	this->m_Mapping = nullptr;
+	this->m_MappingSize = 0;
+#endif
+}
+
+/** Move Constructor for ChunkedMemory
+* @param aMove The object to move
+*/
+ChunkedMemory::ChunkedMemory(ChunkedMemory&& aMove)
+	: ChunkedMemory()
+{
+	*this = std::move(aMove);
+}
+
+/** Destructor for ChunkedMemory. Releases the memory.
+*/
+ChunkedMemory::~ChunkedMemory()
+{
+	this->release();
+}
+
+/** Move assignment operator
+* @param aRight The right side of the = operator
+*/
+ChunkedMemory& ChunkedMemory::operator=(ChunkedMemory&& aRight)
+{
+	if (this == &aRight) return *this;
+
+	this->release();
+	this->m_Data = aRight.m_Data;
+	this->m_ReservedSize = aRight.m_ReservedSize;
+	this->m_CommittedSize = aRight.m_CommittedSize;
+	this->m_ChunkSize = aRight.m_ChunkSize;
+	this->m_UseHugePages = aRight.m_UseHugePages;
+#ifndef _WIN32
+	this->m_Mapping = aRight.m_Mapping;
+	this->m_MappingSize = aRight.m_MappingSize;
+	aRight.m_Mapping = nullptr;
+	aRight.m_MappingSize = 0;
+#endif
+	aRight.m_Data = nullptr;
+	aRight.m_ReservedSize = 0;
+	aRight.m_CommittedSize = 0;
+	return *this;
+}
+
+/** Reserves address space for aSize bytes (rounded up to whole chunks) without committing any of it. Any memory
+*   reserved before is released.
+* @param aSize The number of bytes
+* @param aChunkSize The number of bytes committed at a time (rounded up to a multiple of the page size)
+* @param aUseHugePages Advise the operating system to back the chunks with huge pages
+*/
+void ChunkedMemory::reserve(const std::size_t aSize, const std::size_t aChunkSize, const bool aUseHugePages)
+{
+	this->release();
+	if (aSize == 0) return;
+
+#ifdef _WIN32
+	SYSTEM_INFO lSystemInfo;
+	GetSystemInfo(&lSystemInfo);
+	const std::size_t lPageSize = lSystemInfo.dwAllocationGranularity;
+#else
+	const std::size_t lPageSize = static_cast<std::size_t>(sysconf(_SC_PAGESIZE));
+#endif
+	const std::size_t lChunkSize = ((aChunkSize < lPageSize ? lPageSize : aChunkSize) + lPageSize - 1) / lPageSize * lPageSize;
+	const std::size_t lReservedSize = (aSize + lChunkSize - 1) / lChunkSize * lChunkSize;
+
+#ifdef _WIN32
+	void* const lData = VirtualAlloc(nullptr, lReservedSize, MEM_RESERVE, PAGE_NOACCESS);
+	if (lData == nullptr) throw ChunkedMemory::RESERVE_EXCEPTION;
+	this->m_Data = static_cast<unsigned char*>(lData);
+#else
+	// reserve one chunk more than needed so the chunks can start on a chunk boundary (huge pages must be aligned)
+	const std::size_t lMappingSize = lReservedSize + lChunkSize;
+	void* const lMapping = mmap(nullptr, lMappingSize, PROT_NONE, MAP_PRIVATE | MAP_ANONYMOUS | MAP_NORESERVE, -1, 0);
+	if (lMapping == MAP_FAILED) throw ChunkedMemory::RESERVE_EXCEPTION;
+
+	this->m_Mapping = static_cast<unsigned char*>(lMapping);
+	this->m_MappingSize = lMappingSize;
+	const std::uintptr_t lAddress = reinterpret_cast<std::uintptr_t>(lMapping);
+	this->m_Data = this->m_Mapping + ((lChunkSize - lAddress % lChunkSize) % lChunkSize);
+#endif
+
+	this->m_ReservedSize = lReservedSize;
+	this->m_CommittedSize = 0;
+	this->m_ChunkSize = lChunkSize;
+	this->m_UseHugePages = aUseHugePages;
+}
+
+/** Commits the chunks holding the first aSize bytes. Chunks that are already committed are unchanged.
+* @param aSize The number of bytes (at most the reserved size)
+*/
+void ChunkedMemory::commit(const std::size_t aSize)
+{
+	if (aSize > this->m_ReservedSize) throw ChunkedMemory::COMMIT_EXCEPTION;
+
+	while (this->m_CommittedSize < aSize)
+	{
+		unsigned char* const lChunk = this->m_Data + this->m_CommittedSize;
+#ifdef _WIN32
+		if (VirtualAlloc(lChunk, this->m_ChunkSize, MEM_COMMIT, PAGE_READWRITE) == nullptr) throw ChunkedMemory::COMMIT_EXCEPTION;
+#else
+		if (mprotect(lChunk, this->m_ChunkSize, PROT_READ | PROT_WRITE) != 0) throw ChunkedMemory::COMMIT_EXCEPTION;
+#ifdef MADV_HUGEPAGE
+		// only advice: the chunk still works with ordinary pages if huge pages are not available
+		if (this->m_UseHugePages) madvise(lChunk, this->m_ChunkSize, MADV_HUGEPAGE);
+#endif
+#endif
+		this->m_CommittedSize += this->m_ChunkSize;
+	}
+}
+
+/** Releases the reserved memory (and everything in it)
+*/
+void ChunkedMemory::release()
+{
+#ifdef _WIN32
+	if (this->m_Data != nullptr) VirtualFree(this->m_Data, 0, MEM_RELEASE);
+#else
+	if (this->m_Mapping != nullptr) munmap(this->m_Mapping, this->m_MappingSize);
+	this->m_Mapping = nullptr;
+	this->m_MappingSize = 0;
+#endif
+	this->m_Data = nullptr;
+	this->m_ReservedSize = 0;
+	this->m_CommittedSize = 0;
+}
+
+/** Returns a pointer to the first byte
+*/
+unsigned char* ChunkedMemory::data()
+{
+	return this->m_Data;
+}
+
+/** Returns a pointer to the first byte
+*/
+const unsigned char* ChunkedMemory::data() const
+{
+	return this->m_Data;
+}
+
+/** Returns the number of bytes of address space reserved
+*/
+std::size_t ChunkedMemory::getReservedSize() const
+{
+	return this->m_ReservedSize;
+}
+
+/** Returns the number of bytes committed
+*/
+std::size_t ChunkedMemory::getCommittedSize() const
+{
+	return this->m_CommittedSize;
+}
+
+/** Returns the number of bytes committed at a time
+*/
+std::size_t ChunkedMemory::getChunkSize() const
+{
+	return this->m_ChunkSize;
+}
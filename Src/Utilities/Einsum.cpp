@@ -0,0 +1,178 @@
+/**
+*  @file    Einsum.cpp
+*  @author  Jordan Nesley
+**/
+
+#include "Einsum.h"
+#include <algorithm> // std::stable_sort, std::sort
+
+#pragma unmanaged
+
+const std::size_t EinsumPlan::MAXIMUM_NUMBER_OF_PARTIAL_RESULTS;
+
+/** Returns true for the letters that can name a dimension
+* @param aCharacter The character
+*/
+static bool IsEinsumIndex(const char aCharacter)
+{
+	return (aCharacter >= 'a' && aCharacter <= 'z') || (aCharacter >= 'A' && aCharacter <= 'Z');
+}
+
+/** Constructor for EinsumPlan: checks the specification against the shapes of the operands and orders the loops
+* @param aSpecification The letters of every dimension of the operands separated by commas, optionally followed by "->"
+* and the letters of the result (e.g. "ij,jk->ik"). Spaces are ignored.
+* @param aOperandDimLengths The length of every dimension of every operand
+*/
+EinsumPlan::EinsumPlan(const std::string& aSpecification, const std::vector<std::vector<std::size_t>>& aOperandDimLengths)
+{
+	std::string lSpecification;
+	for (std::size_t lCount = 0; lCount < aSpecification.size(); lCount++)
+	{
+		if (aSpecification[lCount] != ' ') lSpecification.push_back(aSpecification[lCount]);
+	}
+
+	// split the specification into the operands and the result
+	const std::size_t lArrow = lSpecification.find("->");
+	const std::string lInputs = lSpecification.substr(0, lArrow);
+	std::vector<std::string> lOperandIndices(1);
+	for (std::size_t lCount = 0; lCount < lInputs.size(); lCount++)
+	{
+		if (lInputs[lCount] == ',') lOperandIndices.push_back(std::string());
+		else if (IsEinsumIndex(lInputs[lCount])) lOperandIndices.back().push_back(lInputs[lCount]);
+		else throw EinsumPlan::SPECIFICATION_EXCEPTION;
+	}
+	if (lOperandIndices.size() != aOperandDimLengths.size()) throw EinsumPlan::NUMBER_OF_OPERANDS_EXCEPTION;
+	this->m_NumberOfOperands = lOperandIndices.size();
+
+	// the length of every letter (the same in every operand that uses it) and the letters in order of appearance
+	std::string lIndices;
+	std::vector<std::size_t> lIndexLengths;
+	std::vector<unsigned> lNumberOfUses;
+	for (std::size_t lOperand = 0; lOperand < this->m_NumberOfOperands; lOperand++)
+	{
+		const std::string& lLetters = lOperandIndices[lOperand];
+		if (lLetters.size() != aOperandDimLengths[lOperand].size()) throw EinsumPlan::DIMENSIONS_DONT_MATCH;
+
+		for (std::size_t lDim = 0; lDim < lLetters.size(); lDim++)
+		{
+			const std::size_t lIndex = lIndices.find(lLetters[lDim]);
+			if (lIndex == std::string::npos)
+			{
+				lIndices.push_back(lLetters[lDim]);
+				lIndexLengths.push_back(aOperandDimLengths[lOperand][lDim]);
+				lNumberOfUses.push_back(1);
+			}
+			else
+			{
+				if (lIndexLengths[lIndex] != aOperandDimLengths[lOperand][lDim]) throw EinsumPlan::DIMENSIONS_DONT_MATCH;
+				lNumberOfUses[lIndex]++;
+			}
+		}
+	}
+
+	// without "->" the result has the letters used once in alphabetical order
+	std::string lResultIndices;
+	if (lArrow == std::string::npos)
+	{
+		for (std::size_t lIndex = 0; lIndex < lIndices.size(); lIndex++)
+		{
+			if (lNumberOfUses[lIndex] == 1) lResultIndices.push_back(lIndices[lIndex]);
+		}
+		std::sort(lResultIndices.begin(), lResultIndices.end());
+	}
+	else
+	{
+		lResultIndices = lSpecification.substr(lArrow + 2);
+	}
+
+	this->m_ResultDimLengths.clear();
+	for (std::size_t lDim = 0; lDim < lResultIndices.size(); lDim++)
+	{
+		const std::size_t lIndex = lIndices.find(lResultIndices[lDim]);
+		if (!IsEinsumIndex(lResultIndices[lDim]) || lIndex == std::string::npos) throw EinsumPlan::SPECIFICATION_EXCEPTION;
+		if (lResultIndices.find(lResultIndices[lDim]) != lDim) throw EinsumPlan::SPECIFICATION_EXCEPTION;
+		this->m_ResultDimLengths.push_back(lIndexLengths[lIndex]);
+	}
+
+	// the stride of every letter in every operand (row major, a letter repeated in an operand adds its strides)
+	const std::size_t lNumberOfArrays = this->m_NumberOfOperands + 1;
+	std::vector<std::ptrdiff_t> lStrides(lIndices.size() * lNumberOfArrays, 0);
+	for (std::size_t lArray = 0; lArray < lNumberOfArrays; lArray++)
+	{
+		const std::string& lLetters = (lArray < this->m_NumberOfOperands) ? lOperandIndices[lArray] : lResultIndices;
+		std::ptrdiff_t lStride = 1;
+		for (std::size_t lDim = lLetters.size(); lDim > 0; lDim--)
+		{
+			const std::size_t lIndex = lIndices.find(lLetters[lDim - 1]);
+			lStrides[lIndex * lNumberOfArrays + lArray] += lStride;
+			lStride *= static_cast<std::ptrdiff_t>(lIndexLengths[lIndex]);
+		}
+	}
+
+	// order the loops so the largest strides are outermost (the innermost loop walks memory contiguously); of two
+	// loops with the same largest stride the longer one goes outside so the blocks of the outer loop are large
+	std::vector<std::size_t> lOrder(lIndices.size());
+	std::vector<std::ptrdiff_t> lLargestStrides(lIndices.size(), 0);
+	for (std::size_t lIndex = 0; lIndex < lIndices.size(); lIndex++)
+	{
+		lOrder[lIndex] = lIndex;
+		for (std::size_t lArray = 0; lArray < lNumberOfArrays; lArray++)
+		{
+			if (lStrides[lIndex * lNumberOfArrays + lArray] > lLargestStrides[lIndex]) lLargestStrides[lIndex] = lStrides[lIndex * lNumberOfArrays + lArray];
+		}
+	}
+	std::stable_sort(lOrder.begin(), lOrder.end(), [&lLargestStrides, &lIndexLengths](const std::size_t aLeft, const std::size_t aRight)
+	{
+		if (lLargestStrides[aLeft] != lLargestStrides[aRight]) return lLargestStrides[aLeft] > lLargestStrides[aRight];
+		return lIndexLengths[aLeft] > lIndexLengths[aRight];
+	});
+
+	this->m_LoopIndices.clear();
+	this->m_LoopLengths.clear();
+	this->m_Strides.clear();
+	this->m_TotalNumberOfProducts = 1;
+	for (std::size_t lLoop = 0; lLoop < lOrder.size(); lLoop++)
+	{
+		const std::size_t lIndex = lOrder[lLoop];
+		this->m_LoopIndices.push_back(lIndices[lIndex]);
+		this->m_LoopLengths.push_back(lIndexLengths[lIndex]);
+		this->m_Strides.insert(this->m_Strides.end(), lStrides.begin() + lIndex * lNumberOfArrays, lStrides.begin() + (lIndex + 1) * lNumberOfArrays);
+		this->m_TotalNumberOfProducts *= lIndexLengths[lIndex];
+	}
+
+	this->m_ResultSize = 1;
+	for (std::size_t lDim = 0; lDim < this->m_ResultDimLengths.size(); lDim++)
+	{
+		this->m_ResultSize *= this->m_ResultDimLengths[lDim];
+	}
+
+	this->m_IsOuterLoopSummed = !this->m_LoopIndices.empty() && lResultIndices.find(this->m_LoopIndices[0]) == std::string::npos;
+}
+
+/** Returns the number of operands of the specification
+*/
+std::size_t EinsumPlan::getNumberOfOperands() const
+{
+	return this->m_NumberOfOperands;
+}
+
+/** Returns the length of every dimension of the result (empty for a single number)
+*/
+const std::vector<std::size_t>& EinsumPlan::getResultDimLengths() const
+{
+	return this->m_ResultDimLengths;
+}
+
+/** Returns the number of elements of the result
+*/
+std::size_t EinsumPlan::getResultSize() const
+{
+	return this->m_ResultSize;
+}
+
+/** Returns the letters of the loops, outermost first
+*/
+const std::string& EinsumPlan::getLoopOrder() const
+{
+	return this->m_LoopIndices;
+}
@@ -0,0 +1,162 @@
+/**
+*  @file    KDTree.cpp
+*  @author  Jordan Nesley
+**/
+
+#include "KDTree.h"
+
+#pragma unmanaged
+
+/** Default constructor for KDTree
+*/
+KDTree::KDTree()
+{
+	this->m_NumberOfDimensions = 0;
+	this->m_NumberOfPoints = 0;
+	this->m_Points = std::vector<double>();
+	this->m_Nodes = std::vector<KDNode>();
+	this->m_Root = -1;
+}
+
+/** Constructor for KDTree. Builds the tree in O(N log N).
+* @param aPoints All the points stored one after another (point i is at aPoints[i*aNumberOfDimensions])
+* @param aNumberOfDimensions The number of dimensions of each point
+*/
+KDTree::KDTree(const std::vector<double>& aPoints, const unsigned aNumberOfDimensions)
+{
+	if (aNumberOfDimensions == 0 || aPoints.size() % aNumberOfDimensions != 0) throw KDTree::DIMENSIONS_DONT_MATCH;
+
+	this->m_NumberOfDimensions = aNumberOfDimensions;
+	this->m_NumberOfPoints = aPoints.size() / aNumberOfDimensions;
+	this->m_Points = aPoints;
+	this->m_Nodes = std::vector<KDNode>();
+	this->m_Nodes.reserve(this->m_NumberOfPoints);
+
+	std::vector<unsigned> lIndices(this->m_NumberOfPoints);
+	for (unsigned lCount = 0; lCount < lIndices.size(); lCount++)
+	{
+		lIndices[lCount] = lCount;
+	}
+
+	this->m_Root = this->build(lIndices, 0, this->m_NumberOfPoints, 0);
+}
+
+/** Recursively builds a sub tree by splitting the points at the median of the current axis
+* @param aIndices The point indices (will be reordered)
+* @param aStart The first index of the sub tree in aIndices
+* @param aEnd One past the last index of the sub tree in aIndices
+* @param aDepth The depth of the sub tree
+* @return The node index of the sub tree root (-1 if the sub tree is empty)
+*/
+int KDTree::build(std::vector<unsigned>& aIndices, const unsigned aStart, const unsigned aEnd, const unsigned aDepth)
+{
+	if (aStart >= aEnd) return -1;
+
+	unsigned lAxis = aDepth % this->m_NumberOfDimensions;
+	unsigned lMedian = aStart + (aEnd - aStart) / 2;
+
+	const std::vector<double>& lPoints = this->m_Points;
+	const unsigned lDimensions = this->m_NumberOfDimensions;
+	std::nth_element(aIndices.begin() + aStart, aIndices.begin() + lMedian, aIndices.begin() + aEnd,
+		[&lPoints, lDimensions, lAxis](const unsigned a, const unsigned b)->bool {return lPoints[a*lDimensions + lAxis] < lPoints[b*lDimensions + lAxis]; });
+
+	int lNodeIndex = this->m_Nodes.size();
+	this->m_Nodes.push_back({ aIndices[lMedian], lAxis, -1, -1 });
+
+	int lLeft = this->build(aIndices, aStart, lMedian, aDepth + 1);
+	int lRight = this->build(aIndices, lMedian + 1, aEnd, aDepth + 1);
+	this->m_Nodes[lNodeIndex].Left = lLeft;
+	this->m_Nodes[lNodeIndex].Right = lRight;
+
+	return lNodeIndex;
+}
+
+/** Returns the number of points in the tree
+*/
+unsigned KDTree::getNumberOfPoints() const
+{
+	return this->m_NumberOfPoints;
+}
+
+/** Returns the number of dimensions of each point
+*/
+unsigned KDTree::getNumberOfDimensions() const
+{
+	return this->m_NumberOfDimensions;
+}
+
+/** Calculates the euclidean distance between two points in the tree
+* @param aPointIndex1 The index of the first point
+* @param aPointIndex2 The index of the second point
+* @return The distance
+*/
+double KDTree::distance(const unsigned aPointIndex1, const unsigned aPointIndex2) const
+{
+	return sqrt(this->distanceSquared(aPointIndex1, &this->m_Points[aPointIndex2 * this->m_NumberOfDimensions]));
+}
+
+/** Finds all the points within a radius of a point in the tree (the point itself is included)
+* @param aPointIndex The index of the point to search around
+* @param aRadius The search radius
+* @return The indices of the points found
+*/
+std::vector<unsigned> KDTree::radiusSearch(const unsigned aPointIndex, const double aRadius) const
+{
+	std::vector<unsigned> lResult;
+	if (aPointIndex >= this->m_NumberOfPoints) return lResult;
+
+	this->radiusSearch(this->m_Root, &this->m_Points[aPointIndex * this->m_NumberOfDimensions], aRadius*aRadius, lResult);
+	return lResult;
+}
+
+/** Finds all the points within a radius of an arbitrary point
+* @param aPoint The point to search around
+* @param aRadius The search radius
+* @return The indices of the points found
+*/
+std::vector<unsigned> KDTree::radiusSearch(const std::vector<double>& aPoint, const double aRadius) const
+{
+	if (aPoint.size() != this->m_NumberOfDimensions) throw KDTree::DIMENSIONS_DONT_MATCH;
+
+	std::vector<unsigned> lResult;
+	this->radiusSearch(this->m_Root, aPoint.data(), aRadius*aRadius, lResult);
+	return lResult;
+}
+
+/** Recursive radius search. Only visits the far side of a split when the split plane is inside the radius.
+* @param aNode The node of the sub tree to search
+* @param aPoint The point to search around
+* @param aRadiusSquared The search radius squared
+* @param aResult Found point indices are appended to this array
+*/
+void KDTree::radiusSearch(const int aNode, const double* const aPoint, const double aRadiusSquared, std::vector<unsigned>& aResult) const
+{
+	if (aNode < 0) return;
+
+	const KDNode& lNode = this->m_Nodes[aNode];
+	if (this->distanceSquared(lNode.Point, aPoint) <= aRadiusSquared) aResult.push_back(lNode.Point);
+
+	double lDelta = aPoint[lNode.Axis] - this->m_Points[lNode.Point * this->m_NumberOfDimensions + lNode.Axis];
+	int lNear = (lDelta <= 0.0) ? lNode.Left : lNode.Right;
+	int lFar = (lDelta <= 0.0) ? lNode.Right : lNode.Left;
+
+	this->radiusSearch(lNear, aPoint, aRadiusSquared, aResult);
+	if (lDelta*lDelta <= aRadiusSquared) this->radiusSearch(lFar, aPoint, aRadiusSquared, aResult);
+}
+
+/** Calculates the squared distance between a point in the tree and an arbitrary point
+* @param aPointIndex The index of the point in the tree
+* @param aPoint The other point
+* @return The squared distance
+*/
+double KDTree::distanceSquared(const unsigned aPointIndex, const double* const aPoint) const
+{
+	const double* lPoint = &this->m_Points[aPointIndex * this->m_NumberOfDimensions];
+	double lResult = 0.0;
+	for (unsigned lCount = 0; lCount < this->m_NumberOfDimensions; lCount++)
+	{
+		double lDelta = lPoint[lCount] - aPoint[lCount];
+		lResult += lDelta*lDelta;
+	}
+	return lResult;
+}
@@ -0,0 +1,670 @@
+/**
+*  @file    LinearAlgebra.cpp
+*  @author  Jordan Nesley
+**/
+
+#include "LinearAlgebra.h"
+#include "MultidimensionalArray.h"
+#include <algorithm> // std::min, std::fill
+
+#if defined(__AVX512F__) || defined(__AVX2__)
+#include <immintrin.h>
+#endif
+
+// MSVC does not define __FMA__ but every processor with AVX2 has FMA
+#if defined(__FMA__) || defined(_MSC_VER)
+#define LINEARALGEBRA_FMA256(a, b, c) _mm256_fmadd_pd(a, b, c)
+#else
+#define LINEARALGEBRA_FMA256(a, b, c) _mm256_add_pd(_mm256_mul_pd(a, b), c)
+#endif
+
+#pragma unmanaged
+
+const std::size_t LinearAlgebra::COLUMN_BLOCK;
+const std::size_t LinearAlgebra::ROW_BLOCK;
+const std::size_t LinearAlgebra::DEPTH_BLOCK;
+const std::size_t LinearAlgebra::GEMM_COLUMN_BLOCK;
+
+/** Returns the sum of the products of the elements of two vectors
+* @param aLeft The first vector
+* @param aRight The second vector
+* @param aLength The length of the vectors
+*/
+double LinearAlgebra::dot(const double* const aLeft, const double* const aRight, const std::size_t aLength)
+{
+	std::size_t lCount = 0;
+	double lResult = 0.0;
+
+#if defined(__AVX512F__)
+	__m512d lSum0 = _mm512_setzero_pd();
+	__m512d lSum1 = _mm512_setzero_pd();
+	for (; lCount + 16 <= aLength; lCount += 16)
+	{
+		lSum0 = _mm512_fmadd_pd(_mm512_loadu_pd(aLeft + lCount), _mm512_loadu_pd(aRight + lCount), lSum0);
+		lSum1 = _mm512_fmadd_pd(_mm512_loadu_pd(aLeft + lCount + 8), _mm512_loadu_pd(aRight + lCount + 8), lSum1);
+	}
+	lResult = _mm512_reduce_add_pd(_mm512_add_pd(lSum0, lSum1));
+#elif defined(__AVX2__)
+	__m256d lSum0 = _mm256_setzero_pd();
+	__m256d lSum1 = _mm256_setzero_pd();
+	for (; lCount + 8 <= aLength; lCount += 8)
+	{
+		lSum0 = LINEARALGEBRA_FMA256(_mm256_loadu_pd(aLeft + lCount), _mm256_loadu_pd(aRight + lCount), lSum0);
+		lSum1 = LINEARALGEBRA_FMA256(_mm256_loadu_pd(aLeft + lCount + 4), _mm256_loadu_pd(aRight + lCount + 4), lSum1);
+	}
+	__m256d lSum = _mm256_add_pd(lSum0, lSum1);
+	__m128d lHalf = _mm_add_pd(_mm256_castpd256_pd128(lSum), _mm256_extractf128_pd(lSum, 1));
+	lResult = _mm_cvtsd_f64(_mm_add_sd(lHalf, _mm_unpackhi_pd(lHalf, lHalf)));
+#else
+	// four independent sums so the additions don't wait on each other
+	double lSum[4] = { 0.0, 0.0, 0.0, 0.0 };
+	for (; lCount + 4 <= aLength; lCount += 4)
+	{
+		lSum[0] += aLeft[lCount] * aRight[lCount];
+		lSum[1] += aLeft[lCount + 1] * aRight[lCount + 1];
+		lSum[2] += aLeft[lCount + 2] * aRight[lCount + 2];
+		lSum[3] += aLeft[lCount + 3] * aRight[lCount + 3];
+	}
+	lResult = (lSum[0] + lSum[1]) + (lSum[2] + lSum[3]);
+#endif
+
+	for (; lCount < aLength; lCount++)
+	{
+		lResult += aLeft[lCount] * aRight[lCount];
+	}
+	return lResult;
+}
+
+/** Adds a scaled vector to another vector (aResult = aResult + aScale * aVector)
+* @param aScale The scale
+* @param aVector The vector to scale
+* @param aResult The vector that is added to
+* @param aLength The length of the vectors
+*/
+void LinearAlgebra::axpy(const double aScale, const double* const aVector, double* const aResult, const std::size_t aLength)
+{
+	std::size_t lCount = 0;
+
+#if defined(__AVX512F__)
+	const __m512d lScale = _mm512_set1_pd(aScale);
+	for (; lCount + 8 <= aLength; lCount += 8)
+	{
+		_mm512_storeu_pd(aResult + lCount, _mm512_fmadd_pd(lScale, _mm512_loadu_pd(aVector + lCount), _mm512_loadu_pd(aResult + lCount)));
+	}
+#elif defined(__AVX2__)
+	const __m256d lScale = _mm256_set1_pd(aScale);
+	for (; lCount + 4 <= aLength; lCount += 4)
+	{
+		_mm256_storeu_pd(aResult + lCount, LINEARALGEBRA_FMA256(lScale, _mm256_loadu_pd(aVector + lCount), _mm256_loadu_pd(aResult + lCount)));
+	}
+#endif
+
+	for (; lCount < aLength; lCount++)
+	{
+		aResult[lCount] += aScale * aVector[lCount];
+	}
+}
+
+/** Matrix-vector product: aResult = aMatrix * aVector
+* @param aMatrix The row major matrix (aNumberOfRows x aNumberOfColumns)
+* @param aNumberOfRows The number of rows of the matrix (the length of aResult)
+* @param aNumberOfColumns The number of columns of the matrix (the length of aVector)
+* @param aVector The vector
+* @param aResult Will be returned with the product (must not overlap aVector)
+*/
+void LinearAlgebra::Gemv(const double* const aMatrix, const std::size_t aNumberOfRows, const std::size_t aNumberOfColumns, const double* const aVector, double* const aResult)
+{
+	std::fill(aResult, aResult + aNumberOfRows, 0.0);
+
+	// block the columns so the part of aVector being used stays in cache while every row is processed
+	for (std::size_t lColumnStart = 0; lColumnStart < aNumberOfColumns; lColumnStart += COLUMN_BLOCK)
+	{
+		const std::size_t lLength = std::min(COLUMN_BLOCK, aNumberOfColumns - lColumnStart);
+		for (std::size_t lRow = 0; lRow < aNumberOfRows; lRow++)
+		{
+			aResult[lRow] += dot(aMatrix + lRow * aNumberOfColumns + lColumnStart, aVector + lColumnStart, lLength);
+		}
+	}
+}
+
+/** Transposed matrix-vector product: aResult = transpose(aMatrix) * aVector.
+* Calculated as a sum of scaled rows so the matrix is read in memory order.
+* @param aMatrix The row major matrix (aNumberOfRows x aNumberOfColumns)
+* @param aNumberOfRows The number of rows of the matrix (the length of aVector)
+* @param aNumberOfColumns The number of columns of the matrix (the length of aResult)
+* @param aVector The vector
+* @param aResult Will be returned with the product (must not overlap aVector)
+*/
+void LinearAlgebra::GemvTransposed(const double* const aMatrix, const std::size_t aNumberOfRows, const std::size_t aNumberOfColumns, const double* const aVector, double* const aResult)
+{
+	std::fill(aResult, aResult + aNumberOfColumns, 0.0);
+
+	// block the columns so the part of aResult being accumulated stays in cache while every row is processed
+	for (std::size_t lColumnStart = 0; lColumnStart < aNumberOfColumns; lColumnStart += COLUMN_BLOCK)
+	{
+		const std::size_t lLength = std::min(COLUMN_BLOCK, aNumberOfColumns - lColumnStart);
+		for (std::size_t lRow = 0; lRow < aNumberOfRows; lRow++)
+		{
+			axpy(aVector[lRow], aMatrix + lRow * aNumberOfColumns + lColumnStart, aResult + lColumnStart, lLength);
+		}
+	}
+}
+
+/** Matrix-matrix product: aResult = aLeft * aRight
+* @param aLeft The row major left matrix (aNumberOfRows x aDepth)
+* @param aRight The row major right matrix (aDepth x aNumberOfColumns)
+* @param aResult Will be returned with the row major product (aNumberOfRows x aNumberOfColumns, must not overlap the inputs)
+*/
+void LinearAlgebra::Gemm(const double* const aLeft, const double* const aRight, double* const aResult, const std::size_t aNumberOfRows, const std::size_t aDepth, const std::size_t aNumberOfColumns)
+{
+	std::fill(aResult, aResult + aNumberOfRows * aNumberOfColumns, 0.0);
+
+	for (std::size_t lColumnStart = 0; lColumnStart < aNumberOfColumns; lColumnStart += GEMM_COLUMN_BLOCK)
+	{
+		const std::size_t lColumnLength = std::min(GEMM_COLUMN_BLOCK, aNumberOfColumns - lColumnStart);
+		for (std::size_t lDepthStart = 0; lDepthStart < aDepth; lDepthStart += DEPTH_BLOCK)
+		{
+			// this panel of aRight is reused by every row of aLeft
+			const std::size_t lDepthEnd = std::min(lDepthStart + DEPTH_BLOCK, aDepth);
+			for (std::size_t lRow = 0; lRow < aNumberOfRows; lRow++)
+			{
+				double* const lResultRow = aResult + lRow * aNumberOfColumns + lColumnStart;
+				for (std::size_t lCountK = lDepthStart; lCountK < lDepthEnd; lCountK++)
+				{
+					axpy(aLeft[lRow * aDepth + lCountK], aRight + lCountK * aNumberOfColumns + lColumnStart, lResultRow, lColumnLength);
+				}
+			}
+		}
+	}
+}
+
+/** Multiplies one matrix by many vectors.
+* @param aMatrix The row major matrix (aNumberOfRows x aNumberOfColumns)
+* @param aVectors The vectors stored one after another
+* @param aResults Will be returned with the products stored one after another
+* @param aNumberOfVectors The number of vectors
+* @param aTransposed If false each result is aMatrix * vector (vectors have aNumberOfColumns elements, results aNumberOfRows).
+* If true each result is transpose(aMatrix) * vector (vectors have aNumberOfRows elements, results aNumberOfColumns).
+*/
+void LinearAlgebra::BatchedGemv(const double* const aMatrix, const std::size_t aNumberOfRows, const std::size_t aNumberOfColumns, const double* const aVectors, double* const aResults, const std::size_t aNumberOfVectors, const bool aTransposed)
+{
+	if (aTransposed)
+	{
+		// the results are the rows of (vectors * aMatrix)
+		Gemm(aVectors, aMatrix, aResults, aNumberOfVectors, aNumberOfRows, aNumberOfColumns);
+		return;
+	}
+
+	// process a block of rows of the matrix for every vector before moving to the next block so the block stays in cache
+	for (std::size_t lRowStart = 0; lRowStart < aNumberOfRows; lRowStart += ROW_BLOCK)
+	{
+		const std::size_t lRowEnd = std::min(lRowStart + ROW_BLOCK, aNumberOfRows);
+		for (std::size_t lVector = 0; lVector < aNumberOfVectors; lVector++)
+		{
+			const double* const lVectorStart = aVectors + lVector * aNumberOfColumns;
+			for (std::size_t lRow = lRowStart; lRow < lRowEnd; lRow++)
+			{
+				aResults[lVector * aNumberOfRows + lRow] = dot(aMatrix + lRow * aNumberOfColumns, lVectorStart, aNumberOfColumns);
+			}
+		}
+	}
+}
+
+/** Element-wise product of two vectors (aResult may be the same as aLeft or aRight)
+* @param aLength The length of the vectors
+*/
+void LinearAlgebra::Multiply(const double* const aLeft, const double* const aRight, double* const aResult, const std::size_t aLength)
+{
+	std::size_t lCount = 0;
+
+#if defined(__AVX512F__)
+	for (; lCount + 8 <= aLength; lCount += 8)
+	{
+		_mm512_storeu_pd(aResult + lCount, _mm512_mul_pd(_mm512_loadu_pd(aLeft + lCount), _mm512_loadu_pd(aRight + lCount)));
+	}
+#elif defined(__AVX2__)
+	for (; lCount + 4 <= aLength; lCount += 4)
+	{
+		_mm256_storeu_pd(aResult + lCount, _mm256_mul_pd(_mm256_loadu_pd(aLeft + lCount), _mm256_loadu_pd(aRight + lCount)));
+	}
+#endif
+
+	for (; lCount < aLength; lCount++)
+	{
+		aResult[lCount] = aLeft[lCount] * aRight[lCount];
+	}
+}
+
+/** Matrix-vector product: returns aMatrix * aVector
+* @param aMatrix A two dimensional array
+* @param aVector A vector with one element for each column of aMatrix
+*/
+std::vector<double> LinearAlgebra::Gemv(const MultidimensionalArray<double>& aMatrix, const std::vector<double>& aVector)
+{
+	if (aMatrix.getNumberOfDimensions() != 2 || aMatrix.getNumberOfElementsOfDimension(1) != aVector.size()) throw LinearAlgebra::DIMENSIONS_DONT_MATCH;
+
+	std::vector<double> lResult(aMatrix.getNumberOfElementsOfDimension(0));
+	Gemv(aMatrix.data(), aMatrix.getNumberOfElementsOfDimension(0), aMatrix.getNumberOfElementsOfDimension(1), aVector.data(), lResult.data());
+	return lResult;
+}
+
+/** Transposed matrix-vector product: returns transpose(aMatrix) * aVector
+* @param aMatrix A two dimensional array
+* @param aVector A vector with one element for each row of aMatrix
+*/
+std::vector<double> LinearAlgebra::GemvTransposed(const MultidimensionalArray<double>& aMatrix, const std::vector<double>& aVector)
+{
+	if (aMatrix.getNumberOfDimensions() != 2 || aMatrix.getNumberOfElementsOfDimension(0) != aVector.size()) throw LinearAlgebra::DIMENSIONS_DONT_MATCH;
+
+	std::vector<double> lResult(aMatrix.getNumberOfElementsOfDimension(1));
+	GemvTransposed(aMatrix.data(), aMatrix.getNumberOfElementsOfDimension(0), aMatrix.getNumberOfElementsOfDimension(1), aVector.data(), lResult.data());
+	return lResult;
+}
+
+/** Matrix-matrix product: returns aLeft * aRight
+* @param aLeft A two dimensional array
+* @param aRight A two dimensional array with as many rows as aLeft has columns
+*/
+MultidimensionalArray<double> LinearAlgebra::Gemm(const MultidimensionalArray<double>& aLeft, const MultidimensionalArray<double>& aRight)
+{
+	if (aLeft.getNumberOfDimensions() != 2 || aRight.getNumberOfDimensions() != 2) throw LinearAlgebra::DIMENSIONS_DONT_MATCH;
+	if (aLeft.getNumberOfElementsOfDimension(1) != aRight.getNumberOfElementsOfDimension(0)) throw LinearAlgebra::DIMENSIONS_DONT_MATCH;
+
+	MultidimensionalArray<double> lResult(2, { aLeft.getNumberOfElementsOfDimension(0), aRight.getNumberOfElementsOfDimension(1) });
+	Gemm(aLeft.data(), aRight.data(), lResult.data(), aLeft.getNumberOfElementsOfDimension(0), aLeft.getNumberOfElementsOfDimension(1), aRight.getNumberOfElementsOfDimension(1));
+	return lResult;
+}
+
+/** Multiplies one matrix by many vectors
+* @param aMatrix A two dimensional array
+* @param aVectors A two dimensional array with one vector in each row
+* @param aTransposed If true multiply by the transpose of aMatrix
+* @return A two dimensional array with one result in each row
+*/
+MultidimensionalArray<double> LinearAlgebra::BatchedGemv(const MultidimensionalArray<double>& aMatrix, const MultidimensionalArray<double>& aVectors, const bool aTransposed)
+{
+	if (aMatrix.getNumberOfDimensions() != 2 || aVectors.getNumberOfDimensions() != 2) throw LinearAlgebra::DIMENSIONS_DONT_MATCH;
+
+	const std::size_t lNumberOfRows = aMatrix.getNumberOfElementsOfDimension(0);
+	const std::size_t lNumberOfColumns = aMatrix.getNumberOfElementsOfDimension(1);
+	const std::size_t lNumberOfVectors = aVectors.getNumberOfElementsOfDimension(0);
+	if (aVectors.getNumberOfElementsOfDimension(1) != (aTransposed ? lNumberOfRows : lNumberOfColumns)) throw LinearAlgebra::DIMENSIONS_DONT_MATCH;
+
+	MultidimensionalArray<double> lResult(2, { lNumberOfVectors, aTransposed ? lNumberOfColumns : lNumberOfRows });
+	BatchedGemv(aMatrix.data(), lNumberOfRows, lNumberOfColumns, aVectors.data(), lResult.data(), lNumberOfVectors, aTransposed);
+	return lResult;
+}
+
+/** Returns the sum of the elements
+* @param aData The elements
+* @param aLength The number of elements
+*/
+template<>
+double LinearAlgebra::Sum<double>(const double* const aData, const std::size_t aLength)
+{
+	std::size_t lCount = 0;
+	double lResult = 0.0;
+
+#if defined(__AVX512F__)
+	__m512d lSum0 = _mm512_setzero_pd();
+	__m512d lSum1 = _mm512_setzero_pd();
+	for (; lCount + 16 <= aLength; lCount += 16)
+	{
+		lSum0 = _mm512_add_pd(lSum0, _mm512_loadu_pd(aData + lCount));
+		lSum1 = _mm512_add_pd(lSum1, _mm512_loadu_pd(aData + lCount + 8));
+	}
+	lResult = _mm512_reduce_add_pd(_mm512_add_pd(lSum0, lSum1));
+#elif defined(__AVX2__)
+	__m256d lSum0 = _mm256_setzero_pd();
+	__m256d lSum1 = _mm256_setzero_pd();
+	for (; lCount + 8 <= aLength; lCount += 8)
+	{
+		lSum0 = _mm256_add_pd(lSum0, _mm256_loadu_pd(aData + lCount));
+		lSum1 = _mm256_add_pd(lSum1, _mm256_loadu_pd(aData + lCount + 4));
+	}
+	__m256d lSum = _mm256_add_pd(lSum0, lSum1);
+	__m128d lHalf = _mm_add_pd(_mm256_castpd256_pd128(lSum), _mm256_extractf128_pd(lSum, 1));
+	lResult = _mm_cvtsd_f64(_mm_add_sd(lHalf, _mm_unpackhi_pd(lHalf, lHalf)));
+#else
+	double lSum[4] = { 0.0, 0.0, 0.0, 0.0 };
+	for (; lCount + 4 <= aLength; lCount += 4)
+	{
+		lSum[0] += aData[lCount];
+		lSum[1] += aData[lCount + 1];
+		lSum[2] += aData[lCount + 2];
+		lSum[3] += aData[lCount + 3];
+	}
+	lResult = (lSum[0] + lSum[1]) + (lSum[2] + lSum[3]);
+#endif
+
+	for (; lCount < aLength; lCount++)
+	{
+		lResult += aData[lCount];
+	}
+	return lResult;
+}
+
+/** Returns the smallest element (aLength must be greater than 0)
+* @param aData The elements
+* @param aLength The number of elements
+*/
+template<>
+double LinearAlgebra::Min<double>(const double* const aData, const std::size_t aLength)
+{
+	std::size_t lCount = 0;
+	double lResult = aData[0];
+
+#if defined(__AVX512F__)
+	if (aLength >= 8)
+	{
+		__m512d lMin = _mm512_loadu_pd(aData);
+		for (lCount = 8; lCount + 8 <= aLength; lCount += 8)
+		{
+			lMin = _mm512_min_pd(lMin, _mm512_loadu_pd(aData + lCount));
+		}
+		lResult = _mm512_reduce_min_pd(lMin);
+	}
+#elif defined(__AVX2__)
+	if (aLength >= 4)
+	{
+		__m256d lMin = _mm256_loadu_pd(aData);
+		for (lCount = 4; lCount + 4 <= aLength; lCount += 4)
+		{
+			lMin = _mm256_min_pd(lMin, _mm256_loadu_pd(aData + lCount));
+		}
+		__m128d lHalf = _mm_min_pd(_mm256_castpd256_pd128(lMin), _mm256_extractf128_pd(lMin, 1));
+		lResult = _mm_cvtsd_f64(_mm_min_sd(lHalf, _mm_unpackhi_pd(lHalf, lHalf)));
+	}
+#endif
+
+	for (; lCount < aLength; lCount++)
+	{
+		if (aData[lCount] < lResult) lResult = aData[lCount];
+	}
+	return lResult;
+}
+
+/** Returns the largest element (aLength must be greater than 0)
+* @param aData The elements
+* @param aLength The number of elements
+*/
+template<>
+double LinearAlgebra::Max<double>(const double* const aData, const std::size_t aLength)
+{
+	std::size_t lCount = 0;
+	double lResult = aData[0];
+
+#if defined(__AVX512F__)
+	if (aLength >= 8)
+	{
+		__m512d lMax = _mm512_loadu_pd(aData);
+		for (lCount = 8; lCount + 8 <= aLength; lCount += 8)
+		{
+			lMax = _mm512_max_pd(lMax, _mm512_loadu_pd(aData + lCount));
+		}
+		lResult = _mm512_reduce_max_pd(lMax);
+	}
+#elif defined(__AVX2__)
+	if (aLength >= 4)
+	{
+		__m256d lMax = _mm256_loadu_pd(aData);
+		for (lCount = 4; lCount + 4 <= aLength; lCount += 4)
+		{
+			lMax = _mm256_max_pd(lMax, _mm256_loadu_pd(aData + lCount));
+		}
+		__m128d lHalf = _mm_max_pd(_mm256_castpd256_pd128(lMax), _mm256_extractf128_pd(lMax, 1));
+		lResult = _mm_cvtsd_f64(_mm_max_sd(lHalf, _mm_unpackhi_pd(lHalf, lHalf)));
+	}
+#endif
+
+	for (; lCount < aLength; lCount++)
+	{
+		if (aData[lCount] > lResult) lResult = aData[lCount];
+	}
+	return lResult;
+}
+
+/** Returns the index of the first largest element (aLength must be greater than 0)
+* @param aData The elements
+* @param aLength The number of elements
+*/
+template<>
+std::size_t LinearAlgebra::ArgMax<double>(const double* const aData, const std::size_t aLength)
+{
+	// find the largest value with the vectorized Max then search for its first position
+	const double lMax = Max(aData, aLength);
+	for (std::size_t lCount = 0; lCount < aLength; lCount++)
+	{
+		if (aData[lCount] == lMax) return lCount;
+	}
+	return 0;
+}
+
+/** Returns the sum of the products of the elements of two vectors
+* @param aLength The length of the vectors
+*/
+template<>
+double LinearAlgebra::Dot<double>(const double* const aLeft, const double* const aRight, const std::size_t aLength)
+{
+	return dot(aLeft, aRight, aLength);
+}
+
+/** Adds a vector to another vector element-wise (aResult = aResult + aVector)
+* @param aLength The length of the vectors
+*/
+template<>
+void LinearAlgebra::AddTo<double>(const double* const aVector, double* const aResult, const std::size_t aLength)
+{
+	std::size_t lCount = 0;
+
+#if defined(__AVX512F__)
+	for (; lCount + 8 <= aLength; lCount += 8)
+	{
+		_mm512_storeu_pd(aResult + lCount, _mm512_add_pd(_mm512_loadu_pd(aResult + lCount), _mm512_loadu_pd(aVector + lCount)));
+	}
+#elif defined(__AVX2__)
+	for (; lCount + 4 <= aLength; lCount += 4)
+	{
+		_mm256_storeu_pd(aResult + lCount, _mm256_add_pd(_mm256_loadu_pd(aResult + lCount), _mm256_loadu_pd(aVector + lCount)));
+	}
+#endif
+
+	for (; lCount < aLength; lCount++)
+	{
+		aResult[lCount] += aVector[lCount];
+	}
+}
+
+/** Keeps the smaller of two elements element-wise (aResult = min(aResult, aVector))
+* @param aLength The length of the vectors
+*/
+template<>
+void LinearAlgebra::MinTo<double>(const double* const aVector, double* const aResult, const std::size_t aLength)
+{
+	std::size_t lCount = 0;
+
+#if defined(__AVX512F__)
+	for (; lCount + 8 <= aLength; lCount += 8)
+	{
+		_mm512_storeu_pd(aResult + lCount, _mm512_min_pd(_mm512_loadu_pd(aResult + lCount), _mm512_loadu_pd(aVector + lCount)));
+	}
+#elif defined(__AVX2__)
+	for (; lCount + 4 <= aLength; lCount += 4)
+	{
+		_mm256_storeu_pd(aResult + lCount, _mm256_min_pd(_mm256_loadu_pd(aResult + lCount), _mm256_loadu_pd(aVector + lCount)));
+	}
+#endif
+
+	for (; lCount < aLength; lCount++)
+	{
+		if (aVector[lCount] < aResult[lCount]) aResult[lCount] = aVector[lCount];
+	}
+}
+
+/** Keeps the larger of two elements element-wise (aResult = max(aResult, aVector))
+* @param aLength The length of the vectors
+*/
+template<>
+void LinearAlgebra::MaxTo<double>(const double* const aVector, double* const aResult, const std::size_t aLength)
+{
+	std::size_t lCount = 0;
+
+#if defined(__AVX512F__)
+	for (; lCount + 8 <= aLength; lCount += 8)
+	{
+		_mm512_storeu_pd(aResult + lCount, _mm512_max_pd(_mm512_loadu_pd(aResult + lCount), _mm512_loadu_pd(aVector + lCount)));
+	}
+#elif defined(__AVX2__)
+	for (; lCount + 4 <= aLength; lCount += 4)
+	{
+		_mm256_storeu_pd(aResult + lCount, _mm256_max_pd(_mm256_loadu_pd(aResult + lCount), _mm256_loadu_pd(aVector + lCount)));
+	}
+#endif
+
+	for (; lCount < aLength; lCount++)
+	{
+		if (aVector[lCount] > aResult[lCount]) aResult[lCount] = aVector[lCount];
+	}
+}
+
+/** Adds the element-wise product of two vectors to another vector (aResult = aResult + aLeft * aRight)
+* @param aLength The length of the vectors
+*/
+template<>
+void LinearAlgebra::MultiplyAddTo<double>(const double* const aLeft, const double* const aRight, double* const aResult, const std::size_t aLength)
+{
+	std::size_t lCount = 0;
+
+#if defined(__AVX512F__)
+	for (; lCount + 8 <= aLength; lCount += 8)
+	{
+		_mm512_storeu_pd(aResult + lCount, _mm512_fmadd_pd(_mm512_loadu_pd(aLeft + lCount), _mm512_loadu_pd(aRight + lCount), _mm512_loadu_pd(aResult + lCount)));
+	}
+#elif defined(__AVX2__)
+	for (; lCount + 4 <= aLength; lCount += 4)
+	{
+		_mm256_storeu_pd(aResult + lCount, LINEARALGEBRA_FMA256(_mm256_loadu_pd(aLeft + lCount), _mm256_loadu_pd(aRight + lCount), _mm256_loadu_pd(aResult + lCount)));
+	}
+#endif
+
+	for (; lCount < aLength; lCount++)
+	{
+		aResult[lCount] += aLeft[lCount] * aRight[lCount];
+	}
+}
+
+/** Multiplies every element by a scalar
+* @param aLength The number of elements
+*/
+template<>
+void LinearAlgebra::Scale<double>(const double aScale, double* const aData, const std::size_t aLength)
+{
+	std::size_t lCount = 0;
+
+#if defined(__AVX512F__)
+	const __m512d lScale = _mm512_set1_pd(aScale);
+	for (; lCount + 8 <= aLength; lCount += 8)
+	{
+		_mm512_storeu_pd(aData + lCount, _mm512_mul_pd(lScale, _mm512_loadu_pd(aData + lCount)));
+	}
+#elif defined(__AVX2__)
+	const __m256d lScale = _mm256_set1_pd(aScale);
+	for (; lCount + 4 <= aLength; lCount += 4)
+	{
+		_mm256_storeu_pd(aData + lCount, _mm256_mul_pd(lScale, _mm256_loadu_pd(aData + lCount)));
+	}
+#endif
+
+	for (; lCount < aLength; lCount++)
+	{
+		aData[lCount] *= aScale;
+	}
+}
+
+/** Returns the sum of the elements, accumulated in double
+* @param aData The elements
+* @param aLength The number of elements
+*/
+template<>
+float LinearAlgebra::Sum<float>(const float* const aData, const std::size_t aLength)
+{
+	std::size_t lCount = 0;
+	double lResult = 0.0;
+
+#if defined(__AVX512F__)
+	__m512d lSum0 = _mm512_setzero_pd();
+	__m512d lSum1 = _mm512_setzero_pd();
+	for (; lCount + 16 <= aLength; lCount += 16)
+	{
+		lSum0 = _mm512_add_pd(lSum0, _mm512_cvtps_pd(_mm256_loadu_ps(aData + lCount)));
+		lSum1 = _mm512_add_pd(lSum1, _mm512_cvtps_pd(_mm256_loadu_ps(aData + lCount + 8)));
+	}
+	lResult = _mm512_reduce_add_pd(_mm512_add_pd(lSum0, lSum1));
+#elif defined(__AVX2__)
+	__m256d lSum0 = _mm256_setzero_pd();
+	__m256d lSum1 = _mm256_setzero_pd();
+	for (; lCount + 8 <= aLength; lCount += 8)
+	{
+		const __m256 lData = _mm256_loadu_ps(aData + lCount);
+		lSum0 = _mm256_add_pd(lSum0, _mm256_cvtps_pd(_mm256_castps256_ps128(lData)));
+		lSum1 = _mm256_add_pd(lSum1, _mm256_cvtps_pd(_mm256_extractf128_ps(lData, 1)));
+	}
+	__m256d lSum = _mm256_add_pd(lSum0, lSum1);
+	__m128d lHalf = _mm_add_pd(_mm256_castpd256_pd128(lSum), _mm256_extractf128_pd(lSum, 1));
+	lResult = _mm_cvtsd_f64(_mm_add_sd(lHalf, _mm_unpackhi_pd(lHalf, lHalf)));
+#else
+	double lSum[4] = { 0.0, 0.0, 0.0, 0.0 };
+	for (; lCount + 4 <= aLength; lCount += 4)
+	{
+		lSum[0] += aData[lCount];
+		lSum[1] += aData[lCount + 1];
+		lSum[2] += aData[lCount + 2];
+		lSum[3] += aData[lCount + 3];
+	}
+	lResult = (lSum[0] + lSum[1]) + (lSum[2] + lSum[3]);
+#endif
+
+	for (; lCount < aLength; lCount++)
+	{
+		lResult += aData[lCount];
+	}
+	return static_cast<float>(lResult);
+}
+
+/** Returns the sum of the products of the elements of two vectors, accumulated in double
+* @param aLength The length of the vectors
+*/
+template<>
+float LinearAlgebra::Dot<float>(const float* const aLeft, const float* const aRight, const std::size_t aLength)
+{
+	std::size_t lCount = 0;
+	double lResult = 0.0;
+
+#if defined(__AVX512F__)
+	__m512d lSum = _mm512_setzero_pd();
+	for (; lCount + 8 <= aLength; lCount += 8)
+	{
+		lSum = _mm512_fmadd_pd(_mm512_cvtps_pd(_mm256_loadu_ps(aLeft + lCount)), _mm512_cvtps_pd(_mm256_loadu_ps(aRight + lCount)), lSum);
+	}
+	lResult = _mm512_reduce_add_pd(lSum);
+#elif defined(__AVX2__)
+	__m256d lSum0 = _mm256_setzero_pd();
+	__m256d lSum1 = _mm256_setzero_pd();
+	for (; lCount + 8 <= aLength; lCount += 8)
+	{
+		const __m256 lLeft = _mm256_loadu_ps(aLeft + lCount);
+		const __m256 lRight = _mm256_loadu_ps(aRight + lCount);
+		lSum0 = LINEARALGEBRA_FMA256(_mm256_cvtps_pd(_mm256_castps256_ps128(lLeft)), _mm256_cvtps_pd(_mm256_castps256_ps128(lRight)), lSum0);
+		lSum1 = LINEARALGEBRA_FMA256(_mm256_cvtps_pd(_mm256_extractf128_ps(lLeft, 1)), _mm256_cvtps_pd(_mm256_extractf128_ps(lRight, 1)), lSum1);
+	}
+	__m256d lSum = _mm256_add_pd(lSum0, lSum1);
+	__m128d lHalf = _mm_add_pd(_mm256_castpd256_pd128(lSum), _mm256_extractf128_pd(lSum, 1));
+	lResult = _mm_cvtsd_f64(_mm_add_sd(lHalf, _mm_unpackhi_pd(lHalf, lHalf)));
+#endif
+
+	for (; lCount < aLength; lCount++)
+	{
+		lResult += static_cast<double>(aLeft[lCount]) * static_cast<double>(aRight[lCount]);
+	}
+	return static_cast<float>(lResult);
+}
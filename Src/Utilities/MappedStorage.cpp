@@ -0,0 +1,348 @@
+/**
+*  @file    MappedStorage.cpp
+*  @author  Jordan Nesley
+**/
+
+#include "MappedStorage.h"
+#include "DebugLogger.h"
+#include <cstring> // std::memcpy
+#include <limits> // std::numeric_limits
+
+#ifdef _WIN32
+#define NOMINMAX
+#include <windows.h>
+#else
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
+#pragma unmanaged
+
+const std::uint32_t MappedArrayFormat::VERSION;
+const std::size_t MappedArrayFormat::ALIGNMENT;
+
+namespace
+{
+	const char MAGIC[8] = { 'M', 'Y', 'L', 'I', 'B', 'M', 'D', 'A' };
+
+	// magic, version, element type, element size, number of dimensions, data offset
+	const std::size_t FIXED_HEADER_SIZE = 8 + 4 * sizeof(std::uint32_t) + sizeof(std::uint64_t);
+}
+
+/** Default constructor for MappedFile (no file)
+*/
+MappedFile::MappedFile()
+{
+	this->m_Data = nullptr;
+	this->m_Size = 0;
+	this->m_Mode = MappedFile::READ_ONLY;
+#ifdef _WIN32
+	this->m_File = INVALID_HANDLE_VALUE;
+	this->m_Mapping = nullptr;
+#else
+	this->m_File = -1;
+#endif
+}
+
+/** Move Constructor for MappedFile
+* @param aMove The object to move
+*/
+MappedFile::MappedFile(MappedFile&& aMove)
+	: MappedFile()
+{
+	*this = std::move(aMove);
+}
+
+/** Destructor for MappedFile. Unmaps the file.
+*/
+MappedFile::~MappedFile()
+{
+	this->close();
+}
+
+/** Move assignment operator
+* @param aRight The right side of the = operator
+*/
+MappedFile& MappedFile::operator=(MappedFile&& aRight)
+{
+	if (this == &aRight) return *this;
+
+	this->close();
+	this->m_Data = aRight.m_Data;
+	this->m_Size = aRight.m_Size;
+	this->m_Mode = aRight.m_Mode;
+	this->m_File = aRight.m_File;
+#ifdef _WIN32
+	this->m_Mapping = aRight.m_Mapping;
+	aRight.m_File = INVALID_HANDLE_VALUE;
+	aRight.m_Mapping = nullptr;
+#else
+	aRight.m_File = -1;
+#endif
+	aRight.m_Data = nullptr;
+	aRight.m_Size = 0;
+	return *this;
+}
+
+/** Creates a file of aSize zero bytes (replacing any existing file) and maps it READ_WRITE
+* @param aPath The path of the file
+* @param aSize The size of the file in bytes
+*/
+void MappedFile::create(const std::string& aPath, const std::size_t aSize)
+{
+	this->close();
+	this->m_Mode = MappedFile::READ_WRITE;
+
+#ifdef _WIN32
+	this->m_File = CreateFileA(aPath.c_str(), GENERIC_READ | GENERIC_WRITE, FILE_SHARE_READ, nullptr, CREATE_ALWAYS, FILE_ATTRIBUTE_NORMAL, nullptr);
+	if (this->m_File == INVALID_HANDLE_VALUE)
+	{
+		DebugLogger::getInstance().logMessage(DebugLogger::MessageLoggerType::Error, __FUNCTION__, "Could not create the file");
+		throw MappedFile::OPEN_EXCEPTION;
+	}
+
+	// the mapping extends the file to aSize
+	const unsigned long long lSize = aSize;
+	this->m_Mapping = CreateFileMappingA(this->m_File, nullptr, PAGE_READWRITE, static_cast<DWORD>(lSize >> 32), static_cast<DWORD>(lSize), nullptr);
+	if (this->m_Mapping != nullptr) this->m_Data = static_cast<unsigned char*>(MapViewOfFile(this->m_Mapping, FILE_MAP_WRITE, 0, 0, aSize));
+#else
+	this->m_File = ::open(aPath.c_str(), O_RDWR | O_CREAT | O_TRUNC | O_CLOEXEC, 0644);
+	if (this->m_File < 0)
+	{
+		DebugLogger::getInstance().logMessage(DebugLogger::MessageLoggerType::Error, __FUNCTION__, "Could not create the file");
+		throw MappedFile::OPEN_EXCEPTION;
+	}
+
+	if (ftruncate(this->m_File, static_cast<off_t>(aSize)) == 0)
+	{
+		void* lData = mmap(nullptr, aSize, PROT_READ | PROT_WRITE, MAP_SHARED, this->m_File, 0);
+		if (lData != MAP_FAILED) this->m_Data = static_cast<unsigned char*>(lData);
+	}
+#endif
+
+	if (this->m_Data == nullptr)
+	{
+		this->close();
+		DebugLogger::getInstance().logMessage(DebugLogger::MessageLoggerType::Error, __FUNCTION__, "Could not map the file");
+		throw MappedFile::MAP_EXCEPTION;
+	}
+	this->m_Size = aSize;
+}
+
+/** Maps an existing file
+* @param aPath The path of the file
+* @param aMode READ_ONLY, READ_WRITE or COPY_ON_WRITE
+*/
+void MappedFile::open(const std::string& aPath, const Mode aMode)
+{
+	this->close();
+	this->m_Mode = aMode;
+
+#ifdef _WIN32
+	const DWORD lAccess = (aMode == MappedFile::READ_WRITE) ? (GENERIC_READ | GENERIC_WRITE) : GENERIC_READ;
+	this->m_File = CreateFileA(aPath.c_str(), lAccess, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+	if (this->m_File == INVALID_HANDLE_VALUE)
+	{
+		DebugLogger::getInstance().logMessage(DebugLogger::MessageLoggerType::Error, __FUNCTION__, "Could not open the file");
+		throw MappedFile::OPEN_EXCEPTION;
+	}
+
+	LARGE_INTEGER lSize;
+	if (GetFileSizeEx(this->m_File, &lSize) && lSize.QuadPart > 0)
+	{
+		const DWORD lProtection = (aMode == MappedFile::READ_WRITE) ? PAGE_READWRITE : (aMode == MappedFile::COPY_ON_WRITE) ? PAGE_WRITECOPY : PAGE_READONLY;
+		const DWORD lViewAccess = (aMode == MappedFile::READ_WRITE) ? FILE_MAP_WRITE : (aMode == MappedFile::COPY_ON_WRITE) ? FILE_MAP_COPY : FILE_MAP_READ;
+		this->m_Mapping = CreateFileMappingA(this->m_File, nullptr, lProtection, 0, 0, nullptr);
+		if (this->m_Mapping != nullptr) this->m_Data = static_cast<unsigned char*>(MapViewOfFile(this->m_Mapping, lViewAccess, 0, 0, 0));
+		this->m_Size = static_cast<std::size_t>(lSize.QuadPart);
+	}
+#else
+	this->m_File = ::open(aPath.c_str(), ((aMode == MappedFile::READ_WRITE) ? O_RDWR : O_RDONLY) | O_CLOEXEC);
+	if (this->m_File < 0)
+	{
+		DebugLogger::getInstance().logMessage(DebugLogger::MessageLoggerType::Error, __FUNCTION__, "Could not open the file");
+		throw MappedFile::OPEN_EXCEPTION;
+	}
+
+	struct stat lStat;
+	if (fstat(this->m_File, &lStat) == 0 && lStat.st_size > 0)
+	{
+		const int lProtection = (aMode == MappedFile::READ_ONLY) ? PROT_READ : (PROT_READ | PROT_WRITE);
+		const int lFlags = (aMode == MappedFile::COPY_ON_WRITE) ? MAP_PRIVATE : MAP_SHARED;
+		void* lData = mmap(nullptr, static_cast<std::size_t>(lStat.st_size), lProtection, lFlags, this->m_File, 0);
+		if (lData != MAP_FAILED) this->m_Data = static_cast<unsigned char*>(lData);
+		this->m_Size = static_cast<std::size_t>(lStat.st_size);
+	}
+#endif
+
+	if (this->m_Data == nullptr)
+	{
+		this->close();
+		DebugLogger::getInstance().logMessage(DebugLogger::MessageLoggerType::Error, __FUNCTION__, "Could not map the file");
+		throw MappedFile::MAP_EXCEPTION;
+	}
+}
+
+/** Unmaps and closes the file. Changes made READ_WRITE are kept, changes made COPY_ON_WRITE are thrown away.
+*/
+void MappedFile::close()
+{
+#ifdef _WIN32
+	if (this->m_Data != nullptr) UnmapViewOfFile(this->m_Data);
+	if (this->m_Mapping != nullptr) CloseHandle(this->m_Mapping);
+	if (this->m_File != INVALID_HANDLE_VALUE) CloseHandle(this->m_File);
+	this->m_Mapping = nullptr;
+	this->m_File = INVALID_HANDLE_VALUE;
+#else
+	if (this->m_Data != nullptr) munmap(this->m_Data, this->m_Size);
+	if (this->m_File >= 0) ::close(this->m_File);
+	this->m_File = -1;
+#endif
+	this->m_Data = nullptr;
+	this->m_Size = 0;
+}
+
+/** Writes the changed pages of a READ_WRITE mapping to the file
+*/
+void MappedFile::flush()
+{
+	if (this->m_Data == nullptr || this->m_Mode != MappedFile::READ_WRITE) return;
+
+#ifdef _WIN32
+	FlushViewOfFile(this->m_Data, 0);
+	FlushFileBuffers(this->m_File);
+#else
+	msync(this->m_Data, this->m_Size, MS_SYNC);
+#endif
+}
+
+/** Returns a pointer to the first byte of the file
+*/
+unsigned char* MappedFile::data()
+{
+	return this->m_Data;
+}
+
+/** Returns a pointer to the first byte of the file
+*/
+const unsigned char* MappedFile::data() const
+{
+	return this->m_Data;
+}
+
+/** Returns the size of the file in bytes
+*/
+std::size_t MappedFile::size() const
+{
+	return this->m_Size;
+}
+
+/** Returns the mode the file was mapped with
+*/
+MappedFile::Mode MappedFile::getMode() const
+{
+	return this->m_Mode;
+}
+
+/** Returns true if a file is mapped
+*/
+bool MappedFile::isOpen() const
+{
+	return this->m_Data != nullptr;
+}
+
+/** Calculates where the elements start in a file
+* @param aNumberOfDimensions The number of dimensions of the array
+* @return The offset in bytes from the start of the file
+*/
+std::size_t MappedArrayFormat::calculateDataOffset(const std::size_t aNumberOfDimensions)
+{
+	const std::size_t lHeaderSize = FIXED_HEADER_SIZE + aNumberOfDimensions * sizeof(std::uint64_t);
+	return (lHeaderSize + MappedArrayFormat::ALIGNMENT - 1) / MappedArrayFormat::ALIGNMENT * MappedArrayFormat::ALIGNMENT;
+}
+
+/** Writes the header at the start of a file
+* @param aFile A file mapped READ_WRITE that is big enough for the header
+* @param aElementType The type of the elements (see getElementType)
+* @param aElementSize The size of an element in bytes
+* @param aDimLengths The length of every dimension
+*/
+void MappedArrayFormat::writeHeader(MappedFile& aFile, const std::uint32_t aElementType, const std::uint32_t aElementSize, const std::vector<std::size_t>& aDimLengths)
+{
+	const std::uint32_t lNumberOfDimensions = static_cast<std::uint32_t>(aDimLengths.size());
+	const std::uint64_t lDataOffset = MappedArrayFormat::calculateDataOffset(aDimLengths.size());
+	if (aFile.size() < lDataOffset) throw MappedArrayFormat::FORMAT_EXCEPTION;
+
+	unsigned char* lPosition = aFile.data();
+	std::memcpy(lPosition, MAGIC, sizeof(MAGIC));
+	lPosition += sizeof(MAGIC);
+	std::memcpy(lPosition, &MappedArrayFormat::VERSION, sizeof(std::uint32_t));
+	lPosition += sizeof(std::uint32_t);
+	std::memcpy(lPosition, &aElementType, sizeof(std::uint32_t));
+	lPosition += sizeof(std::uint32_t);
+	std::memcpy(lPosition, &aElementSize, sizeof(std::uint32_t));
+	lPosition += sizeof(std::uint32_t);
+	std::memcpy(lPosition, &lNumberOfDimensions, sizeof(std::uint32_t));
+	lPosition += sizeof(std::uint32_t);
+	std::memcpy(lPosition, &lDataOffset, sizeof(std::uint64_t));
+	lPosition += sizeof(std::uint64_t);
+
+	for (std::uint32_t lCountDim = 0; lCountDim < lNumberOfDimensions; lCountDim++)
+	{
+		const std::uint64_t lLength = aDimLengths[lCountDim];
+		std::memcpy(lPosition, &lLength, sizeof(std::uint64_t));
+		lPosition += sizeof(std::uint64_t);
+	}
+}
+
+/** Reads and checks the header at the start of a file
+* @param aFile A mapped file
+* @param aElementType The type of elements expected (see getElementType)
+* @param aElementSize The size of an element expected in bytes
+* @param aDimLengths Will be returned with the length of every dimension
+* @return The offset in bytes from the start of the file to the elements
+*/
+std::size_t MappedArrayFormat::readHeader(const MappedFile& aFile, const std::uint32_t aElementType, const std::uint32_t aElementSize, std::vector<std::size_t>& aDimLengths)
+{
+	if (aFile.size() < FIXED_HEADER_SIZE || std::memcmp(aFile.data(), MAGIC, sizeof(MAGIC)) != 0) throw MappedArrayFormat::FORMAT_EXCEPTION;
+
+	std::uint32_t lVersion, lElementType, lElementSize, lNumberOfDimensions;
+	std::uint64_t lDataOffset;
+	const unsigned char* lPosition = aFile.data() + sizeof(MAGIC);
+	std::memcpy(&lVersion, lPosition, sizeof(std::uint32_t));
+	lPosition += sizeof(std::uint32_t);
+	std::memcpy(&lElementType, lPosition, sizeof(std::uint32_t));
+	lPosition += sizeof(std::uint32_t);
+	std::memcpy(&lElementSize, lPosition, sizeof(std::uint32_t));
+	lPosition += sizeof(std::uint32_t);
+	std::memcpy(&lNumberOfDimensions, lPosition, sizeof(std::uint32_t));
+	lPosition += sizeof(std::uint32_t);
+	std::memcpy(&lDataOffset, lPosition, sizeof(std::uint64_t));
+	lPosition += sizeof(std::uint64_t);
+
+	if (lVersion != MappedArrayFormat::VERSION) throw MappedArrayFormat::VERSION_EXCEPTION;
+	if (lElementType != aElementType || lElementSize != aElementSize) throw MappedArrayFormat::ELEMENT_TYPE_EXCEPTION;
+	if (FIXED_HEADER_SIZE + static_cast<std::uint64_t>(lNumberOfDimensions) * sizeof(std::uint64_t) > lDataOffset || lDataOffset > aFile.size()) throw MappedArrayFormat::FORMAT_EXCEPTION;
+	// the elements are used in place, so they must be aligned like the format promises (and T needs)
+	if (lDataOffset % MappedArrayFormat::ALIGNMENT != 0) throw MappedArrayFormat::FORMAT_EXCEPTION;
+
+	aDimLengths = std::vector<std::size_t>(lNumberOfDimensions);
+	std::uint64_t lTotalSize = aElementSize;
+	for (std::uint32_t lCountDim = 0; lCountDim < lNumberOfDimensions; lCountDim++)
+	{
+		std::uint64_t lLength;
+		std::memcpy(&lLength, lPosition, sizeof(std::uint64_t));
+		lPosition += sizeof(std::uint64_t);
+
+		// a dimension of a 32 bit process cannot be longer than 4G (even one of an empty array)
+		if (lLength > std::numeric_limits<std::size_t>::max()) throw MappedArrayFormat::FORMAT_EXCEPTION;
+		aDimLengths[lCountDim] = static_cast<std::size_t>(lLength);
+		if (lLength != 0 && lTotalSize > (aFile.size() - lDataOffset) / lLength) throw MappedArrayFormat::FORMAT_EXCEPTION;
+		lTotalSize = lTotalSize * lLength;
+	}
+	if (lTotalSize > aFile.size() - lDataOffset) throw MappedArrayFormat::FORMAT_EXCEPTION;
+
+	return static_cast<std::size_t>(lDataOffset);
+}
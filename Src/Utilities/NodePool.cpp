@@ -0,0 +1,95 @@
+/**
+*  @file    NodePool.cpp
+*  @author  Jordan Nesley
+**/
+
+#include "NodePool.h"
+
+#pragma unmanaged
+
+const std::size_t NodePool::INITIAL_SLAB_LENGTH;
+const std::size_t NodePool::MAXIMUM_SLAB_LENGTH;
+
+/** Constructor for NodePool (no slab is allocated until the first node)
+* @param aNodeSize The size of a node in bytes
+* @param aNodeAlignment The alignment of a node in bytes (at most alignof(std::max_align_t))
+*/
+NodePool::NodePool(const std::size_t aNodeSize, const std::size_t aNodeAlignment)
+{
+	// a free node holds the pointer to the next free node, and every node in a slab must stay aligned
+	const std::size_t lAlignment = (aNodeAlignment < alignof(FreeNode)) ? alignof(FreeNode) : aNodeAlignment;
+	const std::size_t lSize = (aNodeSize < sizeof(FreeNode)) ? sizeof(FreeNode) : aNodeSize;
+
+	this->m_FreeNodes = nullptr;
+	this->m_NumberOfFreeNodes = 0;
+	this->m_SlabPosition = nullptr;
+	this->m_SlabEnd = nullptr;
+	this->m_NodeSize = (lSize + lAlignment - 1) / lAlignment * lAlignment;
+	this->m_NextSlabLength = NodePool::INITIAL_SLAB_LENGTH;
+	this->m_Capacity = 0;
+}
+
+/** Destructor for NodePool: frees every slab (the nodes must already be destroyed)
+*/
+NodePool::~NodePool()
+{
+	for (std::size_t lCount = 0; lCount < this->m_Slabs.size(); lCount++)
+	{
+		::operator delete(this->m_Slabs[lCount]);
+	}
+}
+
+/** Returns the size of a node in bytes (rounded up to its alignment)
+*/
+std::size_t NodePool::getNodeSize() const
+{
+	return this->m_NodeSize;
+}
+
+/** Returns the number of slabs allocated so far
+*/
+std::size_t NodePool::getNumberOfSlabs() const
+{
+	return this->m_Slabs.size();
+}
+
+/** Returns the number of nodes the slabs allocated so far hold
+*/
+std::size_t NodePool::getCapacity() const
+{
+	return this->m_Capacity;
+}
+
+/** Makes sure the next aNumberOfNodes nodes can be allocated without allocating more than one slab
+* @param aNumberOfNodes The number of nodes
+*/
+void NodePool::reserve(const std::size_t aNumberOfNodes)
+{
+	const std::size_t lAvailable = this->m_NumberOfFreeNodes + static_cast<std::size_t>(this->m_SlabEnd - this->m_SlabPosition) / this->m_NodeSize;
+	if (lAvailable >= aNumberOfNodes) return;
+
+	// the rest of the current slab goes on the free list so it is not lost when the new slab is started
+	while (this->m_SlabPosition != this->m_SlabEnd)
+	{
+		this->deallocate(this->m_SlabPosition);
+		this->m_SlabPosition += this->m_NodeSize;
+	}
+	this->addSlab(aNumberOfNodes - lAvailable);
+}
+
+/** Allocates the next slab (twice as long as the last one up to MAXIMUM_SLAB_LENGTH nodes)
+* @param aMinimumLength The least number of nodes the slab must hold
+*/
+void NodePool::addSlab(const std::size_t aMinimumLength)
+{
+	const std::size_t lLength = (aMinimumLength > this->m_NextSlabLength) ? aMinimumLength : this->m_NextSlabLength;
+
+	this->m_Slabs.reserve(this->m_Slabs.size() + 1);
+	unsigned char* const lSlab = static_cast<unsigned char*>(::operator new(lLength * this->m_NodeSize));
+	this->m_Slabs.push_back(lSlab);
+
+	this->m_SlabPosition = lSlab;
+	this->m_SlabEnd = lSlab + lLength * this->m_NodeSize;
+	this->m_Capacity += lLength;
+	if (this->m_NextSlabLength < NodePool::MAXIMUM_SLAB_LENGTH) this->m_NextSlabLength *= 2;
+}
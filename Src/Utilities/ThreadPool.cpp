@@ -0,0 +1,183 @@
+/**
+*  @file    ThreadPool.cpp
+*  @author  Jordan Nesley
+**/
+
+#include "ThreadPool.h"
+
+#pragma unmanaged
+
+// true on a thread that is running a block of a parallelFor (a parallelFor inside a block runs on that thread)
+static thread_local bool sInsideParallelFor = false;
+
+/** Returns the only instance of the ThreadPool
+*/
+ThreadPool& ThreadPool::getInstance()
+{
+	// allocated and never deleted so no static destructor joins the workers (see shutdown)
+	static ThreadPool* const Instance = new ThreadPool();
+	return *Instance;
+}
+
+/** Constructor for ThreadPool: starts a worker for every hardware thread except the one calling parallelFor
+*/
+ThreadPool::ThreadPool()
+{
+	this->m_Task = nullptr;
+	this->m_NumberOfBlocks = 0;
+	this->m_NextBlock = 0;
+	this->m_NumberOfBusyThreads = 0;
+	this->m_Generation = 0;
+	this->m_Stop = false;
+
+	const unsigned lHardwareThreads = std::thread::hardware_concurrency();
+	for (unsigned lCount = 1; lCount < lHardwareThreads; lCount++)
+	{
+		this->m_Threads.push_back(std::thread(&ThreadPool::workerLoop, this));
+	}
+}
+
+/** Destructor for ThreadPool: stops the workers
+*/
+ThreadPool::~ThreadPool()
+{
+	this->shutdown();
+}
+
+/** Stops and joins the workers, e.g. before the library is unloaded. A parallelFor after shutdown runs its blocks in
+*   order on the calling thread. Waits for a parallelFor running on another thread to finish first; must not be called
+*   from inside a block.
+*/
+void ThreadPool::shutdown()
+{
+	std::lock_guard<std::mutex> lCallLock(this->m_CallMutex);
+
+	{
+		std::lock_guard<std::mutex> lLock(this->m_Mutex);
+		this->m_Stop = true;
+	}
+	this->m_WorkAvailable.notify_all();
+
+	for (std::size_t lCount = 0; lCount < this->m_Threads.size(); lCount++)
+	{
+		this->m_Threads[lCount].join();
+	}
+	this->m_Threads.clear();
+}
+
+/** Returns the number of threads a parallelFor runs on (the workers and the calling thread)
+*/
+std::size_t ThreadPool::getNumberOfThreads() const
+{
+	return this->m_Threads.size() + 1;
+}
+
+/** Runs aTask(0) ... aTask(aNumberOfBlocks - 1) on the workers and the calling thread and returns when they have all
+*   finished. Blocks run in no particular order. If a block throws, the blocks that have not started are skipped and
+*   the exception is rethrown here.
+*
+*   A parallelFor called from inside a block, or while another thread's parallelFor is running, runs its blocks in
+*   order on the calling thread instead of waiting for the workers.
+* @param aNumberOfBlocks The number of blocks
+* @param aTask The function to run for every block
+*/
+void ThreadPool::parallelFor(const std::size_t aNumberOfBlocks, const std::function<void(std::size_t)>& aTask)
+{
+	if (aNumberOfBlocks == 0) return;
+
+	if (aNumberOfBlocks == 1 || sInsideParallelFor || !this->m_CallMutex.try_lock())
+	{
+		runInOrder(aNumberOfBlocks, aTask);
+		return;
+	}
+	std::lock_guard<std::mutex> lCallLock(this->m_CallMutex, std::adopt_lock);
+
+	// checked with the call mutex held, so shutdown cannot be joining the workers meanwhile
+	if (this->m_Threads.empty())
+	{
+		runInOrder(aNumberOfBlocks, aTask);
+		return;
+	}
+
+	{
+		std::lock_guard<std::mutex> lLock(this->m_Mutex);
+		this->m_Task = &aTask;
+		this->m_NumberOfBlocks = aNumberOfBlocks;
+		this->m_NextBlock = 0;
+		this->m_NumberOfBusyThreads = this->m_Threads.size();
+		this->m_Exception = nullptr;
+		this->m_Generation++;
+	}
+	this->m_WorkAvailable.notify_all();
+
+	this->runBlocks();
+
+	std::exception_ptr lException;
+	{
+		std::unique_lock<std::mutex> lLock(this->m_Mutex);
+		this->m_WorkDone.wait(lLock, [this] { return this->m_NumberOfBusyThreads == 0; });
+		this->m_Task = nullptr;
+		lException = this->m_Exception;
+		this->m_Exception = nullptr;
+	}
+
+	if (lException) std::rethrow_exception(lException);
+}
+
+/** Runs aTask(0) ... aTask(aNumberOfBlocks - 1) in order on the calling thread
+* @param aNumberOfBlocks The number of blocks
+* @param aTask The function to run for every block
+*/
+void ThreadPool::runInOrder(const std::size_t aNumberOfBlocks, const std::function<void(std::size_t)>& aTask)
+{
+	for (std::size_t lBlock = 0; lBlock < aNumberOfBlocks; lBlock++)
+	{
+		aTask(lBlock);
+	}
+}
+
+/** Runs blocks of the current parallelFor until there are none left
+*/
+void ThreadPool::runBlocks()
+{
+	sInsideParallelFor = true;
+	while (true)
+	{
+		const std::size_t lBlock = this->m_NextBlock.fetch_add(1);
+		if (lBlock >= this->m_NumberOfBlocks) break;
+
+		try
+		{
+			(*this->m_Task)(lBlock);
+		}
+		catch (...)
+		{
+			std::lock_guard<std::mutex> lLock(this->m_Mutex);
+			if (!this->m_Exception) this->m_Exception = std::current_exception();
+			this->m_NextBlock = this->m_NumberOfBlocks;
+		}
+	}
+	sInsideParallelFor = false;
+}
+
+/** The loop of a worker thread: waits for a parallelFor, helps run its blocks, repeats
+*/
+void ThreadPool::workerLoop()
+{
+	unsigned long lGeneration = 0;
+	while (true)
+	{
+		{
+			std::unique_lock<std::mutex> lLock(this->m_Mutex);
+			this->m_WorkAvailable.wait(lLock, [this, lGeneration] { return this->m_Stop || this->m_Generation != lGeneration; });
+			if (this->m_Stop) return;
+			lGeneration = this->m_Generation;
+		}
+
+		this->runBlocks();
+
+		std::lock_guard<std::mutex> lLock(this->m_Mutex);
+		this->m_NumberOfBusyThreads--;
+		if (this->m_NumberOfBusyThreads == 0) this->m_WorkDone.notify_one();
+	}
+}